@@ -15,9 +15,14 @@
 
 #include "File.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <stdexcept>
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <boost/filesystem.hpp>
 
 #include "Ecf.hpp"
@@ -244,6 +249,156 @@ bool File::open(const std::string& filePath, std::string& contents) {
     return true;
 }
 
+namespace {
+
+// Closes the file descriptor on scope exit
+class FileDescriptor {
+public:
+    explicit FileDescriptor(int fd) : fd_(fd) {}
+    ~FileDescriptor() {
+        if (fd_ >= 0)
+            ::close(fd_);
+    }
+    FileDescriptor(const FileDescriptor&)            = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+    int fd() const { return fd_; }
+
+private:
+    int fd_;
+};
+
+bool open_for_range(const std::string& filename,
+                    const char* caller,
+                    int& fd,
+                    size_t& file_size,
+                    std::time_t& modify_time,
+                    std::string& error_msg) {
+    fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error_msg = std::string(caller) + ": Could not open file " + filename + " (" + strerror(errno) + ")";
+        return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        error_msg = std::string(caller) + ": Could not stat file " + filename + " (" + strerror(errno) + ")";
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    file_size   = static_cast<size_t>(st.st_size);
+    modify_time = st.st_mtime;
+    return true;
+}
+
+// Read up to len bytes at offset, returns the number of bytes read or -1
+ssize_t pread_all(int fd, char* buf, size_t len, size_t offset) {
+    size_t done = 0;
+    while (done < len) {
+        ssize_t n = ::pread(fd, buf + done, len - done, static_cast<off_t>(offset + done));
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        if (n == 0)
+            break; // end of file
+        done += static_cast<size_t>(n);
+    }
+    return static_cast<ssize_t>(done);
+}
+
+} // namespace
+
+bool File::read_byte_range(const std::string& filename,
+                           size_t begin,
+                           size_t end,
+                           std::string& contents,
+                           size_t& file_size,
+                           std::time_t& modify_time,
+                           std::string& error_msg) {
+    contents.clear();
+    int fd = -1;
+    if (!open_for_range(filename, "File::read_byte_range", fd, file_size, modify_time, error_msg))
+        return false;
+    FileDescriptor closer(fd);
+
+    if (end == 0 || end > file_size)
+        end = file_size;
+    if (begin >= end)
+        return true; // nothing new, i.e. when following a file that has not changed
+
+    contents.resize(end - begin);
+    ssize_t n = pread_all(fd, &contents[0], end - begin, begin);
+    if (n < 0) {
+        error_msg = "File::read_byte_range: Could not read file " + filename + " (" + strerror(errno) + ")";
+        contents.clear();
+        return false;
+    }
+    contents.resize(static_cast<size_t>(n)); // the file may have been truncated meanwhile
+    return true;
+}
+
+bool File::read_line_range(const std::string& filename,
+                           size_t begin,
+                           size_t end,
+                           std::string& contents,
+                           size_t& begin_offset,
+                           size_t& file_size,
+                           std::time_t& modify_time,
+                           std::string& error_msg) {
+    contents.clear();
+    begin_offset = 0;
+    int fd       = -1;
+    if (!open_for_range(filename, "File::read_line_range", fd, file_size, modify_time, error_msg))
+        return false;
+    FileDescriptor closer(fd);
+
+    if (end != 0 && end <= begin) {
+        return true;
+    }
+
+    const size_t block_size = 64 * 1024;
+    std::vector<char> buf(block_size);
+    size_t line      = 0;
+    size_t offset    = 0;
+    bool found_begin = (begin == 0);
+    while (offset < file_size) {
+        ssize_t n = pread_all(fd, buf.data(), std::min(block_size, file_size - offset), offset);
+        if (n < 0) {
+            error_msg = "File::read_line_range: Could not read file " + filename + " (" + strerror(errno) + ")";
+            contents.clear();
+            return false;
+        }
+        if (n == 0)
+            break;
+
+        const char* first = buf.data();
+        const char* last  = buf.data() + n;
+        const char* from  = first;
+        for (const char* p = first; p != last; ++p) {
+            if (*p != '\n')
+                continue;
+            ++line;
+            if (!found_begin && line == begin) {
+                found_begin  = true;
+                from         = p + 1;
+                begin_offset = offset + static_cast<size_t>(from - first);
+            }
+            else if (found_begin && end != 0 && line == end) {
+                contents.append(from, p + 1);
+                return true;
+            }
+        }
+        if (found_begin)
+            contents.append(from, last);
+        offset += static_cast<size_t>(n);
+    }
+
+    if (!found_begin)
+        begin_offset = offset;
+    return true;
+}
+
 bool File::create(const std::string& filename, const std::vector<std::string>& lines, std::string& errorMsg) {
     // For very large file. This is about 1 second quicker. Than using streams
     // See Test: TestFile.cpp:test_file_create_perf
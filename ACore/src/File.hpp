@@ -16,6 +16,7 @@
 // Description : This class is used as a helper class for file utilities
 //============================================================================
 
+#include <ctime>
 #include <ios>
 #include <string>
 #include <vector>
@@ -64,6 +65,31 @@ public:
     /// Opens the file and returns the contents
     static bool open(const std::string& filePath, std::string& contents);
 
+    /// Returns the bytes [begin,end) of the file, end of 0 means up to the end of the file.
+    /// The file is read with pread, only the requested range is held in memory, hence
+    /// suitable for following large files that are still being written.
+    /// file_size and modify_time are those of the file when it was read.
+    /// Return false and set error_msg if the file could not be read
+    static bool read_byte_range(const std::string& filename,
+                                size_t begin,
+                                size_t end,
+                                std::string& contents,
+                                size_t& file_size,
+                                std::time_t& modify_time,
+                                std::string& error_msg);
+
+    /// As above, but for the lines [begin,end), counted from 0. begin_offset is set to
+    /// the byte offset of the first returned line, so a client can continue with a byte range.
+    /// The lines before begin are scanned, but not kept.
+    static bool read_line_range(const std::string& filename,
+                                size_t begin,
+                                size_t end,
+                                std::string& contents,
+                                size_t& begin_offset,
+                                size_t& file_size,
+                                std::time_t& modify_time,
+                                std::string& error_msg);
+
     /// Given a file spath, and a vector of lines, creates a file. returns true if success
     /// else returns false and an error message
     static bool create(const std::string& filename, const std::vector<std::string>& lines, std::string& errorMsg);
@@ -0,0 +1,53 @@
+//============================================================================
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+//============================================================================
+
+#include "MappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace ecf;
+
+MappedFile::MappedFile(const std::string& file_name) : file_name_(file_name) {
+    int fd = ::open(file_name.c_str(), O_RDONLY);
+    if (fd == -1)
+        return;
+
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        if (st.st_size == 0) {
+            ok_ = true; // mmap does not allow zero length
+        }
+        else {
+            void* addr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                // We read the file once, from start to end
+                ::madvise(addr, st.st_size, MADV_SEQUENTIAL);
+                data_ = static_cast<const char*>(addr);
+                size_ = st.st_size;
+                ok_   = true;
+            }
+        }
+    }
+    ::close(fd); // The mapping remains valid after the close
+}
+
+MappedFile::~MappedFile() {
+    if (data_) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef MAPPED_FILE_HPP_
+#define MAPPED_FILE_HPP_
+
+//============================================================================
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description : Read only memory mapped file.
+//               The contents are available as a string_view, without being copied,
+//               allowing large files (defs, logs) to be processed in place.
+//============================================================================
+
+#include <string>
+
+#include <boost/utility/string_view.hpp>
+
+namespace ecf {
+
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& file_name);
+    ~MappedFile();
+
+    /// return false if the file could not be opened or mapped
+    bool ok() const { return ok_; }
+    const std::string& file_name() const { return file_name_; }
+
+    /// The whole file. Only valid while this object is alive
+    boost::string_view view() const { return boost::string_view(data_, size_); }
+    size_t size() const { return size_; }
+
+private:
+    MappedFile(const MappedFile&)                  = delete;
+    const MappedFile& operator=(const MappedFile&) = delete;
+
+    std::string file_name_;
+    const char* data_{nullptr};
+    size_t size_{0};
+    bool ok_{false};
+};
+
+} // namespace ecf
+
+#endif
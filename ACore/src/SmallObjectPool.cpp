@@ -0,0 +1,187 @@
+//============================================================================
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+//============================================================================
+
+#include "SmallObjectPool.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+namespace ecf {
+
+namespace {
+
+constexpr std::size_t ALIGN         = 16;
+constexpr std::size_t NO_OF_CLASSES = SmallObjectPool::MAX_SIZE / ALIGN;
+constexpr std::size_t CHUNK_SIZE    = 64 * 1024;
+constexpr std::size_t BATCH         = 64;        // blocks moved between a thread and the depot at a time
+constexpr std::size_t CACHE_LIMIT   = 4 * BATCH; // free blocks of a size kept by a thread
+
+struct FreeBlock
+{
+    FreeBlock* next_;
+};
+
+struct FreeList
+{
+    FreeBlock* head_;
+    std::size_t count_;
+
+    void push(void* p) {
+        auto* block  = static_cast<FreeBlock*>(p);
+        block->next_ = head_;
+        head_        = block;
+        count_++;
+    }
+    void* pop() {
+        FreeBlock* block = head_;
+        head_            = block->next_;
+        count_--;
+        return block;
+    }
+    // move up to n blocks to the other list
+    void move_to(FreeList& other, std::size_t n) {
+        while (head_ && n-- > 0)
+            other.push(pop());
+    }
+};
+
+// The free blocks shared by all threads, and the chunks they are carved from.
+// Never destroyed, since objects may be freed by static destructors at exit
+struct Depot
+{
+    std::mutex mutex_;
+    FreeList lists_[NO_OF_CLASSES];
+    std::size_t reserved_{0};
+};
+
+Depot& depot() {
+    static Depot* the_depot = new Depot();
+    return *the_depot;
+}
+
+// Trivially destructible, hence still usable after the thread exit handler below has run
+struct ThreadCache
+{
+    FreeList lists_[NO_OF_CLASSES];
+    bool exited_;
+    bool registered_;
+};
+thread_local ThreadCache cache;
+
+// Return the free blocks of a thread to the depot, when the thread exits
+struct ThreadCacheFlush
+{
+    ~ThreadCacheFlush() {
+        Depot& d = depot();
+        std::lock_guard<std::mutex> lock(d.mutex_);
+        for (std::size_t i = 0; i < NO_OF_CLASSES; i++)
+            cache.lists_[i].move_to(d.lists_[i], cache.lists_[i].count_);
+        cache.exited_ = true;
+    }
+};
+thread_local ThreadCacheFlush cache_flush;
+
+inline std::size_t size_class(std::size_t size) {
+    return (size == 0) ? 0 : (size - 1) / ALIGN;
+}
+
+bool read_enabled() {
+    const char* env = ::getenv("ECF_SMALL_OBJECT_POOL");
+    return !(env && std::strcmp(env, "0") == 0);
+}
+
+// Fill the list of the thread with a batch of blocks, from the depot or a new chunk
+void refill(FreeList& list, std::size_t index) {
+    if (!cache.registered_) {
+        cache.registered_ = true;
+        (void)&cache_flush; // construct, so that its destructor runs at thread exit
+    }
+
+    Depot& d = depot();
+    std::lock_guard<std::mutex> lock(d.mutex_);
+    FreeList& shared = d.lists_[index];
+    if (!shared.head_) {
+        std::size_t block_size = (index + 1) * ALIGN;
+        char* chunk            = static_cast<char*>(::operator new(CHUNK_SIZE));
+        d.reserved_ += CHUNK_SIZE;
+        for (std::size_t offset = 0; offset + block_size <= CHUNK_SIZE; offset += block_size)
+            shared.push(chunk + offset);
+    }
+    shared.move_to(list, BATCH);
+}
+
+} // namespace
+
+bool SmallObjectPool::enabled() {
+    static const bool is_enabled = read_enabled();
+    return is_enabled;
+}
+
+void* SmallObjectPool::allocate(std::size_t size) {
+    if (size > MAX_SIZE || !enabled())
+        return ::operator new(size);
+
+    std::size_t index = size_class(size);
+    if (cache.exited_) {
+        // only at thread exit, after the thread cache has been returned
+        Depot& d = depot();
+        std::lock_guard<std::mutex> lock(d.mutex_);
+        if (d.lists_[index].head_)
+            return d.lists_[index].pop();
+        // a full block, since deallocate() puts it on the free list of its size class
+        return ::operator new((index + 1) * ALIGN);
+    }
+
+    FreeList& list = cache.lists_[index];
+    if (!list.head_)
+        refill(list, index);
+    return list.pop();
+}
+
+void SmallObjectPool::deallocate(void* p, std::size_t size) noexcept {
+    if (!p)
+        return;
+    if (size > MAX_SIZE || !enabled()) {
+        ::operator delete(p);
+        return;
+    }
+
+    std::size_t index = size_class(size);
+    if (cache.exited_) {
+        Depot& d = depot();
+        std::lock_guard<std::mutex> lock(d.mutex_);
+        d.lists_[index].push(p);
+        return;
+    }
+
+    FreeList& list = cache.lists_[index];
+    list.push(p);
+    if (list.count_ > CACHE_LIMIT) {
+        // freeing a large defs, give the blocks back so that other threads can use them
+        Depot& d = depot();
+        std::lock_guard<std::mutex> lock(d.mutex_);
+        list.move_to(d.lists_[index], list.count_ - BATCH);
+    }
+}
+
+std::size_t SmallObjectPool::reserved_bytes() {
+    Depot& d = depot();
+    std::lock_guard<std::mutex> lock(d.mutex_);
+    return d.reserved_;
+}
+
+} // namespace ecf
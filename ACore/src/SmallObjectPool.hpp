@@ -0,0 +1,59 @@
+#ifndef SMALL_OBJECT_POOL_HPP_
+#define SMALL_OBJECT_POOL_HPP_
+
+//============================================================================
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description : Pool for small objects that are created and destroyed in large numbers,
+//               i.e. the nodes of the trigger/complete expression trees.
+//
+//               Objects are rounded up to a multiple of 16 bytes, and carved out of 64KB
+//               chunks that only hold objects of the same size. Freed objects are kept on
+//               a free list, per thread, and shared between threads in batches. Hence
+//               building and destroying a large defs needs few calls to malloc, and the
+//               objects do not fragment the heap used by the longer lived strings and
+//               vectors. The chunks are never returned to the system, but are re-used.
+//
+//               Classes opt in by defining operator new/delete, see ECF_SMALL_OBJECT_POOL
+//               Setting the environment variable ECF_SMALL_OBJECT_POOL=0 bypasses the pool,
+//               (read once, at the first allocation), to compare against the system allocator.
+//============================================================================
+
+#include <cstddef>
+
+namespace ecf {
+
+class SmallObjectPool {
+public:
+    /// Larger objects are allocated with the global operator new
+    static constexpr std::size_t MAX_SIZE = 256;
+
+    static void* allocate(std::size_t size);
+    static void deallocate(void* p, std::size_t size) noexcept;
+
+    /// The memory held by the pool, whether in use or free
+    static std::size_t reserved_bytes();
+    static bool enabled();
+
+private:
+    SmallObjectPool() = delete;
+};
+
+} // namespace ecf
+
+/// Place in the class definition, to allocate the class, and all derived classes, from the pool.
+/// The class must have a virtual destructor if objects are deleted through a base class pointer.
+#define ECF_SMALL_OBJECT_POOL                                                                                      \
+    static void* operator new(std::size_t size) { return ecf::SmallObjectPool::allocate(size); }                   \
+    static void operator delete(void* p, std::size_t size) noexcept { ecf::SmallObjectPool::deallocate(p, size); }
+
+#endif
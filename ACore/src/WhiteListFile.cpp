@@ -138,6 +138,13 @@ bool WhiteListFile::verify_write_access(const std::string& user, const std::vect
     return false;
 }
 
+// return true if path is allowed_path, or is below it
+static bool is_sub_path(const std::string& path, const std::string& allowed_path) {
+    if (path.compare(0, allowed_path.size(), allowed_path) != 0)
+        return false;
+    return path.size() == allowed_path.size() || path[allowed_path.size()] == '/';
+}
+
 static bool path_access(const std::vector<std::string>& paths, const std::vector<std::string>& allowed_paths) {
     if (allowed_paths.empty())
         return true; // no paths is specified in PASSWORD file allow access
@@ -155,31 +162,24 @@ static bool path_access(const std::vector<std::string>& paths, const std::vector
     //    /ecflow/fred               /ecflow/freddy      FALSE
     //    /ecflow/fred               /ecflow/fred/me     TRUE
 
+    // Requests with many paths, typically have paths in the same subtree. Hence try the
+    // allowed path that matched the previous path first, so that each subtree is checked once.
     size_t allowed_paths_size = allowed_paths.size();
-    size_t paths_size         = paths.size();
-    for (size_t i = 0; i < paths_size; i++) {
-        const std::string& path          = paths[i];
-        bool found_path_in_allowed_paths = false;
+    size_t last_allowed       = 0;
+    for (const auto& path : paths) {
+        if (is_sub_path(path, allowed_paths[last_allowed]))
+            continue;
 
+        bool found_path_in_allowed_paths = false;
         for (size_t ap = 0; ap < allowed_paths_size; ap++) {
-            const std::string& allowed_path = allowed_paths[ap];
-            //         cout << "path " << path << "\n";
-            //         cout << "allowed_path " <<  allowed_path << "\n";
-            //         if (path.size() > allowed_paths[ap].size()) {
-            //            cout << "path[allowed_path.size()] " << path[ allowed_path.size()] << "\n";
-            //         }
-            if (path.find(allowed_path) == 0) {
-                if (path.size() > allowed_path.size() && path[allowed_path.size()] != '/') {
-                    // FALSE case above
-                    continue;
-                }
-
+            if (is_sub_path(path, allowed_paths[ap])) {
                 found_path_in_allowed_paths = true;
-                continue; // all paths must match, or fail
+                last_allowed                = ap;
+                break;
             }
         }
         if (!found_path_in_allowed_paths)
-            return false;
+            return false; // all paths must match, or fail
     }
     return true;
 }
@@ -190,18 +190,9 @@ static bool path_access(const std::string& path, const std::vector<std::string>&
     if (path.empty())
         return false;
 
-    size_t allowed_paths_size = allowed_paths.size();
-    for (size_t ap = 0; ap < allowed_paths_size; ap++) {
-        const std::string& allowed_path = allowed_paths[ap];
-
-        if (path.find(allowed_path) == 0) {
-            // found path in allowed paths, check correct SUB_PATH
-            if (path.size() > allowed_path.size() && path[allowed_path.size()] != '/') {
-                // FALSE case above
-                continue;
-            }
+    for (const auto& allowed_path : allowed_paths) {
+        if (is_sub_path(path, allowed_path))
             return true;
-        }
     }
     return false;
 }
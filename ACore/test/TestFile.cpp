@@ -497,6 +497,59 @@ BOOST_AUTO_TEST_CASE(test_get_last_lines_of_a_file) {
     fs::remove(path); // Remove the file. Comment out for debugging
 }
 
+BOOST_AUTO_TEST_CASE(test_read_file_range) {
+    cout << "ACore:: ...test_read_file_range\n";
+
+    std::string path = File::test_data("ACore/test/data/test_read_file_range.txt", "ACore");
+    std::string all;
+    { // create file with 100 lines 0-99
+        std::stringstream ss;
+        std::ofstream file(path.c_str());
+        for (size_t i = 0; i < 100; i++) {
+            file << i << ": the line\n";
+            ss << i << ": the line\n";
+        }
+        all = ss.str();
+    }
+
+    std::string contents, error_msg;
+    size_t file_size        = 0;
+    size_t begin_offset     = 0;
+    std::time_t modify_time = 0;
+    { // the whole file
+        BOOST_REQUIRE_MESSAGE(File::read_byte_range(path, 0, 0, contents, file_size, modify_time, error_msg),
+                              error_msg);
+        BOOST_CHECK_MESSAGE(contents == all, "Expected the whole file");
+        BOOST_CHECK_MESSAGE(file_size == all.size(), "Expected size " << all.size() << " but found " << file_size);
+        BOOST_CHECK_MESSAGE(modify_time != 0, "Expected the modification time");
+    }
+    { // from a byte to the end, and past the end
+        BOOST_REQUIRE(File::read_byte_range(path, 10, 0, contents, file_size, modify_time, error_msg));
+        BOOST_CHECK_MESSAGE(contents == all.substr(10), "Expected from byte 10 but found " << contents);
+        BOOST_REQUIRE(File::read_byte_range(path, 20, 30, contents, file_size, modify_time, error_msg));
+        BOOST_CHECK_MESSAGE(contents == all.substr(20, 10), "Expected bytes [20,30) but found " << contents);
+        BOOST_REQUIRE(File::read_byte_range(path, all.size() + 10, 0, contents, file_size, modify_time, error_msg));
+        BOOST_CHECK_MESSAGE(contents.empty(), "Expected nothing past the end but found " << contents);
+    }
+    { // lines
+        BOOST_REQUIRE(File::read_line_range(path, 98, 0, contents, begin_offset, file_size, modify_time, error_msg));
+        BOOST_CHECK_MESSAGE(contents == "98: the line\n99: the line\n",
+                            "Expected the last 2 lines but found " << contents);
+        BOOST_CHECK_MESSAGE(begin_offset == all.find("98: the line"), "Unexpected offset " << begin_offset);
+        BOOST_REQUIRE(File::read_line_range(path, 0, 2, contents, begin_offset, file_size, modify_time, error_msg));
+        BOOST_CHECK_MESSAGE(contents == "0: the line\n1: the line\n",
+                            "Expected the first 2 lines but found " << contents);
+        BOOST_CHECK_MESSAGE(begin_offset == 0, "Unexpected offset " << begin_offset);
+        BOOST_REQUIRE(File::read_line_range(path, 200, 0, contents, begin_offset, file_size, modify_time, error_msg));
+        BOOST_CHECK_MESSAGE(contents.empty(), "Expected no lines but found " << contents);
+        BOOST_CHECK_MESSAGE(begin_offset == all.size(), "Unexpected offset " << begin_offset);
+    }
+    fs::remove(path); // Remove the file. Comment out for debugging
+
+    BOOST_CHECK_MESSAGE(!File::read_byte_range(path, 0, 0, contents, file_size, modify_time, error_msg),
+                        "Expected failure for a missing file");
+}
+
 BOOST_AUTO_TEST_CASE(test_directory_traversal) {
     cout << "ACore:: ...test_directory_traversal\n";
 
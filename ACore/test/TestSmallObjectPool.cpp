@@ -0,0 +1,130 @@
+//============================================================================
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+//============================================================================
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "SmallObjectPool.hpp"
+
+using namespace std;
+using namespace ecf;
+
+BOOST_AUTO_TEST_SUITE(CoreTestSuite)
+
+namespace {
+class Base {
+public:
+    Base() = default;
+    virtual ~Base() = default;
+    virtual int value() const { return 1; }
+    ECF_SMALL_OBJECT_POOL
+};
+
+class Derived : public Base {
+public:
+    Derived() { std::memset(buffer_, 'x', sizeof(buffer_)); }
+    int value() const override { return buffer_[sizeof(buffer_) - 1]; }
+
+private:
+    char buffer_[100];
+};
+
+class Large : public Base {
+    char buffer_[SmallObjectPool::MAX_SIZE * 2];
+};
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_small_object_pool) {
+    cout << "ACore:: ...test_small_object_pool\n";
+
+    // All sizes, including zero and beyond the pool, are aligned and writable
+    std::vector<std::pair<void*, size_t>> blocks;
+    for (size_t size = 0; size <= SmallObjectPool::MAX_SIZE + 16; size++) {
+        void* p = SmallObjectPool::allocate(size);
+        BOOST_REQUIRE(p);
+        BOOST_CHECK_MESSAGE(reinterpret_cast<std::uintptr_t>(p) % 16 == 0, "Block of size " << size << " not aligned");
+        std::memset(p, 0xff, size);
+        blocks.emplace_back(p, size);
+    }
+    for (auto& b : blocks)
+        SmallObjectPool::deallocate(b.first, b.second);
+
+    if (SmallObjectPool::enabled()) {
+        // A freed block is re-used by the next allocation of the same size class
+        void* p = SmallObjectPool::allocate(40);
+        SmallObjectPool::deallocate(p, 40);
+        void* q = SmallObjectPool::allocate(48);
+        BOOST_CHECK_MESSAGE(p == q, "Expected block to be re-used");
+        SmallObjectPool::deallocate(q, 48);
+        BOOST_CHECK(SmallObjectPool::reserved_bytes() > 0);
+    }
+
+    // Deleting through the base class, returns the block of the derived size
+    std::vector<std::unique_ptr<Base>> objects;
+    for (int i = 0; i < 10000; i++) {
+        if (i % 3 == 0)
+            objects.emplace_back(std::make_unique<Base>());
+        else if (i % 3 == 1)
+            objects.emplace_back(std::make_unique<Derived>());
+        else
+            objects.emplace_back(std::make_unique<Large>());
+    }
+    for (size_t i = 0; i < objects.size(); i++) {
+        int expected = (i % 3 == 1) ? 'x' : 1;
+        BOOST_REQUIRE_MESSAGE(objects[i]->value() == expected, "Object " << i << " overwritten");
+    }
+    objects.clear();
+}
+
+BOOST_AUTO_TEST_CASE(test_small_object_pool_threads) {
+    cout << "ACore:: ...test_small_object_pool_threads\n";
+
+    // Objects created in one thread may be destroyed in another
+    std::vector<std::unique_ptr<Base>> shared(20000);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; t++) {
+        threads.emplace_back([&shared, t]() {
+            for (size_t i = t; i < shared.size(); i += 4)
+                shared[i] = (i % 2) ? std::unique_ptr<Base>(std::make_unique<Derived>()) : std::make_unique<Base>();
+        });
+    }
+    for (auto& th : threads)
+        th.join();
+    threads.clear();
+
+    for (size_t t = 0; t < 4; t++) {
+        threads.emplace_back([&shared, t]() {
+            // free the objects created by another thread
+            for (size_t i = (t + 1) % 4; i < shared.size(); i += 4) {
+                int expected = (i % 2) ? 'x' : 1;
+                if (shared[i]->value() != expected)
+                    throw std::runtime_error("object overwritten");
+                shared[i].reset();
+            }
+        });
+    }
+    for (auto& th : threads)
+        th.join();
+    shared.clear();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
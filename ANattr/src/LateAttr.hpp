@@ -21,6 +21,7 @@
 
 #include <boost/date_time/posix_time/posix_time_types.hpp>
 
+#include "SmallObjectPool.hpp"
 #include "TimeSlot.hpp"
 class NState;
 namespace ecf {
@@ -52,6 +53,8 @@ class LateAttr {
 public:
     LateAttr();
 
+    ECF_SMALL_OBJECT_POOL
+
     void print(std::string&) const;
     bool operator==(const LateAttr& rhs) const;
 
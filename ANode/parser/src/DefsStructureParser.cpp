@@ -14,13 +14,18 @@
 //============================================================================
 #include "DefsStructureParser.hpp"
 
+#include <atomic>
+#include <memory>
+#include <set>
 #include <sstream>
+#include <thread>
 
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/token_functions.hpp>
 #include <boost/tokenizer.hpp>
 
 #include "Defs.hpp"
+#include "Ecf.hpp"
 #include "Str.hpp"
 #include "Version.hpp"
 
@@ -30,6 +35,17 @@ using namespace ecf;
 using namespace std;
 using namespace boost;
 
+// By default only large definitions, i.e. server check points, are parsed in parallel
+static size_t parallel_parse_threshold_ = 4 * 1024 * 1024;
+
+void DefsStructureParser::set_parallel_parse_threshold(size_t bytes) {
+    parallel_parse_threshold_ = bytes;
+}
+
+size_t DefsStructureParser::parallel_parse_threshold() {
+    return parallel_parse_threshold_;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////
 DefsStructureParser::DefsStructureParser(Defs* defsfile, const std::string& file_name)
     : parsing_node_string_(false),
@@ -38,7 +54,7 @@ DefsStructureParser::DefsStructureParser(Defs* defsfile, const std::string& file
       defsParser_(this),
       lineNumber_(0),
       file_type_(PrintStyle::DEFS),
-      defs_as_string_(Str::EMPTY()) {
+      defs_as_string_(infile_.view(), false /* same as std::getline() */) {
     if (!infile_.ok()) {
         std::stringstream ss;
         ss << "DefsStructureParser::DefsStructureParser: Unable to open file! " << infile_.file_name() << "\n\n";
@@ -79,6 +95,21 @@ DefsStructureParser::DefsStructureParser(const std::string& defs_node_string)
     }
 }
 
+DefsStructureParser::DefsStructureParser(Defs* defsfile,
+                                         boost::string_view suite_text,
+                                         bool skip_empty_lines,
+                                         int lineNumber,
+                                         PrintStyle::Type_t file_type)
+    : parsing_node_string_(false),
+      infile_(""),
+      defsfile_(defsfile),
+      defsParser_(this),
+      lineNumber_(lineNumber),
+      file_type_(file_type),
+      defs_as_string_(suite_text, skip_empty_lines),
+      parallel_parse_tried_(true) {
+}
+
 DefsStructureParser::~DefsStructureParser() {
 #ifdef SHOW_PARSER_STATS
     defsParser_.printStats();
@@ -91,13 +122,13 @@ bool DefsStructureParser::doParse(std::string& errorMsg, std::string& warningMsg
         return false;
     }
 
-    if (defs_as_string_.empty()) {
-        if (!do_parse_file(errorMsg)) {
+    if (infile_.file_name().empty()) {
+        if (!do_parse_string(errorMsg)) {
             return false;
         }
     }
     else {
-        if (!do_parse_string(errorMsg)) {
+        if (!do_parse_file(errorMsg)) {
             return false;
         }
     }
@@ -113,11 +144,30 @@ bool DefsStructureParser::doParse(std::string& errorMsg, std::string& warningMsg
 }
 
 bool DefsStructureParser::do_parse_file(std::string& errorMsg) {
+    return do_parse(errorMsg);
+}
+
+bool DefsStructureParser::do_parse_string(std::string& errorMsg) {
+    if (!do_parse(errorMsg)) {
+        the_node_ptr_ = node_ptr();
+        return false;
+    }
+    return true;
+}
+
+bool DefsStructureParser::do_parse(std::string& errorMsg) {
     std::vector<std::string> lineTokens;
     lineTokens.reserve(64);
     string line;
     line.reserve(1024);
-    while (infile_.good()) {
+    while (defs_as_string_.good()) {
+        if (!parallel_parse_tried_ && can_parse_suites_in_parallel()) {
+            parallel_parse_tried_ = true;
+            if (parse_suites_in_parallel()) {
+                continue; // carry on after the last suite
+            }
+        }
+
         getNextLine(line); // will increment lineNumer_
         if (!do_parse_line(line, lineTokens, errorMsg)) {
             return false;
@@ -126,18 +176,158 @@ bool DefsStructureParser::do_parse_file(std::string& errorMsg) {
     return true;
 }
 
-bool DefsStructureParser::do_parse_string(std::string& errorMsg) {
-    std::vector<std::string> lineTokens;
-    lineTokens.reserve(64);
-    string line;
-    line.reserve(1024);
-    while (defs_as_string_.good()) {
-        getNextLine(line); // will increment lineNumer_
-        if (!do_parse_line(line, lineTokens, errorMsg)) {
-            the_node_ptr_ = node_ptr();
+// return the first token of the line, without copying
+static boost::string_view first_token(boost::string_view line, size_t& end) {
+    size_t begin = line.find_first_not_of(" \t");
+    if (begin == boost::string_view::npos) {
+        end = line.size();
+        return boost::string_view();
+    }
+    end = line.find_first_of(" \t", begin);
+    if (end == boost::string_view::npos)
+        end = line.size();
+    return line.substr(begin, end - begin);
+}
+
+static boost::string_view first_token(boost::string_view line) {
+    size_t end = 0;
+    return first_token(line, end);
+}
+
+bool DefsStructureParser::can_parse_suites_in_parallel() const {
+    // Only at the top level of a defs, when we are about to parse the first suite
+    if (parsing_node_string_ || !defsfile_ || parallel_parse_threshold_ == 0)
+        return false;
+    if (!nodeStack_.empty() || !multi_statements_per_line_vec_.empty())
+        return false;
+    if (defs_as_string_.pos() + defs_as_string_.remaining().size() < parallel_parse_threshold_)
+        return false;
+
+    DefsString reader(defs_as_string_.remaining(), defs_as_string_.skips_empty_lines());
+    return reader.good() && first_token(reader.next_line()) == "suite";
+}
+
+bool DefsStructureParser::parse_suites_in_parallel() {
+    // Find the text of each suite. Only comments are allowed between and after the suites,
+    // anything else (i.e. externs, nested or duplicate suites, multiple statements per line
+    // involving suites) and we parse serially, so that the results and errors are unchanged.
+    struct SuiteText
+    {
+        boost::string_view text_;
+        int lineNumber_; // number of lines before the suite
+    };
+    std::vector<SuiteText> suites;
+    std::set<boost::string_view> suite_names;
+
+    boost::string_view remaining = defs_as_string_.remaining();
+    DefsString reader(remaining, defs_as_string_.skips_empty_lines());
+    bool persist_style   = PrintStyle::is_persist_style(file_type_);
+    int lineNumber       = lineNumber_;
+    int suite_lineNumber = 0;
+    int end_lineNumber   = 0;
+    size_t suite_begin   = boost::string_view::npos;
+    size_t end_of_suites = 0;
+    while (reader.good()) {
+        size_t line_begin       = reader.pos();
+        boost::string_view line = reader.next_line();
+        lineNumber++;
+
+        if (!persist_style && line.find(';') != boost::string_view::npos &&
+            line.find("suite") != boost::string_view::npos) {
             return false;
         }
+
+        size_t end               = 0;
+        boost::string_view token = first_token(line, end);
+        if (token.empty() || token[0] == '#') {
+            continue;
+        }
+        if (token == "suite") {
+            if (suite_begin != boost::string_view::npos)
+                return false;
+            if (!suite_names.insert(first_token(line.substr(end))).second)
+                return false;
+            suite_begin      = line_begin;
+            suite_lineNumber = lineNumber - 1;
+        }
+        else if (token == "endsuite") {
+            if (suite_begin == boost::string_view::npos)
+                return false;
+            suites.push_back({remaining.substr(suite_begin, reader.pos() - suite_begin), suite_lineNumber});
+            suite_begin    = boost::string_view::npos;
+            end_of_suites  = reader.pos();
+            end_lineNumber = lineNumber;
+        }
+        else if (suite_begin == boost::string_view::npos) {
+            return false;
+        }
+    }
+    if (suite_begin != boost::string_view::npos || suites.size() < 2) {
+        return false;
+    }
+
+    // Each suite is parsed into its own Defs. The change numbers are global, and *not* thread safe.
+    // Hence disable them whilst parsing. This only affects the server, which resets its change numbers
+    // after loading the check point, forcing the clients to re-sync.
+    struct SuiteResult
+    {
+        Defs defs_;
+        std::string faults_;
+        bool ok_{false};
+    };
+    std::vector<std::unique_ptr<SuiteResult>> results(suites.size());
+    for (auto& result : results) {
+        result = std::make_unique<SuiteResult>();
+    }
+
+    std::atomic<size_t> next_suite(0);
+    auto parse_suites = [&]() {
+        size_t i;
+        while ((i = next_suite++) < suites.size()) {
+            SuiteResult& result = *results[i];
+            try {
+                DefsStructureParser parser(&result.defs_,
+                                           suites[i].text_,
+                                           defs_as_string_.skips_empty_lines(),
+                                           suites[i].lineNumber_,
+                                           file_type_);
+                std::string errorMsg;
+                result.ok_     = parser.do_parse(errorMsg) && parser.nodeStack_.empty();
+                result.faults_ = parser.faults_;
+            }
+            catch (std::exception&) {
+                result.ok_ = false;
+            }
+        }
+    };
+
+    bool server = Ecf::server();
+    Ecf::set_server(false);
+    size_t no_of_threads = std::min<size_t>(suites.size(), std::max(2u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> threads;
+    threads.reserve(no_of_threads - 1);
+    for (size_t t = 1; t < no_of_threads; t++) {
+        threads.emplace_back(parse_suites);
     }
+    parse_suites();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    Ecf::set_server(server);
+
+    // Any errors, parse serially, to report the same error as before
+    for (const auto& result : results) {
+        if (!result->ok_)
+            return false;
+    }
+
+    for (const auto& result : results) {
+        defsfile_->absorb(&result->defs_, false); // only has the one suite
+        faults_ += result->faults_;
+    }
+
+    defs_as_string_.skip(end_of_suites);
+    lineNumber_ = end_lineNumber;
     return true;
 }
 
@@ -181,10 +371,7 @@ void DefsStructureParser::getNextLine(std::string& line) {
     // *ALL* the handling of multiple statements per line are handled in this function
     // The presence of ';' signals multiple statements per line.
     if (multi_statements_per_line_vec_.empty()) {
-        if (defs_as_string_.empty())
-            infile_.getline(line);
-        else
-            defs_as_string_.getline(line);
+        defs_as_string_.getline(line);
         lineNumber_++;
         if (PrintStyle::is_persist_style(file_type_)) {
             return; // ignore multiline for migrate, *BECAUSE* *history* for group command uses ';'
@@ -280,17 +467,51 @@ bool DefsStructureParser::semiColonInEditVariable() {
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
-DefsString::DefsString(const std::string& defs_as_string) : empty_(defs_as_string.empty()) {
-    if (!empty_) {
-        lines_.reserve(256);
-        Str::split_using_string_view(defs_as_string, lines_, "\n");
-    }
+DefsString::DefsString(const std::string& defs_as_string) : storage_(defs_as_string), defs_(storage_) {
+    skip_empty();
+}
+
+DefsString::DefsString(boost::string_view defs, bool skip_empty_lines)
+    : defs_(defs),
+      skip_empty_lines_(skip_empty_lines) {
+    skip_empty();
 }
 
 bool DefsString::good() const {
-    return line_pos_ < lines_.size();
+    if (skip_empty_lines_)
+        return pos_ < defs_.size();
+    return !eof_;
 }
 
 void DefsString::getline(std::string& line) {
-    line = lines_[line_pos_++];
+    boost::string_view the_line = next_line();
+    line.assign(the_line.data(), the_line.size());
+}
+
+boost::string_view DefsString::next_line() {
+    boost::string_view line;
+    size_t end = defs_.find('\n', pos_);
+    if (end == boost::string_view::npos) {
+        line = defs_.substr(pos_);
+        pos_ = defs_.size();
+        eof_ = true;
+    }
+    else {
+        line = defs_.substr(pos_, end - pos_);
+        pos_ = end + 1;
+    }
+    skip_empty();
+    return line;
+}
+
+void DefsString::skip(size_t n) {
+    pos_ += n;
+    skip_empty();
+}
+
+void DefsString::skip_empty() {
+    if (skip_empty_lines_) {
+        while (pos_ < defs_.size() && defs_[pos_] == '\n')
+            pos_++;
+    }
 }
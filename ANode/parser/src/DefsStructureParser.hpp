@@ -22,29 +22,53 @@
 
 #include <unordered_map>
 
+#include <boost/utility/string_view.hpp>
+
 #include "DefsParser.hpp"
-#include "File_r.hpp"
+#include "MappedFile.hpp"
 #include "NodeFwd.hpp"
 #include "PrintStyle.hpp"
 
 class Parser;
 
-// This class is used get a line of defs format from a defs string
+// This class is used get a line of defs format from a defs string, or a memory mapped defs file.
+// The lines are found in place, only the line returned by getline() is copied.
 class DefsString {
 public:
+    /// Empty lines are ignored
     explicit DefsString(const std::string& defs_as_string);
+
+    /// The defs must outlive this object. When skip_empty_lines is false, we behave like
+    /// std::getline(), i.e. a trailing new line gives an empty last line
+    DefsString(boost::string_view defs, bool skip_empty_lines);
+
     bool good() const;
     void getline(std::string& line);
-    bool empty() const { return empty_; }
+    bool empty() const { return defs_.empty(); }
+
+    /// return the next line, without copying
+    boost::string_view next_line();
+
+    /// The position of the next line, and the text from there on
+    size_t pos() const { return pos_; }
+    boost::string_view remaining() const { return defs_.substr(pos_); }
+
+    /// Skip over n characters of remaining(), which must end on a line boundary
+    void skip(size_t n);
+    bool skips_empty_lines() const { return skip_empty_lines_; }
 
 private:
     DefsString(const DefsString&)                  = delete;
     const DefsString& operator=(const DefsString&) = delete;
 
+    void skip_empty();
+
 private:
-    std::vector<std::string> lines_;
-    size_t line_pos_{0};
-    bool empty_;
+    std::string storage_;
+    boost::string_view defs_;
+    size_t pos_{0};
+    bool skip_empty_lines_{true};
+    bool eof_{false};
 };
 
 // This class is used to parse the DEFS file.
@@ -78,18 +102,40 @@ public:
     // warn about tokens not understood.
     std::string& faults() { return faults_; }
 
+    /// Definitions of at least this many bytes, have their suites parsed in parallel.
+    /// The suites are then added to the Defs in order. The results are identical to a serial parse.
+    /// A threshold of 0 disables parallel parsing. Allows the tests to force a parallel parse of small files.
+    static void set_parallel_parse_threshold(size_t bytes);
+    static size_t parallel_parse_threshold();
+
 protected: // allow test code access
     bool do_parse_file(std::string& errorMsg);
     bool do_parse_string(std::string& errorMsg);
 
+private:
+    // Parses the text of a single suite, for parse_suites_in_parallel()
+    DefsStructureParser(Defs* defsfile,
+                        boost::string_view suite_text,
+                        bool skip_empty_lines,
+                        int lineNumber,
+                        PrintStyle::Type_t file_type);
+
+    bool do_parse(std::string& errorMsg);
+
+    // Returns false if the suites can't be parsed independently, or there was an error. Caller must then
+    // parse serially, to get the same results/errors as before. Otherwise the suites are added to defsfile_
+    bool parse_suites_in_parallel();
+    bool can_parse_suites_in_parallel() const;
+
 private:
     bool parsing_node_string_;
-    ecf::File_r infile_;
+    ecf::MappedFile infile_;
     Defs* defsfile_;
     DefsParser defsParser_; // Child parsers will be deleted as well
     int lineNumber_;
     PrintStyle::Type_t file_type_;
     DefsString defs_as_string_;
+    bool parallel_parse_tried_{false};
     node_ptr the_node_ptr_;
 
     std::stack<std::pair<Node*, const Parser*>> nodeStack_; // stack of nodes used in parsing
@@ -102,7 +148,6 @@ private:
 private:
     // read in the next line form the defs file
     void getNextLine(std::string& line);
-    void getNextStringLine(std::string& line);
     bool do_parse_line(const std::string& line, std::vector<std::string>& lineTokens, std::string& errorMsg);
     bool semiColonInEditVariable();
 
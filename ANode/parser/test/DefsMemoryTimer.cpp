@@ -0,0 +1,109 @@
+//============================================================================
+// Name        :
+// Author      : Avi
+// Revision    : $Revision$
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description : Time and memory used to build, check, copy and destroy a large defs.
+//               Run with ECF_SMALL_OBJECT_POOL=0 to compare against the system allocator
+//               i.e.
+//               The defs is created by SyntheticDefs, the arguments are its parameters
+//                  perf_defs_memory suites=200
+//                  ECF_SMALL_OBJECT_POOL=0 perf_defs_memory suites=200
+//============================================================================
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <boost/timer/timer.hpp>
+
+#include <unistd.h>
+
+#include "Defs.hpp"
+#include "PrintStyle.hpp"
+#include "SmallObjectPool.hpp"
+#include "Str.hpp"
+#include "SyntheticDefs.hpp"
+
+using namespace std;
+using namespace ecf;
+using namespace boost::timer;
+
+// Resident set size in MB, from /proc/self/statm. Returns 0 if not available.
+static double rss_mb() {
+    std::ifstream statm("/proc/self/statm");
+    size_t size = 0, resident = 0;
+    if (!(statm >> size >> resident))
+        return 0;
+    return static_cast<double>(resident) * ::sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
+}
+
+static void report(const std::string& what, cpu_timer& timer) {
+    cout << " " << what << " = " << timer.format(3, Str::cpu_timer_format()) << " rss(" << rss_mb()
+         << " MB) pool(" << SmallObjectPool::reserved_bytes() / (1024 * 1024) << " MB)" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    // Each task has a trigger, and a complete expression, on its siblings,
+    // hence check() creates two abstract syntax trees per task
+    SyntheticDefs::Params params;
+    params.suites           = 100;
+    params.depth            = 1;
+    params.fan_out          = 20;
+    params.tasks            = 20;
+    params.trigger_density  = 1;
+    params.trigger_refs     = 2;
+    params.complete_density = 1;
+    try {
+        for (int i = 1; i < argc; i++)
+            params.set(argv[i]);
+    }
+    catch (std::exception& e) {
+        cout << e.what() << "\n";
+        cout << "Usage: perf_defs_memory [name=value ...], see SyntheticDefs::Params\n";
+        return 1;
+    }
+
+    cout << params.to_string() << " small object pool(" << (SmallObjectPool::enabled() ? "on" : "off") << ")"
+         << endl;
+    cout << " Start rss(" << rss_mb() << " MB)" << endl;
+
+    std::string defs_as_string;
+    SyntheticDefs(params).create()->save_as_string(defs_as_string, PrintStyle::DEFS);
+    cpu_timer timer;
+    for (int i = 0; i < 2; i++) {
+        // The second iteration shows how much of the memory released by the first is re-used
+        auto defs = std::make_unique<Defs>();
+
+        timer.start();
+        std::string error_msg, warning_msg;
+        if (!defs->restore_from_string(defs_as_string, error_msg, warning_msg)) {
+            cout << "Failed to parse generated defs: " << error_msg << "\n";
+            return 1;
+        }
+        report("Parse and check (AST creation) ", timer);
+
+        timer.start();
+        auto copy = std::make_unique<Defs>(*defs);
+        if (!copy->check(error_msg, warning_msg)) {
+            cout << "Failed to check copy: " << error_msg << "\n";
+            return 1;
+        }
+        report("Copy and check                 ", timer);
+
+        timer.start();
+        copy.reset();
+        defs.reset();
+        report("Destroy                        ", timer);
+    }
+    return 0;
+}
@@ -478,14 +478,14 @@ BOOST_AUTO_TEST_CASE(test_state_edit_history) {
                           "Edit history failed: " << helper.errorMsg());
 }
 
-static std::string dump_edit_history(const std::unordered_map<std::string, std::vector<std::string>>& edit_history) {
+static std::string dump_edit_history(const EditHistory& edit_history) {
     std::stringstream ss;
-    for (const auto& i : edit_history) {
-        ss << "node: " << i.first << "\n";
-        for (const auto& h : i.second) {
+    edit_history.for_each([&ss](const std::string& path, const std::vector<std::string>& requests) {
+        ss << "node: " << path << "\n";
+        for (const auto& h : requests) {
             ss << "  " << h << "\n";
         }
-    }
+    });
     return ss.str();
 }
 
@@ -515,8 +515,7 @@ BOOST_AUTO_TEST_CASE(test_state_edit_history_pruning) {
         BOOST_REQUIRE_MESSAGE(reloaded_defs.restore(tmpFilename, errorMsg, warningMsg),
                               "RE-PARSE failed for " << tmpFilename);
 
-        const std::unordered_map<std::string, std::vector<std::string>>& edit_history =
-            reloaded_defs.get_edit_history();
+        const EditHistory& edit_history = reloaded_defs.get_edit_history();
         BOOST_REQUIRE_MESSAGE(edit_history.empty(),
                               "Expected no edit history after pruning, but found:\n"
                                   << dump_edit_history(edit_history));
@@ -558,8 +557,7 @@ BOOST_AUTO_TEST_CASE(test_state_edit_history_pruning2) {
         BOOST_REQUIRE_MESSAGE(reloaded_defs.restore(tmpFilename, errorMsg, warningMsg),
                               "RE-PARSE failed for " << tmpFilename);
 
-        const std::unordered_map<std::string, std::vector<std::string>>& edit_history =
-            reloaded_defs.get_edit_history();
+        const EditHistory& edit_history = reloaded_defs.get_edit_history();
         //      cout << dump_edit_history(defs.get_edit_history()) << "\n";
 
         BOOST_REQUIRE_MESSAGE(!edit_history.empty(), "Expected edit history but found none");
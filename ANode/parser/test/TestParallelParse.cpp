@@ -0,0 +1,196 @@
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        : Request
+// Author      : Avi
+// Revision    : $Revision$
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description : Parsing suites in parallel, must give the same results as a serial parse
+//============================================================================
+
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Defs.hpp"
+#include "DefsStructureParser.hpp"
+#include "Ecf.hpp"
+#include "File.hpp"
+#include "Suite.hpp"
+
+namespace fs = boost::filesystem;
+using namespace std;
+using namespace ecf;
+
+BOOST_AUTO_TEST_SUITE(ParserTestSuite)
+
+// Restores the default, even if the test fails
+class ParallelParseThreshold {
+public:
+    explicit ParallelParseThreshold(size_t bytes) : previous_(DefsStructureParser::parallel_parse_threshold()) {
+        DefsStructureParser::set_parallel_parse_threshold(bytes);
+    }
+    ~ParallelParseThreshold() { DefsStructureParser::set_parallel_parse_threshold(previous_); }
+
+private:
+    size_t previous_;
+};
+
+struct ParseResult
+{
+    bool ok_{false};
+    std::string errorMsg_;
+    std::string warningMsg_;
+};
+
+static ParseResult parse_file(Defs& defs, const std::string& file, size_t threshold) {
+    ParallelParseThreshold parallel(threshold);
+    ParseResult result;
+    DefsStructureParser parser(&defs, file);
+    result.ok_ = parser.doParse(result.errorMsg_, result.warningMsg_);
+    return result;
+}
+
+static ParseResult parse_string(Defs& defs, const std::string& contents, size_t threshold) {
+    ParallelParseThreshold parallel(threshold);
+    ParseResult result;
+    DefsStructureParser parser(&defs, contents, true);
+    result.ok_ = parser.doParse(result.errorMsg_, result.warningMsg_);
+    return result;
+}
+
+static void compare(const std::string& file,
+                    const Defs& serial_defs,
+                    const ParseResult& serial,
+                    const Defs& parallel_defs,
+                    const ParseResult& parallel) {
+    BOOST_CHECK_MESSAGE(serial.ok_ == parallel.ok_,
+                        "Parallel parse of " << file << " returned " << parallel.ok_ << " expected " << serial.ok_
+                                             << "\n"
+                                             << parallel.errorMsg_);
+    BOOST_CHECK_MESSAGE(serial.errorMsg_ == parallel.errorMsg_,
+                        "Parallel parse of " << file << " error:\n"
+                                             << parallel.errorMsg_ << "\nexpected:\n"
+                                             << serial.errorMsg_);
+    BOOST_CHECK_MESSAGE(serial.warningMsg_ == parallel.warningMsg_,
+                        "Parallel parse of " << file << " warning:\n"
+                                             << parallel.warningMsg_ << "\nexpected:\n"
+                                             << serial.warningMsg_);
+    if (serial.ok_ && parallel.ok_) {
+        BOOST_CHECK_MESSAGE(serial_defs == parallel_defs, "Parallel parse of " << file << " gave a different defs");
+    }
+}
+
+static void test_parallel_parse(const std::string& directory, int& no_of_multi_suite_files) {
+    DebugEquality debug_equality; // only as affect in DEBUG build
+
+    fs::path full_path = fs::system_complete(fs::path(directory));
+    BOOST_REQUIRE(fs::is_directory(full_path));
+
+    fs::directory_iterator end_iter;
+    for (fs::directory_iterator dir_itr(full_path); dir_itr != end_iter; ++dir_itr) {
+        std::string file = directory + "/" + dir_itr->path().filename().string();
+        if (fs::is_directory(dir_itr->status())) {
+            test_parallel_parse(file, no_of_multi_suite_files);
+            continue;
+        }
+
+        // By file, this uses std::getline semantics
+        Defs serial_defs, parallel_defs;
+        ParseResult serial   = parse_file(serial_defs, file, 0);
+        ParseResult parallel = parse_file(parallel_defs, file, 1);
+        compare(file, serial_defs, serial, parallel_defs, parallel);
+        if (serial_defs.suiteVec().size() > 1) {
+            no_of_multi_suite_files++;
+        }
+
+        // By string, empty lines are ignored
+        std::string contents;
+        BOOST_REQUIRE_MESSAGE(File::open(file, contents), "Could not open file " << file);
+        if (!contents.empty()) {
+            Defs serial_str_defs, parallel_str_defs;
+            ParseResult serial_str   = parse_string(serial_str_defs, contents, 0);
+            ParseResult parallel_str = parse_string(parallel_str_defs, contents, 1);
+            compare(file, serial_str_defs, serial_str, parallel_str_defs, parallel_str);
+        }
+
+        // As a check point, i.e. with state, externs and edit history
+        if (serial.ok_) {
+            std::string tmpFilename = "test_parallel_parse.check";
+            serial_defs.save_as_checkpt(tmpFilename);
+
+            Defs serial_checkpt, parallel_checkpt;
+            ParseResult serial_result   = parse_file(serial_checkpt, tmpFilename, 0);
+            ParseResult parallel_result = parse_file(parallel_checkpt, tmpFilename, 1);
+            compare(file + " check point", serial_checkpt, serial_result, parallel_checkpt, parallel_result);
+            std::remove(tmpFilename.c_str());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_parse_of_test_data) {
+    cout << "AParser:: ...test_parallel_parse_of_test_data\n";
+
+    int no_of_multi_suite_files = 0;
+    test_parallel_parse(File::test_data("ANode/parser/test/data/good_defs", "parser"), no_of_multi_suite_files);
+    test_parallel_parse(File::test_data("ANode/parser/test/data/good_defs_state", "parser"),
+                        no_of_multi_suite_files);
+    test_parallel_parse(File::test_data("ANode/parser/test/data/single_defs", "parser"), no_of_multi_suite_files);
+    test_parallel_parse(File::test_data("ANode/parser/test/data/bad_defs", "parser"), no_of_multi_suite_files);
+    BOOST_CHECK_MESSAGE(no_of_multi_suite_files > 0, "Expected some test data with more than one suite");
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_parse_of_many_suites) {
+    cout << "AParser:: ...test_parallel_parse_of_many_suites\n";
+
+    // Comments between and after the suites are allowed
+    std::stringstream ss;
+    ss << "# many suites\nextern /a/b\n\n";
+    for (int s = 0; s < 50; s++) {
+        ss << "suite s" << s << "\n  edit SLEEP " << s << "\n";
+        for (int f = 0; f < 5; f++) {
+            ss << "  family f" << f << "\n    task t0\n    task t1\n      trigger t0 == complete\n  endfamily\n";
+        }
+        ss << "endsuite\n# end of s" << s << "\n\n";
+    }
+    std::string contents = ss.str();
+
+    DebugEquality debug_equality;
+    Defs serial_defs, parallel_defs;
+    ParseResult serial   = parse_string(serial_defs, contents, 0);
+    ParseResult parallel = parse_string(parallel_defs, contents, 1);
+    BOOST_REQUIRE_MESSAGE(serial.ok_, serial.errorMsg_);
+    compare("many suites", serial_defs, serial, parallel_defs, parallel);
+    BOOST_CHECK_MESSAGE(parallel_defs.suiteVec().size() == 50, "Expected 50 suites");
+    BOOST_CHECK_MESSAGE(parallel_defs.suiteVec()[49]->name() == "s49", "Expected suites in order");
+
+    // duplicate suites, must give the same error as a serial parse
+    std::string duplicate = contents + "suite s0\nendsuite\n";
+    Defs serial_dup, parallel_dup;
+    ParseResult serial_dup_result   = parse_string(serial_dup, duplicate, 0);
+    ParseResult parallel_dup_result = parse_string(parallel_dup, duplicate, 1);
+    BOOST_CHECK_MESSAGE(!serial_dup_result.ok_, "Expected duplicate suite to fail");
+    compare("duplicate suites", serial_dup, serial_dup_result, parallel_dup, parallel_dup_result);
+
+    // error in a suite, must give the same error and line number
+    std::string error = contents;
+    error.replace(error.find("task t1"), 7, "task t1 t2 t3 t4");
+    error.replace(error.rfind("task t1"), 7, "tusk t1");
+    Defs serial_err, parallel_err;
+    ParseResult serial_err_result   = parse_string(serial_err, error, 0);
+    ParseResult parallel_err_result = parse_string(parallel_err, error, 1);
+    BOOST_CHECK_MESSAGE(!serial_err_result.ok_, "Expected error");
+    compare("error", serial_err, serial_err_result, parallel_err, parallel_err_result);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
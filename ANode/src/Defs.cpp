@@ -26,6 +26,7 @@
 #include "ExprDuplicate.hpp"
 #include "Extract.hpp"
 #include "File.hpp"
+#include "FindNodeCache.hpp"
 #include "Indentor.hpp"
 #include "JobCreationCtrl.hpp"
 #include "Log.hpp"
@@ -133,20 +134,14 @@ void Defs::handle_migration() {
     }
 
     // remove any edit history that is no longer referenced. Ignore root, which will not be found
-    auto it = edit_history_.begin();
-    while (it != edit_history_.end()) {
-
-        if ((*it).first == Str::ROOT_PATH()) {
-            it++;
+    for (const auto& path : edit_history_.paths()) {
+        if (path == Str::ROOT_PATH())
             continue; // root path is defs, which is not a node, hence ignore
-        }
 
-        node_ptr node = findAbsNode((*it).first);
+        node_ptr node = findAbsNode(path);
         if (!node.get()) {
-            it = edit_history_.erase(it);
+            edit_history_.remove(path);
         }
-        else
-            it++;
     }
 }
 
@@ -444,6 +439,16 @@ void Defs::add_suite_only(const suite_ptr& s, size_t position) {
     client_suite_mgr_.suite_added_in_defs(s);
 }
 
+void Defs::share_suite(const suite_ptr& s) {
+    if (findSuite(s->name()).get()) {
+        std::stringstream ss;
+        ss << "Share Suite failed: A Suite of name '" << s->name() << "' already exist";
+        throw std::runtime_error(ss.str());
+    }
+    s->set_defs(this);
+    suiteVec_.push_back(s);
+}
+
 suite_ptr Defs::removeSuite(suite_ptr s) {
     auto i = std::find(suiteVec_.begin(), suiteVec_.end(), s);
     if (i != suiteVec_.end()) {
@@ -739,58 +744,13 @@ void Defs::write_state(std::string& os) const {
     // -  Used in commands
     if (save_edit_history_) {
         Indentor in;
-        for (const auto& i : edit_history_) {
-            Indentor::indent(os);
-            os += "history ";
-            os += i.first;
-            os += " ";                                      // node path
-            const std::vector<std::string>& vec = i.second; // list of requests
-            for (const auto& c : vec) {
-
-                // We expect to output a single newline, hence if there are additional new lines
-                // It can mess  up, re-parse. i.e during alter change label/value, user could have added newlines
-                if (c.find("\n") == std::string::npos) {
-                    os += "\b";
-                    os += c;
-                }
-                else {
-                    std::string h = c;
-                    Str::replaceall(h, "\n", "\\n");
-                    os += "\b";
-                    os += h;
-                }
-            }
-            os += "\n";
-        }
+        edit_history_.write(os);
         save_edit_history_ = false;
     }
 }
 
 std::string Defs::dump_edit_history() const {
-    std::stringstream os;
-    for (const auto& i : edit_history_) {
-        os << "history ";
-        os << i.first;
-        os << "  ";                                     // node path
-        const std::vector<std::string>& vec = i.second; // list of requests
-        for (const auto& c : vec) {
-
-            // We expect to output a single newline, hence if there are additional new lines
-            // It can mess  up, re-parse. i.e during alter change label/value, user could have added newlines
-            if (c.find("\n") == std::string::npos) {
-                os << " ";
-                os << c;
-            }
-            else {
-                std::string h = c;
-                Str::replaceall(h, "\n", "\\n");
-                os << " ";
-                os << h;
-            }
-        }
-        os << "\n";
-    }
-    return os.str();
+    return edit_history_.dump();
 }
 
 void Defs::read_state(const std::string& line, const std::vector<std::string>& lineTokens) {
@@ -859,33 +819,12 @@ void Defs::read_history(const std::string& line, const std::vector<std::string>&
         }
     }
     else {
-        std::vector<std::string> vec;
         date todays_date_in_utc = day_clock::universal_day();
-
         for (const auto& parsed_message : parsed_messages) {
-            // extract the date, expecting MSG:[HH:MM:SS D.M.YYYY]
-            if (parsed_message.find("MSG:[") == 0) {
-
-                size_t space_pos = parsed_message.find(" ");
-                size_t close_p   = parsed_message.find("]");
-                std::string date = parsed_message.substr(space_pos + 1, close_p - space_pos - 1);
-                vec.clear();
-                Str::split(date, vec, ".");
-                if (vec.size() == 3) {
-                    try {
-                        int day   = boost::lexical_cast<int>(vec[0]);
-                        int month = boost::lexical_cast<int>(vec[1]);
-                        int year  = boost::lexical_cast<int>(vec[2]);
-
-                        boost::gregorian::date node_log_date(year, month, day);
-                        boost::gregorian::date_duration duration = todays_date_in_utc - node_log_date;
-                        if (duration.days() > ecf_prune_node_log_) {
-                            continue;
-                        }
-                    }
-                    catch (...) {
-                    }
-                }
+            date node_log_date;
+            if (EditHistory::request_date(parsed_message, node_log_date) &&
+                (todays_date_in_utc - node_log_date).days() > ecf_prune_node_log_) {
+                continue;
             }
             add_edit_history(lineTokens[1], parsed_message);
         }
@@ -1009,7 +948,8 @@ node_ptr Defs::findAbsNode(const std::string& pathToNode) const {
         }
         else {
             // cout << "seraching from " << ret->absNodePath() << " for " << ref << "\n";
-            ret = ret->find_immediate_child(path_token);
+            ret = (find_cache_) ? find_cache_->find_immediate_child(ret, path_token)
+                                : ret->find_immediate_child(path_token);
             if (ret) {
                 if (string_splitter.last()) {
                     // cout << "finished returning " << ret->absNodePath() << " *last* \n";
@@ -1939,16 +1879,7 @@ void Defs::set_memento(const FlagMemento* memento, std::vector<ecf::Aspect::Type
 // =====================================================================
 
 void Defs::add_edit_history(const std::string& path, const std::string& request) {
-    auto i = edit_history_.find(path);
-    if (i == edit_history_.end()) {
-        edit_history_.insert(std::make_pair(path, std::vector<std::string>(1, request)));
-    }
-    else {
-        (*i).second.push_back(request);
-        if ((*i).second.size() > Defs::max_edit_history_size_per_node()) {
-            (*i).second.erase((*i).second.begin());
-        }
-    }
+    edit_history_.add(path, request);
 }
 
 void Defs::remove_edit_history(Node* node) {
@@ -1959,11 +1890,7 @@ void Defs::remove_edit_history(Node* node) {
     std::vector<node_ptr> node_children;
     node->get_all_nodes(node_children);
     for (const auto& c : node_children) {
-
-        auto it = edit_history_.find(c->absNodePath());
-        if (it != edit_history_.end()) {
-            edit_history_.erase(it);
-        }
+        edit_history_.remove(c->absNodePath());
     }
 }
 
@@ -1971,17 +1898,14 @@ void Defs::clear_edit_history() {
     edit_history_.clear();
 }
 
-const std::vector<std::string>& Defs::get_edit_history(const std::string& path) const {
-    auto i = edit_history_.find(path);
-    if (i != edit_history_.end()) {
-        return (*i).second;
+void Defs::prune_edit_history() {
+    if (ecf_prune_node_log_ != 0) {
+        edit_history_.prune(ecf_prune_node_log_, day_clock::universal_day());
     }
-    return empty_edit_history();
 }
 
-const std::vector<std::string>& Defs::empty_edit_history() {
-    static std::vector<std::string> static_edit_history;
-    return static_edit_history;
+std::vector<std::string> Defs::get_edit_history(const std::string& path) const {
+    return edit_history_.get(path);
 }
 
 // =====================================================================================
@@ -2123,10 +2047,8 @@ std::string Defs::stats() const {
     stats.nodes_              = node_vec.size();
 
     stats.edit_history_nodes_ = edit_history_.size();
-    for (const auto& i : edit_history_) {
-        const std::vector<std::string>& vec = i.second; // list of requests
-        stats.edit_history_paths_ += vec.size();
-    }
+    stats.edit_history_paths_ = edit_history_.no_of_requests();
+    stats.edit_history_size_  = edit_history_.memory_size();
 
     for (auto node : node_vec)
         node->stats(stats);
@@ -32,6 +32,7 @@
 #include "Aspect.hpp"
 #include "Attr.hpp"
 #include "ClientSuiteMgr.hpp"
+#include "EditHistory.hpp"
 #include "Flag.hpp"
 #include "NOrder.hpp"
 #include "NState.hpp"
@@ -46,6 +47,7 @@ namespace ecf {
 class NodeTreeVisitor;
 class CalendarUpdateParams;
 } // namespace ecf
+class FindNodeCache;
 
 class Defs {
 public:
@@ -145,6 +147,11 @@ public:
     /// Add a suite to the definition, will throw std::runtime_error if duplicate
     suite_ptr add_suite(const std::string& name);
     void addSuite(const suite_ptr&, size_t position = std::numeric_limits<std::size_t>::max());
+
+    /// Add a suite that is also held by other, immutable, Defs. The suite is moved to this Defs,
+    /// i.e. Node::defs() then returns this Defs, hence this Defs must outlive the other holders.
+    /// Used by ecflow_http, to share the unchanged suites between the snapshots of the defs
+    void share_suite(const suite_ptr&);
     size_t child_position(const Node*) const;
 
     /// Externs refer to Nodes or, variable, events, meter, repeat, or generated variable
@@ -300,11 +307,16 @@ public:
     void remove_edit_history(Node*);
     void clear_edit_history();
     std::string dump_edit_history() const;
-    const std::vector<std::string>& get_edit_history(const std::string& path) const;
-    const std::unordered_map<std::string, std::vector<std::string>>& get_edit_history() const { return edit_history_; }
+    std::vector<std::string> get_edit_history(const std::string& path) const;
+    const EditHistory& get_edit_history() const { return edit_history_; }
     void save_edit_history(bool f) const { save_edit_history_ = f; }
-    static const std::vector<std::string>& empty_edit_history();
-    constexpr static size_t max_edit_history_size_per_node() { return 10; }
+    constexpr static size_t max_edit_history_size_per_node() { return EditHistory::max_requests_per_node(); }
+
+    /// Limit the memory used by the edit history, across all nodes. 0 means no limit
+    void set_edit_history_max_size(size_t bytes) { edit_history_.set_max_size(bytes); }
+
+    /// Remove edit history older than ecf_prune_node_log_ days. Only does work once a day.
+    void prune_edit_history();
 
     /// Memento functions:
     void collateChanges(unsigned int client_handle, DefsDelta&) const;
@@ -383,7 +395,7 @@ private:
     NState state_;                          // state & change_no, i,e attribute changed
     ServerState server_;
     std::vector<suite_ptr> suiteVec_;
-    std::unordered_map<std::string, std::vector<std::string>> edit_history_; // path,request
+    EditHistory edit_history_;
     ecf::Flag flag_;
 
     ClientSuiteMgr client_suite_mgr_{this}; // NOT persisted
@@ -401,6 +413,9 @@ private:
     std::vector<AbstractObserver*> observers_;
     mutable bool save_edit_history_{false}; // NOT persisted
     bool in_notification_{false};
+    FindNodeCache* find_cache_{nullptr}; // NOT persisted, set while a FindNodeCache is in scope
+
+    friend class FindNodeCache;
 
     friend class ChangeStartNotification;
     void notify_delete();
@@ -15,6 +15,7 @@
 
 #include "DefsDelta.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "Memento.hpp"
@@ -28,8 +29,9 @@ using namespace std;
 // DefsDelta
 
 /// Defs delta can be re-used. reset all data members
-void DefsDelta::init(unsigned int client_state_change_no, bool sync_suite_clock) {
+void DefsDelta::init(unsigned int client_state_change_no, bool sync_suite_clock, bool compact_paths) {
     sync_suite_clock_        = sync_suite_clock;
+    compact_paths_           = compact_paths;
     client_state_change_no_  = client_state_change_no;
 
     server_state_change_no_  = 0;
@@ -61,9 +63,31 @@ bool DefsDelta::incremental_sync(defs_ptr client_def,
 #endif
 
         // For each compound memento, we should have a changed node,
-        for (compound_memento_ptr m : compound_mementos_) {
-            changed_nodes.push_back(m->abs_node_path()); // Record changed nodes for the Python interface
-            m->incremental_sync(client_def);
+        // Consecutive mementos are typically siblings, hence cache the parent, to avoid
+        // searching the defs from the root for every memento.
+        changed_nodes.reserve(compound_mementos_.size());
+        Node* parent = nullptr;
+        std::string::size_type parent_path_size = 0;
+        for (const compound_memento_ptr& m : compound_mementos_) {
+            const std::string& path = m->abs_node_path();
+            changed_nodes.push_back(path); // Record changed nodes for the Python interface
+
+            node_ptr node;
+            std::string::size_type pos = path.rfind('/');
+            if (parent && pos == parent_path_size &&
+                changed_nodes[changed_nodes.size() - 2].compare(0, pos, path, 0, pos) == 0) {
+                node = parent->find_immediate_child(boost::string_view(path.data() + pos + 1, path.size() - pos - 1));
+            }
+            else {
+                node = client_def->findAbsNode(path);
+            }
+
+            m->incremental_sync(client_def, node);
+
+            // A memento can add/delete/re-order the children of its node, but not the node itself,
+            // hence the parent of this node, remains valid, for the next memento
+            parent           = (node) ? node->parent() : nullptr;
+            parent_path_size = (parent) ? pos : 0;
         }
     }
     catch (std::exception& e) {
@@ -84,8 +108,46 @@ void DefsDelta::add(compound_memento_ptr memento) {
     compound_mementos_.push_back(memento);
 }
 
+void DefsDelta::compact_memento_paths() {
+    // Only worth front coding, when the shared prefix is larger than the cost of persisting path_prefix_
+    const std::string::size_type min_prefix = 24;
+
+    const std::string* previous = nullptr;
+    for (const compound_memento_ptr& m : compound_mementos_) {
+        const std::string& path = m->absNodePath_;
+        std::string::size_type prefix = 0;
+        if (previous) {
+            std::string::size_type max_prefix = std::min(path.size(), previous->size());
+            while (prefix < max_prefix && path[prefix] == (*previous)[prefix])
+                prefix++;
+        }
+        m->path_prefix_ = (prefix >= min_prefix) ? static_cast<unsigned int>(prefix) : 0;
+        previous        = &path;
+    }
+}
+
+void DefsDelta::expand_memento_paths() {
+    const std::string* previous = nullptr;
+    for (const compound_memento_ptr& m : compound_mementos_) {
+        if (m->path_prefix_ != 0) {
+            if (!previous || previous->size() < m->path_prefix_) {
+                throw std::runtime_error("DefsDelta::expand_memento_paths: Invalid path prefix for " + m->absNodePath_);
+            }
+            m->absNodePath_.insert(0, *previous, 0, m->path_prefix_);
+            m->path_prefix_ = 0;
+        }
+        previous = &m->absNodePath_;
+    }
+}
+
 template <class Archive>
 void DefsDelta::serialize(Archive& ar, std::uint32_t const version) {
+    if (Archive::is_saving::value && compact_paths_) {
+        compact_memento_paths();
+    }
     ar(CEREAL_NVP(server_state_change_no_), CEREAL_NVP(server_modify_change_no_), CEREAL_NVP(compound_mementos_));
+    if (Archive::is_loading::value) {
+        expand_memento_paths();
+    }
 }
 CEREAL_TEMPLATE_SPECIALIZE_V(DefsDelta);
@@ -25,6 +25,12 @@
 // so bringing it in sync with the server defs.
 //
 // Note:: updating state_change_no() on the *client side*  a no-op() it has no effect
+//
+// Compact paths:
+// The compound mementos are collated in tree order, hence consecutive mementos usually share a
+// long path prefix. When the client asks for it, (see CSyncCmd) only the part of each path that
+// differs from the previous memento is transferred. The paths are expanded again on loading.
+// A client that did not ask, gets the full paths, hence old clients are unaffected.
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
 
 #include <cstdint>
@@ -45,7 +51,7 @@ public:
     explicit DefsDelta(unsigned int client_state_change_no) : client_state_change_no_(client_state_change_no) {}
 
     /// This class can be re-used hence init() should reset all data members
-    void init(unsigned int client_state_change_no, bool sync_suite_clock);
+    void init(unsigned int client_state_change_no, bool sync_suite_clock, bool compact_paths = false);
 
     /// reclaim memory
     void cleanup() { std::vector<compound_memento_ptr>().swap(compound_mementos_); }
@@ -53,6 +59,9 @@ public:
     // ECFLOW-631, allow the suite calendar to be sync'ed, even if there are no other changes
     bool sync_suite_clock() const { return sync_suite_clock_; }
 
+    // When set, the compound memento paths are front coded on saving
+    bool compact_paths() const { return compact_paths_; }
+
     /// Add the compound memento, ie. store all memento's for a *given* node.
     void add(compound_memento_ptr);
 
@@ -75,8 +84,13 @@ public:
     /// return the number of compound mementos
     size_t size() const { return compound_mementos_.size(); }
 
+private:
+    void compact_memento_paths();
+    void expand_memento_paths();
+
 private:
     bool sync_suite_clock_{false};        // *no* need to persist since only used on server side
+    bool compact_paths_{false};           // *no* need to persist since only used on server side
     unsigned int client_state_change_no_; // *no* need to persist since only used on server side
 
     unsigned int server_state_change_no_{0};
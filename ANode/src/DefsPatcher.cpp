@@ -0,0 +1,384 @@
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#include "DefsPatcher.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <unordered_map>
+
+#include "AutoArchiveAttr.hpp"
+#include "AutoCancelAttr.hpp"
+#include "AutoRestoreAttr.hpp"
+#include "Defs.hpp"
+#include "Ecf.hpp"
+#include "Expression.hpp"
+#include "LateAttr.hpp"
+#include "Limit.hpp"
+#include "MiscAttrs.hpp"
+#include "PrintStyle.hpp"
+#include "Suite.hpp"
+#include "SuiteChanged.hpp"
+#include "Task.hpp"
+
+using namespace ecf;
+
+DefsPatcher::DefsPatcher(Defs& live_defs, Defs& new_defs) : live_defs_(&live_defs) {
+    for (const suite_ptr& new_suite : new_defs.suiteVec()) {
+        suite_ptr live_suite = live_defs.findSuite(new_suite->name());
+        if (live_suite) {
+            diff(live_suite, new_suite);
+        }
+        else {
+            Change change{ADD, node_ptr(), new_suite};
+            change.position_ = std::numeric_limits<std::size_t>::max();
+            changes_.push_back(change);
+        }
+    }
+}
+
+DefsPatcher::DefsPatcher(const node_ptr& live_node, const node_ptr& new_node) : live_defs_(live_node->defs()) {
+    diff(live_node, new_node);
+}
+
+void DefsPatcher::diff(const node_ptr& live_node, const node_ptr& new_node) {
+    if (live_node->debugType() != new_node->debugType() || !same_clock(*live_node, *new_node)) {
+        changes_.push_back(Change{REPLACE, live_node, new_node});
+        return;
+    }
+
+    if (!same_attributes(*live_node, *new_node)) {
+        changes_.push_back(Change{CHANGE, live_node, new_node});
+    }
+
+    // The children of a task are aliases, these are not part of the definition
+    if (live_node->isNodeContainer()) {
+        diff_children(live_node, new_node);
+    }
+}
+
+void DefsPatcher::diff_children(const node_ptr& live_node, const node_ptr& new_node) {
+    const std::vector<node_ptr>& live_children = live_node->isNodeContainer()->nodeVec();
+    const std::vector<node_ptr>& new_children  = new_node->isNodeContainer()->nodeVec();
+
+    std::vector<std::string> kept_in_live_order;
+    for (const node_ptr& live_child : live_children) {
+        if (new_node->find_immediate_child(live_child->name())) {
+            kept_in_live_order.push_back(live_child->name());
+        }
+        else {
+            changes_.push_back(Change{DELETE, live_child});
+        }
+    }
+
+    std::vector<std::string> kept_in_new_order;
+    std::vector<std::string> new_order;
+    new_order.reserve(new_children.size());
+    for (size_t i = 0; i < new_children.size(); i++) {
+        const node_ptr& new_child = new_children[i];
+        new_order.push_back(new_child->name());
+
+        node_ptr live_child = live_node->find_immediate_child(new_child->name());
+        if (live_child) {
+            kept_in_new_order.push_back(new_child->name());
+            diff(live_child, new_child);
+        }
+        else {
+            Change change{ADD, node_ptr(), new_child};
+            change.live_parent_ = live_node.get();
+            change.position_    = i;
+            changes_.push_back(change);
+        }
+    }
+
+    // Adding at the new position, only keeps the order, if the children we keep are in the same order
+    if (kept_in_live_order != kept_in_new_order) {
+        Change change{ORDER, live_node};
+        change.order_ = new_order;
+        changes_.push_back(change);
+    }
+}
+
+std::vector<node_ptr> DefsPatcher::nodes_to_remove() const {
+    std::vector<node_ptr> nodes;
+    for (const Change& change : changes_) {
+        if (change.kind_ == DELETE || change.kind_ == REPLACE) {
+            nodes.push_back(change.live_);
+        }
+    }
+    return nodes;
+}
+
+bool DefsPatcher::apply(bool force, std::string& errorMsg) {
+    if (!force) {
+        for (const node_ptr& node : nodes_to_remove()) {
+            std::vector<Task*> taskVec;
+            node->getAllTasks(taskVec); // taskVec will be empty if node is a task
+            if (node->isTask())
+                taskVec.push_back(node->isTask());
+            auto count = std::count_if(taskVec.begin(), taskVec.end(), [](Task* t) {
+                return t->state() == NState::ACTIVE || t->state() == NState::SUBMITTED;
+            });
+            if (count != 0) {
+                std::stringstream ss;
+                ss << "Cannot delete or replace node " << node->debugNodePath() << " because it has " << count
+                   << " tasks which are active or submitted\n";
+                ss << "Please use the 'force' option to bypass this check, at the expense of creating zombies\n";
+                errorMsg = ss.str();
+                return false;
+            }
+        }
+    }
+
+    bool structure_changed = false;
+    for (Change& change : changes_) {
+        switch (change.kind_) {
+            case ADD: {
+                node_ptr child = change.new_->remove();
+                if (change.live_parent_) {
+                    SuiteChangedPtr changed(change.live_parent_);
+                    change.live_parent_->addChild(child, change.position_);
+                    if (child->suite()->begun())
+                        child->begin();
+                    change.live_parent_->set_most_significant_state_up_node_tree();
+                }
+                else {
+                    live_defs_->addSuite(std::dynamic_pointer_cast<Suite>(child), change.position_);
+                }
+                structure_changed = true;
+                break;
+            }
+            case DELETE: {
+                Node* parent = change.live_->parent();
+                change.live_->remove();
+                if (parent)
+                    parent->set_most_significant_state_up_node_tree();
+                structure_changed = true;
+                break;
+            }
+            case REPLACE: {
+                // As with --replace, keep the suspended and begun status
+                Node* parent   = change.live_->parent();
+                size_t pos     = change.live_->position();
+                bool begun     = change.live_->suite()->begun();
+                node_ptr child = change.new_->remove();
+                if (change.live_->isSuspended())
+                    child->suspend();
+
+                change.live_->remove();
+                if (parent)
+                    parent->addChild(child, pos);
+                else
+                    live_defs_->addSuite(std::dynamic_pointer_cast<Suite>(child), pos);
+                if (begun)
+                    child->begin();
+                child->set_most_significant_state_up_node_tree();
+                structure_changed = true;
+                break;
+            }
+            case CHANGE: {
+                SuiteChangedPtr changed(change.live_.get());
+                patch_attributes(*change.live_, *change.new_);
+                break;
+            }
+            case ORDER: {
+                SuiteChangedPtr changed(change.live_.get());
+                order_children(*change.live_, change.order_);
+                break;
+            }
+        }
+    }
+
+    if (live_defs_) {
+        // Trigger AST's may reference nodes that have been deleted/replaced
+        if (structure_changed)
+            live_defs_->invalidate_trigger_references();
+        live_defs_->set_most_significant_state();
+    }
+    return true;
+}
+
+size_t DefsPatcher::count(Kind kind) const {
+    return std::count_if(
+        changes_.begin(), changes_.end(), [kind](const Change& change) { return change.kind_ == kind; });
+}
+
+std::string DefsPatcher::summary() const {
+    std::stringstream ss;
+    ss << "added:" << count(ADD) << " deleted:" << count(DELETE) << " replaced:" << count(REPLACE)
+       << " changed:" << count(CHANGE) << " re-ordered:" << count(ORDER);
+    return ss.str();
+}
+
+bool DefsPatcher::same_clock(const Node& live_node, const Node& new_node) {
+    const Suite* live_suite = live_node.isSuite();
+    const Suite* new_suite  = new_node.isSuite();
+    if (!live_suite || !new_suite)
+        return true;
+
+    auto clock_str = [](const clock_ptr& clock) { return clock ? clock->toString() : std::string(); };
+    return clock_str(live_suite->clockAttr()) == clock_str(new_suite->clockAttr()) &&
+           clock_str(live_suite->clock_end_attr()) == clock_str(new_suite->clock_end_attr());
+}
+
+bool DefsPatcher::same_attributes(const Node& live_node, const Node& new_node) {
+    // The defs format only shows the definition, and not the state
+    PrintStyle style(PrintStyle::DEFS);
+    std::string live_defs, new_defs;
+    live_node.Node::print(live_defs);
+    new_node.Node::print(new_defs);
+    return live_defs == new_defs;
+}
+
+// Take the new attributes, but where the definition is the same keep the live attribute, and hence its state
+template <typename T>
+static void keep_unchanged(std::vector<T>& live_attrs, const std::vector<T>& new_attrs) {
+    std::vector<T> attrs = new_attrs;
+    for (T& attr : attrs) {
+        std::string attr_str = attr.toString();
+        for (const T& live_attr : live_attrs) {
+            if (live_attr.toString() == attr_str) {
+                attr = live_attr;
+                break;
+            }
+        }
+    }
+    live_attrs = std::move(attrs);
+}
+
+static void patch_expression(std::unique_ptr<Expression>& live_expr,
+                             const std::unique_ptr<Expression>& new_expr,
+                             const char* expr_type) {
+    if (!new_expr) {
+        live_expr.reset();
+        return;
+    }
+    if (live_expr) {
+        // Keep the AST, and whether the expression was freed
+        std::string live_str, new_str;
+        live_expr->print(live_str, expr_type);
+        new_expr->print(new_str, expr_type);
+        if (live_str == new_str)
+            return;
+    }
+    live_expr = std::make_unique<Expression>(*new_expr);
+}
+
+// Replace the attribute only when its definition changed, hence an unchanged attribute keeps its state.
+// Returns true if the attribute was replaced
+template <typename T>
+static bool patch_attr(std::unique_ptr<T>& live_attr, const std::unique_ptr<T>& new_attr) {
+    if (live_attr && new_attr && live_attr->toString() == new_attr->toString())
+        return false;
+    if (new_attr)
+        live_attr = std::make_unique<T>(*new_attr);
+    else
+        live_attr.reset();
+    return true;
+}
+
+void DefsPatcher::patch_attributes(Node& live_node, const Node& new_node) {
+    PrintStyle style(PrintStyle::DEFS);
+
+    if (live_node.d_st_ != new_node.d_st_)
+        live_node.d_st_.setState(new_node.d_st_.state());
+    live_node.vars_ = new_node.vars_;
+
+    patch_expression(live_node.c_expr_, new_node.c_expr_, "complete");
+    patch_expression(live_node.t_expr_, new_node.t_expr_, "trigger");
+
+    keep_unchanged(live_node.meters_, new_node.meters_);
+    keep_unchanged(live_node.events_, new_node.events_);
+    keep_unchanged(live_node.labels_, new_node.labels_);
+    keep_unchanged(live_node.times_, new_node.times_);
+    keep_unchanged(live_node.todays_, new_node.todays_);
+    keep_unchanged(live_node.crons_, new_node.crons_);
+    keep_unchanged(live_node.dates_, new_node.dates_);
+    keep_unchanged(live_node.days_, new_node.days_);
+
+    patch_attr(live_node.late_, new_node.late_);
+    patch_attr(live_node.auto_cancel_, new_node.auto_cancel_);
+    patch_attr(live_node.auto_archive_, new_node.auto_archive_);
+    if (patch_attr(live_node.auto_restore_, new_node.auto_restore_) && live_node.auto_restore_)
+        live_node.auto_restore_->set_node(&live_node);
+
+    // Zombie and generic attributes have no state, queues keep their position and verify their count
+    if (live_node.misc_attrs_ && new_node.misc_attrs_) {
+        MiscAttrs& live_misc      = *live_node.misc_attrs_;
+        const MiscAttrs& new_misc = *new_node.misc_attrs_;
+        live_misc.zombies_        = new_misc.zombies_;
+        live_misc.generics_       = new_misc.generics_;
+        keep_unchanged(live_misc.verifys_, new_misc.verifys_);
+        keep_unchanged(live_misc.queues_, new_misc.queues_);
+    }
+    else if (new_node.misc_attrs_) {
+        live_node.misc_attrs_ = std::make_unique<MiscAttrs>(*new_node.misc_attrs_);
+        live_node.misc_attrs_->set_node(&live_node);
+    }
+    else {
+        live_node.misc_attrs_.reset();
+    }
+
+    if (live_node.repeat_.toString() != new_node.repeat_.toString())
+        live_node.repeat_ = new_node.repeat_;
+
+    // Keep limits of the same name, since they hold the paths of the tasks that consumed a token
+    std::vector<limit_ptr> limits;
+    for (const limit_ptr& new_limit : new_node.limits_) {
+        auto live_limit = std::find_if(live_node.limits_.begin(),
+                                       live_node.limits_.end(),
+                                       [&new_limit](const limit_ptr& l) { return l->name() == new_limit->name(); });
+        if (live_limit != live_node.limits_.end()) {
+            if ((*live_limit)->theLimit() != new_limit->theLimit())
+                (*live_limit)->setLimit(new_limit->theLimit());
+            limits.push_back(*live_limit);
+        }
+        else {
+            limit_ptr the_limit = std::make_shared<Limit>(*new_limit);
+            the_limit->set_node(&live_node);
+            limits.push_back(the_limit);
+        }
+    }
+    live_node.limits_ = limits;
+
+    std::string live_inlimits, new_inlimits;
+    for (const InLimit& inlimit : live_node.inLimitMgr_.inlimits())
+        live_inlimits += inlimit.toString();
+    for (const InLimit& inlimit : new_node.inLimitMgr_.inlimits())
+        new_inlimits += inlimit.toString();
+    if (live_inlimits != new_inlimits) {
+        live_node.inLimitMgr_ = new_node.inLimitMgr_;
+        live_node.inLimitMgr_.set_node(&live_node);
+    }
+
+    // Attributes added or deleted, clients will be sent all the attributes of this node
+    live_node.state_change_no_ = Ecf::incr_state_change_no();
+}
+
+void DefsPatcher::order_children(Node& live_node, const std::vector<std::string>& order) {
+    std::unordered_map<std::string, size_t> index;
+    index.reserve(order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        index[order[i]] = i;
+    }
+
+    NodeContainer* container     = live_node.isNodeContainer();
+    std::vector<node_ptr>& nodes = container->nodes_;
+    std::stable_sort(nodes.begin(), nodes.end(), [&index](const node_ptr& a, const node_ptr& b) {
+        return index[a->name()] < index[b->name()];
+    });
+    container->order_state_change_no_ = Ecf::incr_state_change_no();
+}
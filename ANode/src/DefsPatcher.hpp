@@ -0,0 +1,92 @@
+#ifndef DEFS_PATCHER_HPP_
+#define DEFS_PATCHER_HPP_
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+// Used by --load=<defs> patch and --replace=<path> <defs> patch
+//
+// Replacing a whole suite/node loses all its run time state, and since the suite
+// is replaced every client must do a full sync. Instead we compare the new
+// definition with the live one, and apply only the differences:
+//   - nodes only in the new definition are added, at the same position
+//   - nodes no longer in the new definition are deleted
+//   - nodes whose own attributes changed, have their attributes updated in place.
+//     Attributes whose definition did not change keep their state, i.e event values,
+//     queue positions and verify counts
+//   - nodes whose type changed (i.e. family -> task), or suites whose clock
+//     changed, are replaced
+// Everything else is left untouched. Unless a suite is replaced, clients are
+// updated with an incremental sync.
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#include <string>
+#include <vector>
+
+#include "NodeFwd.hpp"
+
+class DefsPatcher {
+public:
+    DefsPatcher(const DefsPatcher&)                  = delete;
+    const DefsPatcher& operator=(const DefsPatcher&) = delete;
+
+    /// Compare the suites in new_defs, with the suites of the same name in live_defs
+    /// Suites only in new_defs are added, suites only in live_defs are left alone.
+    DefsPatcher(Defs& live_defs, Defs& new_defs);
+
+    /// Compare the live node with new node, which must have the same path
+    DefsPatcher(const node_ptr& live_node, const node_ptr& new_node);
+
+    /// The live nodes that will be deleted or replaced
+    std::vector<node_ptr> nodes_to_remove() const;
+
+    /// Apply the changes to the live definition, the nodes are moved from the new definition.
+    /// Unless force is set, returns false if any node to remove has tasks that are active or submitted
+    bool apply(bool force, std::string& errorMsg);
+
+    size_t no_of_changes() const { return changes_.size(); }
+
+    /// i.e. "added:1 deleted:0 replaced:0 changed:3 re-ordered:0"
+    std::string summary() const;
+
+private:
+    enum Kind { ADD, DELETE, REPLACE, CHANGE, ORDER };
+    struct Change
+    {
+        Change(Kind kind, const node_ptr& live, const node_ptr& new_node = node_ptr())
+            : kind_(kind),
+              live_(live),
+              new_(new_node) {}
+
+        Kind kind_;
+        node_ptr live_;                  // NULL for ADD
+        node_ptr new_;                   // NULL for DELETE and ORDER
+        Node* live_parent_{nullptr};     // ADD only, NULL for suites
+        size_t position_{0};             // ADD only
+        std::vector<std::string> order_; // ORDER only
+    };
+
+    void diff(const node_ptr& live_node, const node_ptr& new_node);
+    void diff_children(const node_ptr& live_node, const node_ptr& new_node);
+    size_t count(Kind) const;
+
+    static bool same_clock(const Node& live_node, const Node& new_node);
+    static bool same_attributes(const Node& live_node, const Node& new_node);
+    static void patch_attributes(Node& live_node, const Node& new_node);
+    static void order_children(Node& live_node, const std::vector<std::string>& order);
+
+private:
+    Defs* live_defs_{nullptr};
+    std::vector<Change> changes_;
+};
+
+#endif
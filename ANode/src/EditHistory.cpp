@@ -0,0 +1,307 @@
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#include "EditHistory.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+#include <boost/lexical_cast.hpp>
+
+#include "Indentor.hpp"
+#include "Serialization.hpp"
+#include "Str.hpp"
+
+using namespace ecf;
+
+void EditHistory::add(const std::string& path, const std::string& request) {
+    auto i = entries_.find(path);
+    if (i == entries_.end()) {
+        i = entries_.emplace(path, Entry()).first;
+        bytes_ += entry_size(path);
+    }
+    Entry& entry = i->second;
+
+    // Use the same form as the check point file, each request must be on a single line
+    size_t old_size = entry.requests_.size();
+    entry.requests_ += "\b";
+    if (request.find_first_of("\n\b") == std::string::npos) {
+        entry.requests_ += request;
+    }
+    else {
+        std::string h = request;
+        Str::replaceall(h, "\n", "\\n");
+        std::replace(h.begin(), h.end(), '\b', ' ');
+        entry.requests_ += h;
+    }
+    entry.numbers_.push_back(next_number_++);
+    bytes_ += entry.requests_.size() - old_size + sizeof(std::uint64_t);
+
+    if (entry.numbers_.size() > max_requests_per_node()) {
+        remove_requests(entry, entry.numbers_.size() - max_requests_per_node());
+    }
+    if (max_size_ != 0 && bytes_ > max_size_) {
+        trim();
+    }
+}
+
+void EditHistory::remove(const std::string& path) {
+    auto i = entries_.find(path);
+    if (i != entries_.end()) {
+        remove_requests(i->second, i->second.numbers_.size());
+        bytes_ -= entry_size(path);
+        entries_.erase(i);
+    }
+}
+
+void EditHistory::clear() {
+    entries_.clear();
+    bytes_       = 0;
+    last_pruned_ = boost::gregorian::date();
+}
+
+std::vector<std::string> EditHistory::get(const std::string& path) const {
+    auto i = entries_.find(path);
+    if (i != entries_.end()) {
+        return split(i->second);
+    }
+    return std::vector<std::string>();
+}
+
+std::vector<std::string> EditHistory::paths() const {
+    std::vector<std::string> paths;
+    paths.reserve(entries_.size());
+    for (const auto& e : entries_) {
+        paths.push_back(e.first);
+    }
+    return paths;
+}
+
+void EditHistory::set_max_size(size_t bytes) {
+    max_size_ = bytes;
+    if (max_size_ != 0 && bytes_ > max_size_) {
+        trim();
+    }
+}
+
+size_t EditHistory::no_of_requests() const {
+    size_t count = 0;
+    for (const auto& e : entries_) {
+        count += e.second.numbers_.size();
+    }
+    return count;
+}
+
+void EditHistory::trim() {
+    // Remove the oldest requests, until 10% below the maximum, so that trimming is infrequent
+    size_t target = max_size_ - max_size_ / 10;
+
+    std::vector<std::pair<std::uint64_t, size_t>> requests; // number, size
+    requests.reserve(no_of_requests());
+    for (const auto& e : entries_) {
+        const Entry& entry = e.second;
+        size_t start       = 0;
+        for (auto number : entry.numbers_) {
+            size_t end = entry.requests_.find('\b', start + 1);
+            if (end == std::string::npos)
+                end = entry.requests_.size();
+            requests.emplace_back(number, end - start + sizeof(std::uint64_t));
+            start = end;
+        }
+        // Removing the newest request of a node, also removes the node
+        requests.back().second += entry_size(e.first);
+    }
+    std::sort(requests.begin(), requests.end());
+
+    size_t bytes   = bytes_;
+    size_t removed = 0;
+    while (removed < requests.size() && bytes > target) {
+        bytes -= requests[removed].second;
+        removed++;
+    }
+    if (removed == 0)
+        return;
+    std::uint64_t last_removed = requests[removed - 1].first;
+
+    for (auto i = entries_.begin(); i != entries_.end();) {
+        Entry& entry = i->second;
+        auto last    = std::upper_bound(entry.numbers_.begin(), entry.numbers_.end(), last_removed);
+        remove_requests(entry, last - entry.numbers_.begin());
+        if (entry.numbers_.empty()) {
+            bytes_ -= entry_size(i->first);
+            i = entries_.erase(i);
+        }
+        else
+            ++i;
+    }
+}
+
+void EditHistory::prune(int days, const boost::gregorian::date& today) {
+    if (days <= 0 || last_pruned_ == today)
+        return;
+    last_pruned_ = today;
+
+    for (auto i = entries_.begin(); i != entries_.end();) {
+        Entry& entry = i->second;
+        Entry kept;
+        bool pruned                       = false;
+        std::vector<std::string> requests = split(entry);
+        for (size_t r = 0; r < requests.size(); r++) {
+            boost::gregorian::date request_day;
+            if (request_date(requests[r], request_day) && (today - request_day).days() > days) {
+                pruned = true;
+                continue;
+            }
+            kept.requests_ += "\b";
+            kept.requests_ += requests[r];
+            kept.numbers_.push_back(entry.numbers_[r]);
+        }
+        if (!pruned) {
+            ++i;
+            continue;
+        }
+
+        bytes_ -= entry.requests_.size() + entry.numbers_.size() * sizeof(std::uint64_t);
+        if (kept.numbers_.empty()) {
+            bytes_ -= entry_size(i->first);
+            i = entries_.erase(i);
+            continue;
+        }
+        bytes_ += kept.requests_.size() + kept.numbers_.size() * sizeof(std::uint64_t);
+        entry = std::move(kept);
+        ++i;
+    }
+}
+
+bool EditHistory::request_date(const std::string& request, boost::gregorian::date& the_date) {
+    // extract the date, expecting MSG:[HH:MM:SS D.M.YYYY]
+    if (request.find("MSG:[") != 0)
+        return false;
+
+    size_t space_pos = request.find(" ");
+    size_t close_p   = request.find("]");
+    if (space_pos == std::string::npos || close_p == std::string::npos || close_p < space_pos)
+        return false;
+
+    std::vector<std::string> vec;
+    Str::split(request.substr(space_pos + 1, close_p - space_pos - 1), vec, ".");
+    if (vec.size() != 3)
+        return false;
+    try {
+        int day   = boost::lexical_cast<int>(vec[0]);
+        int month = boost::lexical_cast<int>(vec[1]);
+        int year  = boost::lexical_cast<int>(vec[2]);
+        the_date  = boost::gregorian::date(year, month, day);
+        return true;
+    }
+    catch (...) {
+    }
+    return false;
+}
+
+void EditHistory::write(std::string& os) const {
+    for (const auto& e : entries_) {
+        Indentor::indent(os);
+        os += "history ";
+        os += e.first;
+        os += " "; // node path
+        os += e.second.requests_;
+        os += "\n";
+    }
+}
+
+std::string EditHistory::dump() const {
+    std::stringstream os;
+    for (const auto& e : entries_) {
+        os << "history " << e.first << " "; // node path
+        for (const auto& request : split(e.second)) {
+            os << " " << request;
+        }
+        os << "\n";
+    }
+    return os.str();
+}
+
+bool EditHistory::operator==(const EditHistory& rhs) const {
+    if (entries_.size() != rhs.entries_.size())
+        return false;
+    for (const auto& e : entries_) {
+        auto i = rhs.entries_.find(e.first);
+        if (i == rhs.entries_.end() || i->second.requests_ != e.second.requests_)
+            return false;
+    }
+    return true;
+}
+
+void EditHistory::remove_requests(Entry& entry, size_t count) {
+    if (count == 0)
+        return;
+    size_t pos = 0;
+    for (size_t r = 0; r < count && pos != std::string::npos; r++) {
+        pos = entry.requests_.find('\b', pos + 1);
+    }
+    if (pos == std::string::npos)
+        pos = entry.requests_.size();
+
+    bytes_ -= pos + count * sizeof(std::uint64_t);
+    entry.requests_.erase(0, pos);
+    entry.numbers_.erase(entry.numbers_.begin(), entry.numbers_.begin() + count);
+}
+
+std::vector<std::string> EditHistory::split(const Entry& entry) {
+    std::vector<std::string> requests;
+    requests.reserve(entry.numbers_.size());
+    size_t start = 0;
+    while (start < entry.requests_.size()) {
+        size_t end = entry.requests_.find('\b', start + 1);
+        if (end == std::string::npos)
+            end = entry.requests_.size();
+        requests.emplace_back(entry.requests_, start + 1, end - start - 1);
+        start = end;
+    }
+    return requests;
+}
+
+size_t EditHistory::entry_size(const std::string& path) {
+    // Approximate overhead of the hash node, holding the path and entry
+    return path.size() + sizeof(std::string) + sizeof(Entry) + 2 * sizeof(void*);
+}
+
+template <class Archive>
+void EditHistory::save(Archive& ar) const {
+    // Same form as std::unordered_map<std::string, std::vector<std::string>>, used by older releases
+    ar(cereal::make_size_tag(static_cast<cereal::size_type>(entries_.size())));
+    for (const auto& e : entries_) {
+        ar(cereal::make_map_item(e.first, split(e.second)));
+    }
+}
+
+template <class Archive>
+void EditHistory::load(Archive& ar) {
+    clear();
+    cereal::size_type size;
+    ar(cereal::make_size_tag(size));
+    for (cereal::size_type i = 0; i < size; i++) {
+        std::string path;
+        std::vector<std::string> requests;
+        ar(cereal::make_map_item(path, requests));
+        for (const auto& request : requests) {
+            add(path, request);
+        }
+    }
+}
+
+template void EditHistory::save<cereal::JSONOutputArchive>(cereal::JSONOutputArchive&) const;
+template void EditHistory::load<cereal::JSONInputArchive>(cereal::JSONInputArchive&);
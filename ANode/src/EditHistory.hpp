@@ -0,0 +1,110 @@
+#ifndef EDIT_HISTORY_HPP_
+#define EDIT_HISTORY_HPP_
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+// The user requests applied to each node, i.e. alter,force,requeue etc.
+//
+// The number of requests per node is limited, but so is the total memory:
+// Each request is numbered, in the order it was added. When the memory exceeds
+// max_size(), the oldest requests, across *all* nodes, are removed.
+//
+// The requests of a node are held in a single string, in the same form as they
+// are written to the check point file. i.e \brequest1\brequest2
+// This avoids an allocation per request, and check pointing only appends the string.
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/date_time/gregorian/gregorian_types.hpp>
+
+namespace cereal {
+class access;
+}
+
+class EditHistory {
+public:
+    EditHistory() = default;
+
+    static constexpr size_t max_requests_per_node() { return 10; }
+    static constexpr size_t default_max_size() { return 64 * 1024 * 1024; }
+
+    void add(const std::string& path, const std::string& request);
+    void remove(const std::string& path);
+    void clear();
+
+    /// Returns an empty vector, if there is no history for the path
+    std::vector<std::string> get(const std::string& path) const;
+
+    /// The approximate memory used. When exceeded, the oldest requests are removed. 0 means no limit
+    void set_max_size(size_t bytes);
+    size_t max_size() const { return max_size_; }
+    size_t memory_size() const { return bytes_; }
+
+    /// Remove requests older than the given days. Uses time stamp MSG:[HH:MM:SS D.M.YYYY] at the start of request.
+    /// Requests without a time stamp are kept. Does nothing if already pruned today.
+    void prune(int days, const boost::gregorian::date& today);
+
+    /// Extract the date from the MSG:[HH:MM:SS D.M.YYYY] time stamp. Returns false if not found.
+    static bool request_date(const std::string& request, boost::gregorian::date&);
+
+    std::vector<std::string> paths() const;
+    size_t size() const { return entries_.size(); } // number of nodes with history
+    bool empty() const { return entries_.empty(); }
+    size_t no_of_requests() const;
+
+    /// For each node: history <path> \brequest1\brequest2, read by Defs::read_history
+    void write(std::string& os) const;
+    std::string dump() const;
+
+    /// f(path, requests)
+    template <typename F>
+    void for_each(F f) const {
+        for (const auto& e : entries_)
+            f(e.first, split(e.second));
+    }
+
+    bool operator==(const EditHistory& rhs) const;
+    bool operator!=(const EditHistory& rhs) const { return !operator==(rhs); }
+
+private:
+    struct Entry
+    {
+        std::string requests_;               // \brequest1\brequest2, oldest first
+        std::vector<std::uint64_t> numbers_; // order in which each request was added, across all nodes
+    };
+
+    void trim();
+    void remove_requests(Entry& entry, size_t count);
+    static std::vector<std::string> split(const Entry& entry);
+    static size_t entry_size(const std::string& path);
+
+private:
+    std::unordered_map<std::string, Entry> entries_;
+    std::uint64_t next_number_{0};
+    size_t bytes_{0};
+    size_t max_size_{default_max_size()};
+    boost::gregorian::date last_pruned_;
+
+    // Persisted as a map of path to requests
+    friend class cereal::access;
+    template <class Archive>
+    void save(Archive& ar) const;
+    template <class Archive>
+    void load(Archive& ar);
+};
+
+#endif
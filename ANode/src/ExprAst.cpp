@@ -28,6 +28,11 @@
 using namespace ecf;
 using namespace std;
 
+// Cache the referenced node as a handle, avoids weak_ptr locking on every evaluation
+static NodeHandle handle_of(const node_ptr& node) {
+    return (node) ? node->handle() : NodeHandle();
+}
+
 ////////////////////////////////////////////////////////////////////////////////////
 
 Ast::~Ast() = default;
@@ -1395,7 +1400,7 @@ Node* AstNode::referencedNode() const {
     }
     if (parentNode_) {
         std::string errorMsg;
-        ref_node_ = parentNode_->findReferencedNode(nodePath_, errorMsg);
+        ref_node_ = handle_of(parentNode_->findReferencedNode(nodePath_, errorMsg));
         return get_ref_node(); // can be NULL
     }
     return nullptr;
@@ -1407,7 +1412,7 @@ Node* AstNode::referencedNode(std::string& errorMsg) const {
         return ref;
     }
     if (parentNode_) {
-        ref_node_ = parentNode_->findReferencedNode(nodePath_, errorMsg);
+        ref_node_ = handle_of(parentNode_->findReferencedNode(nodePath_, errorMsg));
         return get_ref_node(); // can be NULL
     }
     return nullptr;
@@ -1505,7 +1510,7 @@ Node* AstFlag::referencedNode() const {
         if (nodePath_ == "/")
             return nullptr; // reference to defs
         std::string errorMsg;
-        ref_node_ = parentNode_->findReferencedNode(nodePath_, errorMsg);
+        ref_node_ = handle_of(parentNode_->findReferencedNode(nodePath_, errorMsg));
         return get_ref_node(); // can be NULL
     }
     return nullptr;
@@ -1519,7 +1524,7 @@ Node* AstFlag::referencedNode(std::string& errorMsg) const {
     if (parentNode_) {
         if (nodePath_ == "/")
             return nullptr; // reference to defs
-        ref_node_ = parentNode_->findReferencedNode(nodePath_, ecf::Flag::enum_to_string(flag_), errorMsg);
+        ref_node_ = handle_of(parentNode_->findReferencedNode(nodePath_, ecf::Flag::enum_to_string(flag_), errorMsg));
         return get_ref_node(); // can be NULL
     }
     return nullptr;
@@ -1701,7 +1706,7 @@ Node* AstVariable::referencedNode() const {
     }
     if (parentNode_) {
         std::string ignoredErrorMsg;
-        ref_node_ = parentNode_->findReferencedNode(nodePath_, name_, ignoredErrorMsg);
+        ref_node_ = handle_of(parentNode_->findReferencedNode(nodePath_, name_, ignoredErrorMsg));
         return get_ref_node(); // can be NULL
     }
     return nullptr;
@@ -1713,7 +1718,7 @@ Node* AstVariable::referencedNode(std::string& errorMsg) const {
         return ref;
     }
     if (parentNode_) {
-        ref_node_ = parentNode_->findReferencedNode(nodePath_, name_, errorMsg);
+        ref_node_ = handle_of(parentNode_->findReferencedNode(nodePath_, name_, errorMsg));
         return get_ref_node(); // can be NULL
     }
     return nullptr;
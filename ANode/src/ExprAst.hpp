@@ -23,6 +23,8 @@
 #include "DState.hpp"
 #include "Flag.hpp"
 #include "NodeFwd.hpp"
+#include "NodeTable.hpp"
+#include "SmallObjectPool.hpp"
 namespace ecf {
 class ExprAstVisitor;
 } // namespace ecf
@@ -33,6 +35,9 @@ public:
     Ast() = default;
     virtual ~Ast();
 
+    // A large defs has many expression nodes, allocate them from a pool
+    ECF_SMALL_OBJECT_POOL
+
     std::string evaluate_str() const { return evaluate() ? "true" : "false"; }
 
     virtual void accept(ecf::ExprAstVisitor&) = 0;
@@ -497,7 +502,7 @@ public:
     std::string expression() const override;
     std::string why_expression(bool html = false) const override;
     void setParentNode(Node* n) override { parentNode_ = n; }
-    void invalidate_trigger_references() const override { ref_node_.reset(); }
+    void invalidate_trigger_references() const override { ref_node_ = ecf::NodeHandle(); }
     static std::string stype() { return "node"; }
 
     const std::string& nodePath() const { return nodePath_; }
@@ -507,10 +512,10 @@ public:
     DState::State state() const;
 
 private:
-    Node* get_ref_node() const { return ref_node_.lock().get(); }
+    Node* get_ref_node() const { return ecf::NodeTable::find(ref_node_); }
     Node* parentNode_; // should always be non null, before evaluate.
     std::string nodePath_;
-    mutable weak_node_ptr ref_node_;
+    mutable ecf::NodeHandle ref_node_;
 };
 
 class AstFlag : public AstLeaf {
@@ -535,7 +540,7 @@ public:
     std::string expression() const override;
     std::string why_expression(bool html = false) const override;
     void setParentNode(Node* n) override { parentNode_ = n; }
-    void invalidate_trigger_references() const override { ref_node_.reset(); }
+    void invalidate_trigger_references() const override { ref_node_ = ecf::NodeHandle(); }
     static std::string stype() { return "flag"; }
 
     const std::string& nodePath() const { return nodePath_; }
@@ -544,11 +549,11 @@ public:
     Node* parentNode() const { return parentNode_; }
 
 private:
-    Node* get_ref_node() const { return ref_node_.lock().get(); }
+    Node* get_ref_node() const { return ecf::NodeTable::find(ref_node_); }
 
     std::string nodePath_;
     Node* parentNode_{nullptr}; // should always be non null, before evaluate.
-    mutable weak_node_ptr ref_node_;
+    mutable ecf::NodeHandle ref_node_;
     ecf::Flag::Type flag_;
 };
 
@@ -585,7 +590,7 @@ public:
     std::string expression() const override;
     std::string why_expression(bool html = false) const override;
     void setParentNode(Node* n) override { parentNode_ = n; }
-    void invalidate_trigger_references() const override { ref_node_.reset(); }
+    void invalidate_trigger_references() const override { ref_node_ = ecf::NodeHandle(); }
 
     int minus(Ast* right) const override;
     int plus(Ast* right) const override;
@@ -598,12 +603,12 @@ public:
     const std::string& nodePath() const { return nodePath_; }
 
 private:
-    Node* get_ref_node() const { return ref_node_.lock().get(); }
+    Node* get_ref_node() const { return ecf::NodeTable::find(ref_node_); }
 
     Node* parentNode_;
     std::string nodePath_;
     std::string name_;
-    mutable weak_node_ptr ref_node_;
+    mutable ecf::NodeHandle ref_node_;
 };
 
 /// A variable: This can reference in the CURRENT order:
@@ -636,7 +641,7 @@ public:
     std::string expression() const override;
     std::string why_expression(bool html = false) const override;
     void setParentNode(Node* n) override { parentNode_ = n; }
-    void invalidate_trigger_references() const override { ref_node_.reset(); }
+    void invalidate_trigger_references() const override { ref_node_ = ecf::NodeHandle(); }
 
     int minus(Ast* right) const override;
     int plus(Ast* right) const override;
@@ -650,7 +655,7 @@ public:
 private:
     Node* parentNode_;
     std::string name_;
-    mutable weak_node_ptr ref_node_;
+    mutable ecf::NodeHandle ref_node_;
 };
 
 // Helper class
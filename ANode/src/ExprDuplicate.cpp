@@ -16,7 +16,7 @@
 #include "ExprDuplicate.hpp"
 
 #include <iostream>
-
+#include <mutex>
 #include <unordered_map>
 
 #include "Ecf.hpp"
@@ -25,12 +25,16 @@
 ////////////////////////////////////////////////////////////////////////////
 using namespace std;
 
+// The map is shared by all Defs. The python api and the client can create, and destroy,
+// Defs on several threads, hence access is serialised
 static std::unordered_map<std::string, AstTop*> duplicate_expr;
+static std::mutex duplicate_expr_mutex;
 typedef std::unordered_map<std::string, AstTop*> my_map;
 
 ExprDuplicate::~ExprDuplicate() {
     // cout << "ExprDuplicate::~ExprDuplicate: server(" << Ecf::server() << ") " << duplicate_expr.size() << "
     // *****************************************************************\n";
+    std::lock_guard<std::mutex> lock(duplicate_expr_mutex);
     for (my_map::value_type i : duplicate_expr) {
         // cout << " deleting: " << i.first << " :" << i.second << "\n";
         delete i.second;
@@ -40,6 +44,7 @@ ExprDuplicate::~ExprDuplicate() {
 }
 
 void ExprDuplicate::dump(const std::string& msg) {
+    std::lock_guard<std::mutex> lock(duplicate_expr_mutex);
     cout << "ExprDuplicate::dump server(" << Ecf::server() << ") " << msg << "\n";
     for (const my_map::value_type& i : duplicate_expr) {
         cout << "   " << i.first << " :" << i.second << "\n";
@@ -47,6 +52,7 @@ void ExprDuplicate::dump(const std::string& msg) {
 }
 
 std::unique_ptr<AstTop> ExprDuplicate::find(const std::string& expr) {
+    std::lock_guard<std::mutex> lock(duplicate_expr_mutex);
     my_map::const_iterator it = duplicate_expr.find(expr);
     if (it != duplicate_expr.end()) {
         return std::unique_ptr<AstTop>((*it).second->clone());
@@ -57,7 +63,10 @@ std::unique_ptr<AstTop> ExprDuplicate::find(const std::string& expr) {
 void ExprDuplicate::add(const std::string& expr, AstTop* ast) {
     assert(!expr.empty() && ast);
     AstTop* clone = ast->clone();
-    duplicate_expr.insert(std::make_pair(expr, clone));
+    std::lock_guard<std::mutex> lock(duplicate_expr_mutex);
+    if (!duplicate_expr.insert(std::make_pair(expr, clone)).second) {
+        delete clone; // added by another thread
+    }
 
     // cout << "ExprDuplicate::add: server(" << Ecf::server() << ") " << expr << " :" << clone << "   " <<
     // duplicate_expr.size() << "\n";
@@ -27,6 +27,7 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <stack>
 #include <string>
@@ -453,6 +454,10 @@ bool ExprParser::doParse(std::string& errorMsg) {
     }
 
     // SPIRIT CLASSIC parsing: very slooooow....
+    // The grammar definitions and rule names are static, and not thread safe. Expressions can be
+    // parsed on several threads by the client and the python api, hence serialise
+    static std::mutex spirit_mutex;
+    std::lock_guard<std::mutex> lock(spirit_mutex);
     ExpressionGrammer grammer;
     BOOST_SPIRIT_DEBUG_NODE(grammer);
 
@@ -19,6 +19,7 @@
 #include <memory> // for unique_ptr
 
 #include "ExprAst.hpp"
+#include "SmallObjectPool.hpp"
 class Node;
 namespace cereal {
 class access;
@@ -84,6 +85,9 @@ public:
     Expression();
     Expression(const Expression& rhs);
 
+    // Created for every trigger and complete, when loading or copying a defs
+    ECF_SMALL_OBJECT_POOL
+
     bool operator==(const Expression& rhs) const {
         if (free_ != rhs.free_)
             return false;
@@ -0,0 +1,62 @@
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#include "FindNodeCache.hpp"
+
+#include "Defs.hpp"
+#include "NodeContainer.hpp"
+
+FindNodeCache::FindNodeCache(Defs* defs) : defs_(defs), previous_(defs->find_cache_) {
+    defs_->find_cache_ = this;
+}
+
+FindNodeCache::~FindNodeCache() {
+    defs_->find_cache_ = previous_;
+}
+
+node_ptr FindNodeCache::find_immediate_child(const node_ptr& parent, const boost::string_view& name) {
+    // Not worth indexing small families, or the aliases of a task
+    NodeContainer* container = parent->isNodeContainer();
+    if (!container || container->nodeVec().size() < 16) {
+        return parent->find_immediate_child(name);
+    }
+
+    // Only index on the second search, so that requests with a single path pay nothing extra
+    Index& index = index_[parent.get()];
+    if (++index.no_of_searches_ < 2) {
+        return parent->find_immediate_child(name);
+    }
+    if (!index.container_) {
+        index.container_ = parent;
+        const std::vector<node_ptr>& children = container->nodeVec();
+        index.children_.reserve(children.size());
+        for (const auto& child : children) {
+            index.children_.emplace(child->name(), child);
+        }
+    }
+
+    std::string the_name(name.data(), name.size());
+    auto i = index.children_.find(the_name);
+    if (i != index.children_.end() && i->second->parent() == container) {
+        return i->second;
+    }
+
+    // Not indexed or deleted, the child may have been added/replaced since the index was created
+    node_ptr child = parent->find_immediate_child(name);
+    if (child) {
+        index.children_[the_name] = child;
+    }
+    return child;
+}
@@ -0,0 +1,57 @@
+#ifndef FIND_NODE_CACHE_HPP_
+#define FIND_NODE_CACHE_HPP_
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+// Speeds up Defs::findAbsNode() for requests that look up many paths,
+// i.e. group commands, or commands with thousands of paths.
+//
+// Without this, each look up is a linear search of the children at each level,
+// hence finding every task in a family with N tasks is O(N^2).
+// While in scope, a container that is searched more than once, has its children
+// indexed by name. The index is only a hint, a node that has since been deleted
+// or replaced is ignored, and we fall back to the linear search.
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#include <string>
+#include <unordered_map>
+
+#include <boost/utility/string_view.hpp>
+
+#include "NodeFwd.hpp"
+
+class FindNodeCache {
+public:
+    FindNodeCache(const FindNodeCache&)                  = delete;
+    const FindNodeCache& operator=(const FindNodeCache&) = delete;
+
+    explicit FindNodeCache(Defs*);
+    ~FindNodeCache();
+
+    /// Same as parent->find_immediate_child(name)
+    node_ptr find_immediate_child(const node_ptr& parent, const boost::string_view& name);
+
+private:
+    struct Index
+    {
+        node_ptr container_; // keeps container alive, so that the address used as key is not reused
+        size_t no_of_searches_{0};
+        std::unordered_map<std::string, node_ptr> children_;
+    };
+
+    Defs* defs_;
+    FindNodeCache* previous_;
+    std::unordered_map<const Node*, Index> index_;
+};
+
+#endif
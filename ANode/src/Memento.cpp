@@ -31,12 +31,15 @@ Memento::~Memento() = default;
 
 // ===============================================================
 void CompoundMemento::incremental_sync(defs_ptr client_def) const {
+    incremental_sync(client_def, client_def->findAbsNode(absNodePath_));
+}
+
+void CompoundMemento::incremental_sync(defs_ptr client_def, node_ptr node) const {
     /// Clear out aspects, for this Memento.
     ///   Aspects are added via do_incremental_* / set_mememto functions
     ///   AND in *this* function when node attributes have been added or deleted.
     aspects_.clear();
 
-    node_ptr node = client_def->findAbsNode(absNodePath_);
     if (!node.get()) {
         if (absNodePath_ != Str::ROOT_PATH()) {
 
@@ -145,7 +148,14 @@ void Memento::serialize(Archive& ar, std::uint32_t const version) {
 template <class Archive>
 void CompoundMemento::serialize(Archive& ar, std::uint32_t const version) {
     CEREAL_OPTIONAL_NVP(ar, clear_attributes_, [this]() { return clear_attributes_; }); // conditionally save
-    ar(CEREAL_NVP(absNodePath_), CEREAL_NVP(vec_));
+    CEREAL_OPTIONAL_NVP(ar, path_prefix_, [this]() { return path_prefix_ != 0; });     // conditionally save
+    if (Archive::is_saving::value && path_prefix_ != 0) {
+        std::string path_suffix = absNodePath_.substr(path_prefix_);
+        ar(cereal::make_nvp("absNodePath_", path_suffix), CEREAL_NVP(vec_));
+    }
+    else {
+        ar(CEREAL_NVP(absNodePath_), CEREAL_NVP(vec_));
+    }
 }
 
 template <class Archive>
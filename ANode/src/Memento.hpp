@@ -86,6 +86,7 @@ public:
     CompoundMemento() = default; // for serialization
 
     void incremental_sync(defs_ptr client_def) const;
+    void incremental_sync(defs_ptr client_def, node_ptr node) const; // node found by caller, can be NULL
     void add(memento_ptr m) { vec_.push_back(m); }
     void clear_attributes() { clear_attributes_ = true; }
 
@@ -97,6 +98,11 @@ private:
     mutable std::vector<ecf::Aspect::Type> aspects_; // not persisted only used on client side
     bool clear_attributes_{false};
 
+    // When non zero, only the characters of absNodePath_ after path_prefix_ are persisted, the rest is
+    // shared with the previous compound memento. Set and expanded by DefsDelta. See DefsDelta::compact_paths()
+    unsigned int path_prefix_{0};
+    friend class DefsDelta;
+
     friend class cereal::access;
     template <class Archive>
     void serialize(Archive& ar, std::uint32_t const version);
@@ -19,6 +19,7 @@
 #include "GenericAttr.hpp"
 #include "Node.hpp"
 #include "QueueAttr.hpp"
+#include "SmallObjectPool.hpp"
 #include "VerifyAttr.hpp"
 #include "ZombieAttr.hpp"
 
@@ -29,6 +30,8 @@ public:
     MiscAttrs() = default;
     ~MiscAttrs();
 
+    ECF_SMALL_OBJECT_POOL
+
     // needed by node serialisation
     void set_node(Node* n);
     bool checkInvariants(std::string& errorMsg) const;
@@ -94,6 +97,7 @@ private:
 private:
     Node* node_{nullptr}; // *NOT* persisted must be set by the parent class
     friend class Node;
+    friend class DefsPatcher;
 
 private:
     std::vector<ZombieAttr> zombies_;   // can be added/removed via AlterCmd
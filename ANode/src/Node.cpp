@@ -95,6 +95,7 @@ Node::Node(const Node& rhs)
     if (auto_restore_)
         auto_restore_->set_node(this);
 
+    limits_.reserve(rhs.limits_.size());
     for (const auto& limit : rhs.limits_) {
         limit_ptr the_limit = std::make_shared<Limit>(*limit);
         the_limit->set_node(this);
@@ -207,7 +208,26 @@ Node& Node::operator=(const Node& rhs) {
     return *this;
 }
 
-Node::~Node() = default;
+Node::~Node() {
+    ecf::NodeTable::remove(ecf::NodeHandle::unpack(handle_.load(std::memory_order_relaxed)));
+}
+
+ecf::NodeHandle Node::handle() const {
+    std::uint64_t packed = handle_.load(std::memory_order_acquire);
+    if (packed != 0)
+        return ecf::NodeHandle::unpack(packed);
+
+    ecf::NodeHandle h = ecf::NodeTable::add(const_cast<Node*>(this));
+    if (h.empty())
+        return h; // table full
+
+    // Another thread may have allocated a handle for this node meanwhile, keep theirs
+    if (!handle_.compare_exchange_strong(packed, h.pack(), std::memory_order_acq_rel, std::memory_order_acquire)) {
+        ecf::NodeTable::remove(h);
+        return ecf::NodeHandle::unpack(packed);
+    }
+    return h;
+}
 
 bool Node::isParentSuspended() const {
     Node* theParent = parent();
@@ -27,6 +27,8 @@
 //          2/ Cut down on IPC load between client/server
 //
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+#include <atomic>
+#include <cstdint>
 #include <iosfwd>
 #include <limits>
 
@@ -45,6 +47,7 @@
 #include "NOrder.hpp"
 #include "NodeAttr.hpp"
 #include "NodeFwd.hpp"
+#include "NodeTable.hpp"
 #include "PrintStyle.hpp"
 #include "RepeatAttr.hpp"
 #include "TimeAttr.hpp"
@@ -380,6 +383,10 @@ public:
     virtual bool hasAutoCancel() const { return (auto_cancel_) ? true : false; }
     virtual void invalidate_trigger_references() const;
 
+    /// Returns a stable handle for this node, allocated on first use. see NodeTable.hpp
+    /// Used by the trigger/complete AST, to cache references to other nodes.
+    ecf::NodeHandle handle() const;
+
     // Access functions: ======================================================
     const std::string& name() const { return n_; }
     const Repeat& repeat() const { return repeat_; } // can be empty()
@@ -828,6 +835,7 @@ private:
 
 private: // All mementos access
     friend class CompoundMemento;
+    friend class DefsPatcher; // update attributes in place
     void clear(); /// Clear *ALL* internal attributes
     void delete_attributes();
 
@@ -904,6 +912,7 @@ private:
     std::unique_ptr<ecf::AutoArchiveAttr> auto_archive_; // Can only have 1 auto archive per node
     std::unique_ptr<ecf::AutoRestoreAttr> auto_restore_; // Can only have 1 autorestore per node
     void* graphic_ptr_{nullptr};                         // for use with the gui only
+    mutable std::atomic<std::uint64_t> handle_{0};       // *not* persisted or copied, allocated on demand
 
     unsigned int state_change_no_{
         0}; // *not* persisted, only used on server side,Used to indicate addition or deletion of attribute
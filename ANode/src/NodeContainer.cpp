@@ -54,6 +54,7 @@ NodeContainer::NodeContainer(const std::string& name, bool check) : Node(name, c
 NodeContainer::NodeContainer() = default;
 
 void NodeContainer::copy(const NodeContainer& rhs) {
+    nodes_.reserve(rhs.nodes_.size());
     for (const auto& r_n : rhs.nodes_) {
         Task* task = r_n->isTask();
         if (task) {
@@ -146,6 +146,7 @@ private:
 
     friend class Defs;
     friend class Family;
+    friend class DefsPatcher; // re-order children
     bool doDeleteChild(Node* child) override;
 
     /// For use by python interface,
@@ -28,7 +28,8 @@ std::string NodeStats::print() const {
         ss << "suites_ + family_ +  task_ + alias_ != nodes_ ?\n";
 
     ss << "Edit history nodes  " << edit_history_nodes_ << "\n";
-    ss << "Edit history paths  " << edit_history_paths_ << "\n\n";
+    ss << "Edit history paths  " << edit_history_paths_ << "\n";
+    ss << "Edit history bytes  " << edit_history_size_ << "\n\n";
 
     ss << "vars                " << vars_ << "\n";
     ss << "triggers            " << trigger_ << "\n";
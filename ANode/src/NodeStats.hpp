@@ -28,6 +28,7 @@ struct NodeStats
 
     size_t edit_history_nodes_{0};
     size_t edit_history_paths_{0};
+    size_t edit_history_size_{0}; // approximate memory in bytes
 
     size_t vars_{0};
     size_t c_trigger_{0};
@@ -0,0 +1,81 @@
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+#include "NodeTable.hpp"
+
+#include <mutex>
+#include <vector>
+
+namespace ecf {
+
+std::atomic<NodeTable::Slot*> NodeTable::blocks_[NodeTable::max_blocks];
+
+namespace {
+// Nodes can be created/destroyed on different threads(i.e. ecflow_http/ecflowUI), hence
+// allocation and release of slots are serialised. find() only reads the slots.
+std::mutex table_mutex;
+std::vector<std::uint32_t> free_slots;
+std::uint32_t next_slot = 0;
+std::size_t used_slots  = 0;
+} // namespace
+
+NodeHandle NodeTable::add(Node* node) {
+    std::lock_guard<std::mutex> lock(table_mutex);
+
+    std::uint32_t index = 0;
+    if (!free_slots.empty()) {
+        index = free_slots.back();
+        free_slots.pop_back();
+    }
+    else {
+        if ((next_slot >> block_bits) >= max_blocks)
+            return NodeHandle(); // table full
+
+        index = next_slot++;
+        if ((index & block_mask) == 0)
+            blocks_[index >> block_bits].store(new Slot[block_size], std::memory_order_release);
+    }
+
+    Slot& slot = blocks_[index >> block_bits].load(std::memory_order_relaxed)[index & block_mask];
+    slot.node_.store(node, std::memory_order_relaxed);
+    used_slots++;
+    return NodeHandle(index, slot.generation_.load(std::memory_order_relaxed));
+}
+
+void NodeTable::remove(const NodeHandle& h) {
+    if (h.empty())
+        return;
+
+    std::lock_guard<std::mutex> lock(table_mutex);
+    Slot& slot = blocks_[h.index_ >> block_bits].load(std::memory_order_relaxed)[h.index_ & block_mask];
+    if (slot.generation_.load(std::memory_order_relaxed) != h.generation_)
+        return; // already released
+
+    // Bump the generation first, so that outstanding handles no longer resolve. Skip 0, i.e. the empty handle
+    std::uint32_t generation = h.generation_ + 1;
+    if (generation == 0)
+        generation = 1;
+    slot.generation_.store(generation, std::memory_order_release);
+    slot.node_.store(nullptr, std::memory_order_relaxed);
+
+    free_slots.push_back(h.index_);
+    used_slots--;
+}
+
+std::size_t NodeTable::size() {
+    std::lock_guard<std::mutex> lock(table_mutex);
+    return used_slots;
+}
+
+} // namespace ecf
@@ -0,0 +1,104 @@
+#ifndef NODE_TABLE_HPP_
+#define NODE_TABLE_HPP_
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+//  Table of nodes, indexed by a stable integer handle.
+//
+//  The trigger/complete AST used to cache the referenced node as a weak_ptr.
+//  Locking a weak_ptr is an atomic increment/decrement of the reference count,
+//  and since trigger evaluation is performed hundreds of millions of times,
+//  this was one of the server CPU bottlenecks.
+//
+//  Instead a node is given a handle(index + generation) on demand, see Node::handle().
+//  The handle is set with a compare-exchange, since the nodes of a shared defs may be
+//  evaluated by several threads at once, i.e. the snapshots of ecflow_http.
+//  The slot is released when the Node is destroyed, which bumps the generation,
+//  hence any handle still held for the deleted/replaced node no longer resolves.
+//  Resolving a handle is two plain loads, with no reference count traffic.
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+#include <atomic>
+#include <cstdint>
+
+class Node;
+
+namespace ecf {
+
+class NodeHandle {
+public:
+    NodeHandle() = default;
+
+    bool empty() const { return generation_ == 0; }
+    bool operator==(const NodeHandle& rhs) const { return index_ == rhs.index_ && generation_ == rhs.generation_; }
+    bool operator!=(const NodeHandle& rhs) const { return !operator==(rhs); }
+
+    /// As a single integer, so that it can be held in a std::atomic. Zero is the empty handle
+    std::uint64_t pack() const { return (static_cast<std::uint64_t>(generation_) << 32) | index_; }
+    static NodeHandle unpack(std::uint64_t packed) {
+        return NodeHandle(static_cast<std::uint32_t>(packed), static_cast<std::uint32_t>(packed >> 32));
+    }
+
+private:
+    NodeHandle(std::uint32_t index, std::uint32_t generation) : index_(index), generation_(generation) {}
+    friend class NodeTable;
+
+    std::uint32_t index_{0};
+    std::uint32_t generation_{0}; // zero means empty handle
+};
+
+class NodeTable {
+public:
+    NodeTable()                            = delete;
+    NodeTable(const NodeTable&)            = delete;
+    NodeTable& operator=(const NodeTable&) = delete;
+
+    /// Allocate a slot for the node. Returns an empty handle if the table is full,
+    /// in which case callers resort to finding the node by path.
+    static NodeHandle add(Node*);
+
+    /// Release the slot, any outstanding handles to it will return NULL from find()
+    static void remove(const NodeHandle&);
+
+    /// Returns NULL if the handle is empty or the node has since been destroyed
+    static Node* find(const NodeHandle& h) {
+        if (h.empty())
+            return nullptr;
+        const Slot* block = blocks_[h.index_ >> block_bits].load(std::memory_order_acquire);
+        const Slot& slot  = block[h.index_ & block_mask];
+        if (slot.generation_.load(std::memory_order_acquire) != h.generation_)
+            return nullptr;
+        return slot.node_.load(std::memory_order_relaxed);
+    }
+
+    /// The number of nodes with a handle. For test only.
+    static std::size_t size();
+
+private:
+    struct Slot
+    {
+        std::atomic<Node*> node_{nullptr};
+        std::atomic<std::uint32_t> generation_{1};
+    };
+
+    // Slots are allocated in blocks, which never move, hence find() needs no locking.
+    static constexpr std::uint32_t block_bits = 14;
+    static constexpr std::uint32_t block_size = 1u << block_bits;
+    static constexpr std::uint32_t block_mask = block_size - 1;
+    static constexpr std::uint32_t max_blocks = 1u << 14;
+
+    static std::atomic<Slot*> blocks_[max_blocks];
+};
+
+} // namespace ecf
+
+#endif
@@ -15,6 +15,8 @@
 // Description :
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
 
+#include <atomic>
+
 #include "Calendar.hpp"
 #include "ClockAttr.hpp" // IWYU pragma: keep
 #include "NodeContainer.hpp"
@@ -41,8 +43,8 @@ public:
     bool check_defaults() const override;
 
     Suite* suite() const override { return const_cast<Suite*>(this); }
-    Defs* defs() const override { return defs_; }
-    void set_defs(Defs* d) { defs_ = d; }
+    Defs* defs() const override { return defs_.load(std::memory_order_acquire); }
+    void set_defs(Defs* d) { defs_.store(d, std::memory_order_release); }
     Suite* isSuite() const override { return const_cast<Suite*>(this); }
     NodeContainer* isNodeContainer() const override { return const_cast<Suite*>(this); }
 
@@ -119,7 +121,7 @@ private:
     void serialize(Archive& ar, std::uint32_t const version);
 
 private:
-    Defs* defs_{nullptr}; // *NOT* persisted, set by parent Defs
+    std::atomic<Defs*> defs_{nullptr}; // *NOT* persisted, set by parent Defs, see Defs::share_suite()
     clock_ptr clockAttr_;
     clock_ptr clock_end_attr_;           // *NOT* persisted, used by simulator only
     ecf::Calendar cal_;                  // *Only* persisted since used by the why() on client side
@@ -0,0 +1,223 @@
+#ifndef SYNTHETIC_DEFS_HPP_
+#define SYNTHETIC_DEFS_HPP_
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description : Generates a large defs, of a given shape, for performance tests.
+//               The same parameters (and seed) always generate the same defs,
+//               hence results can be compared between builds.
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+
+#include "CronAttr.hpp"
+#include "Defs.hpp"
+#include "Family.hpp"
+#include "InLimit.hpp"
+#include "Limit.hpp"
+#include "RepeatAttr.hpp"
+#include "Suite.hpp"
+#include "Task.hpp"
+#include "TimeAttr.hpp"
+
+namespace ecf {
+
+class SyntheticDefs {
+public:
+    /// Each suite has <depth> levels of <fan_out> families, the families in
+    /// the last level have <tasks> tasks. Densities are in the range [0,1].
+    struct Params
+    {
+        size_t suites{10};
+        size_t depth{2};
+        size_t fan_out{4};
+        size_t tasks{10};
+        double trigger_density{0.5}; // tasks (and families) that trigger on an earlier sibling
+        size_t trigger_refs{1};      // earlier siblings referenced by a trigger, any of them must complete
+        double complete_density{0};  // tasks with a complete expression on an earlier sibling
+        size_t limits{1};            // per suite, each family is in one of them
+        int limit_size{10};
+        double repeat_density{0.1}; // families with a repeat integer
+        double time_density{0.05};  // tasks with a time (relative) or a cron attribute
+        size_t variables{2};        // per node
+        size_t events{1};           // per task
+        size_t meters{1};           // per task
+        size_t labels{1};           // per task
+        unsigned int seed{1};
+
+        /// Set from "name=value", i.e suites=100. Will throw std::runtime_error for
+        /// an unknown name or a bad value
+        void set(const std::string& arg) {
+            size_t eq = arg.find('=');
+            if (eq == std::string::npos)
+                throw std::runtime_error("SyntheticDefs: expected name=value but found " + arg);
+            std::string name  = arg.substr(0, eq);
+            std::string value = arg.substr(eq + 1);
+            try {
+                if (name == "suites")
+                    suites = boost::lexical_cast<size_t>(value);
+                else if (name == "depth")
+                    depth = boost::lexical_cast<size_t>(value);
+                else if (name == "fan_out")
+                    fan_out = boost::lexical_cast<size_t>(value);
+                else if (name == "tasks")
+                    tasks = boost::lexical_cast<size_t>(value);
+                else if (name == "trigger_density")
+                    trigger_density = boost::lexical_cast<double>(value);
+                else if (name == "trigger_refs")
+                    trigger_refs = boost::lexical_cast<size_t>(value);
+                else if (name == "complete_density")
+                    complete_density = boost::lexical_cast<double>(value);
+                else if (name == "limits")
+                    limits = boost::lexical_cast<size_t>(value);
+                else if (name == "limit_size")
+                    limit_size = boost::lexical_cast<int>(value);
+                else if (name == "repeat_density")
+                    repeat_density = boost::lexical_cast<double>(value);
+                else if (name == "time_density")
+                    time_density = boost::lexical_cast<double>(value);
+                else if (name == "variables")
+                    variables = boost::lexical_cast<size_t>(value);
+                else if (name == "events")
+                    events = boost::lexical_cast<size_t>(value);
+                else if (name == "meters")
+                    meters = boost::lexical_cast<size_t>(value);
+                else if (name == "labels")
+                    labels = boost::lexical_cast<size_t>(value);
+                else if (name == "seed")
+                    seed = boost::lexical_cast<unsigned int>(value);
+                else
+                    throw std::runtime_error("SyntheticDefs: unknown parameter " + name);
+            }
+            catch (boost::bad_lexical_cast&) {
+                throw std::runtime_error("SyntheticDefs: bad value for " + arg);
+            }
+        }
+
+        /// The number of tasks that will be generated
+        size_t no_of_tasks() const {
+            size_t leaf_families = suites;
+            for (size_t i = 0; i < depth; i++)
+                leaf_families *= fan_out;
+            return leaf_families * tasks;
+        }
+
+        std::string to_string() const {
+            std::stringstream ss;
+            ss << "suites=" << suites << " depth=" << depth << " fan_out=" << fan_out << " tasks=" << tasks
+               << " trigger_density=" << trigger_density << " trigger_refs=" << trigger_refs
+               << " complete_density=" << complete_density << " limits=" << limits << " limit_size=" << limit_size
+               << " repeat_density=" << repeat_density << " time_density=" << time_density
+               << " variables=" << variables << " events=" << events << " meters=" << meters << " labels=" << labels
+               << " seed=" << seed;
+            return ss.str();
+        }
+    };
+
+    explicit SyntheticDefs(const Params& params) : params_(params), rng_(params.seed) {}
+
+    /// Suites are called s0,s1..., families f0,f1.. and tasks t0,t1..
+    defs_ptr create() {
+        defs_ptr defs = Defs::create();
+        for (size_t s = 0; s < params_.suites; s++) {
+            suite_ptr suite = Suite::create("s" + boost::lexical_cast<std::string>(s));
+            for (size_t l = 0; l < params_.limits; l++)
+                suite->addLimit(Limit("lim" + boost::lexical_cast<std::string>(l), params_.limit_size));
+            add_variables(suite.get());
+            add_families(suite.get(), suite->absNodePath(), 1);
+            defs->addSuite(suite);
+        }
+        return defs;
+    }
+
+private:
+    bool chance(double density) { return density > 0 && uniform_(rng_) < density; }
+    size_t pick(size_t n) { return std::uniform_int_distribution<size_t>(0, n - 1)(rng_); }
+
+    void add_variables(Node* node) {
+        for (size_t v = 0; v < params_.variables; v++)
+            node->add_variable("VAR" + boost::lexical_cast<std::string>(v), node->name());
+    }
+
+    // trigger on earlier siblings, i.e t3 on t1, or t3 on "t1 == complete or t0 == complete"
+    void add_trigger(Node* node, const std::string& prefix, size_t index) {
+        if (index > 0 && chance(params_.trigger_density))
+            node->add_trigger(sibling_expression(prefix, index, params_.trigger_refs));
+    }
+
+    void add_complete(Node* node, const std::string& prefix, size_t index) {
+        if (index > 0 && chance(params_.complete_density))
+            node->add_complete(sibling_expression(prefix, index, 1));
+    }
+
+    std::string sibling_expression(const std::string& prefix, size_t index, size_t refs) {
+        std::string expr;
+        for (size_t r = 0; r < refs; r++) {
+            if (r > 0)
+                expr += " or ";
+            expr += prefix + boost::lexical_cast<std::string>(pick(index)) + " == complete";
+        }
+        return expr;
+    }
+
+    void add_families(NodeContainer* parent, const std::string& suite_path, size_t level) {
+        if (level > params_.depth) {
+            add_tasks(parent);
+            return;
+        }
+        for (size_t f = 0; f < params_.fan_out; f++) {
+            family_ptr family = parent->add_family("f" + boost::lexical_cast<std::string>(f));
+            add_variables(family.get());
+            add_trigger(family.get(), "f", f);
+            if (params_.limits > 0 && level == 1)
+                family->addInLimit(InLimit("lim" + boost::lexical_cast<std::string>(pick(params_.limits)), suite_path));
+            if (chance(params_.repeat_density))
+                family->addRepeat(RepeatInteger("REP", 0, 2, 1));
+            add_families(family.get(), suite_path, level + 1);
+        }
+    }
+
+    void add_tasks(NodeContainer* parent) {
+        for (size_t t = 0; t < params_.tasks; t++) {
+            task_ptr task = parent->add_task("t" + boost::lexical_cast<std::string>(t));
+            add_variables(task.get());
+            add_trigger(task.get(), "t", t);
+            add_complete(task.get(), "t", t);
+            for (size_t e = 0; e < params_.events; e++)
+                task->addEvent(Event("e" + boost::lexical_cast<std::string>(e)));
+            for (size_t m = 0; m < params_.meters; m++)
+                task->addMeter(Meter("m" + boost::lexical_cast<std::string>(m), 0, 100, 100));
+            for (size_t l = 0; l < params_.labels; l++)
+                task->addLabel(Label("l" + boost::lexical_cast<std::string>(l), ""));
+            if (chance(params_.time_density)) {
+                if (chance(0.5))
+                    task->addTime(TimeAttr(0, 1, true /* relative to suite begin */));
+                else
+                    task->addCron(CronAttr(TimeSlot(0, 0), TimeSlot(23, 59), TimeSlot(0, 10)));
+            }
+        }
+    }
+
+    Params params_;
+    std::mt19937 rng_;
+    std::uniform_real_distribution<double> uniform_{0.0, 1.0};
+};
+
+} // namespace ecf
+
+#endif
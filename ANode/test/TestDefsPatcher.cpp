@@ -0,0 +1,299 @@
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+#include <boost/test/unit_test.hpp>
+
+#include "Defs.hpp"
+#include "DefsPatcher.hpp"
+#include "AutoCancelAttr.hpp"
+#include "Ecf.hpp"
+#include "Family.hpp"
+#include "PrintStyle.hpp"
+#include "QueueAttr.hpp"
+#include "Suite.hpp"
+#include "Task.hpp"
+#include "VerifyAttr.hpp"
+
+using namespace std;
+using namespace ecf;
+
+// Patching only updates the state change numbers, hence clients can sync incrementally
+class ExpectNoModifyChange {
+public:
+    ExpectNoModifyChange() : state_change_no_(Ecf::state_change_no()), modify_change_no_(Ecf::modify_change_no()) {
+        Ecf::set_server(true);
+    }
+    ~ExpectNoModifyChange() {
+        BOOST_CHECK_MESSAGE(modify_change_no_ == Ecf::modify_change_no(), "Expected no modify change");
+        BOOST_CHECK_MESSAGE(state_change_no_ != Ecf::state_change_no(), "Expected state change");
+        Ecf::set_server(false);
+        Ecf::set_state_change_no(state_change_no_); // other tests expect the numbers to be unchanged
+    }
+
+private:
+    unsigned int state_change_no_;
+    unsigned int modify_change_no_;
+};
+
+static defs_ptr create_defs(const std::string& defs_str) {
+    defs_ptr defs = Defs::create();
+    std::string errorMsg, warningMsg;
+    BOOST_REQUIRE_MESSAGE(defs->restore_from_string(defs_str, errorMsg, warningMsg), errorMsg);
+    return defs;
+}
+
+static const char* live_defs_str = "suite s\n"
+                                   "  family f\n"
+                                   "    task t1\n"
+                                   "      event e\n"
+                                   "      meter m 0 100\n"
+                                   "    task t2\n"
+                                   "      trigger t1 == complete\n"
+                                   "    task t3\n"
+                                   "  endfamily\n"
+                                   "endsuite\n";
+
+BOOST_AUTO_TEST_SUITE(NodeTestSuite)
+
+BOOST_AUTO_TEST_CASE(test_defs_patcher_no_change) {
+    cout << "ANode:: ...test_defs_patcher_no_change\n";
+
+    defs_ptr live_defs = create_defs(live_defs_str);
+    defs_ptr new_defs  = create_defs(live_defs_str);
+
+    DefsPatcher patcher(*live_defs, *new_defs);
+    BOOST_CHECK_MESSAGE(patcher.no_of_changes() == 0, "Expected no changes but found " << patcher.summary());
+}
+
+BOOST_AUTO_TEST_CASE(test_defs_patcher_keeps_state) {
+    cout << "ANode:: ...test_defs_patcher_keeps_state\n";
+
+    defs_ptr live_defs = create_defs(live_defs_str);
+    live_defs->beginAll();
+    node_ptr t1 = live_defs->findAbsNode("/s/f/t1");
+    t1->set_state(NState::COMPLETE);
+    t1->set_event("e");
+    t1->set_meter("m", 20);
+
+    // t1 gets a label, t3 is deleted, t4 is added
+    std::string new_defs_str = "suite s\n"
+                               "  family f\n"
+                               "    task t1\n"
+                               "      event e\n"
+                               "      meter m 0 100\n"
+                               "      label info \"\"\n"
+                               "    task t4\n"
+                               "    task t2\n"
+                               "      trigger t1 == complete\n"
+                               "  endfamily\n"
+                               "endsuite\n";
+    defs_ptr new_defs        = create_defs(new_defs_str);
+
+    {
+        ExpectNoModifyChange expect_no_modify_change;
+        DefsPatcher patcher(*live_defs, *new_defs);
+        BOOST_CHECK_MESSAGE(patcher.summary() == "added:1 deleted:1 replaced:0 changed:1 re-ordered:0",
+                            "Unexpected changes " << patcher.summary());
+
+        std::string errorMsg;
+        BOOST_REQUIRE_MESSAGE(patcher.apply(false, errorMsg), errorMsg);
+    }
+
+    BOOST_CHECK_MESSAGE(live_defs->findAbsNode("/s/f/t1") == t1, "Expected t1 to be kept");
+    BOOST_CHECK_MESSAGE(t1->state() == NState::COMPLETE, "Expected state to be kept");
+    BOOST_CHECK_MESSAGE(t1->findEventByNameOrNumber("e").value(), "Expected event value to be kept");
+    BOOST_CHECK_MESSAGE(t1->findMeter("m").value() == 20, "Expected meter value to be kept");
+    BOOST_CHECK_MESSAGE(t1->findLabel("info"), "Expected new label");
+    BOOST_CHECK_MESSAGE(!live_defs->findAbsNode("/s/f/t3"), "Expected t3 to be deleted");
+
+    const std::vector<node_ptr>& children = live_defs->findAbsNode("/s/f")->isFamily()->nodeVec();
+    BOOST_REQUIRE_MESSAGE(children.size() == 3, "Expected 3 children but found " << children.size());
+    BOOST_CHECK_MESSAGE(children[1]->name() == "t4", "Expected t4 to be added at the client position");
+    BOOST_CHECK_MESSAGE(children[1]->state() == NState::QUEUED, "Expected added task to be begun");
+
+    // The patched definition must be the same as the new definition
+    defs_ptr expected_defs = create_defs(new_defs_str);
+    BOOST_CHECK_MESSAGE(live_defs->print(PrintStyle::DEFS) == expected_defs->print(PrintStyle::DEFS),
+                        "Expected patched definition to match the new definition");
+}
+
+BOOST_AUTO_TEST_CASE(test_defs_patcher_keeps_attribute_state) {
+    cout << "ANode:: ...test_defs_patcher_keeps_attribute_state\n";
+
+    std::string defs_str = "suite s\n"
+                           "  family f\n"
+                           "    task t1\n"
+                           "      queue q a b c\n"
+                           "      verify complete:1\n"
+                           "      autocancel +01:00\n"
+                           "  endfamily\n"
+                           "endsuite\n";
+    defs_ptr live_defs   = create_defs(defs_str);
+    live_defs->beginAll();
+    node_ptr t1 = live_defs->findAbsNode("/s/f/t1");
+    t1->findQueue("q").set_index(2);
+    t1->set_state(NState::COMPLETE);
+    BOOST_REQUIRE_MESSAGE(t1->verifys()[0].actual() == 1, "Expected verify count to be incremented");
+    const ecf::AutoCancelAttr* auto_cancel = t1->get_autocancel();
+
+    // t1 gets a label, the queue, verify and autocancel are unchanged
+    std::string new_defs_str = "suite s\n"
+                               "  family f\n"
+                               "    task t1\n"
+                               "      label info \"\"\n"
+                               "      queue q a b c\n"
+                               "      verify complete:1\n"
+                               "      autocancel +01:00\n"
+                               "  endfamily\n"
+                               "endsuite\n";
+    defs_ptr new_defs        = create_defs(new_defs_str);
+
+    {
+        ExpectNoModifyChange expect_no_modify_change;
+        DefsPatcher patcher(*live_defs, *new_defs);
+        BOOST_CHECK_MESSAGE(patcher.summary() == "added:0 deleted:0 replaced:0 changed:1 re-ordered:0",
+                            "Unexpected changes " << patcher.summary());
+
+        std::string errorMsg;
+        BOOST_REQUIRE_MESSAGE(patcher.apply(false, errorMsg), errorMsg);
+    }
+
+    BOOST_CHECK_MESSAGE(live_defs->findAbsNode("/s/f/t1") == t1, "Expected t1 to be kept");
+    BOOST_CHECK_MESSAGE(t1->findLabel("info"), "Expected new label");
+    BOOST_CHECK_MESSAGE(t1->findQueue("q").index() == 2, "Expected queue index to be kept");
+    BOOST_CHECK_MESSAGE(t1->verifys()[0].actual() == 1, "Expected verify count to be kept");
+    BOOST_CHECK_MESSAGE(t1->get_autocancel() == auto_cancel, "Expected autocancel to be kept");
+
+    // A changed queue is replaced
+    defs_ptr changed_defs = create_defs("suite s\n"
+                                        "  family f\n"
+                                        "    task t1\n"
+                                        "      label info \"\"\n"
+                                        "      queue q a b c d\n"
+                                        "      verify complete:1\n"
+                                        "      autocancel +01:00\n"
+                                        "  endfamily\n"
+                                        "endsuite\n");
+    {
+        ExpectNoModifyChange expect_no_modify_change;
+        DefsPatcher patcher(*live_defs, *changed_defs);
+        std::string errorMsg;
+        BOOST_REQUIRE_MESSAGE(patcher.apply(false, errorMsg), errorMsg);
+    }
+    BOOST_CHECK_MESSAGE(t1->findQueue("q").index() == 0, "Expected changed queue to be replaced");
+    BOOST_CHECK_MESSAGE(t1->verifys()[0].actual() == 1, "Expected verify count to be kept");
+}
+
+BOOST_AUTO_TEST_CASE(test_defs_patcher_order_and_replace) {
+    cout << "ANode:: ...test_defs_patcher_order_and_replace\n";
+
+    defs_ptr live_defs = create_defs(live_defs_str);
+    live_defs->beginAll();
+
+    // t3 changes from a task to a family, t2 and t1 swap position, suite s2 is added
+    defs_ptr new_defs = create_defs("suite s\n"
+                                    "  family f\n"
+                                    "    task t2\n"
+                                    "      trigger t1 == complete\n"
+                                    "    task t1\n"
+                                    "      event e\n"
+                                    "      meter m 0 100\n"
+                                    "    family t3\n"
+                                    "      task x\n"
+                                    "    endfamily\n"
+                                    "  endfamily\n"
+                                    "endsuite\n"
+                                    "suite s2\n"
+                                    "endsuite\n");
+
+    DefsPatcher patcher(*live_defs, *new_defs);
+    BOOST_CHECK_MESSAGE(patcher.summary() == "added:1 deleted:0 replaced:1 changed:0 re-ordered:1",
+                        "Unexpected changes " << patcher.summary());
+    BOOST_REQUIRE_MESSAGE(patcher.nodes_to_remove().size() == 1, "Expected t3 to be replaced");
+
+    std::string errorMsg;
+    BOOST_REQUIRE_MESSAGE(patcher.apply(false, errorMsg), errorMsg);
+
+    const std::vector<node_ptr>& children = live_defs->findAbsNode("/s/f")->isFamily()->nodeVec();
+    BOOST_REQUIRE_MESSAGE(children.size() == 3, "Expected 3 children but found " << children.size());
+    BOOST_CHECK_MESSAGE(children[0]->name() == "t2" && children[1]->name() == "t1", "Expected children re-ordered");
+    BOOST_CHECK_MESSAGE(children[2]->isFamily(), "Expected t3 to be replaced with a family");
+    BOOST_CHECK_MESSAGE(live_defs->findAbsNode("/s/f/t3/x"), "Expected family t3 to have task x");
+    BOOST_CHECK_MESSAGE(live_defs->suiteVec().size() == 2, "Expected suite s2 to be added");
+
+    // The trigger must be resolved against the live nodes
+    std::string warningMsg;
+    BOOST_CHECK_MESSAGE(live_defs->check(errorMsg, warningMsg), errorMsg);
+}
+
+BOOST_AUTO_TEST_CASE(test_defs_patcher_active_tasks) {
+    cout << "ANode:: ...test_defs_patcher_active_tasks\n";
+
+    defs_ptr live_defs = create_defs(live_defs_str);
+    live_defs->beginAll();
+    live_defs->findAbsNode("/s/f/t3")->set_state(NState::ACTIVE);
+
+    std::string new_defs_str = live_defs_str;
+    new_defs_str.erase(new_defs_str.find("    task t3\n"), 12);
+
+    {
+        defs_ptr new_defs = create_defs(new_defs_str);
+        DefsPatcher patcher(*live_defs, *new_defs);
+        std::string errorMsg;
+        BOOST_CHECK_MESSAGE(!patcher.apply(false, errorMsg), "Expected failure when deleting active task");
+        BOOST_CHECK_MESSAGE(!errorMsg.empty(), "Expected error message");
+        BOOST_CHECK_MESSAGE(live_defs->findAbsNode("/s/f/t3"), "Expected t3 to be kept");
+    }
+    {
+        defs_ptr new_defs = create_defs(new_defs_str);
+        DefsPatcher patcher(*live_defs, *new_defs);
+        std::string errorMsg;
+        BOOST_CHECK_MESSAGE(patcher.apply(true, errorMsg), "Expected force to delete active task " << errorMsg);
+        BOOST_CHECK_MESSAGE(!live_defs->findAbsNode("/s/f/t3"), "Expected t3 to be deleted");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_defs_patcher_node) {
+    cout << "ANode:: ...test_defs_patcher_node\n";
+
+    defs_ptr live_defs = create_defs(live_defs_str);
+    live_defs->beginAll();
+    node_ptr t1 = live_defs->findAbsNode("/s/f/t1");
+    t1->set_state(NState::COMPLETE);
+
+    // Only the family is compared, suite variables are ignored
+    defs_ptr new_defs = create_defs("suite s\n"
+                                    "  edit VAR value\n"
+                                    "  family f\n"
+                                    "    edit FVAR value\n"
+                                    "    task t1\n"
+                                    "      event e\n"
+                                    "      meter m 0 100\n"
+                                    "    task t2\n"
+                                    "      trigger t1 == complete\n"
+                                    "    task t3\n"
+                                    "  endfamily\n"
+                                    "endsuite\n");
+
+    DefsPatcher patcher(live_defs->findAbsNode("/s/f"), new_defs->findAbsNode("/s/f"));
+    BOOST_CHECK_MESSAGE(patcher.summary() == "added:0 deleted:0 replaced:0 changed:1 re-ordered:0",
+                        "Unexpected changes " << patcher.summary());
+
+    std::string errorMsg;
+    BOOST_REQUIRE_MESSAGE(patcher.apply(false, errorMsg), errorMsg);
+    BOOST_CHECK_MESSAGE(live_defs->findAbsNode("/s/f")->findVariable("FVAR").name() == "FVAR",
+                        "Expected family variable to be added");
+    BOOST_CHECK_MESSAGE(live_defs->findAbsNode("/s")->variables().empty(), "Expected suite to be unchanged");
+    BOOST_CHECK_MESSAGE(t1->state() == NState::COMPLETE, "Expected state to be kept");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,131 @@
+//============================================================================
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+//============================================================================
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Defs.hpp"
+#include "EditHistory.hpp"
+#include "Suite.hpp"
+
+using namespace std;
+using namespace ecf;
+using namespace boost::gregorian;
+
+BOOST_AUTO_TEST_SUITE(NodeTestSuite)
+
+static std::string request(int i, const date& d = date(2020, 3, 10)) {
+    std::stringstream ss;
+    ss << "MSG:[07:36:05 " << d.day() << "." << d.month().as_number() << "." << d.year() << "] --alter change label l "
+       << i << " /s1  :user";
+    return ss.str();
+}
+
+BOOST_AUTO_TEST_CASE(test_edit_history_per_node_limit) {
+    cout << "ANode:: ...test_edit_history_per_node_limit\n";
+
+    EditHistory history;
+    for (int i = 0; i < 15; i++) {
+        history.add("/s1", request(i));
+    }
+    std::vector<std::string> requests = history.get("/s1");
+    BOOST_REQUIRE_MESSAGE(requests.size() == EditHistory::max_requests_per_node(),
+                          "Expected " << EditHistory::max_requests_per_node() << " requests but found "
+                                      << requests.size());
+    BOOST_CHECK_MESSAGE(requests.front() == request(5), "Expected oldest requests to be removed");
+    BOOST_CHECK_MESSAGE(requests.back() == request(14), "Expected newest request last");
+    BOOST_CHECK_MESSAGE(history.get("/s2").empty(), "Expected no history for /s2");
+
+    history.remove("/s1");
+    BOOST_CHECK_MESSAGE(history.empty() && history.memory_size() == 0,
+                        "Expected no history or memory after remove, but found " << history.memory_size());
+}
+
+BOOST_AUTO_TEST_CASE(test_edit_history_memory_limit) {
+    cout << "ANode:: ...test_edit_history_memory_limit\n";
+
+    // Add to 1000 nodes, the oldest requests should be removed across all nodes
+    EditHistory history;
+    history.set_max_size(16 * 1024);
+    for (int i = 0; i < 1000; i++) {
+        history.add("/s1/t" + std::to_string(i), request(i));
+        BOOST_REQUIRE_MESSAGE(history.memory_size() <= history.max_size(),
+                              "Expected memory " << history.memory_size() << " to be less than "
+                                                 << history.max_size());
+    }
+    BOOST_CHECK_MESSAGE(history.size() < 1000, "Expected history of oldest nodes to be removed");
+    BOOST_CHECK_MESSAGE(history.get("/s1/t0").empty(), "Expected oldest history to be removed");
+    BOOST_CHECK_MESSAGE(history.get("/s1/t999").size() == 1, "Expected newest history to be kept");
+
+    // Lowering the limit, removes history straight away
+    history.set_max_size(1024);
+    BOOST_CHECK_MESSAGE(history.memory_size() <= 1024, "Expected memory to be reduced");
+    BOOST_CHECK_MESSAGE(history.get("/s1/t999").size() == 1, "Expected newest history to be kept");
+}
+
+BOOST_AUTO_TEST_CASE(test_edit_history_prune) {
+    cout << "ANode:: ...test_edit_history_prune\n";
+
+    date today(2020, 3, 10);
+    EditHistory history;
+    history.add("/s1", request(1, today - days(40)));
+    history.add("/s1", "no time stamp, is kept");
+    history.add("/s1", request(2, today - days(1)));
+    history.add("/s2", request(3, today - days(40)));
+
+    history.prune(30, today);
+    std::vector<std::string> requests = history.get("/s1");
+    BOOST_REQUIRE_MESSAGE(requests.size() == 2, "Expected 2 requests after pruning, but found " << requests.size());
+    BOOST_CHECK_MESSAGE(requests[0] == "no time stamp, is kept", "Expected request without time stamp to be kept");
+    BOOST_CHECK_MESSAGE(requests[1] == request(2, today - days(1)), "Expected recent request to be kept");
+    BOOST_CHECK_MESSAGE(history.size() == 1, "Expected /s2 to be removed, as all its history was pruned");
+
+    // Only prune once a day
+    history.add("/s1", request(4, today - days(40)));
+    history.prune(30, today);
+    BOOST_CHECK_MESSAGE(history.get("/s1").size() == 3, "Expected prune to do nothing, when called again today");
+    history.prune(30, today + days(1));
+    BOOST_CHECK_MESSAGE(history.get("/s1").size() == 2, "Expected prune the next day, to remove old request");
+}
+
+BOOST_AUTO_TEST_CASE(test_edit_history_checkpoint) {
+    cout << "ANode:: ...test_edit_history_checkpoint\n";
+
+    Defs defs;
+    suite_ptr suite = defs.add_suite("s1");
+    defs.add_edit_history(suite->absNodePath(), request(1));
+    defs.add_edit_history(suite->absNodePath(), "MSG:[07:36:05 10.3.2020] --alter change label l 'new\nline' /s1");
+    defs.add_edit_history("/", request(2));
+
+    std::string tmpFilename = "test_edit_history_checkpoint.def";
+    defs.save_as_checkpt(tmpFilename);
+
+    Defs reloaded_defs;
+    std::string errorMsg, warningMsg;
+    BOOST_REQUIRE_MESSAGE(reloaded_defs.restore(tmpFilename, errorMsg, warningMsg),
+                          "RE-PARSE failed for " << tmpFilename << " " << errorMsg);
+    BOOST_CHECK_MESSAGE(reloaded_defs.get_edit_history() == defs.get_edit_history(),
+                        "Expected same edit history after reload:\n"
+                            << defs.dump_edit_history() << "\nbut found:\n"
+                            << reloaded_defs.dump_edit_history());
+    BOOST_CHECK_MESSAGE(reloaded_defs.get_edit_history("/s1").size() == 2, "Expected 2 requests for /s1");
+
+    std::remove(tmpFilename.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
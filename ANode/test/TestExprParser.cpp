@@ -15,11 +15,14 @@
 #include <iostream>
 #include <map>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 
 #include "Defs.hpp"
 #include "ExprAst.hpp"
+#include "ExprDuplicate.hpp"
 #include "ExprParser.hpp"
 #include "Expression.hpp"
 #include "Suite.hpp"
@@ -739,4 +742,47 @@ BOOST_AUTO_TEST_CASE(test_parser_bad_expressions) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_expression_parser_threads) {
+    std::cout << "ANode:: ...test_expression_parser_threads\n";
+
+    // The client and the python api can parse expressions, and destroy Defs (which clears the
+    // duplicate expression map), on several threads. The simple parser handles the first, spirit the others
+    std::vector<std::string> exprvec{"a == complete",
+                                     "(a == complete or b == complete) and c:event",
+                                     "cal::date_to_julian(/s/f:YMD) >= cal::date_to_julian(20200101)",
+                                     "((../a:meter + 1) % 2) == 0 and not /s/f/t == aborted"};
+
+    std::vector<std::string> expected;
+    for (const std::string& expr : exprvec) {
+        ExprParser theExprParser(expr);
+        std::string errorMsg;
+        BOOST_REQUIRE_MESSAGE(theExprParser.doParse(errorMsg), expr << " failed to parse " << errorMsg);
+        expected.push_back(theExprParser.getAst()->expression());
+    }
+
+    std::vector<std::thread> threads;
+    int failures[4] = {0, 0, 0, 0};
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([t, &exprvec, &expected, &failures]() {
+            for (size_t i = 0; i < 2000; i++) {
+                size_t e = (t + i) % exprvec.size();
+                ExprParser theExprParser(exprvec[e]);
+                std::string errorMsg;
+                if (!theExprParser.doParse(errorMsg) || theExprParser.getAst()->expression() != expected[e]) {
+                    failures[t]++;
+                }
+                if (i % 3 == 0) {
+                    ExprDuplicate reclaim_cloned_ast_memory;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (int t = 0; t < 4; t++) {
+        BOOST_CHECK_MESSAGE(failures[t] == 0, "Thread " << t << " failed to parse " << failures[t] << " expressions");
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -12,6 +12,7 @@
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
 #include "Defs.hpp"
 #include "Family.hpp"
+#include "FindNodeCache.hpp"
 #include "Suite.hpp"
 #include "Task.hpp"
 // #include "PrintStyle.hpp"
@@ -80,4 +81,35 @@ BOOST_AUTO_TEST_CASE(test_find_abs_node_path) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_find_abs_node_path_with_cache) {
+    cout << "ANode:: ...test_find_abs_node_path_with_cache\n";
+
+    Defs theDefs;
+    suite_ptr suite = theDefs.add_suite("suite");
+    family_ptr fam  = suite->add_family("family");
+    std::vector<task_ptr> tasks;
+    for (int t = 0; t < 100; t++) {
+        tasks.push_back(fam->add_task("t" + boost::lexical_cast<std::string>(t)));
+    }
+
+    FindNodeCache cache(&theDefs);
+    for (int i = 0; i < 2; i++) {
+        for (const auto& task : tasks) {
+            node_ptr found_node = theDefs.findAbsNode(task->absNodePath());
+            BOOST_CHECK_MESSAGE(found_node == task, "Could not find node " << task->absNodePath());
+        }
+    }
+    BOOST_CHECK_MESSAGE(!theDefs.findAbsNode("/suite/family/tx"), "Expected not to find /suite/family/tx");
+
+    // The cache must not return deleted nodes, or miss nodes added after it was created
+    std::string path = tasks[10]->absNodePath();
+    BOOST_REQUIRE_MESSAGE(theDefs.deleteChild(tasks[10].get()), "Expected delete to succeed");
+    BOOST_CHECK_MESSAGE(!theDefs.findAbsNode(path), "Expected deleted node not to be found");
+
+    task_ptr new_task = fam->add_task("t10");
+    BOOST_CHECK_MESSAGE(theDefs.findAbsNode(path) == new_task, "Expected to find the re-added node");
+    task_ptr added_task = fam->add_task("t100");
+    BOOST_CHECK_MESSAGE(theDefs.findAbsNode(added_task->absNodePath()) == added_task, "Expected to find added node");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,112 @@
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Defs.hpp"
+#include "ExprAst.hpp"
+#include "Family.hpp"
+#include "NodeTable.hpp"
+#include "Suite.hpp"
+#include "Task.hpp"
+
+using namespace std;
+using namespace ecf;
+
+BOOST_AUTO_TEST_SUITE(NodeTestSuite)
+
+BOOST_AUTO_TEST_CASE(test_node_table) {
+    cout << "ANode:: ...test_node_table\n";
+
+    BOOST_CHECK_MESSAGE(NodeTable::find(NodeHandle()) == nullptr, "Empty handle should not resolve");
+
+    NodeHandle handle;
+    {
+        task_ptr t = Task::create("t");
+        handle     = t->handle();
+        BOOST_REQUIRE_MESSAGE(!handle.empty(), "Expected handle to be allocated");
+        BOOST_CHECK_MESSAGE(t->handle() == handle, "Expected the same handle, on subsequent calls");
+        BOOST_CHECK_MESSAGE(NodeTable::find(handle) == t.get(), "Expected handle to resolve to the task");
+
+        task_ptr copy = std::make_shared<Task>(*t);
+        BOOST_CHECK_MESSAGE(copy->handle() != handle, "Copied node should have its own handle");
+    }
+    BOOST_CHECK_MESSAGE(NodeTable::find(handle) == nullptr, "Handle of a destroyed node should not resolve");
+
+    // The slot is re-used, but the old handle must still not resolve
+    task_ptr t2 = Task::create("t2");
+    BOOST_CHECK_MESSAGE(t2->handle() != handle, "Expected a new generation for a re-used slot");
+    BOOST_CHECK_MESSAGE(NodeTable::find(handle) == nullptr, "Stale handle should not resolve to a re-used slot");
+    BOOST_CHECK_MESSAGE(NodeTable::find(t2->handle()) == t2.get(), "Expected handle to resolve to the task");
+}
+
+BOOST_AUTO_TEST_CASE(test_node_table_trigger_references) {
+    cout << "ANode:: ...test_node_table_trigger_references\n";
+
+    Defs defs;
+    suite_ptr s  = defs.add_suite("s");
+    family_ptr f = s->add_family("f");
+    task_ptr a   = f->add_task("a");
+    task_ptr b   = f->add_task("b");
+    b->add_trigger("a == complete");
+
+    AstTop* ast = b->triggerAst();
+    BOOST_REQUIRE_MESSAGE(ast, "Expected trigger AST");
+    BOOST_CHECK_MESSAGE(!ast->evaluate(), "Expected trigger to hold");
+    a->set_state(NState::COMPLETE);
+    BOOST_CHECK_MESSAGE(ast->evaluate(), "Expected trigger to be free");
+
+    // Delete and re-add 'a', the cached reference to the deleted node must not be used
+    (void)a->remove();
+    a.reset();
+    BOOST_CHECK_MESSAGE(!ast->evaluate(), "Expected trigger to hold, when referenced node is deleted");
+    task_ptr new_a = f->add_task("a");
+    BOOST_CHECK_MESSAGE(!ast->evaluate(), "Expected trigger to hold, referenced node is queued");
+    new_a->set_state(NState::COMPLETE);
+    BOOST_CHECK_MESSAGE(ast->evaluate(), "Expected trigger to resolve to the replacement node");
+}
+
+BOOST_AUTO_TEST_CASE(test_node_table_concurrent_handle) {
+    cout << "ANode:: ...test_node_table_concurrent_handle\n";
+
+    // The nodes of a shared defs, may be given their handle by several threads at once
+    std::vector<task_ptr> tasks;
+    for (int i = 0; i < 1000; i++)
+        tasks.push_back(Task::create("t" + std::to_string(i)));
+
+    size_t size_before = NodeTable::size();
+    std::vector<std::vector<NodeHandle>> handles(4);
+    std::vector<std::thread> threads;
+    for (auto& h : handles) {
+        threads.emplace_back([&tasks, &h]() {
+            for (const auto& t : tasks)
+                h.push_back(t->handle());
+        });
+    }
+    for (auto& th : threads)
+        th.join();
+
+    BOOST_CHECK_MESSAGE(NodeTable::size() == size_before + tasks.size(),
+                        "Expected one slot per node but found " << NodeTable::size() - size_before);
+    for (size_t i = 0; i < tasks.size(); i++) {
+        for (const auto& h : handles) {
+            BOOST_REQUIRE_MESSAGE(h[i] == tasks[i]->handle(), "Expected all threads to get the same handle");
+        }
+        BOOST_REQUIRE_MESSAGE(NodeTable::find(tasks[i]->handle()) == tasks[i].get(), "Expected handle to resolve");
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,78 @@
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#include <iostream>
+#include <stdexcept>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Expression.hpp"
+#include "PrintStyle.hpp"
+#include "SyntheticDefs.hpp"
+
+using namespace std;
+using namespace ecf;
+
+BOOST_AUTO_TEST_SUITE(NodeTestSuite)
+
+BOOST_AUTO_TEST_CASE(test_synthetic_defs) {
+    cout << "ANode:: ...test_synthetic_defs\n";
+
+    SyntheticDefs::Params params;
+    params.set("suites=3");
+    params.set("depth=2");
+    params.set("fan_out=3");
+    params.set("tasks=4");
+    params.set("trigger_density=1");
+    params.set("repeat_density=0.5");
+    params.set("time_density=0.5");
+    params.set("trigger_refs=2");
+    params.set("complete_density=1");
+    BOOST_CHECK_THROW(params.set("suites"), std::runtime_error);
+    BOOST_CHECK_THROW(params.set("suites=x"), std::runtime_error);
+    BOOST_CHECK_THROW(params.set("colour=red"), std::runtime_error);
+
+    defs_ptr defs = SyntheticDefs(params).create();
+    std::vector<task_ptr> tasks;
+    defs->get_all_tasks(tasks);
+    BOOST_REQUIRE_MESSAGE(tasks.size() == params.no_of_tasks() && tasks.size() == 3 * 3 * 3 * 4,
+                          "Expected " << params.no_of_tasks() << " tasks but found " << tasks.size());
+    BOOST_CHECK(defs->findAbsNode("/s2/f2/f2/t3"));
+    BOOST_CHECK_MESSAGE(tasks[1]->get_trigger() && !tasks[0]->get_trigger(),
+                        "Expected all tasks, apart from the first, to have a trigger");
+    BOOST_CHECK_MESSAGE(tasks[1]->get_trigger()->expression() == "t0 == complete or t0 == complete",
+                        "Expected a trigger with two references but found " << tasks[1]->get_trigger()->expression());
+    BOOST_CHECK_MESSAGE(tasks[1]->get_complete() && !tasks[0]->get_complete(),
+                        "Expected all tasks, apart from the first, to have a complete expression");
+
+    // All the triggers and limits must resolve
+    std::string error_msg, warning_msg;
+    BOOST_CHECK_MESSAGE(defs->check(error_msg, warning_msg), error_msg);
+
+    // The same parameters create the same defs
+    defs_ptr again = SyntheticDefs(params).create();
+    std::string first, second;
+    defs->save_as_string(first, PrintStyle::DEFS);
+    again->save_as_string(second, PrintStyle::DEFS);
+    BOOST_CHECK_MESSAGE(first == second, "Expected the same defs, for the same seed");
+
+    params.set("seed=2");
+    defs_ptr other = SyntheticDefs(params).create();
+    std::string third;
+    other->save_as_string(third, PrintStyle::DEFS);
+    BOOST_CHECK_MESSAGE(first != third, "Expected a different defs, for a different seed");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
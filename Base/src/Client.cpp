@@ -14,10 +14,14 @@
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
 #include "Client.hpp"
 
+#include <cerrno>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
 
+#include <sys/socket.h>
+
+#include "ClientToServerCmd.hpp"
 #include "StcCmd.hpp"
 
 #ifdef DEBUG_PERF
@@ -39,6 +43,7 @@ Client::Client(boost::asio::io_service& io_service,
                const std::string& port,
                int timeout)
     : stopped_(false),
+      io_service_(io_service),
       host_(host),
       port_(port),
       connection_(io_service),
@@ -62,26 +67,107 @@ Client::Client(boost::asio::io_service& io_service,
 
     outbound_request_.set_cmd(cmd_ptr);
 
+    start(resolve());
+}
+
+Client::Client(boost::asio::io_service& io_service,
+               const std::string& host,
+               const std::string& port,
+               int timeout)
+    : stopped_(true),
+      persistent_(true),
+      request_timeout_(timeout),
+      io_service_(io_service),
+      host_(host),
+      port_(port),
+      connection_(io_service),
+      deadline_(io_service),
+      timeout_(timeout) {
+}
+
+void Client::request(Cmd_ptr cmd_ptr) {
+    if (!cmd_ptr.get())
+        throw std::runtime_error("Client::request: No request specified !");
+
+    timeout_ = (0 == request_timeout_) ? cmd_ptr->timeout() : request_timeout_;
+    outbound_request_.set_cmd(cmd_ptr);
+    outbound_request_.set_keep_alive(server_keeps_connection(cmd_ptr));
+    inbound_response_.set_cmd(STC_Cmd_ptr());
+    stopped_ = false;
+
+    if (connection_.socket_ll().is_open() && !connection_usable()) {
+        boost::system::error_code ec;
+        connection_.socket_ll().close(ec);
+    }
+
+    reused_ = connection_.socket_ll().is_open();
+    if (reused_) {
+        start_write();
+        deadline_.async_wait([this](const boost::system::error_code&) { check_deadline(); });
+    }
+    else {
+        start(resolve());
+    }
+}
+
+Client::~Client() {
+#ifdef DEBUG_CLIENT
+    std::cout << "   Client::~Client(): connection_.socket().is_open()=" << connection_.socket().is_open() << std::endl;
+#endif
+}
+
+/// Private ==============================================================================
+
+boost::asio::ip::tcp::resolver::iterator Client::resolve() {
     // Host name resolution is performed using a resolver, where host and service
     // names(or ports) are looked up and converted into one or more end points
-    boost::asio::ip::tcp::resolver resolver(io_service);
+    boost::asio::ip::tcp::resolver resolver(io_service_);
     boost::asio::ip::tcp::resolver::query query(host_, port_);
-    boost::asio::ip::tcp::resolver::iterator endpoint_iterator = resolver.resolve(query);
 
     // The list of end points obtained could contain both IPv4 and IPv6 end points,
     // so a program may try each of them until it finds one that works.
     // This keeps the Client program independent of a specific IP version.
-    start(endpoint_iterator);
+    return resolver.resolve(query);
 }
 
-Client::~Client() {
+// The server closes the connection after replying to terminate requests, and to requests
+// that wait for changes. Hence do not ask to keep it, and close it once the reply is read.
+bool Client::server_keeps_connection(const Cmd_ptr& cmd) {
+    if (cmd->terminate_cmd())
+        return false;
+    auto* sync_cmd = dynamic_cast<CSyncCmd*>(cmd.get());
+    return !(sync_cmd && sync_cmd->api() == CSyncCmd::SYNC && sync_cmd->wait_for_change() > 0);
+}
+
+// The server closes persistent connections, that have been idle for too long. Check before
+// sending the request, since once it is sent the server may have run it, even if the reply is lost.
+bool Client::connection_usable() {
+    // Leave a margin, so that the server does not close the connection while the request is sent
+    const int server_idle_timeout = 60;
+    if (std::chrono::steady_clock::now() - last_used_ > std::chrono::seconds(server_idle_timeout / 2))
+        return false;
+
+    // The server has closed the connection (end of file), or sent something unexpected
+    char c;
+    ssize_t n = ::recv(connection_.socket_ll().native_handle(), &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+}
+
+bool Client::reconnect() {
+    // Only when the request could not be sent on a re-used connection, i.e. the server closed it
+    // meanwhile. The server can not have decoded a request that was not completely written.
+    if (!reused_)
+        return false;
+    reused_ = false;
+
 #ifdef DEBUG_CLIENT
-    std::cout << "   Client::~Client(): connection_.socket().is_open()=" << connection_.socket().is_open() << std::endl;
+    std::cout << "   Client::reconnect: re-used connection failed, reconnecting" << std::endl;
 #endif
+    boost::system::error_code ec;
+    connection_.socket_ll().close(ec);
+    return start_connect(resolve());
 }
 
-/// Private ==============================================================================
-
 // This function terminates all the actors to shut down the connection. It
 // may be called by the user of the client class, or by the class itself in
 // response to graceful termination or an unrecoverable error.
@@ -215,6 +301,8 @@ void Client::handle_write(const boost::system::error_code& e) {
         start_read();
     }
     else {
+        if (reconnect())
+            return;
 
         // An error occurred.
         stop();
@@ -248,8 +336,22 @@ void Client::handle_read(const boost::system::error_code& e) {
     if (stopped_)
         return;
 
-    // close socket, & cancel timer.
-    stop();
+    // The request is *not* sent again, when the read failed on a re-used connection. The
+    // server may already have run it, i.e. --requeue, --alter add, and reported as an error.
+    if (e && reused_ && e.value() != boost::asio::error::invalid_argument) {
+        stop();
+#ifdef DEBUG_CLIENT
+        std::cout << "   Client::handle_read: re-used connection failed( " << e.message() << " )" << std::endl;
+#endif
+        inbound_response_.set_cmd(std::make_shared<StcCmd>(StcCmd::END_OF_FILE));
+        return;
+    }
+
+    // close socket(unless persistent), & cancel timer.
+    if (!e)
+        finish();
+    else
+        stop();
 
     if (!e) {
 #ifdef DEBUG_CLIENT
@@ -313,6 +415,18 @@ void Client::stop() {
     deadline_.cancel();
 }
 
+void Client::finish() {
+    if (!persistent_ || !outbound_request_.keep_alive()) {
+        stop();
+        return;
+    }
+
+    // Keep the connection open for the next request
+    stopped_   = true;
+    last_used_ = std::chrono::steady_clock::now();
+    deadline_.cancel();
+}
+
 /// Handle completion of a write operation.
 /// Handle completion of a read operation.
 bool Client::handle_server_response(ServerReply& server_reply, bool debug) const {
@@ -19,6 +19,8 @@
 //               hence the server itself will NEED to ACT as a client.
 //               This is why client lives in Base and not the Client project
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+#include <chrono>
+
 #include <boost/asio.hpp>
 
 #include "ClientToServerRequest.hpp"
@@ -33,8 +35,17 @@ public:
            const std::string& host,
            const std::string& port,
            int timout = 0);
+
+    /// Constructor for a persistent connection. Requests are sent with request(), the connection
+    /// to the server is opened on the first request, and kept open for subsequent requests.
+    /// There is no equivalent for SslClient, SSL clients connect per request.
+    Client(boost::asio::io_service& io_service, const std::string& host, const std::string& port, int timout = 0);
     ~Client();
 
+    /// Send the request on the persistent connection, connecting first if required.
+    /// Call io_service.run() to complete the request.
+    void request(Cmd_ptr cmd_ptr);
+
     /// Client side, get the server response, handles reply from server
     /// Returns true if all is ok, else false if further client action is required
     /// will throw std::runtime_error for errors
@@ -43,6 +54,11 @@ public:
 private:
     void start(boost::asio::ip::tcp::resolver::iterator);
     void stop();
+    void finish();
+    bool reconnect();
+    bool connection_usable();
+    static bool server_keeps_connection(const Cmd_ptr&);
+    boost::asio::ip::tcp::resolver::iterator resolve();
     void check_deadline();
 
     bool start_connect(boost::asio::ip::tcp::resolver::iterator);
@@ -60,6 +76,10 @@ private:
 
 private:
     bool stopped_;
+    bool persistent_{false};                  /// keep the connection open after the reply
+    bool reused_{false};                      /// request was sent on a connection, opened for an earlier request
+    int request_timeout_{0};                  /// timeout given on construction, 0 means take from the command
+    boost::asio::io_service& io_service_;
     std::string host_;                        /// the servers name
     std::string port_;                        /// the port on the server
     connection connection_;                   /// The connection to the server.
@@ -73,5 +93,8 @@ private:
     //    receive reply  : timeout_ second
     // Default value of 0 means take the timeout from the command
     int timeout_;
+
+    // Persistent connection only, when the reply to the previous request was read
+    std::chrono::steady_clock::time_point last_used_;
 };
 #endif
@@ -41,6 +41,10 @@ public:
     bool terminateRequest() const { return (cmd_.get()) ? cmd_->terminate_cmd() : false; }
     bool groupRequest() const { return (cmd_.get()) ? cmd_->group_cmd() : false; }
 
+    /// When set, the server keeps the connection open after replying, and waits for the next request
+    void set_keep_alive(bool f) { keep_alive_ = f; }
+    bool keep_alive() const { return keep_alive_; }
+
     void cleanup() {
         if (cmd_.get())
             cmd_->cleanup();
@@ -51,11 +55,16 @@ public:
 
 private:
     Cmd_ptr cmd_;
+    bool keep_alive_{false};
 
     friend class cereal::access;
     template <class Archive>
     void serialize(Archive& ar) {
         ar(CEREAL_NVP(cmd_));
+        if (Archive::is_loading::value) {
+            keep_alive_ = false; // request is re-used by the server, old clients don't send this
+        }
+        CEREAL_OPTIONAL_NVP(ar, keep_alive_, [this]() { return keep_alive_; }); // conditionally save
     }
 };
 
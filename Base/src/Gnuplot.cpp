@@ -15,7 +15,8 @@
 
 #include "Gnuplot.hpp"
 
-#include <cassert>
+#include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
@@ -25,9 +26,7 @@
 #include <sys/stat.h> // for chmod
 
 #include "File.hpp"
-#include "File_r.hpp"
 #include "Host.hpp"
-#include "NodePath.hpp"
 #include "Str.hpp"
 
 using namespace std;
@@ -39,7 +38,7 @@ Gnuplot::Gnuplot(const std::string& log_file,
                  const std::string& host,
                  const std::string& port,
                  size_t no_of_suites_to_plot)
-    : log_file_(log_file),
+    : log_files_(1, log_file),
       host_(host),
       port_(port),
       no_of_suites_to_plot_(no_of_suites_to_plot) {
@@ -48,7 +47,84 @@ Gnuplot::Gnuplot(const std::string& log_file,
         ss << "Gnuplot::Gnuplot: The log file " << log_file << " does not exist\n";
         throw std::runtime_error(ss.str());
     }
+    check_gnuplot();
+}
+
+Gnuplot::Gnuplot(const std::vector<std::string>& args,
+                 const std::string& host,
+                 const std::string& port,
+                 size_t no_of_suites_to_plot)
+    : host_(host),
+      port_(port),
+      no_of_suites_to_plot_(no_of_suites_to_plot) {
+    for (const auto& arg : args) {
+        if (!is_option(arg)) {
+            if (!fs::exists(arg)) {
+                std::stringstream ss;
+                ss << "Gnuplot::Gnuplot: The log file " << arg << " does not exist\n";
+                throw std::runtime_error(ss.str());
+            }
+            log_files_.push_back(arg);
+            continue;
+        }
+
+        std::string::size_type eq = arg.find('=');
+        std::string key           = arg.substr(0, eq);
+        std::string value         = arg.substr(eq + 1);
+        if (key == "from" || key == "to") {
+            std::time_t t = LogLoadAggregator::iso_time(value);
+            if (t < 0) {
+                std::stringstream ss;
+                ss << "Gnuplot::Gnuplot: Expected " << key << "=YYYY-MM-DD[THH:MM[:SS]] but found " << arg;
+                throw std::runtime_error(ss.str());
+            }
+            if (key == "from")
+                from_ = t;
+            else
+                to_ = t;
+        }
+        else if (key == "resolution") {
+            if (value == "second")
+                resolution_ = LogLoadAggregator::SECOND;
+            else if (value == "minute")
+                resolution_ = LogLoadAggregator::MINUTE;
+            else
+                throw std::runtime_error("Gnuplot::Gnuplot: Expected resolution=[ second | minute ] but found " + arg);
+        }
+        else {
+            output_ = 0;
+            std::vector<std::string> outputs;
+            Str::split(value, outputs, ",");
+            for (const auto& output : outputs) {
+                if (output == "gnuplot")
+                    output_ |= GNUPLOT;
+                else if (output == "csv")
+                    output_ |= CSV;
+                else if (output == "json")
+                    output_ |= JSON;
+                else
+                    throw std::runtime_error("Gnuplot::Gnuplot: Expected output=[gnuplot,csv,json] but found " + arg);
+            }
+            if (output_ == 0)
+                throw std::runtime_error("Gnuplot::Gnuplot: Expected output=[gnuplot,csv,json] but found " + arg);
+        }
+    }
+
+    if (log_files_.empty())
+        throw std::runtime_error("Gnuplot::Gnuplot: No log files specified");
+    if (from_ != 0 && to_ != 0 && to_ <= from_)
+        throw std::runtime_error("Gnuplot::Gnuplot: Expected the time of to= to be after from=");
+
+    if (output_ & GNUPLOT)
+        check_gnuplot();
+}
+
+bool Gnuplot::is_option(const std::string& arg) {
+    return arg.find("from=") == 0 || arg.find("to=") == 0 || arg.find("resolution=") == 0 ||
+           arg.find("output=") == 0;
+}
 
+void Gnuplot::check_gnuplot() const {
     std::string path_to_gnuplot = File::which("gnuplot");
     if (path_to_gnuplot.empty()) {
         std::stringstream ss;
@@ -58,15 +134,23 @@ Gnuplot::Gnuplot(const std::string& log_file,
 }
 
 void Gnuplot::show_server_load() const {
+    /// The log files can be massive, and there can be many of them (i.e. months of rotated logs)
+    /// These are streamed in parallel, and the requests collated per second/minute
+    LogLoadAggregator load(resolution_, from_, to_);
+    load.process(log_files_);
+
+    if (output_ & CSV)
+        load.write_csv(host_.prefix_host_and_port(port_, "load.csv"));
+    if (output_ & JSON)
+        load.write_json(host_.prefix_host_and_port(port_, "load.json"));
+    if (!(output_ & GNUPLOT))
+        return;
+
     std::string gnuplot_dat_file    = host_.prefix_host_and_port(port_, "gnuplot.dat");
     std::string gnuplot_script_file = host_.prefix_host_and_port(port_, "gnuplot.script");
 
-    // The vector index is the order in which suites are found, this will be used to place the suite in the correct
-    // column
-    std::vector<SuiteLoad> suite_vec;
-    std::string gnuplot_file = create_gnuplot_file(suite_vec, gnuplot_dat_file);
-    std::string gnuplot_script =
-        create_gnuplot_script(gnuplot_file, suite_vec, no_of_suites_to_plot_, gnuplot_script_file);
+    std::string gnuplot_file   = create_gnuplot_file(load, gnuplot_dat_file);
+    std::string gnuplot_script = create_gnuplot_script(gnuplot_file, load, no_of_suites_to_plot_, gnuplot_script_file);
 
     // make the gnuplot_script file executable
     if (chmod(gnuplot_script.c_str(), 0755) != 0) {
@@ -80,29 +164,21 @@ void Gnuplot::show_server_load() const {
     ::system(execute_gnuplot.c_str());
 }
 
-std::string Gnuplot::create_gnuplot_file(std::vector<SuiteLoad>& suite_vec, const std::string& temp_file) const {
-    /// Will read the log file and create a new file that can be used as input to gnuplot
-    /// We will collate each request/cmd to the server made over a second.
+std::string Gnuplot::create_gnuplot_file(const LogLoadAggregator& load, const std::string& temp_file) const {
+    /// Create a new file that can be used as input to gnuplot, from the requests collated per second/minute
     /// There are two kinds of commands:
     ///   o User Commands: these start with --
     ///   o Child Command: these start with chd:
     /// All child commands specify a path and hence suite, whereas for user commands this is optional
-    /// We will trap all use of paths, so that we can show which suites are contributing to the server load
-    /// This will be done for 4 suites
+    /// The suites are placed in the columns in the order they were found
     ///
-    /// Will convert: FROM:
-    ///   XXX:[HH:MM:SS D.M.YYYY] chd:init [+additional information]
-    ///   XXX:[HH:MM:SS D.M.YYYY] --begin  [+additional information]
-    /// -------------: TO:
     ///    1         2         3             4              5            6        7       8         9       10
     ///  HH:MM:SS D.M.YYYY request/sec  child_request  users_requests  suite_0 suite_1  suite_2  suite_3  suite_n
+    if (load.buckets().size() < 3) {
+        throw std::runtime_error("Gnuplot::prepare_for_gnuplot: Log file empty or not enough data for plot\n");
+    }
 
-    /// The log file can be massive > 50Mb
-    File_r log_file(log_file_);
-    if (!log_file.ok())
-        throw std::runtime_error("Gnuplot::prepare_for_gnuplot: Could not open log file " + log_file_);
-
-    /// Create a new file that can be used with gnuplot. This has to be column based
+    /// This has to be column based
     std::ofstream gnuplot_file(temp_file.c_str());
     if (!gnuplot_file) {
         throw std::runtime_error("Gnuplot::prepare_for_gnuplot: Could not open output file: " + temp_file);
@@ -110,140 +186,25 @@ std::string Gnuplot::create_gnuplot_file(std::vector<SuiteLoad>& suite_vec, cons
 
     gnuplot_file << "#time    date     total-request child user suite_0  suite_1 suite_2  suite_3  suite_n\n";
 
-    std::vector<std::string> new_time_stamp;
-    std::vector<std::string> old_time_stamp;
-    size_t child_requests_per_second   = 0;
-    size_t user_request_per_second     = 0;
-    unsigned int plot_data_line_number = 0;
-    string line;
-    while (log_file.good()) {
-        log_file.getline(line); // default delimiter is /n
-
-        // The log file format we are interested is :
-        // 0             1         2            3
-        // MSG:[HH:MM:SS D.M.YYYY] chd:fullname [path +additional information]
-        // MSG:[HH:MM:SS D.M.YYYY] --begin      [args | path(optional) ]    :<user>
-
-        /// We are only interested in Commands (i.e MSG:), and not state changes
-        if (line.empty())
-            continue;
-        if (line[0] != 'M')
-            continue;
-        std::string::size_type msg_pos = line.find("MSG:");
-        if (msg_pos != 0)
-            continue;
-
-        bool child_cmd = false;
-        bool user_cmd  = false;
-        if (line.find(Str::CHILD_CMD()) != std::string::npos)
-            child_cmd = true;
-        else if (line.find(Str::USER_CMD()) != std::string::npos)
-            user_cmd = true;
-        if (!child_cmd && !user_cmd)
-            continue;
-
-        new_time_stamp.clear();
-        {
-            /// MSG:[HH:MM:SS D.M.YYYY] chd:fullname [+additional information] ---> HH:MM:SS D.M.YYYY
-            /// EXTRACT the date
-            string::size_type first_open_bracket = line.find('[');
-            if (first_open_bracket == std::string::npos) {
-                std::cout << line << "\n";
-                assert(false);
-                continue;
-            }
-            line.erase(0, first_open_bracket + 1);
-
-            string::size_type first_closed_bracket = line.find(']');
-            if (first_closed_bracket == std::string::npos) {
-                std::cout << line << "\n";
-                assert(false);
-                continue;
-            }
-            std::string time_stamp = line.substr(0, first_closed_bracket);
-
-            Str::split(time_stamp, new_time_stamp);
-            if (new_time_stamp.size() != 2)
-                continue;
-
-            line.erase(0, first_closed_bracket + 1);
-        }
-
-        // Should be just left with " chd:<child command> " or " --<user command>, since we have remove time stamp
-        // #ifdef DEBUG
-        //       std::cout << line << "\n";
-        // #endif
-
-        if (old_time_stamp.empty()) {
-            if (child_cmd)
-                child_requests_per_second++;
-            else
-                user_request_per_second++;
-
-            // Extract path if any, to determine the suite most contributing to server load
-            size_t column_index   = 0;
-            bool suite_path_found = extract_suite_path(line, child_cmd, suite_vec, column_index);
-            if (suite_path_found)
-                assert(suite_vec[column_index].request_per_second_ <=
-                       (child_requests_per_second + user_request_per_second));
+    std::vector<size_t> suite_requests(load.suites().size(), 0);
+    for (const auto& entry : load.buckets()) {
+        const LogLoadAggregator::Bucket& bucket = entry.second;
+        std::fill(suite_requests.begin(), suite_requests.end(), 0);
+        for (const auto& s : bucket.suites_)
+            suite_requests[s.first] = s.second;
+
+        gnuplot_file << LogLoadAggregator::to_log_time(entry.first) << " " << bucket.total() << " " << bucket.child_
+                     << " " << bucket.user_ << " ";
+        for (size_t requests : suite_requests) {
+            gnuplot_file << requests << " ";
         }
-        else if (old_time_stamp[0] == new_time_stamp[0]) { // HH:MM:SS == HH:MM:SS
-            if (child_cmd)
-                child_requests_per_second++;
-            else
-                user_request_per_second++;
-
-            size_t column_index   = 0;
-            bool suite_path_found = extract_suite_path(line, child_cmd, suite_vec, column_index);
-            if (suite_path_found)
-                assert(suite_vec[column_index].request_per_second_ <=
-                       (child_requests_per_second + user_request_per_second));
-        }
-        else {
-            /// Start of *NEW* time,
-            /// write the *OLD* time line should contain time date without []
-            ///    1         2         3             4              5            6        7      8       9       10
-            ///  HH:MM:SS D.M.YYYY total_request child_request  users_requests suite_0 suite_1 suite_2 suite_3 suite_n
-            plot_data_line_number++;
-            gnuplot_file << old_time_stamp[0] << " " << old_time_stamp[1] << " "
-                         << (child_requests_per_second + user_request_per_second) << " " << child_requests_per_second
-                         << " " << user_request_per_second << " ";
-            for (auto& i : suite_vec) {
-                gnuplot_file << i.request_per_second_ << " ";
-            }
-            gnuplot_file << "\n";
-
-            // clear request per second
-            child_requests_per_second = 0;
-            user_request_per_second   = 0;
-            for (auto& i : suite_vec) {
-                i.request_per_second_ = 0;
-            }
-
-            // start of *new* time
-            if (child_cmd)
-                child_requests_per_second++;
-            else
-                user_request_per_second++;
-
-            size_t column_index   = 0;
-            bool suite_path_found = extract_suite_path(line, child_cmd, suite_vec, column_index);
-            if (suite_path_found)
-                assert(suite_vec[column_index].request_per_second_ <=
-                       (child_requests_per_second + user_request_per_second));
-        }
-
-        old_time_stamp = new_time_stamp;
-    }
-
-    if (plot_data_line_number < 3) {
-        throw std::runtime_error("Gnuplot::prepare_for_gnuplot: Log file empty or not enough data for plot\n");
+        gnuplot_file << "\n";
     }
     return temp_file;
 }
 
 std::string Gnuplot::create_gnuplot_script(const std::string& path_to_file,
-                                           const std::vector<SuiteLoad>& suite_vec,
+                                           const LogLoadAggregator& load,
                                            size_t no_of_suites_to_plot,
                                            const std::string& script) const {
     /// Create the gnuplot script file for rendering the graph
@@ -260,7 +221,10 @@ std::string Gnuplot::create_gnuplot_script(const std::string& path_to_file,
     gnuplot_script << "set ytic auto                          # set ytics automatically\n";
     //   gnuplot_script << "set origin 0,0.08                      # offset y, so that rotated xtics don't truncate,
     //   However cause title to disappear\n";
-    gnuplot_script << "set title \"Server request per second\"\n";
+    if (load.resolution() == LogLoadAggregator::MINUTE)
+        gnuplot_script << "set title \"Server request per minute\"\n";
+    else
+        gnuplot_script << "set title \"Server request per second\"\n";
     gnuplot_script << "set x2label \"time/min\" textcolor lt 3\n";
     gnuplot_script << "set ylabel \"requests\"\n";
     gnuplot_script << "set xdata time\n";
@@ -279,36 +243,21 @@ std::string Gnuplot::create_gnuplot_script(const std::string& path_to_file,
     ///    1         2         3             4              5            6        7       8         9       n
     ///  HH:MM:SS D.M.YYYY total_request child_request  users_requests suite_0 suite_1  suite_2  suite_3  suite_n
 
-    // determine which suite columns to plot based on server load
-    std::vector<SuiteLoad> suite_vec_copy = suite_vec;
-
-    //   cout << "sort vector according to load\n";
-    std::sort(suite_vec_copy.begin(), suite_vec_copy.end(), [](const SuiteLoad& a, const SuiteLoad& b) {
-        return a.total_request_per_second_ > b.total_request_per_second_;
-    });
-    //   for(size_t i = 0; i < suite_vec_copy.size(); i++) {
-    //      cout << " " << suite_vec_copy[i].first << " " << suite_vec_copy[i].second << "\n";
-    //   }
-
-    //   cout << "get top loaded suites\n";
-    std::vector<std::string> suites;
-    for (size_t i = 0; i < suite_vec_copy.size() && i < no_of_suites_to_plot; i++) {
-        suites.push_back(suite_vec_copy[i].suite_name_);
-    }
-    //   std::copy(suites.begin(), suites.end(), std::ostream_iterator <std::string> (std::cout, "\n"));
-
-    //   cout << "now determine which columns the top suites belong to, **THIS** time <int> indicates column\n";
+    // determine which suite columns to plot based on server load, the column is the index of the suite
     std::vector<std::pair<std::string, int>> ordered_suites;
-    for (size_t column = 0; column < suite_vec.size(); column++) {
-        for (auto& suite : suites) {
-            if (suite == suite_vec[column].suite_name_) {
-                ordered_suites.emplace_back(suite, column);
-            }
-        }
+    {
+        std::vector<size_t> columns(load.suites().size());
+        for (size_t i = 0; i < columns.size(); i++)
+            columns[i] = i;
+        std::stable_sort(columns.begin(), columns.end(), [&load](size_t a, size_t b) {
+            return load.suite_totals()[a] > load.suite_totals()[b];
+        });
+        if (columns.size() > no_of_suites_to_plot)
+            columns.resize(no_of_suites_to_plot);
+        std::sort(columns.begin(), columns.end());
+        for (size_t column : columns)
+            ordered_suites.emplace_back(load.suites()[column], column);
     }
-    //   for(size_t i = 0; i < ordered_suites.size(); i++) {
-    //      cout << " " << ordered_suites[i].first << " " << ordered_suites[i].second << "\n";
-    //   }
 
     gnuplot_script << "plot \"" << path_to_file << R"(" using 1:4 title "child" with lines, ")" << path_to_file
                    << R"(" using 1:5 title "user" with lines, ")" << path_to_file
@@ -331,71 +280,4 @@ std::string Gnuplot::create_gnuplot_script(const std::string& path_to_file,
     return script;
 }
 
-bool Gnuplot::extract_suite_path(const std::string& line,
-                                 bool child_cmd,
-                                 std::vector<SuiteLoad>& suite_vec,
-                                 size_t& column_index // 0 based
-) {
-    // line should either
-    //  chd:<childcommand> path
-    //  --<user command)   path<optional> :<user>
-    size_t forward_slash = line.find('/');
-    if (forward_slash != std::string::npos) {
-
-        std::string path;
-        if (child_cmd) {
-
-            // For labels ignore paths in the label part
-            // MSG:[14:55:04 17.10.2013] chd:label progress 'core/nodeattr/nodeAParser'
-            // /suite/build/cray/cray_gnu/build_release/test
-            if (line.find("chd:label") != std::string::npos) {
-                size_t last_tick = line.rfind("'");
-                if (last_tick != std::string::npos) {
-                    size_t the_forward_slash = line.find('/', last_tick);
-                    if (the_forward_slash != std::string::npos) {
-                        forward_slash = the_forward_slash;
-                    }
-                }
-            }
-            path = line.substr(forward_slash);
-        }
-        else {
-            // Ignore the --news command, they dont have a path, hence i.e to ignore line like:
-            //  MSG:[09:36:05 22.10.2013] --news=1 36506 6  :ma0 [server handle(36508,7) server(36508,7)
-            //                     : *Large* scale changes (new handle or suites added/removed) :NEWS]
-            //   the /removed was being interpreted as a suite
-            if (line.find("--news") != std::string::npos)
-                return false;
-        }
-
-        // find the space after the path
-        size_t space_pos = line.find(" ", forward_slash);
-        if (space_pos != std::string::npos && space_pos > forward_slash) {
-            path = line.substr(forward_slash, space_pos - forward_slash);
-        }
-
-        if (!path.empty()) {
-
-            std::vector<std::string> theNodeNames;
-            theNodeNames.reserve(4);
-            NodePath::split(path, theNodeNames);
-            if (!theNodeNames.empty()) {
-                for (size_t n = 0; n < suite_vec.size(); n++) {
-                    if (suite_vec[n].suite_name_ == theNodeNames[0]) {
-                        suite_vec[n].request_per_second_++;
-                        suite_vec[n].total_request_per_second_++;
-                        column_index = n;
-                        return true;
-                    }
-                }
-
-                suite_vec.emplace_back(theNodeNames[0]);
-                column_index = suite_vec.size() - 1;
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
 } // namespace ecf
@@ -15,12 +15,14 @@
 // Description :
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
 
+#include <ctime>
 #include <string>
 #include <vector>
 
 #include <boost/core/noncopyable.hpp>
 
 #include "Host.hpp"
+#include "LogLoadAggregator.hpp"
 
 namespace ecf {
 
@@ -31,48 +33,54 @@ public:
             const std::string& port,
             size_t no_of_suites_to_plot = 5);
 
-    /// parse the log file and show gnuplot of server load
+    /// args are one or more log files (which may be compressed), optionally followed by:
+    ///    from=YYYY-MM-DD[THH:MM[:SS]]   only count the requests from this time
+    ///    to=YYYY-MM-DD[THH:MM[:SS]]     only count the requests before this time
+    ///    resolution=[ second | minute ] default is second
+    ///    output=gnuplot,csv,json        default is gnuplot
+    /// Will throw std::runtime_error for unrecognised options, or missing files
+    Gnuplot(const std::vector<std::string>& args,
+            const std::string& host,
+            const std::string& port,
+            size_t no_of_suites_to_plot = 5);
+
+    /// parse the log files and show gnuplot of server load
     /// Include the suite most contributing to the load
-    /// generates two files
+    /// generates the files, depending on the output:
     ///    o <host>.<port>.gnuplot.dat
     ///    o <host>.<port>.gnuplot.script
+    ///    o <host>.<port>.load.csv
+    ///    o <host>.<port>.load.json
     void show_server_load() const;
 
+    /// Return true if arg is one of the options above, rather than a log file
+    static bool is_option(const std::string& arg);
+
 private:
-    std::string log_file_;
+    enum Output { GNUPLOT = 1, CSV = 2, JSON = 4 };
+
+    std::vector<std::string> log_files_;
     Host host_;
     std::string port_;
     size_t no_of_suites_to_plot_;
+    LogLoadAggregator::Resolution resolution_{LogLoadAggregator::SECOND};
+    std::time_t from_{0};
+    std::time_t to_{0};
+    int output_{GNUPLOT};
 
 private:
-    struct SuiteLoad
-    {
-        explicit SuiteLoad(const std::string& name)
-            : suite_name_(name),
-              request_per_second_(1),
-              total_request_per_second_(1) {}
-
-        std::string suite_name_;
-        size_t request_per_second_;
-        size_t total_request_per_second_;
-    };
+    void check_gnuplot() const;
 
     /// Returns that path to file created by this function.
     /// The create file is to be used by gnuplot to show the server load.
     ///  Can throw exceptions
-    std::string create_gnuplot_file(std::vector<SuiteLoad>& suite_vec, const std::string& input_data) const;
+    std::string create_gnuplot_file(const LogLoadAggregator& load, const std::string& input_data) const;
 
     /// returns the path to the gnuplot script
     std::string create_gnuplot_script(const std::string& path_to_file,
-                                      const std::vector<SuiteLoad>& suite_vec,
+                                      const LogLoadAggregator& load,
                                       size_t no_of_suites_to_plot,
                                       const std::string& script) const;
-
-    static bool extract_suite_path(const std::string& line,
-                                   bool child_cmd,
-                                   std::vector<SuiteLoad>& suite_vec,
-                                   size_t& column_index // 0 based
-    );
 };
 } // namespace ecf
 
@@ -0,0 +1,547 @@
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#include "LogLoadAggregator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+
+#include "NodePath.hpp"
+#include "Str.hpp"
+
+using namespace std;
+namespace fs = boost::filesystem;
+
+namespace ecf {
+
+namespace {
+
+// Reads a log file a line at a time, compressed files are read from the pipe of the
+// decompression program
+class LogReader {
+public:
+    explicit LogReader(const std::string& path) : path_(path) {
+        std::string ext        = fs::path(path).extension().string();
+        const char* decompress = nullptr;
+        if (ext == ".gz" || ext == ".Z")
+            decompress = "gzip -dc ";
+        else if (ext == ".bz2")
+            decompress = "bzip2 -dc ";
+        else if (ext == ".xz")
+            decompress = "xz -dc ";
+        else if (ext == ".zst")
+            decompress = "zstd -dc ";
+
+        if (decompress) {
+            // quote the path for the shell
+            std::string cmd = decompress;
+            cmd += "'";
+            for (char c : path) {
+                if (c == '\'')
+                    cmd += "'\\''";
+                else
+                    cmd += c;
+            }
+            cmd += "' 2>/dev/null";
+            fp_   = ::popen(cmd.c_str(), "r");
+            pipe_ = true;
+        }
+        else {
+            fp_ = ::fopen(path.c_str(), "r");
+        }
+        if (!fp_)
+            throw std::runtime_error("LogLoadAggregator: Could not open log file " + path);
+    }
+
+    ~LogReader() {
+        ::free(buf_);
+        if (fp_) {
+            if (pipe_)
+                ::pclose(fp_);
+            else
+                ::fclose(fp_);
+        }
+    }
+
+    LogReader(const LogReader&)            = delete;
+    LogReader& operator=(const LogReader&) = delete;
+
+    // Returns false at the end of the file. The new line is removed
+    bool getline(const char*& line, size_t& len) {
+        ssize_t n = ::getline(&buf_, &cap_, fp_);
+        if (n < 0)
+            return false;
+        if (n > 0 && buf_[n - 1] == '\n')
+            n--;
+        line = buf_;
+        len  = static_cast<size_t>(n);
+        return true;
+    }
+
+    // Will throw if the decompression failed, i.e. program not found or corrupt file
+    void close() {
+        if (pipe_) {
+            int status = ::pclose(fp_);
+            fp_        = nullptr;
+            if (status != 0)
+                throw std::runtime_error("LogLoadAggregator: Could not decompress log file " + path_ +
+                                         ", check the file and that the decompression program is on $PATH");
+        }
+    }
+
+private:
+    std::string path_;
+    FILE* fp_{nullptr};
+    bool pipe_{false};
+    char* buf_{nullptr};
+    size_t cap_{0};
+};
+
+// Howard Hinnant's algorithms, days since 1970-01-01 in the proleptic Gregorian calendar
+long days_from_civil(long y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const long era     = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<long>(doe) - 719468;
+}
+
+void civil_from_days(long z, long& y, unsigned& m, unsigned& d) {
+    z += 719468;
+    const long era     = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp  = (5 * doy + 2) / 153;
+    d                  = doy - (153 * mp + 2) / 5 + 1;
+    m                  = mp < 10 ? mp + 3 : mp - 9;
+    y                  = static_cast<long>(yoe) + era * 400 + (m <= 2);
+}
+
+// Parse an unsigned number from str[pos], followed by sep (or the end when sep is 0)
+bool parse_number(const char* str, size_t len, size_t& pos, char sep, long& value) {
+    size_t start = pos;
+    value        = 0;
+    while (pos < len && str[pos] >= '0' && str[pos] <= '9')
+        value = value * 10 + (str[pos++] - '0');
+    if (pos == start)
+        return false;
+    if (sep == 0)
+        return pos == len;
+    if (pos >= len || str[pos] != sep)
+        return false;
+    pos++;
+    return true;
+}
+
+std::time_t make_time(long year, long month, long day, long hour, long min, long sec) {
+    if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || min > 59 || sec > 60)
+        return -1;
+    return static_cast<std::time_t>(days_from_civil(year, month, day) * 86400 + hour * 3600 + min * 60 + sec);
+}
+
+void add_count(std::vector<std::pair<size_t, size_t>>& counts, size_t index, size_t requests) {
+    for (auto& c : counts) {
+        if (c.first == index) {
+            c.second += requests;
+            return;
+        }
+    }
+    counts.emplace_back(index, requests);
+}
+
+size_t index_of(std::unordered_map<std::string, size_t>& index,
+                std::vector<std::string>& names,
+                const std::string& name) {
+    auto it = index.find(name);
+    if (it != index.end())
+        return it->second;
+    index.emplace(name, names.size());
+    names.push_back(name);
+    return names.size() - 1;
+}
+
+std::string json_escape(const std::string& str) {
+    std::string ret;
+    ret.reserve(str.size());
+    for (char c : str) {
+        if (c == '"' || c == '\\')
+            ret += '\\';
+        ret += c;
+    }
+    return ret;
+}
+
+} // namespace
+
+// The counts of a single file, the indexes are local to the file
+struct LogLoadAggregator::Result
+{
+    Buckets buckets_;
+    std::vector<std::string> commands_;
+    std::vector<std::string> suites_;
+    std::exception_ptr error_;
+};
+
+LogLoadAggregator::LogLoadAggregator(Resolution resolution, std::time_t from, std::time_t to)
+    : resolution_(resolution),
+      from_(from),
+      to_(to) {
+}
+
+void LogLoadAggregator::process(const std::vector<std::string>& log_files, size_t max_threads) {
+    for (const auto& file : log_files) {
+        if (!fs::exists(file))
+            throw std::runtime_error("LogLoadAggregator: The log file " + file + " does not exist");
+    }
+
+    if (max_threads == 0)
+        max_threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t no_of_threads = std::min(max_threads, log_files.size());
+
+    std::vector<Result> results(log_files.size());
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < log_files.size(); i = next++) {
+            try {
+                process_file(log_files[i], results[i]);
+            }
+            catch (...) {
+                results[i].error_ = std::current_exception();
+            }
+        }
+    };
+
+    if (no_of_threads <= 1)
+        worker();
+    else {
+        std::vector<std::thread> threads;
+        threads.reserve(no_of_threads);
+        for (size_t t = 0; t < no_of_threads; t++)
+            threads.emplace_back(worker);
+        for (auto& t : threads)
+            t.join();
+    }
+
+    for (auto& result : results) {
+        if (result.error_)
+            std::rethrow_exception(result.error_);
+    }
+
+    // merge in the order of the files, so the suites/commands are ordered as found
+    for (size_t i = 0; i < results.size(); i++) {
+        merge(results[i]);
+        files_.push_back(log_files[i]);
+    }
+}
+
+void LogLoadAggregator::process_file(const std::string& log_file, Result& result) const {
+    // The log file format we are interested is :
+    // MSG:[HH:MM:SS D.M.YYYY] chd:fullname [path +additional information]
+    // MSG:[HH:MM:SS D.M.YYYY] --begin      [args | path(optional) ]    :<user>
+    LogReader reader(log_file);
+    std::unordered_map<std::string, size_t> command_index, suite_index;
+
+    std::string prev_time_stamp;
+    std::time_t prev_time = -1;
+    std::string command;
+    const char* line = nullptr;
+    size_t len       = 0;
+    while (reader.getline(line, len)) {
+
+        /// We are only interested in Commands (i.e MSG:), and not state changes
+        if (len < 6 || std::strncmp(line, "MSG:[", 5) != 0)
+            continue;
+        const char* close = static_cast<const char*>(std::memchr(line + 5, ']', len - 5));
+        if (!close)
+            continue;
+
+        // Most consecutive lines are logged in the same second
+        size_t time_stamp_len = close - (line + 5);
+        if (prev_time_stamp.size() != time_stamp_len ||
+            std::memcmp(prev_time_stamp.data(), line + 5, time_stamp_len) != 0) {
+            prev_time_stamp.assign(line + 5, time_stamp_len);
+            prev_time = log_time(line + 5, time_stamp_len);
+        }
+        if (prev_time < 0)
+            continue;
+        if ((from_ != 0 && prev_time < from_) || (to_ != 0 && prev_time >= to_))
+            continue;
+
+        command.assign(close + 1, len - (close + 1 - line));
+        bool child_cmd = false;
+        if (command.find(Str::CHILD_CMD()) != std::string::npos)
+            child_cmd = true;
+        else if (command.find(Str::USER_CMD()) == std::string::npos)
+            continue;
+
+        Bucket& bucket = result.buckets_[prev_time - prev_time % resolution_];
+        if (child_cmd)
+            bucket.child_++;
+        else
+            bucket.user_++;
+
+        std::string name = command_name(command, child_cmd);
+        if (!name.empty())
+            add_count(bucket.commands_, index_of(command_index, result.commands_, name), 1);
+
+        std::string suite = suite_name(command, child_cmd);
+        if (!suite.empty())
+            add_count(bucket.suites_, index_of(suite_index, result.suites_, suite), 1);
+    }
+    reader.close();
+}
+
+void LogLoadAggregator::merge(Result& result) {
+    std::unordered_map<std::string, size_t> command_index, suite_index;
+    for (size_t i = 0; i < commands_.size(); i++)
+        command_index.emplace(commands_[i], i);
+    for (size_t i = 0; i < suites_.size(); i++)
+        suite_index.emplace(suites_[i], i);
+
+    std::vector<size_t> command_map, suite_map;
+    for (const auto& name : result.commands_)
+        command_map.push_back(index_of(command_index, commands_, name));
+    for (const auto& name : result.suites_)
+        suite_map.push_back(index_of(suite_index, suites_, name));
+    command_totals_.resize(commands_.size(), 0);
+    suite_totals_.resize(suites_.size(), 0);
+
+    for (auto& entry : result.buckets_) {
+        const Bucket& from = entry.second;
+        Bucket& to         = buckets_[entry.first];
+        to.child_ += from.child_;
+        to.user_ += from.user_;
+        child_ += from.child_;
+        user_ += from.user_;
+        for (const auto& c : from.commands_) {
+            add_count(to.commands_, command_map[c.first], c.second);
+            command_totals_[command_map[c.first]] += c.second;
+        }
+        for (const auto& s : from.suites_) {
+            add_count(to.suites_, suite_map[s.first], s.second);
+            suite_totals_[suite_map[s.first]] += s.second;
+        }
+    }
+    result.buckets_.clear();
+}
+
+void LogLoadAggregator::write_csv(const std::string& path) const {
+    std::ofstream csv(path.c_str());
+    if (!csv)
+        throw std::runtime_error("LogLoadAggregator::write_csv: Could not open output file: " + path);
+
+    csv << "time,type,name,requests\n";
+    for (const auto& entry : buckets_) {
+        std::string time = to_iso(entry.first);
+        const Bucket& b  = entry.second;
+        csv << time << ",total,," << b.total() << "\n";
+        if (b.child_)
+            csv << time << ",child,," << b.child_ << "\n";
+        if (b.user_)
+            csv << time << ",user,," << b.user_ << "\n";
+        for (const auto& c : b.commands_)
+            csv << time << ",command," << commands_[c.first] << "," << c.second << "\n";
+        for (const auto& s : b.suites_)
+            csv << time << ",suite," << suites_[s.first] << "," << s.second << "\n";
+    }
+    if (!csv)
+        throw std::runtime_error("LogLoadAggregator::write_csv: Could not write output file: " + path);
+}
+
+void LogLoadAggregator::write_json(const std::string& path) const {
+    std::ofstream json(path.c_str());
+    if (!json)
+        throw std::runtime_error("LogLoadAggregator::write_json: Could not open output file: " + path);
+
+    auto write_counts = [&](const std::vector<std::pair<size_t, size_t>>& counts,
+                            const std::vector<std::string>& names) {
+        json << "{";
+        for (size_t i = 0; i < counts.size(); i++) {
+            json << (i == 0 ? "" : ",") << "\"" << json_escape(names[counts[i].first]) << "\":" << counts[i].second;
+        }
+        json << "}";
+    };
+    auto write_totals = [&](const std::vector<size_t>& totals, const std::vector<std::string>& names) {
+        json << "{";
+        for (size_t i = 0; i < totals.size(); i++) {
+            json << (i == 0 ? "" : ",") << "\"" << json_escape(names[i]) << "\":" << totals[i];
+        }
+        json << "}";
+    };
+
+    json << "{\n\"resolution\":" << static_cast<int>(resolution_) << ",\n";
+    json << "\"from\":" << (from_ ? "\"" + to_iso(from_) + "\"" : std::string("null")) << ",\n";
+    json << "\"to\":" << (to_ ? "\"" + to_iso(to_) + "\"" : std::string("null")) << ",\n";
+    json << "\"files\":[";
+    for (size_t i = 0; i < files_.size(); i++)
+        json << (i == 0 ? "" : ",") << "\"" << json_escape(files_[i]) << "\"";
+    json << "],\n";
+    json << "\"requests\":" << child_ + user_ << ",\"child\":" << child_ << ",\"user\":" << user_ << ",\n";
+    json << "\"commands\":";
+    write_totals(command_totals_, commands_);
+    json << ",\n\"suites\":";
+    write_totals(suite_totals_, suites_);
+    json << ",\n\"series\":[";
+    bool first = true;
+    for (const auto& entry : buckets_) {
+        const Bucket& b = entry.second;
+        json << (first ? "\n" : ",\n") << "{\"time\":\"" << to_iso(entry.first) << "\",\"child\":" << b.child_
+             << ",\"user\":" << b.user_ << ",\"commands\":";
+        write_counts(b.commands_, commands_);
+        json << ",\"suites\":";
+        write_counts(b.suites_, suites_);
+        json << "}";
+        first = false;
+    }
+    json << "\n]\n}\n";
+    if (!json)
+        throw std::runtime_error("LogLoadAggregator::write_json: Could not write output file: " + path);
+}
+
+std::time_t LogLoadAggregator::log_time(const char* str, size_t len) {
+    // HH:MM:SS D.M.YYYY
+    size_t pos = 0;
+    long hour, min, sec, day, month, year;
+    if (!parse_number(str, len, pos, ':', hour) || !parse_number(str, len, pos, ':', min) ||
+        !parse_number(str, len, pos, ' ', sec) || !parse_number(str, len, pos, '.', day) ||
+        !parse_number(str, len, pos, '.', month) || !parse_number(str, len, pos, 0, year))
+        return -1;
+    return make_time(year, month, day, hour, min, sec);
+}
+
+std::time_t LogLoadAggregator::iso_time(const std::string& iso) {
+    // YYYY-MM-DD[THH:MM[:SS]]
+    const char* str = iso.c_str();
+    size_t len      = iso.size();
+    size_t pos      = 0;
+    long year, month, day, hour = 0, min = 0, sec = 0;
+    if (!parse_number(str, len, pos, '-', year) || !parse_number(str, len, pos, '-', month))
+        return -1;
+    std::string::size_type time_sep = iso.find_first_of("T ", pos);
+    if (time_sep != std::string::npos) {
+        if (!parse_number(str, len, pos, iso[time_sep], day) || !parse_number(str, len, pos, ':', hour))
+            return -1;
+        if (iso.find(':', pos) != std::string::npos) {
+            if (!parse_number(str, len, pos, ':', min) || !parse_number(str, len, pos, 0, sec))
+                return -1;
+        }
+        else if (!parse_number(str, len, pos, 0, min))
+            return -1;
+    }
+    else if (!parse_number(str, len, pos, 0, day))
+        return -1;
+    return make_time(year, month, day, hour, min, sec);
+}
+
+std::string LogLoadAggregator::to_iso(std::time_t t) {
+    long y;
+    unsigned m, d;
+    long days = static_cast<long>(t / 86400);
+    long secs = static_cast<long>(t % 86400);
+    civil_from_days(days, y, m, d);
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%04ld-%02u-%02uT%02ld:%02ld:%02ld", y, m, d, secs / 3600, (secs / 60) % 60, secs % 60);
+    return buf;
+}
+
+std::string LogLoadAggregator::to_log_time(std::time_t t) {
+    long y;
+    unsigned m, d;
+    long days = static_cast<long>(t / 86400);
+    long secs = static_cast<long>(t % 86400);
+    civil_from_days(days, y, m, d);
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%02ld:%02ld:%02ld %u.%u.%ld", secs / 3600, (secs / 60) % 60, secs % 60, d, m, y);
+    return buf;
+}
+
+std::string LogLoadAggregator::command_name(const std::string& command, bool child_cmd) {
+    // " chd:init /s/f/t ..." or " --alter change ..." or " --news=4 ..."
+    std::string::size_type start = command.find(child_cmd ? Str::CHILD_CMD() : Str::USER_CMD());
+    if (start == std::string::npos)
+        return std::string();
+    start += child_cmd ? 4 : 2;
+    std::string::size_type end = command.find_first_of(" =;:", start);
+    if (end == std::string::npos)
+        end = command.size();
+    return command.substr(start, end - start);
+}
+
+std::string LogLoadAggregator::suite_name(const std::string& line, bool child_cmd) {
+    // line should either
+    //  chd:<childcommand> path
+    //  --<user command)   path<optional> :<user>
+    size_t forward_slash = line.find('/');
+    if (forward_slash == std::string::npos)
+        return std::string();
+
+    std::string path;
+    if (child_cmd) {
+        // For labels ignore paths in the label part
+        // MSG:[14:55:04 17.10.2013] chd:label progress 'core/nodeattr/nodeAParser'
+        // /suite/build/cray/cray_gnu/build_release/test
+        if (line.find("chd:label") != std::string::npos) {
+            size_t last_tick = line.rfind("'");
+            if (last_tick != std::string::npos) {
+                size_t the_forward_slash = line.find('/', last_tick);
+                if (the_forward_slash != std::string::npos) {
+                    forward_slash = the_forward_slash;
+                }
+            }
+        }
+        path = line.substr(forward_slash);
+    }
+    else {
+        // Ignore the --news command, they dont have a path, hence i.e to ignore line like:
+        //  MSG:[09:36:05 22.10.2013] --news=1 36506 6  :ma0 [server handle(36508,7) server(36508,7)
+        //                     : *Large* scale changes (new handle or suites added/removed) :NEWS]
+        //   the /removed was being interpreted as a suite
+        if (line.find("--news") != std::string::npos)
+            return std::string();
+    }
+
+    // find the space after the path
+    size_t space_pos = line.find(' ', forward_slash);
+    if (space_pos != std::string::npos && space_pos > forward_slash) {
+        path = line.substr(forward_slash, space_pos - forward_slash);
+    }
+    // commands in a group are separated by ';' i.e. --alter change variable X y /s2; --sync=0 1 2
+    if (!path.empty() && path.back() == ';')
+        path.pop_back();
+    if (path.empty())
+        return std::string();
+
+    std::vector<std::string> theNodeNames;
+    theNodeNames.reserve(4);
+    NodePath::split(path, theNodeNames);
+    if (theNodeNames.empty())
+        return std::string();
+    return theNodeNames[0];
+}
+
+} // namespace ecf
@@ -0,0 +1,109 @@
+#ifndef LOG_LOAD_AGGREGATOR_HPP_
+#define LOG_LOAD_AGGREGATOR_HPP_
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description : Counts the requests in one or more server log files, per second
+//               or per minute, per command and per suite.
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#include <ctime>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/core/noncopyable.hpp>
+
+namespace ecf {
+
+/// The log files are streamed a line at a time, hence months of rotated logs can be
+/// processed without holding them in memory. Each file is read by its own thread, and
+/// the results merged at the end. Compressed files (.gz, .Z, .bz2, .xz, .zst) are read
+/// through the matching decompression program, which must be on $PATH.
+///
+/// The log time stamps have no time zone, hence all times, including from/to, are
+/// treated as UTC. Only the commands (MSG: lines) are counted, one request per line.
+class LogLoadAggregator : private boost::noncopyable {
+public:
+    enum Resolution { SECOND = 1, MINUTE = 60 };
+
+    /// The requests in one second/minute. The command and suite counts are sparse,
+    /// (index into commands()/suites(), requests)
+    struct Bucket
+    {
+        size_t child_{0};
+        size_t user_{0};
+        std::vector<std::pair<size_t, size_t>> commands_;
+        std::vector<std::pair<size_t, size_t>> suites_;
+
+        size_t total() const { return child_ + user_; }
+    };
+    using Buckets = std::map<std::time_t, Bucket>;
+
+    /// Only the requests in [from,to) are counted, 0 means no limit
+    explicit LogLoadAggregator(Resolution resolution = SECOND, std::time_t from = 0, std::time_t to = 0);
+
+    /// Process the log files, using up to max_threads (0 means the number of cores).
+    /// Can be called more than once, the counts are added.
+    /// Will throw std::runtime_error if a file can not be read
+    void process(const std::vector<std::string>& log_files, size_t max_threads = 0);
+
+    Resolution resolution() const { return resolution_; }
+    const Buckets& buckets() const { return buckets_; }
+    const std::vector<std::string>& commands() const { return commands_; }
+    const std::vector<std::string>& suites() const { return suites_; }
+    const std::vector<size_t>& command_totals() const { return command_totals_; }
+    const std::vector<size_t>& suite_totals() const { return suite_totals_; }
+    size_t child_requests() const { return child_; }
+    size_t user_requests() const { return user_; }
+
+    /// One line per count: time,type,name,requests where type is one of
+    /// [ total | child | user | command | suite ]. Zero counts are not written.
+    /// Will throw std::runtime_error if the file can not be created
+    void write_csv(const std::string& path) const;
+    void write_json(const std::string& path) const;
+
+    /// "HH:MM:SS D.M.YYYY" as found in the log file, returns -1 if the format is not recognised
+    static std::time_t log_time(const char* str, size_t len);
+    /// YYYY-MM-DD[THH:MM[:SS]], returns -1 if the format is not recognised
+    static std::time_t iso_time(const std::string& str);
+    static std::string to_iso(std::time_t);
+    static std::string to_log_time(std::time_t); // HH:MM:SS D.M.YYYY, as expected by gnuplot script
+
+    /// Return the suite, from the path in the command, or an empty string
+    static std::string suite_name(const std::string& command, bool child_cmd);
+    /// Return the command name, i.e init, complete for child commands, alter, news for user commands
+    static std::string command_name(const std::string& command, bool child_cmd);
+
+private:
+    struct Result;
+    void process_file(const std::string& log_file, Result& result) const;
+    void merge(Result& result);
+
+    Resolution resolution_;
+    std::time_t from_;
+    std::time_t to_;
+
+    Buckets buckets_;
+    std::vector<std::string> commands_;
+    std::vector<std::string> suites_;
+    std::vector<size_t> command_totals_;
+    std::vector<size_t> suite_totals_;
+    size_t child_{0};
+    size_t user_{0};
+    std::vector<std::string> files_;
+};
+
+} // namespace ecf
+
+#endif
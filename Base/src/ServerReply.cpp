@@ -28,6 +28,9 @@ void ServerReply::clear_for_invoke(bool command_line_interface) {
     block_client_zombie_detected_ = false;
     invalid_argument_             = false;
     eof_                          = false;
+    file_offset_                  = 0;
+    file_size_                    = 0;
+    file_modify_time_             = 0;
     host_.clear();
     port_.clear();
     error_msg_.clear();
@@ -15,6 +15,8 @@
 // Description :
 //
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+#include <ctime>
+
 #include "NodeFwd.hpp"
 #include "Stats.hpp"
 #include "Zombie.hpp"
@@ -83,6 +85,17 @@ public:
     const std::string& get_string() const { return str_; }
     void set_string(const std::string& f) { str_ = f; }
 
+    /// Only valid when the client requested a range of a file with CFileCmd.
+    /// get_string() is the range, which starts at byte file_offset() of the file
+    size_t file_offset() const { return file_offset_; }
+    size_t file_size() const { return file_size_; }
+    std::time_t file_modify_time() const { return file_modify_time_; }
+    void set_file_range(size_t offset, size_t file_size, std::time_t modify_time) {
+        file_offset_      = offset;
+        file_size_        = file_size;
+        file_modify_time_ = modify_time;
+    }
+
     /// Only valid when Stats command called.
     const Stats& stats() const { return stats_; }
     void set_stats(const Stats& s) { stats_ = s; }
@@ -124,6 +137,7 @@ public:
 
     // During incremental sync, record list of changed nodes, used by python api
     std::vector<std::string>& changed_nodes() { return changed_nodes_; }
+    const std::vector<std::string>& changed_nodes() const { return changed_nodes_; }
 
 private:
     friend class SSyncCmd;
@@ -145,6 +159,10 @@ private:
     int client_handle_{0}; // set locally when suites are registered, and kept for reference
     News_t news_{NO_NEWS}; // clear at the start of invoke
 
+    size_t file_offset_{0};           // clear at the start of invoke
+    size_t file_size_{0};             // clear at the start of invoke
+    std::time_t file_modify_time_{0}; // clear at the start of invoke
+
     bool cli_{false};
     bool in_sync_{false};                      // clear at the start of invoke
     bool full_sync_{false};                    // clear at the start of invoke
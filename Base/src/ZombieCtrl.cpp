@@ -14,6 +14,7 @@
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
 #include "ZombieCtrl.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "AbstractServer.hpp"
@@ -105,7 +106,7 @@ bool ZombieCtrl::handle_path_zombie(AbstractServer* as,
                       process_or_remote_id,
                       task_cmd->try_no(),
                       task_cmd->hostname());
-    zombies_.emplace_back(new_zombie);
+    add_zombie(new_zombie);
 
     /// The user action may end deleting the zombie just added. Depends on ZombieAttribute settings
     return handle_user_actions(new_zombie, nullptr /*task*/, task_cmd, action_taken, theReply);
@@ -156,16 +157,13 @@ bool ZombieCtrl::handle_zombie(Submittable* task,       // This NULL for path zo
 #ifdef DEBUG_ZOMBIE
         cout << " >TASK already active:< ";
 #endif
-        size_t zombieVecSize = zombies_.size();
-        for (size_t i = 0; i < zombieVecSize; i++) {
-            if (zombies_[i].path_to_task() == path_to_task) {
-                zombie_type = zombies_[i].type(); // recover the original zombie type
-                zombies_.erase(zombies_.begin() + i);
+        if (const auto* zombies = zombies_with_path(path_to_task)) {
+            zombie_iterator z = zombies->front();
+            zombie_type       = z->type(); // recover the original zombie type
+            erase_zombie(z);
 #ifdef DEBUG_ZOMBIE
-                cout << " Removing: ";
+            cout << " Removing: ";
 #endif
-                break;
-            }
         }
     }
 
@@ -180,7 +178,7 @@ bool ZombieCtrl::handle_zombie(Submittable* task,       // This NULL for path zo
                       process_or_remote_id,
                       task_cmd->try_no(),
                       task_cmd->hostname());
-    zombies_.push_back(new_zombie);
+    add_zombie(new_zombie);
 
     return handle_user_actions(new_zombie, task, task_cmd, action_taken, theReply);
 }
@@ -360,7 +358,8 @@ bool ZombieCtrl::handle_user_actions(Zombie& theZombie,         // Existing or o
     if (theZombie.remove()) {
         /// Ask ClientInvoker to continue blocking, Zombie may re-appear
         action_taken += "remove";
-        bool remove_ok = remove(path_to_task, process_or_remote_id, process_password);
+        Child::ZombieType zombie_type = theZombie.type(); // theZombie may reference the zombie we remove
+        bool remove_ok                = remove(path_to_task, process_or_remote_id, process_password);
         if (!remove_ok)
             (void)remove_by_path(path_to_task);
 
@@ -369,7 +368,7 @@ bool ZombieCtrl::handle_user_actions(Zombie& theZombie,         // Existing or o
         if (!remove_ok)
             std::cout << " >>>ERROR<<<< Remove failed ";
 #endif
-        theReply = PreAllocatedReply::block_client_zombie_cmd(theZombie.type());
+        theReply = PreAllocatedReply::block_client_zombie_cmd(zombie_type);
         return false;
     }
 
@@ -414,15 +413,15 @@ void ZombieCtrl::add_user_zombies(const std::vector<Submittable*>& tasks, const
                 ZombieAttr attr = ZombieAttr::get_default_attr(Child::USER); // get the default USER zombie attribute
                 t->findParentZombie(Child::USER, attr);                      // Override default from the node tree
 
-                zombies_.emplace_back(Child::USER,
-                                      Child::INIT,
-                                      attr,
-                                      t->absNodePath(),
-                                      t->jobsPassword(),
-                                      t->process_or_remote_id(),
-                                      t->try_no(),
-                                      "",
-                                      user_cmd);
+                add_zombie(Zombie(Child::USER,
+                                  Child::INIT,
+                                  attr,
+                                  t->absNodePath(),
+                                  t->jobsPassword(),
+                                  t->process_or_remote_id(),
+                                  t->try_no(),
+                                  "",
+                                  user_cmd));
 
                 /// Mark task as zombie for xcdp
                 t->flag().set(ecf::Flag::ZOMBIE);
@@ -452,25 +451,26 @@ void ZombieCtrl::get(std::vector<Zombie>& ret) {
 
     boost::posix_time::ptime time_now = Calendar::second_clock_time();
 
-    size_t zombieVecSize              = zombies_.size();
-    ret.reserve(zombieVecSize);
-    for (size_t i = 0; i < zombieVecSize; i++) {
+    ret.reserve(zombies_.size());
+    for (auto& z : zombies_) {
 
-        time_duration duration = time_now - zombies_[i].creation_time();
-        zombies_[i].set_duration(duration.total_seconds());
+        time_duration duration = time_now - z.creation_time();
+        z.set_duration(duration.total_seconds());
 
-        ret.push_back(zombies_[i]);
+        ret.push_back(z);
     }
 }
 
 void ZombieCtrl::remove_stale_zombies(const boost::posix_time::ptime& time_now) {
-    for (auto i = zombies_.begin(); i != zombies_.end(); ++i) {
-        time_duration duration = time_now - (*i).creation_time();
-        if (duration.total_seconds() > (*i).allowed_age()) {
+    // Single pass over all zombies, each stale zombie is unlinked from the list and the path index in O(1)
+    for (auto i = zombies_.begin(); i != zombies_.end();) {
+        auto current           = i++;
+        time_duration duration = time_now - (*current).creation_time();
+        if (duration.total_seconds() > (*current).allowed_age()) {
 #ifdef DEBUG_ZOMBIE
-            std::cout << "   ZombieCtrl::remove_stale_zombies " << (*i) << "\n";
+            std::cout << "   ZombieCtrl::remove_stale_zombies " << (*current) << "\n";
 #endif
-            zombies_.erase(i--);
+            erase_zombie(current);
         }
     }
 }
@@ -487,30 +487,29 @@ void ZombieCtrl::fob(const std::string& path_to_task,
 
 void ZombieCtrl::fobCli(const std::string& path_to_task, Submittable* task) {
 
+    const auto* zombies = zombies_with_path(path_to_task);
+    if (!zombies)
+        return;
+
     if (task) {
         /// Try to determine the real zombie. (not 100% precise) by comparing its password with zombie
         /// If zombie password does *NOT* match then this is the real zombie.
-        size_t zombieVecSize = zombies_.size();
-        for (size_t i = 0; i < zombieVecSize; i++) {
-            if (zombies_[i].path_to_task() == path_to_task && zombies_[i].jobs_password() != task->jobsPassword()) {
-                zombies_[i].set_fob();
+        for (zombie_iterator z : *zombies) {
+            if (z->jobs_password() != task->jobsPassword()) {
+                z->set_fob();
                 return;
             }
         }
-        for (size_t i = 0; i < zombieVecSize; i++) {
-            if (zombies_[i].path_to_task() == path_to_task &&
-                zombies_[i].process_or_remote_id() != task->process_or_remote_id()) {
-                zombies_[i].set_fob();
+        for (zombie_iterator z : *zombies) {
+            if (z->process_or_remote_id() != task->process_or_remote_id()) {
+                z->set_fob();
                 return;
             }
         }
     }
 
     /// The best we can do
-    Zombie& theExistingZombie = find_by_path(path_to_task);
-    if (theExistingZombie.empty())
-        return;
-    theExistingZombie.set_fob();
+    zombies->front()->set_fob();
 }
 
 void ZombieCtrl::fail(const std::string& path_to_task,
@@ -525,30 +524,29 @@ void ZombieCtrl::fail(const std::string& path_to_task,
 
 void ZombieCtrl::failCli(const std::string& path_to_task, Submittable* task) {
 
+    const auto* zombies = zombies_with_path(path_to_task);
+    if (!zombies)
+        return;
+
     if (task) {
         /// Try to determine the real zombie. (not 100% precise) by comparing its password with zombie
         /// If zombie password does *NOT* match then this is the real zombie.
-        size_t zombieVecSize = zombies_.size();
-        for (size_t i = 0; i < zombieVecSize; i++) {
-            if (zombies_[i].path_to_task() == path_to_task && zombies_[i].jobs_password() != task->jobsPassword()) {
-                zombies_[i].set_fail();
+        for (zombie_iterator z : *zombies) {
+            if (z->jobs_password() != task->jobsPassword()) {
+                z->set_fail();
                 return;
             }
         }
-        for (size_t i = 0; i < zombieVecSize; i++) {
-            if (zombies_[i].path_to_task() == path_to_task &&
-                zombies_[i].process_or_remote_id() != task->process_or_remote_id()) {
-                zombies_[i].set_fail();
+        for (zombie_iterator z : *zombies) {
+            if (z->process_or_remote_id() != task->process_or_remote_id()) {
+                z->set_fail();
                 return;
             }
         }
     }
 
     /// The best we can do
-    Zombie& theExistingZombie = find_by_path(path_to_task);
-    if (theExistingZombie.empty())
-        return;
-    theExistingZombie.set_fail();
+    zombies->front()->set_fail();
 }
 
 void ZombieCtrl::adopt(const std::string& path_to_task,
@@ -567,19 +565,21 @@ void ZombieCtrl::adoptCli(const std::string& path_to_task, Submittable* task) {
         throw std::runtime_error("ZombieCtrl::adoptCli: Can't adopt zombie, there is no corresponding task!");
     }
 
+    const auto* zombies = zombies_with_path(path_to_task);
+    if (!zombies)
+        return;
+
     /// ***************************************************************************************
     /// IMPORTANT: We should *NEVER* adopt a zombie, when the process id are different
     /// This can end up, with two process running, Will mess up job output, as well as corruption caused
     /// but running the same job twice. Better to kill both and re-queue.
     /// Note: PBS can create two process, i.e same password, different PID's
     /// ***************************************************************************************
-    size_t zombieVecSize = zombies_.size();
-    for (size_t i = 0; i < zombieVecSize; i++) {
-        if (zombies_[i].path_to_task() == path_to_task &&
-            zombies_[i].process_or_remote_id() != task->process_or_remote_id()) {
+    for (zombie_iterator z : *zombies) {
+        if (z->process_or_remote_id() != task->process_or_remote_id()) {
             std::stringstream ss;
             ss << "ZombieCtrl::adoptCli: Can *not* adopt zombies, where process id are different. Task("
-               << task->process_or_remote_id() << ") zombie(" << zombies_[i].process_or_remote_id()
+               << task->process_or_remote_id() << ") zombie(" << z->process_or_remote_id()
                << "). Please kill both process, and re-queue";
             throw std::runtime_error(ss.str());
         }
@@ -587,9 +587,9 @@ void ZombieCtrl::adoptCli(const std::string& path_to_task, Submittable* task) {
 
     /// Try to determine the real zombie. (not 100% precise) by comparing its password with zombie
     /// If zombie password does *NOT* match then this is the real zombie.
-    for (size_t i = 0; i < zombieVecSize; i++) {
-        if (zombies_[i].path_to_task() == path_to_task && zombies_[i].jobs_password() != task->jobsPassword()) {
-            zombies_[i].set_adopt();
+    for (zombie_iterator z : *zombies) {
+        if (z->jobs_password() != task->jobsPassword()) {
+            z->set_adopt();
             return;
         }
     }
@@ -611,13 +611,12 @@ void ZombieCtrl::blockCli(const std::string& path_to_task, Submittable* task) {
         throw std::runtime_error("ZombieCtrl::blockCli: Can't block zombie, there is no corresponding task for path " +
                                  path_to_task);
     }
-    else {
+    else if (const auto* zombies = zombies_with_path(path_to_task)) {
         /// Try to determine the real zombie. (not 100% precise) by comparing its password with zombie
         /// If zombie password does *NOT* match then this is the real zombie.
-        size_t zombieVecSize = zombies_.size();
-        for (size_t i = 0; i < zombieVecSize; i++) {
-            if (zombies_[i].path_to_task() == path_to_task && zombies_[i].jobs_password() != task->jobsPassword()) {
-                zombies_[i].set_block();
+        for (zombie_iterator z : *zombies) {
+            if (z->jobs_password() != task->jobsPassword()) {
+                z->set_block();
                 return;
             }
         }
@@ -641,33 +640,34 @@ void ZombieCtrl::killCli(const std::string& path_to_task, Submittable* task) {
                                  path_to_task);
     }
 
+    const auto* zombies = zombies_with_path(path_to_task);
+    if (!zombies) {
+        throw std::runtime_error("ZombieCtrl::killCli: Can't kill, could not locate zombie(and hence pid) for path: " +
+                                 path_to_task);
+    }
+
     /// Try to determine the real zombie. (not 100% precise) by comparing its password with zombie
     /// If zombie password does *NOT* match then this is the real zombie.
-    size_t zombieVecSize = zombies_.size();
-    for (size_t i = 0; i < zombieVecSize; i++) {
-        if (zombies_[i].path_to_task() == path_to_task && zombies_[i].jobs_password() != task->jobsPassword()) {
-            task->kill(zombies_[i].process_or_remote_id());
-            zombies_[i].set_kill();
+    for (zombie_iterator z : *zombies) {
+        if (z->jobs_password() != task->jobsPassword()) {
+            task->kill(z->process_or_remote_id());
+            z->set_kill();
             return;
         }
     }
-    for (size_t i = 0; i < zombieVecSize; i++) {
-        if (zombies_[i].path_to_task() == path_to_task &&
-            zombies_[i].process_or_remote_id() != task->process_or_remote_id()) {
-            task->kill(zombies_[i].process_or_remote_id());
-            zombies_[i].set_kill();
+    for (zombie_iterator z : *zombies) {
+        if (z->process_or_remote_id() != task->process_or_remote_id()) {
+            task->kill(z->process_or_remote_id());
+            z->set_kill();
             return;
         }
     }
+
     /// The best we can do
-    Zombie& theExistingZombie = find_by_path(path_to_task);
-    if (theExistingZombie.empty()) {
-        throw std::runtime_error("ZombieCtrl::killCli: Can't kill, could not locate zombie(and hence pid) for path: " +
-                                 path_to_task);
-    }
-    task->kill(theExistingZombie.process_or_remote_id());
-    theExistingZombie.set_kill();
-    remove_by_path(path_to_task);
+    zombie_iterator z = zombies->front();
+    task->kill(z->process_or_remote_id());
+    z->set_kill();
+    erase_zombie(z);
 }
 
 /// Called by the child commands, ie complete and abort
@@ -685,14 +685,15 @@ bool ZombieCtrl::remove(const std::string& path_to_task,
 
     /// Note: Its possible for two separate jobs to have the same password. (submit 1, submit 2) before job1 active,
     /// password overridden by submit 2 Hence remove needs to at least match process_id
-    size_t zombieVecSize = zombies_.size();
-    for (size_t i = 0; i < zombieVecSize; i++) {
-        if (match(zombies_[i], path_to_task, process_or_remote_id, password)) {
-            // #ifdef DEBUG_ZOMBIE
-            //			std::cout << "   ZombieCtrl::remove " << zombies_[i] << " \n";
-            // #endif
-            zombies_.erase(zombies_.begin() + i);
-            return true;
+    if (const auto* zombies = zombies_with_path(path_to_task)) {
+        for (zombie_iterator z : *zombies) {
+            if (match(*z, path_to_task, process_or_remote_id, password)) {
+                // #ifdef DEBUG_ZOMBIE
+                //			std::cout << "   ZombieCtrl::remove " << *z << " \n";
+                // #endif
+                erase_zombie(z);
+                return true;
+            }
         }
     }
     return false;
@@ -700,26 +701,28 @@ bool ZombieCtrl::remove(const std::string& path_to_task,
 
 void ZombieCtrl::removeCli(const std::string& path_to_task, Submittable* task) {
 
+    const auto* zombies = zombies_with_path(path_to_task);
+    if (!zombies)
+        return;
+
     if (task) {
         /// Try to determine the real zombie. (not 100% precise) by comparing its password with zombie
         /// If zombie password does *NOT* match then this is the real zombie.
-        size_t zombieVecSize = zombies_.size();
-        for (size_t i = 0; i < zombieVecSize; i++) {
-            if (zombies_[i].path_to_task() == path_to_task && zombies_[i].jobs_password() != task->jobsPassword()) {
+        for (zombie_iterator z : *zombies) {
+            if (z->jobs_password() != task->jobsPassword()) {
 #ifdef DEBUG_ZOMBIE
-                std::cout << "   ZombieCtrl::removeCli " << zombies_[i] << " \n";
+                std::cout << "   ZombieCtrl::removeCli " << *z << " \n";
 #endif
-                zombies_.erase(zombies_.begin() + i);
+                erase_zombie(z);
                 return;
             }
         }
-        for (size_t i = 0; i < zombieVecSize; i++) {
-            if (zombies_[i].path_to_task() == path_to_task &&
-                zombies_[i].process_or_remote_id() != task->process_or_remote_id()) {
+        for (zombie_iterator z : *zombies) {
+            if (z->process_or_remote_id() != task->process_or_remote_id()) {
 #ifdef DEBUG_ZOMBIE
-                std::cout << "   ZombieCtrl::removeCli " << zombies_[i] << " \n";
+                std::cout << "   ZombieCtrl::removeCli " << *z << " \n";
 #endif
-                zombies_.erase(zombies_.begin() + i);
+                erase_zombie(z);
                 return;
             }
         }
@@ -730,15 +733,12 @@ void ZombieCtrl::removeCli(const std::string& path_to_task, Submittable* task) {
 }
 
 bool ZombieCtrl::remove_by_path(const std::string& path_to_task) {
-    size_t zombieVecSize = zombies_.size();
-    for (size_t i = 0; i < zombieVecSize; i++) {
-        if (zombies_[i].path_to_task() == path_to_task) {
+    if (const auto* zombies = zombies_with_path(path_to_task)) {
 #ifdef DEBUG_ZOMBIE
-            std::cout << "   ZombieCtrl::remove_by_path : " << zombies_[i] << " \n";
+        std::cout << "   ZombieCtrl::remove_by_path : " << *zombies->front() << " \n";
 #endif
-            zombies_.erase(zombies_.begin() + i);
-            return true;
-        }
+        erase_zombie(zombies->front());
+        return true;
     }
     return false;
 }
@@ -747,10 +747,11 @@ bool ZombieCtrl::remove_by_path(const std::string& path_to_task) {
 const Zombie& ZombieCtrl::find(const std::string& path_to_task,
                                const std::string& process_or_remote_id,
                                const std::string& password) const {
-    size_t zombieVecSize = zombies_.size();
-    for (size_t i = 0; i < zombieVecSize; i++) {
-        if (match(zombies_[i], path_to_task, process_or_remote_id, password)) {
-            return zombies_[i];
+    if (const auto* zombies = zombies_with_path(path_to_task)) {
+        for (zombie_iterator z : *zombies) {
+            if (match(*z, path_to_task, process_or_remote_id, password)) {
+                return *z;
+            }
         }
     }
     return Zombie::EMPTY();
@@ -773,13 +774,16 @@ const Zombie& ZombieCtrl::find(Submittable* task) const {
 Zombie& ZombieCtrl::find_zombie(const std::string& path_to_task,
                                 const std::string& process_or_remote_id,
                                 const std::string& password) {
-    size_t zombieVecSize = zombies_.size();
-    for (size_t i = 0; i < zombieVecSize; i++) {
-        if (match(zombies_[i], path_to_task, process_or_remote_id, password)) {
-            return zombies_[i];
+    const auto* zombies = zombies_with_path(path_to_task);
+    if (!zombies)
+        return Zombie::EMPTY_();
+
+    for (zombie_iterator z : *zombies) {
+        if (match(*z, path_to_task, process_or_remote_id, password)) {
+            return *z;
         }
     }
-    return find_by_path(path_to_task);
+    return *zombies->front(); // resort to path matching
 }
 
 bool match(const Zombie& z,
@@ -801,21 +805,39 @@ bool match(const Zombie& z,
 }
 
 Zombie& ZombieCtrl::find_by_path(const std::string& path_to_task) {
-    size_t zombieVecSize = zombies_.size();
-    for (size_t i = 0; i < zombieVecSize; i++) {
-        if (zombies_[i].path_to_task() == path_to_task) {
-            return zombies_[i];
-        }
+    if (const auto* zombies = zombies_with_path(path_to_task)) {
+        return *zombies->front();
     }
     return Zombie::EMPTY_();
 }
 
 const Zombie& ZombieCtrl::find_by_path_only(const std::string& path_to_task) const {
-    size_t zombieVecSize = zombies_.size();
-    for (size_t i = 0; i < zombieVecSize; i++) {
-        if (zombies_[i].path_to_task() == path_to_task) {
-            return zombies_[i];
-        }
+    if (const auto* zombies = zombies_with_path(path_to_task)) {
+        return *zombies->front();
     }
     return Zombie::EMPTY();
 }
+
+void ZombieCtrl::add_zombie(const Zombie& zombie) {
+    zombies_.push_back(zombie);
+    path_index_[zombie.path_to_task()].push_back(std::prev(zombies_.end()));
+}
+
+void ZombieCtrl::erase_zombie(zombie_iterator z) {
+    auto found = path_index_.find(z->path_to_task());
+    if (found != path_index_.end()) {
+        std::vector<zombie_iterator>& zombies = found->second;
+        zombies.erase(std::find(zombies.begin(), zombies.end(), z));
+        if (zombies.empty())
+            path_index_.erase(found);
+    }
+    zombies_.erase(z);
+}
+
+const std::vector<ZombieCtrl::zombie_iterator>* ZombieCtrl::zombies_with_path(const std::string& path_to_task) const {
+    // The index never holds an empty vector, hence a non null return always has a front()
+    auto found = path_index_.find(path_to_task);
+    if (found == path_index_.end())
+        return nullptr;
+    return &found->second;
+}
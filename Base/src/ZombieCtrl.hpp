@@ -15,6 +15,10 @@
 // Description : manages the zombies
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
 
+#include <list>
+#include <unordered_map>
+#include <vector>
+
 #include <boost/core/noncopyable.hpp>
 #include <boost/date_time/posix_time/posix_time_types.hpp>
 
@@ -25,6 +29,12 @@ class TaskCmd;
 class AbstractServer;
 
 /// All zombies are auto deleted after a period of time. See Zombie::allowed_age()
+///
+/// Zombies are held in insertion order, and indexed by task path. Every zombie
+/// lookup(see match() in ZombieCtrl.cpp) requires the path to match, hence the
+/// index reduces each lookup to the (typically one or two) zombies of that task.
+/// This matters since TaskCmd::authenticate() will search the zombies for *every*
+/// child command, from a miss-matched process.
 class ZombieCtrl : private boost::noncopyable {
 public:
     ZombieCtrl() = default;
@@ -127,6 +137,15 @@ private:
     Zombie& find_by_path(const std::string& path_to_task);
 
 private:
-    std::vector<Zombie> zombies_;
+    using zombie_list     = std::list<Zombie>; // list, so that iterators held by the index stay valid
+    using zombie_iterator = zombie_list::iterator;
+
+    void add_zombie(const Zombie&);
+    void erase_zombie(zombie_iterator);
+    const std::vector<zombie_iterator>* zombies_with_path(const std::string& path_to_task) const;
+
+private:
+    zombie_list zombies_;                                                      // in order of creation
+    std::unordered_map<std::string, std::vector<zombie_iterator>> path_index_; // task path -> zombies
 };
 #endif
@@ -13,6 +13,8 @@
 // Description :
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
 
+#include <algorithm>
+#include <ctime>
 #include <sstream>
 #include <stdexcept>
 
@@ -34,7 +36,25 @@ using namespace boost;
 namespace po = boost::program_options;
 namespace fs = boost::filesystem;
 
-CFileCmd::CFileCmd(const std::string& pathToNode, const std::string& file_type, const std::string& input_max_lines)
+CFileCmd::CFileCmd(const std::string& pathToNode, File_t file, Range_t range, size_t range_begin, size_t range_end)
+    : file_(file),
+      pathToNode_(pathToNode),
+      max_lines_(File::MAX_LINES()),
+      range_(range),
+      range_begin_(range_begin),
+      range_end_(range_end) {
+    if (range_ != NO_RANGE && range_end_ != 0 && range_end_ <= range_begin_) {
+        std::stringstream ss;
+        ss << "CFileCmd::CFileCmd: The end of the range(" << range_end_ << ") must be greater than the begin("
+           << range_begin_ << ")\n";
+        throw std::runtime_error(ss.str());
+    }
+}
+
+CFileCmd::CFileCmd(const std::string& pathToNode,
+                   const std::string& file_type,
+                   const std::string& input_max_lines,
+                   const std::string& range)
     : pathToNode_(pathToNode),
       max_lines_(File::MAX_LINES()) {
     // std::cout << "CFileCmd::CFileCmd the_max_lines " << the_max_lines << "\n";
@@ -73,6 +93,40 @@ CFileCmd::CFileCmd(const std::string& pathToNode, const std::string& file_type,
             throw std::runtime_error(ss.str());
         }
     }
+
+    if (!range.empty()) {
+        // bytes=<begin>-[<end>] | lines=<begin>-[<end>]
+        std::string::size_type eq   = range.find('=');
+        std::string::size_type dash = range.find('-');
+        std::string unit            = (eq == std::string::npos) ? std::string() : range.substr(0, eq);
+        if (unit == "bytes")
+            range_ = CFileCmd::BYTES;
+        else if (unit == "lines")
+            range_ = CFileCmd::LINES;
+        if (range_ == NO_RANGE || dash == std::string::npos || dash < eq) {
+            std::stringstream ss;
+            ss << "CFileCmd::CFileCmd: Expected the fourth argument(" << range
+               << ") to be of the form bytes=<begin>-[<end>] or lines=<begin>-[<end>]\n";
+            throw std::runtime_error(ss.str());
+        }
+        try {
+            range_begin_        = boost::lexical_cast<size_t>(range.substr(eq + 1, dash - eq - 1));
+            std::string end_str = range.substr(dash + 1);
+            if (!end_str.empty())
+                range_end_ = boost::lexical_cast<size_t>(end_str);
+        }
+        catch (boost::bad_lexical_cast& e) {
+            std::stringstream ss;
+            ss << "CFileCmd::CFileCmd: The begin and end of the range(" << range
+               << ") must be convertible to positive integers\n";
+            throw std::runtime_error(ss.str());
+        }
+        if (range_end_ != 0 && range_end_ <= range_begin_) {
+            std::stringstream ss;
+            ss << "CFileCmd::CFileCmd: The end of the range(" << range << ") must be greater than the begin\n";
+            throw std::runtime_error(ss.str());
+        }
+    }
 }
 
 std::vector<CFileCmd::File_t> CFileCmd::fileTypesVec() {
@@ -113,6 +167,17 @@ std::string CFileCmd::toString(CFileCmd::File_t ft) {
     return "script";
 }
 
+std::string CFileCmd::toString(CFileCmd::Range_t range, size_t range_begin, size_t range_end) {
+    if (range == CFileCmd::NO_RANGE)
+        return std::string();
+    std::string ret = (range == CFileCmd::BYTES) ? "bytes=" : "lines=";
+    ret += boost::lexical_cast<std::string>(range_begin);
+    ret += "-";
+    if (range_end != 0)
+        ret += boost::lexical_cast<std::string>(range_end);
+    return ret;
+}
+
 bool CFileCmd::equals(ClientToServerCmd* rhs) const {
     auto* the_rhs = dynamic_cast<CFileCmd*>(rhs);
     if (!the_rhs)
@@ -126,16 +191,94 @@ bool CFileCmd::equals(ClientToServerCmd* rhs) const {
     if (pathToNode_ != the_rhs->pathToNode()) {
         return false;
     }
+    if (range_ != the_rhs->range() || range_begin_ != the_rhs->range_begin() || range_end_ != the_rhs->range_end()) {
+        return false;
+    }
     return UserCmd::equals(rhs);
 }
 
 void CFileCmd::print(std::string& os) const {
-    user_cmd(
-        os,
-        CtsApi::to_string(CtsApi::file(pathToNode_, toString(file_), boost::lexical_cast<std::string>(max_lines_))));
+    user_cmd(os,
+             CtsApi::to_string(CtsApi::file(pathToNode_,
+                                            toString(file_),
+                                            boost::lexical_cast<std::string>(max_lines_),
+                                            toString(range_, range_begin_, range_end_))));
 }
 void CFileCmd::print_only(std::string& os) const {
-    os += CtsApi::to_string(CtsApi::file(pathToNode_, toString(file_), boost::lexical_cast<std::string>(max_lines_)));
+    os += CtsApi::to_string(CtsApi::file(pathToNode_,
+                                         toString(file_),
+                                         boost::lexical_cast<std::string>(max_lines_),
+                                         toString(range_, range_begin_, range_end_)));
+}
+
+// The part of the file returned, when a range was requested
+struct FileRange
+{
+    size_t offset_{0};
+    size_t size_{0};
+    std::time_t modify_time_{0};
+};
+
+static bool
+read_file(const CFileCmd& cmd, const std::string& file_path, std::string& contents, FileRange& file_range) {
+    std::string error_msg;
+    switch (cmd.range()) {
+        case CFileCmd::BYTES:
+            file_range.offset_ = cmd.range_begin();
+            return File::read_byte_range(file_path,
+                                         cmd.range_begin(),
+                                         cmd.range_end(),
+                                         contents,
+                                         file_range.size_,
+                                         file_range.modify_time_,
+                                         error_msg);
+        case CFileCmd::LINES:
+            return File::read_line_range(file_path,
+                                         cmd.range_begin(),
+                                         cmd.range_end(),
+                                         contents,
+                                         file_range.offset_,
+                                         file_range.size_,
+                                         file_range.modify_time_,
+                                         error_msg);
+        default: break;
+    }
+    return File::open(file_path, contents);
+}
+
+static void apply_range(const CFileCmd& cmd, std::string& contents, FileRange& file_range) {
+    // The script and manual are pre-processed in memory, there is no file to read from
+    file_range.size_        = contents.size();
+    file_range.modify_time_ = 0;
+    size_t begin            = 0;
+    size_t end              = contents.size();
+    if (cmd.range() == CFileCmd::BYTES) {
+        begin = std::min(cmd.range_begin(), contents.size());
+        if (cmd.range_end() != 0)
+            end = std::min(cmd.range_end(), contents.size());
+    }
+    else {
+        size_t line = 0;
+        for (size_t i = 0; i < contents.size() && line < cmd.range_begin(); i++) {
+            if (contents[i] == '\n' && ++line == cmd.range_begin())
+                begin = i + 1;
+        }
+        if (line < cmd.range_begin())
+            begin = contents.size();
+        if (cmd.range_end() != 0) {
+            line = cmd.range_begin();
+            for (size_t i = begin; i < contents.size(); i++) {
+                if (contents[i] == '\n' && ++line == cmd.range_end()) {
+                    end = i + 1;
+                    break;
+                }
+            }
+        }
+    }
+    if (end < begin)
+        end = begin;
+    file_range.offset_ = begin;
+    contents           = contents.substr(begin, end - begin);
 }
 
 STC_Cmd_ptr CFileCmd::doHandleRequest(AbstractServer* as) const {
@@ -164,6 +307,7 @@ STC_Cmd_ptr CFileCmd::doHandleRequest(AbstractServer* as) const {
     node_ptr node = find_node(as->defs().get(), pathToNode_); // will throw if defs not defined, or node not found
 
     std::string fileContents;
+    FileRange file_range;
     Submittable* submittable = node->isSubmittable();
     if (submittable) {
 
@@ -183,7 +327,7 @@ STC_Cmd_ptr CFileCmd::doHandleRequest(AbstractServer* as) const {
             case CFileCmd::JOB: {
                 std::string ecf_job_file;
                 submittable->findParentVariableValue(Str::ECF_JOB(), ecf_job_file);
-                if (!File::open(ecf_job_file, fileContents)) {
+                if (!read_file(*this, ecf_job_file, fileContents, file_range)) {
                     std::stringstream ss;
                     ss << "CFileCmd::doHandleRequest: Failed to open the job file('" << ecf_job_file << "') for task "
                        << pathToNode_ << " (" << strerror(errno) << ")";
@@ -207,13 +351,13 @@ STC_Cmd_ptr CFileCmd::doHandleRequest(AbstractServer* as) const {
                 std::stringstream ss;
                 std::string user_jobout;
                 if (submittable->findParentUserVariableValue(Str::ECF_JOBOUT(), user_jobout)) {
-                    if (File::open(user_jobout, fileContents))
+                    if (read_file(*this, user_jobout, fileContents, file_range))
                         break;
                     ss << "Failed to open user specified job-out(ECF_JOBOUT='" << user_jobout << "') ";
                 }
 
                 const Variable& ecf_jobout_gen_var = submittable->findGenVariable(Str::ECF_JOBOUT());
-                if (!File::open(ecf_jobout_gen_var.theValue(), fileContents)) {
+                if (!read_file(*this, ecf_jobout_gen_var.theValue(), fileContents, file_range)) {
 
                     // If that fails as a backup, look under ECF_HOME/ECF_NAME.ECF_TRYNO,   ECFLOW-177 preserve old SMS
                     // behaviour
@@ -225,7 +369,7 @@ STC_Cmd_ptr CFileCmd::doHandleRequest(AbstractServer* as) const {
 
                     if (ecfhome_jobout != ecf_jobout_gen_var.theValue()) {
                         // Implies ECF_OUT was specified, hence *ALSO* look in ECF_HOME/ECF_NAME.ECF_TRYNO
-                        if (!File::open(ecfhome_jobout, fileContents)) {
+                        if (!read_file(*this, ecfhome_jobout, fileContents, file_range)) {
                             ss << "Failed to open the job-out (ECF_JOBOUT=ECF_OUT/ECF_NAME.ECF_TRYNO='"
                                << ecf_jobout_gen_var.theValue() << "') ";
                             ss << "*AND* (ECF_JOBOUT=ECF_HOME/ECF_NAME.ECF_TRYNO='" << ecfhome_jobout << "')";
@@ -249,7 +393,7 @@ STC_Cmd_ptr CFileCmd::doHandleRequest(AbstractServer* as) const {
                 std::string ecf_job_file;
                 submittable->findParentVariableValue(Str::ECF_JOB(), ecf_job_file);
                 std::string file = ecf_job_file + ".kill";
-                if (!File::open(file, fileContents)) {
+                if (!read_file(*this, file, fileContents, file_range)) {
                     std::stringstream ss;
                     ss << "CFileCmd::doHandleRequest: Failed to open the kill output file('" << file << "') for task "
                        << pathToNode_ << " (" << strerror(errno) << ")";
@@ -262,7 +406,7 @@ STC_Cmd_ptr CFileCmd::doHandleRequest(AbstractServer* as) const {
                 std::string ecf_job_file;
                 submittable->findParentVariableValue(Str::ECF_JOB(), ecf_job_file);
                 std::string file = ecf_job_file + ".stat";
-                if (!File::open(file, fileContents)) {
+                if (!read_file(*this, file, fileContents, file_range)) {
                     std::stringstream ss;
                     ss << "CFileCmd::doHandleRequest: Failed to open the status output file('" << file << "') for task "
                        << pathToNode_ << " (" << strerror(errno) << ")";
@@ -321,6 +465,13 @@ STC_Cmd_ptr CFileCmd::doHandleRequest(AbstractServer* as) const {
         }
     }
 
+    if (range_ != CFileCmd::NO_RANGE) {
+        // Only the requested part of the file was read, except for the script and manual
+        if (file_ == CFileCmd::ECF || file_ == CFileCmd::MANUAL)
+            apply_range(*this, fileContents, file_range);
+        return PreAllocatedReply::file_cmd(fileContents, file_range.offset_, file_range.size_, file_range.modify_time_);
+    }
+
     /// The file could get very large, hence truncate at the start
     if (Str::truncate_at_start(fileContents, max_lines_)) {
         std::stringstream ss;
@@ -347,7 +498,14 @@ const char* CFileCmd::desc() {
            "  arg2 = (optional) [ script<default> | job | jobout | manual | kill | stat ]\n"
            "         kill will attempt to return output of ECF_KILL_CMD, i.e the file %ECF_JOB%.kill\n"
            "         stat will attempt to return output of ECF_STATUS_CMD, i.e the file %ECF_JOB%.stat\n"
-           "  arg3 = (optional) max_lines = 10000 <default>";
+           "  arg3 = (optional) max_lines = 10000 <default>\n"
+           "  arg4 = (optional) range, only return part of the file, max_lines is then ignored\n"
+           "         bytes=<begin>-[<end>] the bytes [begin,end), without end up to the end of file\n"
+           "         lines=<begin>-[<end>] the lines [begin,end), counted from 0\n"
+           "         The file is read in the server, only the range is returned, so large or growing\n"
+           "         job output can be followed by asking for the bytes after those already seen.\n"
+           "Usage:\n"
+           "  --file=/s1/f1/t1 jobout 10000 bytes=2048-   # job output from byte 2048 to the end";
 }
 
 void CFileCmd::addOption(boost::program_options::options_description& desc) const {
@@ -374,11 +532,16 @@ void CFileCmd::create(Cmd_ptr& cmd, boost::program_options::variables_map& vm, A
     }
 
     std::string max_lines;
-    if (args.size() == 3) {
+    if (args.size() >= 3) {
         max_lines = args[2];
     }
 
-    cmd = std::make_shared<CFileCmd>(pathToNode, file_type, max_lines);
+    std::string range;
+    if (args.size() == 4) {
+        range = args[3];
+    }
+
+    cmd = std::make_shared<CFileCmd>(pathToNode, file_type, max_lines, range);
 }
 
 std::ostream& operator<<(std::ostream& os, const CFileCmd& c) {
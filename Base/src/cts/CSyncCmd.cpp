@@ -86,6 +86,10 @@ bool CSyncCmd::equals(ClientToServerCmd* rhs) const {
         return false;
     if (client_modify_change_no_ != the_rhs->client_modify_change_no())
         return false;
+    if (compact_paths_ != the_rhs->compact_paths())
+        return false;
+    if (wait_for_change_ != the_rhs->wait_for_change())
+        return false;
     return UserCmd::equals(rhs);
 }
 
@@ -106,7 +110,7 @@ const char* CSyncCmd::theArg() const {
 
 int CSyncCmd::timeout() const {
     if (api_ == CSyncCmd::SYNC || api_ == CSyncCmd::SYNC_FULL || api_ == CSyncCmd::SYNC_CLOCK) {
-        return time_out_for_load_sync_and_get();
+        return time_out_for_load_sync_and_get() + wait_for_change_;
     }
     return 20; // CSyncCmd::NEWS
 }
@@ -141,7 +145,7 @@ STC_Cmd_ptr CSyncCmd::doHandleRequest(AbstractServer* as) const {
         }
         case CSyncCmd::SYNC: {
             as->update_stats().sync_++;
-            return PreAllocatedReply::sync_cmd(client_handle_, client_state_change_no_, client_modify_change_no_, as);
+            return sync_reply(as);
         }
         case CSyncCmd::SYNC_FULL: {
             as->update_stats().sync_full_++;
@@ -150,7 +154,7 @@ STC_Cmd_ptr CSyncCmd::doHandleRequest(AbstractServer* as) const {
         case CSyncCmd::SYNC_CLOCK: {
             as->update_stats().sync_clock_++;
             return PreAllocatedReply::sync_clock_cmd(
-                client_handle_, client_state_change_no_, client_modify_change_no_, as);
+                client_handle_, client_state_change_no_, client_modify_change_no_, as, compact_paths_);
         }
     }
 
@@ -158,6 +162,11 @@ STC_Cmd_ptr CSyncCmd::doHandleRequest(AbstractServer* as) const {
     return PreAllocatedReply::sync_cmd(client_handle_, client_state_change_no_, client_modify_change_no_, as);
 }
 
+STC_Cmd_ptr CSyncCmd::sync_reply(AbstractServer* as) const {
+    return PreAllocatedReply::sync_cmd(
+        client_handle_, client_state_change_no_, client_modify_change_no_, as, compact_paths_);
+}
+
 void CSyncCmd::addOption(boost::program_options::options_description& desc) const {
     if (api_ == CSyncCmd::NEWS) {
         desc.add_options()(
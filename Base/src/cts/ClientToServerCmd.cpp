@@ -17,11 +17,14 @@
 #include <iostream>
 #include <stdexcept>
 
+#include <boost/lexical_cast.hpp>
+
 #include "AbstractServer.hpp"
 #include "Calendar.hpp"
 #include "CmdContext.hpp"
 #include "Defs.hpp"
 #include "EditHistoryMgr.hpp"
+#include "FindNodeCache.hpp"
 #include "Flag.hpp"
 #include "Host.hpp"
 #include "Log.hpp"
@@ -78,6 +81,10 @@ STC_Cmd_ptr ClientToServerCmd::handleRequest(AbstractServer* as) const {
     // hence must at the same scope level
     EditHistoryMgr edit_history_mgr(this, as);
 
+    // Commands with many paths, or group commands, can look up the same families many times
+    defs_ptr defs = as->defs();
+    FindNodeCache find_node_cache(defs.get());
+
     // Handle the request, and return the reply back to the client
     STC_Cmd_ptr server_to_client_ptr = doHandleRequest(as);
     if (isWrite() && server_to_client_ptr->ok()) {
@@ -178,6 +185,9 @@ void ClientToServerCmd::add_edit_history(Defs* defs) const {
         defs->flag().set(ecf::Flag::MESSAGE);
         add_edit_history(defs, Str::ROOT_PATH());
     }
+    else if (edit_history_nodes_.size() + edit_history_node_paths_.size() > max_edit_history_nodes()) {
+        add_bulk_edit_history(defs, *this, edit_history_nodes_.size() + edit_history_node_paths_.size());
+    }
     else {
         // edit_history_node_paths_ is only populated by the delete command
         size_t the_size = edit_history_node_paths_.size();
@@ -221,6 +231,32 @@ void ClientToServerCmd::add_edit_history(Defs* defs, const std::string& path) co
     defs->add_edit_history(path, ss);
 }
 
+std::string ClientToServerCmd::first_edited_path() const {
+    if (!edit_history_node_paths_.empty())
+        return edit_history_node_paths_[0];
+    for (const auto& edited : edit_history_nodes_) {
+        node_ptr edited_node = edited.lock();
+        if (edited_node.get())
+            return edited_node->absNodePath();
+    }
+    return Str::ROOT_PATH();
+}
+
+void ClientToServerCmd::add_bulk_edit_history(Defs* defs, const ClientToServerCmd& cmd, size_t no_of_nodes) {
+    // A single record is added to the root, rather than one for each node.
+    // Otherwise a request that edits thousands of nodes, would push out the history of the other nodes.
+    // Only the first command and path are shown, as for print_short()
+    std::string ss("MSG:");
+    ss += Log::instance()->get_cached_time_stamp();
+    cmd.print(ss, cmd.first_edited_path());
+    ss += " (bulk edit of ";
+    ss += boost::lexical_cast<std::string>(no_of_nodes);
+    ss += " nodes)";
+
+    defs->flag().set(ecf::Flag::MESSAGE);
+    defs->add_edit_history(Str::ROOT_PATH(), ss);
+}
+
 void ClientToServerCmd::add_delete_edit_history(Defs* defs, const std::string& path) const {
     // History is added to Str::ROOT_PATH(), but the path must show deleted node path
     std::string ss("MSG:");
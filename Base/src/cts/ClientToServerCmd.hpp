@@ -186,6 +186,11 @@ protected:
     void add_edit_history(Defs*, const std::string& path) const;
     void add_delete_edit_history(Defs*, const std::string& path) const;
 
+    /// When a request edits more nodes than this, a single edit history record is added to the root
+    static constexpr size_t max_edit_history_nodes() { return 1000; }
+    static void add_bulk_edit_history(Defs*, const ClientToServerCmd& cmd, size_t no_of_nodes);
+    std::string first_edited_path() const;
+
     mutable bool use_EditHistoryMgr_{
         true}; // sometime quicker to add edit history in command, than using EditHistoryMgr
 private:
@@ -788,6 +793,10 @@ private:
 // Client---(CSyncCmd::SYNC)--------->Server-----(SSyncCmd)--->client:
 // Client---(CSyncCmd::SYNC_CLOCK)--->Server-----(SSyncCmd)--->client:
 // Client---(CSyncCmd::NEWS)--------->Server-----(SNewsCmd)--->client:
+//
+// When wait_for_change_ > 0, and there are no changes, the server holds on to a SYNC request,
+// and replies as soon as the client's suites change, or after wait_for_change_ seconds.
+// This allows clients to wait for changes, instead of polling with NEWS. See ChangeSubscribers.hpp
 class CSyncCmd final : public UserCmd {
 public:
     enum Api { NEWS, SYNC, SYNC_FULL, SYNC_CLOCK };
@@ -795,11 +804,14 @@ public:
     CSyncCmd(Api a,
              unsigned int client_handle,
              unsigned int client_state_change_no,
-             unsigned int client_modify_change_no)
+             unsigned int client_modify_change_no,
+             int wait_for_change = 0)
         : api_(a),
           client_handle_(client_handle),
           client_state_change_no_(client_state_change_no),
-          client_modify_change_no_(client_modify_change_no) {}
+          client_modify_change_no_(client_modify_change_no),
+          wait_for_change_(wait_for_change),
+          compact_paths_(true) {}
     explicit CSyncCmd(unsigned int client_handle) : api_(SYNC_FULL), client_handle_(client_handle) {}
     CSyncCmd() = default;
 
@@ -807,6 +819,12 @@ public:
     int client_state_change_no() const { return client_state_change_no_; }
     int client_modify_change_no() const { return client_modify_change_no_; }
     int client_handle() const { return client_handle_; }
+    bool compact_paths() const { return compact_paths_; }
+    int wait_for_change() const { return wait_for_change_; }
+
+    /// The reply to a SYNC, without logging or updating the server stats. Used to
+    /// answer a request that was held waiting for changes, and was already counted.
+    STC_Cmd_ptr sync_reply(AbstractServer*) const;
 
     void set_client_handle(int client_handle) override { client_handle_ = client_handle; } // used by group_cmd
     void print(std::string&) const override;
@@ -830,6 +848,8 @@ private:
     int client_handle_{0};
     int client_state_change_no_{0};
     int client_modify_change_no_{0};
+    int wait_for_change_{0};    // seconds, server replies when suites change or after wait. Only used by SYNC
+    bool compact_paths_{false}; // client can expand front coded memento paths, see DefsDelta.hpp
 
     friend class cereal::access;
     template <class Archive>
@@ -839,6 +859,8 @@ private:
            CEREAL_NVP(client_handle_),
            CEREAL_NVP(client_state_change_no_),
            CEREAL_NVP(client_modify_change_no_));
+        CEREAL_OPTIONAL_NVP(ar, compact_paths_, [this]() { return compact_paths_; });       // conditionally save
+        CEREAL_OPTIONAL_NVP(ar, wait_for_change_, [this]() { return wait_for_change_ != 0; }); // conditionally save
     }
 };
 
@@ -1381,18 +1403,20 @@ private:
 // to Node, events, meters, limits, variables defined on another suite.
 class LoadDefsCmd final : public UserCmd {
 public:
-    explicit LoadDefsCmd(const defs_ptr& defs, bool force = false);
+    explicit LoadDefsCmd(const defs_ptr& defs, bool force = false, bool patch = false);
     explicit LoadDefsCmd(const std::string& defs_filename,
                          bool force      = false,
                          bool check_only = false /* not persisted */,
                          bool print      = false /* not persisted */,
                          bool stats      = false /* not persisted */,
                          const std::vector<std::pair<std::string, std::string>>& client_env =
-                             std::vector<std::pair<std::string, std::string>>());
+                             std::vector<std::pair<std::string, std::string>>(),
+                         bool patch = false);
     LoadDefsCmd() = default;
 
     // Uses by equals only
     const std::string& defs_as_string() const { return defs_; }
+    bool patch() const { return patch_; }
 
     bool isWrite() const override { return true; }
     int timeout() const override { return time_out_for_load_sync_and_get(); }
@@ -1408,7 +1432,8 @@ public:
                           bool check_only,
                           bool print,
                           bool stats,
-                          AbstractClientEnv* clientEnv);
+                          AbstractClientEnv* clientEnv,
+                          bool patch = false);
 
 private:
     static const char* arg();  // used for argument parsing
@@ -1417,6 +1442,7 @@ private:
     STC_Cmd_ptr doHandleRequest(AbstractServer*) const override;
 
     bool force_{false};
+    bool patch_{false}; // update existing suites in place, see DefsPatcher
     std::string defs_;
     std::string defs_filename_;
 
@@ -1424,13 +1450,22 @@ private:
     template <class Archive>
     void serialize(Archive& ar, std::uint32_t const /*version*/) {
         ar(cereal::base_class<UserCmd>(this), CEREAL_NVP(force_), CEREAL_NVP(defs_), CEREAL_NVP(defs_filename_));
+        CEREAL_OPTIONAL_NVP(ar, patch_, [this]() { return patch_; }); // conditionally save
     }
 };
 
 class ReplaceNodeCmd final : public UserCmd {
 public:
-    ReplaceNodeCmd(const std::string& node_path, bool createNodesAsNeeded, defs_ptr client_defs, bool force);
-    ReplaceNodeCmd(const std::string& node_path, bool createNodesAsNeeded, const std::string& path_to_defs, bool force);
+    ReplaceNodeCmd(const std::string& node_path,
+                   bool createNodesAsNeeded,
+                   defs_ptr client_defs,
+                   bool force,
+                   bool patch = false);
+    ReplaceNodeCmd(const std::string& node_path,
+                   bool createNodesAsNeeded,
+                   const std::string& path_to_defs,
+                   bool force,
+                   bool patch = false);
     ReplaceNodeCmd() = default;
 
     const std::string& the_client_defs() const { return clientDefs_; }
@@ -1438,6 +1473,7 @@ public:
     const std::string& path_to_defs() const { return path_to_defs_; }
     bool createNodesAsNeeded() const { return createNodesAsNeeded_; }
     bool force() const { return force_; }
+    bool patch() const { return patch_; }
 
     bool isWrite() const override { return true; }
     int timeout() const override { return 300; }
@@ -1457,11 +1493,13 @@ private:
     static const char* desc(); // The description of the argument as provided to user
 
     STC_Cmd_ptr doHandleRequest(AbstractServer*) const override;
+    STC_Cmd_ptr patch_node(AbstractServer*, const node_ptr& server_node, const defs_ptr& client_defs) const;
     bool authenticate(AbstractServer*, STC_Cmd_ptr&) const override;
     void cleanup() override { std::string().swap(clientDefs_); } /// run in the server, after command send to client
 
     bool createNodesAsNeeded_{false};
     bool force_{false};
+    bool patch_{false}; // update the existing node in place, see DefsPatcher
     std::string pathToNode_;
     std::string path_to_defs_; // Can be empty if defs loaded in memory via python api
     std::string clientDefs_;
@@ -1475,6 +1513,7 @@ private:
            CEREAL_NVP(pathToNode_),
            CEREAL_NVP(path_to_defs_),
            CEREAL_NVP(clientDefs_));
+        CEREAL_OPTIONAL_NVP(ar, patch_, [this]() { return patch_; }); // conditionally save
     }
 };
 
@@ -1851,20 +1890,33 @@ private:
 class CFileCmd final : public UserCmd {
 public:
     enum File_t { ECF, JOB, JOBOUT, MANUAL, KILL, STAT };
+
+    // A range of the file, [begin,end) in bytes or lines, an end of 0 means up to the end of file.
+    // When a range is requested the server replies with SFileCmd, and max_lines is ignored
+    enum Range_t { NO_RANGE, BYTES, LINES };
+
     CFileCmd(const std::string& pathToNode, File_t file, size_t max_lines)
         : file_(file),
           pathToNode_(pathToNode),
           max_lines_(max_lines) {}
-    CFileCmd(const std::string& pathToNode, const std::string& file_type, const std::string& max_lines);
+    CFileCmd(const std::string& pathToNode, File_t file, Range_t range, size_t range_begin, size_t range_end);
+    CFileCmd(const std::string& pathToNode,
+             const std::string& file_type,
+             const std::string& max_lines,
+             const std::string& range = "");
     CFileCmd() = default;
 
     // Uses by equals only
     const std::string& pathToNode() const { return pathToNode_; }
     File_t fileType() const { return file_; }
     size_t max_lines() const { return max_lines_; }
+    Range_t range() const { return range_; }
+    size_t range_begin() const { return range_begin_; }
+    size_t range_end() const { return range_end_; }
 
     static std::vector<CFileCmd::File_t> fileTypesVec();
     static std::string toString(File_t);
+    static std::string toString(Range_t, size_t range_begin, size_t range_end); // i.e. bytes=100- | lines=0-20
 
     bool handleRequestIsTestable() const override { return false; }
     void print(std::string&) const override;
@@ -1885,11 +1937,17 @@ private:
     File_t file_{ECF};
     std::string pathToNode_;
     size_t max_lines_{0};
+    Range_t range_{NO_RANGE};
+    size_t range_begin_{0};
+    size_t range_end_{0};
 
     friend class cereal::access;
     template <class Archive>
     void serialize(Archive& ar, std::uint32_t const /*version*/) {
         ar(cereal::base_class<UserCmd>(this), CEREAL_NVP(file_), CEREAL_NVP(pathToNode_), CEREAL_NVP(max_lines_));
+        CEREAL_OPTIONAL_NVP(ar, range_, [this]() { return range_ != NO_RANGE; });      // conditionally save
+        CEREAL_OPTIONAL_NVP(ar, range_begin_, [this]() { return range_begin_ != 0; }); // conditionally save
+        CEREAL_OPTIONAL_NVP(ar, range_end_, [this]() { return range_end_ != 0; });     // conditionally save
     }
 };
 
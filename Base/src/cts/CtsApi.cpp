@@ -258,7 +258,8 @@ const char* CtsApi::newsArg() {
     return "news";
 }
 
-std::vector<std::string> CtsApi::loadDefs(const std::string& filePath, bool force, bool check_only, bool print) {
+std::vector<std::string>
+CtsApi::loadDefs(const std::string& filePath, bool force, bool check_only, bool print, bool patch) {
 
     std::string ret = "--load=";
     ret += filePath;
@@ -272,6 +273,8 @@ std::vector<std::string> CtsApi::loadDefs(const std::string& filePath, bool forc
         retVec.emplace_back("check_only");
     if (print)
         retVec.emplace_back("print");
+    if (patch)
+        retVec.emplace_back("patch");
     return retVec;
 }
 const char* CtsApi::loadDefsArg() {
@@ -794,7 +797,8 @@ const char* CtsApi::orderArg() {
 std::vector<std::string> CtsApi::replace(const std::string& absNodePath,
                                          const std::string& path_to_client_defs,
                                          bool create_parents_as_required,
-                                         bool force) {
+                                         bool force,
+                                         bool patch) {
     std::vector<std::string> retVec;
     retVec.reserve(3);
 
@@ -806,6 +810,8 @@ std::vector<std::string> CtsApi::replace(const std::string& absNodePath,
         retVec.emplace_back("parent");
     if (force)
         retVec.emplace_back("force");
+    if (patch)
+        retVec.emplace_back("patch");
 
     return retVec;
 }
@@ -924,15 +930,19 @@ const char* CtsApi::freeDepArg() {
     return "free-dep";
 }
 
-std::vector<std::string>
-CtsApi::file(const std::string& absNodePath, const std::string& fileType, const std::string& max_lines) {
+std::vector<std::string> CtsApi::file(const std::string& absNodePath,
+                                      const std::string& fileType,
+                                      const std::string& max_lines,
+                                      const std::string& range) {
     std::vector<std::string> retVec;
-    retVec.reserve(3);
+    retVec.reserve(4);
     std::string ret = "--file=";
     ret += absNodePath;
     retVec.push_back(ret);
     retVec.push_back(fileType);
     retVec.push_back(max_lines);
+    if (!range.empty())
+        retVec.push_back(range);
     return retVec;
 }
 const char* CtsApi::fileArg() {
@@ -38,7 +38,8 @@ public:
     static std::vector<std::string> loadDefs(const std::string& filePath,
                                              bool force,
                                              bool check_only,
-                                             bool print); // check_only & print are client side only
+                                             bool print,
+                                             bool patch = false); // check_only & print are client side only
     static std::string get(const std::string& absNodePath = "");
     static std::string get_state(const std::string& absNodePath = "");
     static std::string migrate(const std::string& absNodePath = "");
@@ -130,7 +131,8 @@ public:
     static std::vector<std::string> replace(const std::string& absNodePath,
                                             const std::string& path_to_client_defs,
                                             bool create_parents_as_required = true,
-                                            bool force                      = false);
+                                            bool force                      = false,
+                                            bool patch                      = false);
     static std::vector<std::string> requeue(const std::vector<std::string>& paths,
                                             const std::string& option /* [ "" | "force" | "abort" ] */);
     static std::vector<std::string> requeue(const std::string& absNodePath,
@@ -164,8 +166,10 @@ public:
                                             bool date    = false,
                                             bool time    = false);
 
-    static std::vector<std::string>
-    file(const std::string& absNodePath, const std::string& fileType, const std::string& max_lines);
+    static std::vector<std::string> file(const std::string& absNodePath,
+                                         const std::string& fileType,
+                                         const std::string& max_lines,
+                                         const std::string& range = "");
     static std::vector<std::string> plug(const std::string& sourcePath, const std::string& destPath);
 
     static std::vector<std::string>
@@ -503,11 +503,23 @@ static const char* server_load_desc() {
            "    o <host>.<port>.png\n\n"
            "The generated script can be manually changed, to see different rendering\n"
            "effects. i.e. just run 'gnuplot <host>.<port>.gnuplot.script'\n\n"
-           "  arg1 = <optional> path to log file\n\n"
+           "  arg1 = <optional> path to log file\n"
+           "  argN = <optional> more log files, i.e. rotated logs. Files ending in .gz, .Z, .bz2,\n"
+           "         .xz or .zst are decompressed on the fly. The files are parsed in parallel.\n"
+           "  The following options are only used when the log files are given:\n"
+           "    from=YYYY-MM-DD[THH:MM[:SS]]  only count the requests from this time\n"
+           "    to=YYYY-MM-DD[THH:MM[:SS]]    only count the requests before this time\n"
+           "    resolution=[ second | minute ] count the requests per second<default> or minute\n"
+           "    output=gnuplot,csv,json        any combination, default is gnuplot. Also writes:\n"
+           "         o <host>.<port>.load.csv   lines of time,type,name,requests where type is\n"
+           "                                    [ total | child | user | command | suite ]\n"
+           "         o <host>.<port>.load.json  the totals, and the requests per command and\n"
+           "                                    suite for each second/minute\n\n"
            "If the path to log file is known, it is *preferable* to use this,\n"
            "rather than requesting the log path from the server.\n\n"
            "Usage:\n"
            "   --server_load=/path/to_log_file  # Parses log and generate gnuplot files\n"
+           "   --server_load=ecf.log.1.gz ecf.log from=2023-01-01 output=csv,json\n"
            "   --server_load                    # Log file path is requested from server\n"
            "                                    # which is then used to generate gnuplot files\n"
            "                                    # *AVOID* if log file path is accessible\n\n"
@@ -718,8 +730,9 @@ void CtsCmd::addOption(boost::program_options::options_description& desc) const
             break;
         }
         case CtsCmd::SERVER_LOAD: {
-            desc.add_options()(
-                CtsApi::server_load_arg(), po::value<std::string>()->implicit_value(string("")), server_load_desc());
+            desc.add_options()(CtsApi::server_load_arg(),
+                               po::value<vector<string>>()->multitoken()->zero_tokens(),
+                               server_load_desc());
             break;
         }
         case CtsCmd::NO_CMD:
@@ -762,18 +775,18 @@ void CtsCmd::create(Cmd_ptr& cmd, boost::program_options::variables_map& vm, Abs
     }
     else if (api_ == CtsCmd::SERVER_LOAD) {
 
-        std::string log_file = vm[theArg()].as<std::string>();
+        vector<string> args = vm[theArg()].as<vector<string>>();
         if (ac->debug())
-            std::cout << "  CtsCmd::create CtsCmd::SERVER_LOAD " << log_file << "\n";
+            dumpVecArgs(CtsApi::server_load_arg(), args);
 
-        if (!log_file.empty()) {
+        if (!args.empty()) {
 
             // testing client interface
             if (ac->under_test())
                 return;
 
-            // No need to call server. Parse the log file to create gnu_plot file.
-            Gnuplot gnuplot(log_file, ac->host(), ac->port());
+            // No need to call server. Parse the log files to create gnu_plot file.
+            Gnuplot gnuplot(args, ac->host(), ac->port());
             gnuplot.show_server_load();
 
             return; // Don't create command, since with log file, it is client specific only
@@ -275,6 +275,24 @@ void GroupCTSCmd::setup_user_authentification() {
 }
 
 void GroupCTSCmd::add_edit_history(Defs* defs) const {
+    // When used for bulk edits, i.e. thousands of alter/force commands, add a single record to the root
+    size_t no_of_nodes                  = 0;
+    const ClientToServerCmd* first_edit = nullptr;
+    for (const Cmd_ptr& subCmd : cmdVec_) {
+        size_t edited = subCmd->edit_history_nodes_.size() + subCmd->edit_history_node_paths_.size();
+        if (edited != 0 && !first_edit)
+            first_edit = subCmd.get();
+        no_of_nodes += edited;
+    }
+    if (no_of_nodes > max_edit_history_nodes()) {
+        add_bulk_edit_history(defs, *first_edit, no_of_nodes);
+        for (const Cmd_ptr& subCmd : cmdVec_) {
+            subCmd->edit_history_nodes_.clear();
+            subCmd->edit_history_node_paths_.clear();
+        }
+        return;
+    }
+
     for (Cmd_ptr subCmd : cmdVec_) {
         subCmd->add_edit_history(defs);
     }
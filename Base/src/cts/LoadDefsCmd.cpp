@@ -13,6 +13,7 @@
 // Description :
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
 
+#include <optional>
 #include <stdexcept>
 
 #include <boost/filesystem.hpp>
@@ -22,6 +23,8 @@
 #include "ClientToServerCmd.hpp"
 #include "CtsApi.hpp"
 #include "Defs.hpp"
+#include "DefsPatcher.hpp"
+#include "Ecf.hpp"
 #include "Log.hpp"
 #include "PrintStyle.hpp"
 
@@ -30,7 +33,7 @@ using namespace std;
 using namespace boost;
 namespace po = boost::program_options;
 
-LoadDefsCmd::LoadDefsCmd(const defs_ptr& defs, bool force) : force_(force) {
+LoadDefsCmd::LoadDefsCmd(const defs_ptr& defs, bool force, bool patch) : force_(force), patch_(patch) {
     if (defs) {
         defs->handle_migration();
         defs->save_as_string(defs_, PrintStyle::NET);
@@ -42,8 +45,10 @@ LoadDefsCmd::LoadDefsCmd(const std::string& defs_filename,
                          bool check_only,
                          bool print,
                          bool stats,
-                         const std::vector<std::pair<std::string, std::string>>& client_env)
+                         const std::vector<std::pair<std::string, std::string>>& client_env,
+                         bool patch)
     : force_(force),
+      patch_(patch),
       defs_filename_(defs_filename) {
     if (defs_filename_.empty()) {
         std::stringstream ss;
@@ -103,6 +108,8 @@ bool LoadDefsCmd::equals(ClientToServerCmd* rhs) const {
         return false;
     if (defs_ != the_rhs->defs_as_string())
         return false;
+    if (patch_ != the_rhs->patch())
+        return false;
     return true;
 }
 
@@ -115,19 +122,43 @@ STC_Cmd_ptr LoadDefsCmd::doHandleRequest(AbstractServer* as) const {
         // Parse the string and load the defs file into memory.
         std::string errMsg, warningMsg;
         defs_ptr defs = Defs::create();
-        if (!defs->restore_from_string(defs_, errMsg, warningMsg)) {
-            std::stringstream ss;
-            ss << "LoadDefsCmd::doHandleRequest : Could not parse file " << defs_filename_ << " : " << errMsg;
-            throw std::runtime_error(ss.str());
+        {
+            // When patching, parsing the new defs must not count as a structural change to the server defs
+            std::optional<EcfPreserveChangeNo> preserveChangeNo;
+            if (patch_)
+                preserveChangeNo.emplace();
+            if (!defs->restore_from_string(defs_, errMsg, warningMsg)) {
+                std::stringstream ss;
+                ss << "LoadDefsCmd::doHandleRequest : Could not parse file " << defs_filename_ << " : " << errMsg;
+                throw std::runtime_error(ss.str());
+            }
         }
 
-        // After the updateDefs, defs will be left with NO suites.
-        // Can't really used defs after this point
-        // *NOTE* Externs are not persisted. Hence calling check() will report
-        // all errors, references are not resolved.
-        as->updateDefs(defs, force_);
-
-        LOG_ASSERT(defs->suiteVec().size() == 0, "Expected suites to be transferred to server defs");
+        if (patch_) {
+            // Only the differences are applied to suites of the same name, the rest of their state is kept.
+            // Unless a suite is replaced, i.e. its clock changed, clients can sync incrementally.
+            DefsPatcher patcher(*as->defs(), *defs);
+            if (force_) {
+                for (const node_ptr& node : patcher.nodes_to_remove()) {
+                    as->zombie_ctrl().add_user_zombies(node.get(), CtsApi::loadDefsArg());
+                }
+            }
+
+            std::string errorMsg;
+            if (!patcher.apply(force_, errorMsg)) {
+                throw std::runtime_error(errorMsg);
+            }
+            ecf::log(Log::MSG, "LoadDefsCmd: patch " + patcher.summary());
+        }
+        else {
+            // After the updateDefs, defs will be left with NO suites.
+            // Can't really used defs after this point
+            // *NOTE* Externs are not persisted. Hence calling check() will report
+            // all errors, references are not resolved.
+            as->updateDefs(defs, force_);
+
+            LOG_ASSERT(defs->suiteVec().size() == 0, "Expected suites to be transferred to server defs");
+        }
     }
     LOG_ASSERT(as->defs()->externs().size() == 0, "Expected server to have no externs");
 
@@ -137,18 +168,21 @@ STC_Cmd_ptr LoadDefsCmd::doHandleRequest(AbstractServer* as) const {
 void LoadDefsCmd::print(std::string& os) const {
     /// If defs_filename_ is empty, the Defs was a in memory defs.
     if (defs_filename_.empty()) {
-        user_cmd(
-            os, CtsApi::to_string(CtsApi::loadDefs("<in-memory-defs>", force_, false /*check_only*/, false /*print*/)));
+        user_cmd(os,
+                 CtsApi::to_string(
+                     CtsApi::loadDefs("<in-memory-defs>", force_, false /*check_only*/, false /*print*/, patch_)));
         return;
     }
-    user_cmd(os, CtsApi::to_string(CtsApi::loadDefs(defs_filename_, force_, false /*check_only*/, false /*print*/)));
+    user_cmd(
+        os, CtsApi::to_string(CtsApi::loadDefs(defs_filename_, force_, false /*check_only*/, false /*print*/, patch_)));
 }
 void LoadDefsCmd::print_only(std::string& os) const {
     if (defs_filename_.empty()) {
-        os += CtsApi::to_string(CtsApi::loadDefs("<in-memory-defs>", force_, false /*check_only*/, false /*print*/));
+        os += CtsApi::to_string(
+            CtsApi::loadDefs("<in-memory-defs>", force_, false /*check_only*/, false /*print*/, patch_));
         return;
     }
-    os += CtsApi::to_string(CtsApi::loadDefs(defs_filename_, force_, false /*check_only*/, false /*print*/));
+    os += CtsApi::to_string(CtsApi::loadDefs(defs_filename_, force_, false /*check_only*/, false /*print*/, patch_));
 }
 
 const char* LoadDefsCmd::arg() {
@@ -160,13 +194,17 @@ const char* LoadDefsCmd::desc() {
            "additionally in-limit references to limits will be validated.\n"
            "If the server already has the 'suites' of the same name, then a error message is issued.\n"
            "The suite's can be overwritten if the force option is used.\n"
+           "Alternatively the 'patch' option will update suite's of the same name in place. Only the\n"
+           "differences are applied, nodes and attributes whose definition did not change keep their state.\n"
+           "Nodes with active or submitted tasks, are only deleted or replaced when 'force' is also used.\n"
            "To just check the definition and not send to server, use 'check_only'\n"
            "This command can also be used to load a checkpoint file into the server\n"
            "  arg1 = path to the definition file or checkpoint file\n"
-           "  arg2 = (optional) [ force | check_only | print | stats ]  # default = false for all\n"
+           "  arg2 = (optional) [ force | check_only | print | stats | patch ]  # default = false for all\n"
            "Usage:\n"
            "--load=/my/home/exotic.def               # will error if suites of same name exists\n"
            "--load=/my/home/exotic.def force         # overwrite suite's of same name in the server\n"
+           "--load=/my/home/exotic.def patch         # update suite's of same name, keeping their state\n"
            "--load=/my/home/exotic.def check_only    # Just check, don't send to server\n"
            "--load=/my/home/exotic.def stats         # Show defs statistics, don't send to server\n"
            "--load=host1.3141.check                  # Load checkpoint file to the server\n"
@@ -186,6 +224,7 @@ void LoadDefsCmd::create(Cmd_ptr& cmd, boost::program_options::variables_map& vm
     bool force      = false;
     bool print      = false;
     bool stats      = false;
+    bool patch      = false;
     std::string defs_filename;
     for (const auto& arg : args) {
         if (arg == "force")
@@ -196,13 +235,15 @@ void LoadDefsCmd::create(Cmd_ptr& cmd, boost::program_options::variables_map& vm
             print = true;
         else if (arg == "stats")
             stats = true;
+        else if (arg == "patch")
+            patch = true;
         else
             defs_filename = arg;
     }
     if (clientEnv->debug())
         cout << "  LoadDefsCmd::create: Defs file '" << defs_filename << "'.\n";
 
-    cmd = LoadDefsCmd::create(defs_filename, force, check_only, print, stats, clientEnv);
+    cmd = LoadDefsCmd::create(defs_filename, force, check_only, print, stats, clientEnv, patch);
 }
 
 Cmd_ptr LoadDefsCmd::create(const std::string& defs_filename,
@@ -210,13 +251,14 @@ Cmd_ptr LoadDefsCmd::create(const std::string& defs_filename,
                             bool check_only,
                             bool print,
                             bool stats,
-                            AbstractClientEnv* clientEnv) {
+                            AbstractClientEnv* clientEnv,
+                            bool patch) {
     // For test allow the server environment to be changed, i.e. allow us to inject ECF_CLIENT
     // The server will also update the env on the defs, server will override client env, where they clash
 
     // The constructor can throw if parsing of defs_filename fail's
     std::shared_ptr<LoadDefsCmd> load_cmd =
-        std::make_shared<LoadDefsCmd>(defs_filename, force, check_only, print, stats, clientEnv->env());
+        std::make_shared<LoadDefsCmd>(defs_filename, force, check_only, print, stats, clientEnv->env(), patch);
 
     // Don't send to server if checking, i.e cmd not set
     if (check_only || stats || print)
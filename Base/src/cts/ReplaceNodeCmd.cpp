@@ -13,6 +13,7 @@
 // Description :
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
 
+#include <optional>
 #include <stdexcept>
 
 #include "AbstractClientEnv.hpp"
@@ -20,6 +21,8 @@
 #include "ClientToServerCmd.hpp"
 #include "CtsApi.hpp"
 #include "Defs.hpp"
+#include "DefsPatcher.hpp"
+#include "Ecf.hpp"
 #include "Suite.hpp"
 
 using namespace ecf;
@@ -27,9 +30,14 @@ using namespace std;
 using namespace boost;
 namespace po = boost::program_options;
 
-ReplaceNodeCmd::ReplaceNodeCmd(const std::string& node_path, bool createNodesAsNeeded, defs_ptr client_defs, bool force)
+ReplaceNodeCmd::ReplaceNodeCmd(const std::string& node_path,
+                               bool createNodesAsNeeded,
+                               defs_ptr client_defs,
+                               bool force,
+                               bool patch)
     : createNodesAsNeeded_(createNodesAsNeeded),
       force_(force),
+      patch_(patch),
       pathToNode_(node_path) {
     if (!client_defs.get()) {
         throw std::runtime_error("ReplaceNodeCmd::ReplaceNodeCmd: client definition is empty");
@@ -60,9 +68,11 @@ ReplaceNodeCmd::ReplaceNodeCmd(const std::string& node_path, bool createNodesAsN
 ReplaceNodeCmd::ReplaceNodeCmd(const std::string& node_path,
                                bool createNodesAsNeeded,
                                const std::string& path_to_defs,
-                               bool force)
+                               bool force,
+                               bool patch)
     : createNodesAsNeeded_(createNodesAsNeeded),
       force_(force),
+      patch_(patch),
       pathToNode_(node_path),
       path_to_defs_(path_to_defs) {
     // Parse the file and load the defs file into memory.
@@ -107,6 +117,8 @@ bool ReplaceNodeCmd::equals(ClientToServerCmd* rhs) const {
     }
     if (force_ != the_rhs->force())
         return false;
+    if (patch_ != the_rhs->patch())
+        return false;
     if (pathToNode_ != the_rhs->pathToNode())
         return false;
     if (path_to_defs_ != the_rhs->path_to_defs())
@@ -123,10 +135,24 @@ STC_Cmd_ptr ReplaceNodeCmd::doHandleRequest(AbstractServer* as) const {
 
     std::string errMsg, warningMsg;
     defs_ptr client_defs = Defs::create();
-    if (!client_defs->restore_from_string(clientDefs_, errMsg, warningMsg)) {
-        std::stringstream ss;
-        ss << "ReplaceNodeCmd::doHandleRequest : Could not create client defs : " << errMsg;
-        throw std::runtime_error(ss.str());
+    {
+        // When patching, parsing the client defs must not count as a structural change to the server defs
+        std::optional<EcfPreserveChangeNo> preserveChangeNo;
+        if (patch_)
+            preserveChangeNo.emplace();
+        if (!client_defs->restore_from_string(clientDefs_, errMsg, warningMsg)) {
+            std::stringstream ss;
+            ss << "ReplaceNodeCmd::doHandleRequest : Could not create client defs : " << errMsg;
+            throw std::runtime_error(ss.str());
+        }
+    }
+
+    if (patch_) {
+        node_ptr server_node = defs->findAbsNode(pathToNode_);
+        if (server_node) {
+            return patch_node(as, server_node, client_defs);
+        }
+        // Node does not exist in the server, hence nothing to patch, fall back to add
     }
 
     if (force_) {
@@ -155,6 +181,35 @@ STC_Cmd_ptr ReplaceNodeCmd::doHandleRequest(AbstractServer* as) const {
     return doJobSubmission(as);
 }
 
+STC_Cmd_ptr
+ReplaceNodeCmd::patch_node(AbstractServer* as, const node_ptr& server_node, const defs_ptr& client_defs) const {
+    // Only apply the differences, nodes and attributes whose definition did not change keep their state
+    node_ptr client_node = client_defs->findAbsNode(pathToNode_);
+    DefsPatcher patcher(server_node, client_node);
+    if (force_) {
+        for (const node_ptr& node : patcher.nodes_to_remove()) {
+            as->zombie_ctrl().add_user_zombies(node.get(), CtsApi::replace_arg());
+        }
+    }
+
+    std::string errorMsg;
+    if (!patcher.apply(force_, errorMsg)) {
+        throw std::runtime_error(errorMsg);
+    }
+
+    Defs* defs = as->defs().get();
+    add_node_for_edit_history(defs, pathToNode_);
+
+    // The node itself may have been replaced, i.e. if its type changed
+    node_ptr patched_node = defs->findAbsNode(pathToNode_);
+    std::string warning_msg;
+    if (!patched_node->suite()->check(errorMsg, warning_msg)) {
+        throw std::runtime_error(errorMsg);
+    }
+
+    return doJobSubmission(as);
+}
+
 bool ReplaceNodeCmd::authenticate(AbstractServer* as, STC_Cmd_ptr& cmd) const {
     return do_authenticate(as, cmd, pathToNode_);
 }
@@ -163,13 +218,15 @@ void ReplaceNodeCmd::print(std::string& os) const {
     std::string path_to_client_defs = path_to_defs_;
     if (path_to_client_defs.empty())
         path_to_client_defs = "<empty>"; // defs must have been loaded in memory via python api
-    user_cmd(os, CtsApi::to_string(CtsApi::replace(pathToNode_, path_to_client_defs, createNodesAsNeeded_, force_)));
+    user_cmd(os,
+             CtsApi::to_string(
+                 CtsApi::replace(pathToNode_, path_to_client_defs, createNodesAsNeeded_, force_, patch_)));
 }
 void ReplaceNodeCmd::print_only(std::string& os) const {
     std::string path_to_client_defs = path_to_defs_;
     if (path_to_client_defs.empty())
         path_to_client_defs = "<empty>"; // defs must have been loaded in memory via python api
-    os += CtsApi::to_string(CtsApi::replace(pathToNode_, path_to_client_defs, createNodesAsNeeded_, force_));
+    os += CtsApi::to_string(CtsApi::replace(pathToNode_, path_to_client_defs, createNodesAsNeeded_, force_, patch_));
 }
 
 const char* ReplaceNodeCmd::arg() {
@@ -189,6 +246,9 @@ const char* ReplaceNodeCmd::desc() {
            "         exist in the server\n"
            "  arg4 = (optional) force (default = false) \n"
            "         Force the replacement even if it causes zombies to be created\n"
+           "  arg5 = (optional) patch (default = false) \n"
+           "         Only apply the differences to the existing node, nodes and attributes\n"
+           "         whose definition did not change keep their state\n"
            "Replace can fail if:\n"
            "- The node path(arg1) does not exist in the provided client definition(arg2)\n"
            "- The client definition(arg2) must be free of errors\n"
@@ -201,7 +261,8 @@ const char* ReplaceNodeCmd::desc() {
            "For more information use --help check.\n\n"
            "Usage:\n"
            "  --replace=/suite/f1/t1 /tmp/client.def  parent      # Add/replace node tree /suite/f1/t1\n"
-           "  --replace=/suite/f1/t1 /tmp/client.def  false force # replace t1 even if its active or submitted";
+           "  --replace=/suite/f1/t1 /tmp/client.def  false force # replace t1 even if its active or submitted\n"
+           "  --replace=/suite/f1 /tmp/client.def  parent patch   # update f1 in place, keeping its state";
 }
 
 void ReplaceNodeCmd::addOption(boost::program_options::options_description& desc) const {
@@ -223,6 +284,12 @@ void ReplaceNodeCmd::create(Cmd_ptr& cmd,
         throw std::runtime_error(ss.str());
     }
 
+    bool patch = false;
+    if (args.size() > 2 && args.back() == "patch") {
+        patch = true;
+        args.pop_back();
+    }
+
     std::string pathToNode     = args[0];
     std::string pathToDefsFile = args[1];
     bool createNodesAsNeeded   = true; // parent arg
@@ -232,7 +299,7 @@ void ReplaceNodeCmd::create(Cmd_ptr& cmd,
     if (args.size() == 4 && args[3] == "force")
         force = true;
 
-    cmd = std::make_shared<ReplaceNodeCmd>(pathToNode, createNodesAsNeeded, pathToDefsFile, force);
+    cmd = std::make_shared<ReplaceNodeCmd>(pathToNode, createNodesAsNeeded, pathToDefsFile, force, patch);
 }
 
 std::ostream& operator<<(std::ostream& os, const ReplaceNodeCmd& c) {
@@ -25,6 +25,7 @@
 #include "SNodeCmd.hpp"
 #include "SServerLoadCmd.hpp"
 #include "SStatsCmd.hpp"
+#include "SFileCmd.hpp"
 #include "SStringCmd.hpp"
 #include "SStringVecCmd.hpp"
 #include "SSuitesCmd.hpp"
@@ -42,6 +43,7 @@ STC_Cmd_ptr PreAllocatedReply::error_cmd_                = std::make_shared<Erro
 STC_Cmd_ptr PreAllocatedReply::client_handle_cmd_        = std::make_shared<SClientHandleCmd>();
 STC_Cmd_ptr PreAllocatedReply::client_handle_suites_cmd_ = std::make_shared<SClientHandleSuitesCmd>();
 STC_Cmd_ptr PreAllocatedReply::string_cmd_               = std::make_shared<SStringCmd>();
+STC_Cmd_ptr PreAllocatedReply::file_cmd_                 = std::make_shared<SFileCmd>();
 STC_Cmd_ptr PreAllocatedReply::string_vec_cmd_           = std::make_shared<SStringVecCmd>();
 STC_Cmd_ptr PreAllocatedReply::server_load_cmd_          = std::make_shared<SServerLoadCmd>();
 STC_Cmd_ptr PreAllocatedReply::news_cmd_                 = std::make_shared<SNewsCmd>();
@@ -129,6 +131,13 @@ STC_Cmd_ptr PreAllocatedReply::string_cmd(const std::string& any_string) {
     return string_cmd_;
 }
 
+STC_Cmd_ptr
+PreAllocatedReply::file_cmd(const std::string& contents, size_t offset, size_t file_size, std::time_t modify_time) {
+    auto* cmd = dynamic_cast<SFileCmd*>(file_cmd_.get());
+    cmd->init(contents, offset, file_size, modify_time);
+    return file_cmd_;
+}
+
 STC_Cmd_ptr PreAllocatedReply::string_vec_cmd(const std::vector<std::string>& vec) {
     auto* cmd = dynamic_cast<SStringVecCmd*>(string_vec_cmd_.get());
     cmd->init(vec);
@@ -153,28 +162,32 @@ STC_Cmd_ptr PreAllocatedReply::news_cmd(unsigned int client_handle,
 STC_Cmd_ptr PreAllocatedReply::sync_cmd(unsigned int client_handle,
                                         unsigned int client_state_change_no,
                                         unsigned int client_modify_change_no,
-                                        AbstractServer* as) {
+                                        AbstractServer* as,
+                                        bool compact_paths) {
     auto* cmd = dynamic_cast<SSyncCmd*>(sync_cmd_.get());
     cmd->init(client_handle,
               client_state_change_no,
               client_modify_change_no,
               false /*full sync*/,
               false /*sync suite clock*/,
-              as);
+              as,
+              compact_paths);
     return sync_cmd_;
 }
 
 STC_Cmd_ptr PreAllocatedReply::sync_clock_cmd(unsigned int client_handle,
                                               unsigned int client_state_change_no,
                                               unsigned int client_modify_change_no,
-                                              AbstractServer* as) {
+                                              AbstractServer* as,
+                                              bool compact_paths) {
     auto* cmd = dynamic_cast<SSyncCmd*>(sync_cmd_.get());
     cmd->init(client_handle,
               client_state_change_no,
               client_modify_change_no,
               false /*full sync*/,
               true /*sync suite clock*/,
-              as);
+              as,
+              compact_paths);
     return sync_cmd_;
 }
 
@@ -190,6 +203,7 @@ STC_Cmd_ptr PreAllocatedReply::sync_full_cmd(unsigned int client_handle, Abstrac
 CEREAL_REGISTER_TYPE(DefsCmd)
 CEREAL_REGISTER_TYPE(SNodeCmd)
 CEREAL_REGISTER_TYPE(SStringCmd)
+CEREAL_REGISTER_TYPE(SFileCmd)
 CEREAL_REGISTER_TYPE(SStringVecCmd)
 CEREAL_REGISTER_TYPE(SServerLoadCmd)
 CEREAL_REGISTER_TYPE(GroupSTCCmd)
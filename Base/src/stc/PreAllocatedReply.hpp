@@ -14,6 +14,7 @@
 //
 // Description :
 //============================================================================
+#include <ctime>
 #include <string>
 
 #include <boost/core/noncopyable.hpp>
@@ -45,6 +46,7 @@ public:
     static STC_Cmd_ptr client_handle_cmd(int handle);
     static STC_Cmd_ptr client_handle_suites_cmd(AbstractServer*);
     static STC_Cmd_ptr string_cmd(const std::string& any_string);
+    static STC_Cmd_ptr file_cmd(const std::string& contents, size_t offset, size_t file_size, std::time_t modify_time);
     static STC_Cmd_ptr string_vec_cmd(const std::vector<std::string>&);
     static STC_Cmd_ptr server_load_cmd(const std::string& any_string);
     static STC_Cmd_ptr news_cmd(unsigned int client_handle,
@@ -54,11 +56,13 @@ public:
     static STC_Cmd_ptr sync_cmd(unsigned int client_handle,
                                 unsigned int client_state_change_no,
                                 unsigned int client_modify_change_no,
-                                AbstractServer* as);
+                                AbstractServer* as,
+                                bool compact_paths = false);
     static STC_Cmd_ptr sync_clock_cmd(unsigned int client_handle,
                                       unsigned int client_state_change_no,
                                       unsigned int client_modify_change_no,
-                                      AbstractServer* as);
+                                      AbstractServer* as,
+                                      bool compact_paths = false);
     static STC_Cmd_ptr sync_full_cmd(unsigned int client_handle, AbstractServer* as);
 
 private:
@@ -72,6 +76,7 @@ private:
     static STC_Cmd_ptr client_handle_cmd_;
     static STC_Cmd_ptr client_handle_suites_cmd_;
     static STC_Cmd_ptr string_cmd_;
+    static STC_Cmd_ptr file_cmd_;
     static STC_Cmd_ptr string_vec_cmd_;
     static STC_Cmd_ptr server_load_cmd_;
     static STC_Cmd_ptr news_cmd_;
@@ -0,0 +1,64 @@
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#include "SFileCmd.hpp"
+
+#include <iostream>
+
+using namespace std;
+
+void SFileCmd::init(const std::string& contents, size_t offset, size_t file_size, std::time_t modify_time) {
+    str_         = contents;
+    offset_      = offset;
+    file_size_   = file_size;
+    modify_time_ = modify_time;
+}
+
+bool SFileCmd::equals(ServerToClientCmd* rhs) const {
+    auto* the_rhs = dynamic_cast<SFileCmd*>(rhs);
+    if (!the_rhs)
+        return false;
+    if (str_ != the_rhs->get_string())
+        return false;
+    if (offset_ != the_rhs->offset())
+        return false;
+    if (file_size_ != the_rhs->file_size())
+        return false;
+    if (modify_time_ != the_rhs->modify_time())
+        return false;
+    return ServerToClientCmd::equals(rhs);
+}
+
+std::string SFileCmd::print() const {
+    return "cmd:SFileCmd ";
+}
+
+bool SFileCmd::handle_server_response(ServerReply& server_reply, Cmd_ptr cts_cmd, bool debug) const {
+    if (debug)
+        cout << "  SFileCmd::handle_server_response str.size()= " << str_.size() << " offset= " << offset_
+             << " file_size= " << file_size_ << " modify_time= " << modify_time_ << "\n";
+    if (server_reply.cli())
+        std::cout << str_;
+    else {
+        server_reply.set_string(str_);
+        server_reply.set_file_range(offset_, file_size_, modify_time_);
+    }
+    return true;
+}
+
+std::ostream& operator<<(std::ostream& os, const SFileCmd& c) {
+    os << c.print();
+    return os;
+}
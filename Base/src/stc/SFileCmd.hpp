@@ -0,0 +1,62 @@
+#ifndef SFILE_CMD_HPP_
+#define SFILE_CMD_HPP_
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#include <ctime>
+
+#include "ServerToClientCmd.hpp"
+
+///================================================================================
+/// Paired with CFileCmd, when a range of the file was requested
+/// Client---(CFileCmd)---->Server-----(SFileCmd)--->client:
+/// The requested range of the file, the byte offset it starts at, and the size
+/// and modification time of the whole file. Clients can follow a file that is
+/// still being written, by asking for the bytes from offset + size of contents.
+///================================================================================
+class SFileCmd final : public ServerToClientCmd {
+public:
+    SFileCmd() : ServerToClientCmd() {}
+
+    void init(const std::string& contents, size_t offset, size_t file_size, std::time_t modify_time);
+    std::string print() const override;
+    bool equals(ServerToClientCmd*) const override;
+    const std::string& get_string() const override { return str_; }
+    size_t offset() const { return offset_; }
+    size_t file_size() const { return file_size_; }
+    std::time_t modify_time() const { return modify_time_; }
+    bool handle_server_response(ServerReply& server_reply, Cmd_ptr cts_cmd, bool debug) const override;
+    void cleanup() override { std::string().swap(str_); } /// run in the server, after command send to client
+
+private:
+    std::string str_;
+    size_t offset_{0};
+    size_t file_size_{0};
+    std::time_t modify_time_{0};
+
+    friend class cereal::access;
+    template <class Archive>
+    void serialize(Archive& ar, std::uint32_t const /*version*/) {
+        ar(cereal::base_class<ServerToClientCmd>(this),
+           CEREAL_NVP(str_),
+           CEREAL_NVP(offset_),
+           CEREAL_NVP(file_size_),
+           CEREAL_NVP(modify_time_));
+    }
+};
+
+std::ostream& operator<<(std::ostream& os, const SFileCmd&);
+
+#endif
@@ -37,10 +37,11 @@ SSyncCmd::SSyncCmd(unsigned int client_handle,
     init(client_handle, client_state_change_no, client_modify_change_no, false, false, as);
 }
 
-void SSyncCmd::reset_data_members(unsigned int client_state_change_no, bool sync_suite_clock) {
+void SSyncCmd::reset_data_members(unsigned int client_state_change_no, bool sync_suite_clock, bool compact_paths) {
     full_defs_ = false;
     incremental_changes_.init(client_state_change_no,
-                              sync_suite_clock); // persisted, used for returning INCREMENTAL changes
+                              sync_suite_clock,
+                              compact_paths); // persisted, used for returning INCREMENTAL changes
     server_defs_.clear();                        // persisted, used for returning FULL definition
     full_server_defs_as_string_.clear(); // semi-persisted, i.e on load & not on saving used to return cached defs
 }
@@ -50,7 +51,8 @@ void SSyncCmd::init(unsigned int client_handle, // a reference to a set of suite
                     unsigned int client_modify_change_no,
                     bool do_full_sync,
                     bool sync_suite_clock,
-                    AbstractServer* as) {
+                    AbstractServer* as,
+                    bool compact_paths) {
     // ********************************************************
     // This is called in the server
     // ********************************************************
@@ -61,7 +63,7 @@ void SSyncCmd::init(unsigned int client_handle, // a reference to a set of suite
 #endif
 
     // Reset all data members since this command can be re-used
-    reset_data_members(client_state_change_no, sync_suite_clock);
+    reset_data_members(client_state_change_no, sync_suite_clock, compact_paths);
 
     // explicit request
     if (do_full_sync) {
@@ -188,6 +190,12 @@ void SSyncCmd::init(unsigned int client_handle, // a reference to a set of suite
 #endif
 }
 
+bool SSyncCmd::client_in_sync(unsigned int client_state_change_no, unsigned int client_modify_change_no) const {
+    return !full_defs_ && server_defs_.empty() && incremental_changes_.size() == 0 &&
+           incremental_changes_.get_server_state_change_no() == client_state_change_no &&
+           incremental_changes_.get_server_modify_change_no() == client_modify_change_no;
+}
+
 void SSyncCmd::full_sync(unsigned int client_handle, AbstractServer* as) {
     Defs* server_defs = as->defs().get();
 
@@ -57,6 +57,9 @@ public:
     /// changes in the server. Returns true if client defs changed.
     bool do_sync(ServerReply& server_reply, bool debug = false) const;
 
+    /// Server side: Return true if there is nothing to send, i.e. no changes since client change numbers
+    bool client_in_sync(unsigned int client_state_change_no, unsigned int client_modify_change_no) const;
+
 private:
     friend class PreAllocatedReply;
     void init(unsigned int client_handle, // a reference to a set of suites used by client
@@ -64,12 +67,13 @@ private:
               unsigned int client_modify_change_no,
               bool full_sync,
               bool sync_suite_clock,
-              AbstractServer* as);
+              AbstractServer* as,
+              bool compact_paths = false);
 
     /// For use when doing a full sync
     void init(unsigned int client_handle, AbstractServer* as);
 
-    void reset_data_members(unsigned int client_state_change_no, bool sync_suite_clock);
+    void reset_data_members(unsigned int client_state_change_no, bool sync_suite_clock, bool compact_paths);
     void full_sync(unsigned int client_handle, AbstractServer* as);
     void cleanup() override; /// run in the server, after command sent to client
 
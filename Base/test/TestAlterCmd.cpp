@@ -1267,6 +1267,45 @@ BOOST_AUTO_TEST_CASE(test_alter_cmd_errors) {
     System::destroy();
 }
 
+BOOST_AUTO_TEST_CASE(test_alter_cmd_bulk_edit_history) {
+    cout << "Base:: ...test_alter_cmd_bulk_edit_history\n";
+
+    // Editing more than ClientToServerCmd::max_edit_history_nodes(), should add a single record to the root
+    Defs defs;
+    suite_ptr s = defs.add_suite("suite");
+    s->addDefStatus(DState::SUSPENDED); // avoid AlterCmd from job submission
+    family_ptr f = s->add_family("f");
+    std::vector<std::string> paths;
+    for (int i = 0; i < 1200; i++) {
+        paths.push_back(f->add_task("t" + std::to_string(i))->absNodePath());
+    }
+
+    TestHelper::invokeRequest(&defs, Cmd_ptr(new AlterCmd(paths, "add", "variable", "name", "value")));
+    for (const auto& path : paths) {
+        node_ptr task = defs.findAbsNode(path);
+        BOOST_REQUIRE_MESSAGE(task && task->findVariable("name").theValue() == "value",
+                              "Expected variable to be added to " << path);
+    }
+    BOOST_CHECK_MESSAGE(defs.get_edit_history("/").size() == 1,
+                        "expected a single edit history on the root but found " << defs.get_edit_history("/").size());
+    BOOST_CHECK_MESSAGE(defs.get_edit_history(paths[0]).empty(), "expected no edit history on the tasks");
+
+    // Likewise for a group of commands
+    std::shared_ptr<GroupCTSCmd> group = std::make_shared<GroupCTSCmd>();
+    for (const auto& path : paths) {
+        group->addChild(std::make_shared<AlterCmd>(path, AlterCmd::VARIABLE, "name", "changed"));
+    }
+    TestHelper::invokeRequest(&defs, group);
+    BOOST_CHECK_MESSAGE(defs.findAbsNode(paths.back())->findVariable("name").theValue() == "changed",
+                        "Expected variable to be changed");
+    std::vector<std::string> root_history = defs.get_edit_history("/");
+    BOOST_REQUIRE_MESSAGE(root_history.size() == 2,
+                          "expected 2 edit history on the root but found " << root_history.size());
+    BOOST_CHECK_MESSAGE(root_history[1].find("(bulk edit of 1200 nodes)") != std::string::npos,
+                        "expected bulk edit history but found " << root_history[1]);
+    BOOST_CHECK_MESSAGE(defs.get_edit_history(paths[0]).empty(), "expected no edit history on the tasks");
+}
+
 BOOST_AUTO_TEST_CASE(test_destroy_log5) {
     Log::destroy();
     fs::remove("test_add_log5.log");
@@ -19,14 +19,19 @@
 #include <boost/filesystem/path.hpp>
 
 #include "Defs.hpp"
+#include "ExprAst.hpp"
+#include "Family.hpp"
 #include "File.hpp"
 #include "JobProfiler.hpp"
 #include "Jobs.hpp"
 #include "JobsParam.hpp"
 #include "Log.hpp"
 #include "Str.hpp"
+#include "Suite.hpp"
+#include "SyntheticDefs.hpp"
 #include "Task.hpp"
 #include "Variable.hpp"
+#include "perf_timer.hpp"
 
 using namespace std;
 using namespace ecf;
@@ -82,10 +87,57 @@ namespace fs = boost::filesystem;
 //
 //       3.118979324 seconds time elapsed                                          ( +-  2.80% )
 
+// Trigger evaluation: perf_job_gen --triggers [name=value ...]
+// The defs is created by SyntheticDefs, the arguments are its parameters. Every task, apart from
+// the first in each family, triggers on <trigger_refs> of its earlier siblings. All trigger
+// expressions are then repeatedly evaluated. After the first pass, every referenced node is
+// resolved from the cached node handle(see NodeTable.hpp), rather than locking a weak_ptr.
+// Nothing is complete, hence every expression is false, and every reference is evaluated.
+static int trigger_perf(int argc, char* argv[]) {
+    SyntheticDefs::Params params;
+    params.suites          = 1;
+    params.depth           = 1;
+    params.fan_out         = 10;
+    params.tasks           = 100;
+    params.trigger_density = 1;
+    params.trigger_refs    = 20;
+    try {
+        for (int i = 2; i < argc; i++)
+            params.set(argv[i]);
+    }
+    catch (std::exception& e) {
+        cout << e.what() << "\n";
+        return 1;
+    }
+
+    defs_ptr defs = SyntheticDefs(params).create();
+    std::vector<Task*> tasks;
+    defs->getAllTasks(tasks);
+
+    const int no_of_evaluations = 100;
+    size_t evaluated            = 0;
+    Timer<std::chrono::milliseconds> timer;
+    for (int i = 0; i < no_of_evaluations; i++) {
+        for (Task* task : tasks) {
+            AstTop* ast = task->triggerAst();
+            if (ast && ast->evaluate())
+                evaluated++;
+        }
+    }
+    cout << "trigger evaluation of " << tasks.size() << " tasks, " << no_of_evaluations << " times ("
+         << params.to_string() << ") : " << timer.elapsed().count() << "ms (" << evaluated << " true)\n";
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
+    if (argc >= 2 && std::string(argv[1]) == "--triggers") {
+        return trigger_perf(argc, argv);
+    }
+
     if (argc != 2) {
         cout << "TestJobGenPerf.cpp --> " << argv[0] << "\n";
         cout << "Expect single argument which is path to a defs file\n";
+        cout << "or --triggers [name=value ...], to time trigger evaluation, see SyntheticDefs::Params\n";
         return 1;
     }
 
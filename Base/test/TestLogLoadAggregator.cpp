@@ -0,0 +1,135 @@
+//============================================================================
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+//============================================================================
+
+#include <fstream>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "File.hpp"
+#include "LogLoadAggregator.hpp"
+
+using namespace boost;
+namespace fs = boost::filesystem;
+using namespace std;
+using namespace ecf;
+
+BOOST_AUTO_TEST_SUITE(BaseTestSuite)
+
+static size_t requests_for(const std::vector<std::pair<size_t, size_t>>& counts,
+                           const std::vector<std::string>& names,
+                           const std::string& name) {
+    for (const auto& c : counts) {
+        if (names[c.first] == name)
+            return c.second;
+    }
+    return 0;
+}
+
+BOOST_AUTO_TEST_CASE(test_log_load_time_conversion) {
+    cout << "Base:: ...test_log_load_time_conversion\n";
+
+    std::string log_time = "13:53:56 4.10.2018";
+    std::time_t t        = LogLoadAggregator::log_time(log_time.c_str(), log_time.size());
+    BOOST_CHECK_MESSAGE(t == 1538661236, "Expected 1538661236 but found " << t);
+    BOOST_CHECK_MESSAGE(LogLoadAggregator::to_log_time(t) == log_time,
+                        "Expected " << log_time << " but found " << LogLoadAggregator::to_log_time(t));
+    BOOST_CHECK_MESSAGE(LogLoadAggregator::to_iso(t) == "2018-10-04T13:53:56",
+                        "Unexpected " << LogLoadAggregator::to_iso(t));
+    BOOST_CHECK(LogLoadAggregator::iso_time("2018-10-04T13:53:56") == t);
+    BOOST_CHECK(LogLoadAggregator::iso_time("2018-10-04 13:53") == t - 56);
+    BOOST_CHECK(LogLoadAggregator::iso_time("2018-10-04") == t - 13 * 3600 - 53 * 60 - 56);
+
+    std::string bad = "13:53 4.10.2018";
+    BOOST_CHECK(LogLoadAggregator::log_time(bad.c_str(), bad.size()) == -1);
+    BOOST_CHECK(LogLoadAggregator::iso_time("2018-13-04") == -1);
+    BOOST_CHECK(LogLoadAggregator::iso_time("yesterday") == -1);
+
+    BOOST_CHECK_MESSAGE(LogLoadAggregator::command_name(" chd:init /s1/f1/t1", true) == "init", "");
+    BOOST_CHECK_MESSAGE(LogLoadAggregator::command_name(" --news=4 66603 46 :user", false) == "news", "");
+    BOOST_CHECK_MESSAGE(LogLoadAggregator::suite_name(" chd:complete /s1/f1/t1", true) == "s1", "");
+    BOOST_CHECK_MESSAGE(LogLoadAggregator::suite_name(" --news=1 36506 6 :ma0 [suites added/removed]", false) == "",
+                        "");
+}
+
+BOOST_AUTO_TEST_CASE(test_log_load_aggregator) {
+    cout << "Base:: ...test_log_load_aggregator\n";
+
+    std::string log1 = "test_log_load_aggregator1.log";
+    std::string log2 = "test_log_load_aggregator2.log";
+    {
+        std::ofstream file(log1.c_str());
+        file << "LOG:[10:00:00 1.2.2023] submitted: /s1/t1\n"
+             << "MSG:[10:00:00 1.2.2023] chd:init /s1/t1\n"
+             << "MSG:[10:00:00 1.2.2023] --alter change variable X y /s2; --sync=0 1 2 :user@host\n"
+             << "MSG:[10:00:01 1.2.2023] chd:complete /s1/t1\n"
+             << "MSG:[10:01:30 1.2.2023] --news=4 66603 46 :user@host [:NO_NEWS]\n";
+    }
+    {
+        std::ofstream file(log2.c_str());
+        file << "MSG:[10:01:31 1.2.2023] chd:init /s2/t1\n"
+             << "MSG:[10:02:00 1.2.2023] chd:label progress 'a/b' /s2/t1\n";
+    }
+
+    {
+        LogLoadAggregator load;
+        load.process({log1, log2}, 2);
+        BOOST_REQUIRE_MESSAGE(load.buckets().size() == 5, "Expected 5 seconds but found " << load.buckets().size());
+        BOOST_CHECK_MESSAGE(load.child_requests() == 4, "Expected 4 child requests but " << load.child_requests());
+        BOOST_CHECK_MESSAGE(load.user_requests() == 2, "Expected 2 user requests but " << load.user_requests());
+        BOOST_REQUIRE_MESSAGE(load.suites().size() == 2 && load.suites()[0] == "s1" && load.suites()[1] == "s2",
+                              "Expected suites s1 and s2 in the order found");
+        BOOST_CHECK(load.suite_totals()[0] == 2 && load.suite_totals()[1] == 3);
+
+        const LogLoadAggregator::Bucket& first = load.buckets().begin()->second;
+        BOOST_CHECK_MESSAGE(first.child_ == 1 && first.user_ == 1, "Expected a child and a user request");
+        BOOST_CHECK_MESSAGE(requests_for(first.commands_, load.commands(), "init") == 1, "");
+        BOOST_CHECK_MESSAGE(requests_for(first.commands_, load.commands(), "alter") == 1, "");
+    }
+    {
+        // per minute, and only from 10:01
+        LogLoadAggregator load(LogLoadAggregator::MINUTE, LogLoadAggregator::iso_time("2023-02-01T10:01"));
+        load.process({log1, log2}, 1);
+        BOOST_REQUIRE_MESSAGE(load.buckets().size() == 2, "Expected 2 minutes but found " << load.buckets().size());
+        BOOST_CHECK_MESSAGE(load.buckets().begin()->second.total() == 2, "Expected 2 requests at 10:01");
+        BOOST_CHECK_MESSAGE(load.buckets().rbegin()->second.total() == 1, "Expected 1 request at 10:02");
+
+        std::string csv = "test_log_load_aggregator.csv";
+        load.write_csv(csv);
+        std::string contents;
+        BOOST_REQUIRE(File::open(csv, contents));
+        BOOST_CHECK_MESSAGE(contents.find("2023-02-01T10:01:00,total,,2\n") != std::string::npos, contents);
+        BOOST_CHECK_MESSAGE(contents.find("2023-02-01T10:02:00,suite,s2,1\n") != std::string::npos, contents);
+        fs::remove(csv);
+    }
+
+    if (!File::which("gzip").empty()) {
+        // compressed rotated logs are read through gzip
+        std::string gz  = log2 + ".gz";
+        std::string cmd = "gzip -c " + log2 + " > " + gz;
+        BOOST_REQUIRE(::system(cmd.c_str()) == 0);
+        LogLoadAggregator load;
+        load.process({log1, gz});
+        BOOST_CHECK_MESSAGE(load.child_requests() == 4, "Expected 4 child requests but " << load.child_requests());
+        fs::remove(gz);
+    }
+
+    BOOST_CHECK_THROW(LogLoadAggregator().process({log1 + ".missing"}), std::runtime_error);
+
+    fs::remove(log1);
+    fs::remove(log2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -21,6 +21,7 @@
 #include "ErrorCmd.hpp"
 #include "GroupSTCCmd.hpp"
 #include "MyDefsFixture.hpp"
+#include "SFileCmd.hpp"
 #include "SNewsCmd.hpp"
 #include "SNodeCmd.hpp"
 #include "SServerLoadCmd.hpp"
@@ -59,6 +60,8 @@ populateCmdVec(std::vector<Cmd_ptr>& cmd_vec, std::vector<STC_Cmd_ptr>& stc_cmd_
     cmd_vec.push_back(Cmd_ptr(new ServerVersionCmd()));
     cmd_vec.push_back(Cmd_ptr(new ReplaceNodeCmd("suiteName", false, client_defs, true)));
     cmd_vec.push_back(Cmd_ptr(new LoadDefsCmd(client_defs, true /*force*/)));
+    cmd_vec.push_back(Cmd_ptr(new LoadDefsCmd(client_defs, false /*force*/, true /*patch*/)));
+    cmd_vec.push_back(Cmd_ptr(new ReplaceNodeCmd("suiteName", false, client_defs, false, true /*patch*/)));
     cmd_vec.push_back(
         Cmd_ptr(new BeginCmd("suiteName"))); // after loading new defs, must call begin, for downstream cmds
     cmd_vec.push_back(
@@ -196,6 +199,8 @@ populateCmdVec(std::vector<Cmd_ptr>& cmd_vec, std::vector<STC_Cmd_ptr>& stc_cmd_
     cmd_vec.push_back(Cmd_ptr(new CFileCmd("/suiteName", CFileCmd::JOB, 100)));
     cmd_vec.push_back(Cmd_ptr(new CFileCmd("/suiteName", CFileCmd::JOBOUT, 100)));
     cmd_vec.push_back(Cmd_ptr(new CFileCmd("/suiteName", CFileCmd::MANUAL, 100)));
+    cmd_vec.push_back(Cmd_ptr(new CFileCmd("/suiteName", CFileCmd::JOBOUT, CFileCmd::BYTES, 100, 0)));
+    cmd_vec.push_back(Cmd_ptr(new CFileCmd("/suiteName", CFileCmd::JOB, CFileCmd::LINES, 10, 20)));
     cmd_vec.push_back(Cmd_ptr(new EditScriptCmd()));
     cmd_vec.push_back(Cmd_ptr(new AlterCmd("/suiteName/t1", AlterCmd::ADD_DATE, "12.*.*")));
     cmd_vec.push_back(Cmd_ptr(new AlterCmd("/suiteName/t1", AlterCmd::ADD_DAY, "sunday")));
@@ -302,6 +307,11 @@ populateCmdVec(std::vector<Cmd_ptr>& cmd_vec, std::vector<STC_Cmd_ptr>& stc_cmd_
     stc_cmd_vec.push_back(STC_Cmd_ptr(new StcCmd(StcCmd::BLOCK_CLIENT_ON_HOME_SERVER)));
     stc_cmd_vec.push_back(STC_Cmd_ptr(new BlockClientZombieCmd(ecf::Child::ECF)));
     stc_cmd_vec.push_back(STC_Cmd_ptr(new SStringCmd("Dummy contents")));
+    {
+        auto file_cmd = std::make_shared<SFileCmd>();
+        file_cmd->init("Dummy contents", 100, 200, 1234);
+        stc_cmd_vec.push_back(file_cmd);
+    }
     stc_cmd_vec.push_back(STC_Cmd_ptr(new SServerLoadCmd("/path/to/log_file")));
     stc_cmd_vec.push_back(STC_Cmd_ptr(new SSyncCmd(0, 0, 0, mock_server)));
     stc_cmd_vec.push_back(STC_Cmd_ptr(new SNewsCmd(0, 0, 0, mock_server)));
@@ -315,6 +325,7 @@ populateCmdVec(std::vector<Cmd_ptr>& cmd_vec, std::vector<STC_Cmd_ptr>& stc_cmd_
     theSTCGroupCmd->addChild(STC_Cmd_ptr(new StcCmd(StcCmd::BLOCK_CLIENT_ON_HOME_SERVER)));
     theSTCGroupCmd->addChild(STC_Cmd_ptr(new BlockClientZombieCmd(ecf::Child::ECF)));
     theSTCGroupCmd->addChild(STC_Cmd_ptr(new SStringCmd()));
+    theSTCGroupCmd->addChild(STC_Cmd_ptr(new SFileCmd()));
     theSTCGroupCmd->addChild(STC_Cmd_ptr(new SServerLoadCmd()));
     theSTCGroupCmd->addChild(STC_Cmd_ptr(new DefsCmd(mock_server)));
     theSTCGroupCmd->addChild(STC_Cmd_ptr(new SNodeCmd(mock_server, node_ptr())));
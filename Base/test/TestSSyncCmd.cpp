@@ -22,12 +22,15 @@
 #include "Limit.hpp"
 #include "MockServer.hpp"
 #include "MyDefsFixture.hpp"
+#include "PreAllocatedReply.hpp"
 #include "SNewsCmd.hpp"
 #include "SSyncCmd.hpp"
+#include "Serialization.hpp"
 #include "Suite.hpp"
 #include "SuiteChanged.hpp"
 #include "Task.hpp"
 #include "TestHelper.hpp"
+#include "perf_timer.hpp"
 
 using namespace std;
 using namespace ecf;
@@ -478,4 +481,74 @@ BOOST_AUTO_TEST_CASE(test_ssync_cmd) {
     test_sync_scaffold(set_defs_state, "set_defs_state");
 }
 
+static defs_ptr create_deep_defs(int no_of_families, int no_of_tasks) {
+    defs_ptr defs = Defs::create();
+    suite_ptr suite = defs->add_suite("test_ssync_cmd_compact_paths");
+    for (int f = 0; f < no_of_families; f++) {
+        family_ptr fam    = suite->add_family("family" + std::to_string(f));
+        family_ptr nested = fam->add_family("nested_family");
+        for (int t = 0; t < no_of_tasks; t++) {
+            nested->add_task("task" + std::to_string(t));
+        }
+    }
+    defs->set_server().set_state(SState::HALTED);
+    return defs;
+}
+
+BOOST_AUTO_TEST_CASE(test_ssync_cmd_compact_paths) {
+    cout << "Base:: ...test_ssync_cmd_compact_paths\n";
+    TestLog test_log("test_ssync_cmd_compact_paths.log"); // will create log file, and destroy log and remove file
+
+    const int no_of_families = 50;
+    const int no_of_tasks    = 40;
+    defs_ptr server_defs     = create_deep_defs(no_of_families, no_of_tasks);
+
+    unsigned int client_state_change_no  = Ecf::state_change_no();
+    unsigned int client_modify_change_no = Ecf::modify_change_no();
+    {
+        Ecf::set_server(true);
+        std::vector<Task*> tasks;
+        server_defs->getAllTasks(tasks);
+        for (Task* task : tasks) {
+            SuiteChanged1 changed(task->suite());
+            task->set_state(NState::COMPLETE);
+        }
+        Ecf::set_server(false);
+    }
+
+    // Transfer the *same* changes, with and without front coded paths, and apply to a fresh client defs
+    std::string payload[2];
+    for (int compact = 0; compact < 2; compact++) {
+        {
+            MockServer mock_server(server_defs);
+            STC_Cmd_ptr cmd = PreAllocatedReply::sync_cmd(
+                0, client_state_change_no, client_modify_change_no, &mock_server, compact == 1);
+            ecf::save_as_string(payload[compact], cmd);
+            cmd->cleanup();
+        }
+
+        STC_Cmd_ptr restored_cmd;
+        ecf::restore_from_string(payload[compact], restored_cmd);
+        auto* sync_cmd = dynamic_cast<SSyncCmd*>(restored_cmd.get());
+        BOOST_REQUIRE_MESSAGE(sync_cmd, "Expected SSyncCmd");
+
+        ServerReply server_reply;
+        server_reply.set_client_defs(create_deep_defs(no_of_families, no_of_tasks));
+        {
+            Timer<std::chrono::microseconds> timer;
+            BOOST_CHECK_MESSAGE(sync_cmd->do_sync(server_reply), "Expected server to change");
+            cout << "   compact(" << compact << ") payload size: " << payload[compact].size()
+                 << " apply: " << timer.elapsed().count() << "us\n";
+        }
+        BOOST_CHECK_MESSAGE(!server_reply.full_sync(), "Expected incremental sync");
+        BOOST_CHECK_MESSAGE(server_reply.changed_nodes().size() >= static_cast<size_t>(no_of_families * no_of_tasks),
+                            "Expected a changed node for each task, but found " << server_reply.changed_nodes().size());
+
+        DebugEquality debug_equality; // only has affect in DEBUG build
+        BOOST_CHECK_MESSAGE(*server_defs == *server_reply.client_defs(),
+                            "compact(" << compact << "): Server and client should be same after sync");
+    }
+    BOOST_CHECK_MESSAGE(payload[1].size() < payload[0].size(), "Expected front coded paths to reduce the payload");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,101 @@
+//============================================================================
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+//   Tests for `ZombieCtrl`
+//    - check zombies are found/removed, via the task path index
+//    - check that stale zombies are removed, and the index kept in step
+//============================================================================
+#include <boost/test/unit_test.hpp>
+
+#include "Calendar.hpp"
+#include "Defs.hpp"
+#include "Family.hpp"
+#include "Suite.hpp"
+#include "Task.hpp"
+#include "ZombieCtrl.hpp"
+
+using namespace ecf;
+
+BOOST_AUTO_TEST_SUITE(BaseTestSuite)
+
+BOOST_AUTO_TEST_CASE(test_zombie_ctrl) {
+
+    const size_t no_of_tasks = 100;
+
+    Defs defs;
+    suite_ptr s  = defs.add_suite("s");
+    family_ptr f = s->add_family("f");
+    std::vector<Submittable*> tasks;
+    for (size_t i = 0; i < no_of_tasks; i++) {
+        task_ptr t = f->add_task("t" + std::to_string(i));
+        t->init("pid" + std::to_string(i)); // make active
+        tasks.push_back(t.get());
+    }
+
+    ZombieCtrl zombie_ctrl;
+    zombie_ctrl.add_user_zombies(tasks, "test_zombie_ctrl");
+    zombie_ctrl.add_user_zombies(tasks, "test_zombie_ctrl"); // zombies already exist, should not be added again
+
+    std::vector<Zombie> zombies;
+    zombie_ctrl.get(zombies);
+    BOOST_REQUIRE_MESSAGE(zombies.size() == no_of_tasks, "Expected " << no_of_tasks << " but found " << zombies.size());
+    for (size_t i = 0; i < no_of_tasks; i++) {
+        BOOST_CHECK_MESSAGE(zombies[i].path_to_task() == tasks[i]->absNodePath(), "Expected zombies in creation order");
+    }
+
+    for (auto* t : tasks) {
+        BOOST_CHECK_MESSAGE(!zombie_ctrl.find(t->absNodePath(), t->process_or_remote_id(), t->jobsPassword()).empty(),
+                            "Expected to find zombie for " << t->absNodePath());
+        BOOST_CHECK_MESSAGE(!zombie_ctrl.find(t->absNodePath(), "", t->jobsPassword()).empty(),
+                            "Expected to find zombie by password, when process id is empty");
+        BOOST_CHECK_MESSAGE(zombie_ctrl.find(t->absNodePath(), "", "bad_passwd").empty(),
+                            "Expected no zombie, for miss-matched password");
+        BOOST_CHECK_MESSAGE(!zombie_ctrl.find_by_path_only(t->absNodePath()).empty(),
+                            "Expected to find zombie by path");
+    }
+    BOOST_CHECK_MESSAGE(zombie_ctrl.find_by_path_only("/s/f/unknown").empty(), "Expected no zombie for unknown path");
+
+    // remove every other zombie
+    for (size_t i = 0; i < no_of_tasks; i += 2) {
+        BOOST_CHECK_MESSAGE(zombie_ctrl.remove(tasks[i]), "Expected removal of zombie " << tasks[i]->absNodePath());
+        BOOST_CHECK_MESSAGE(!zombie_ctrl.remove(tasks[i]), "Zombie already removed " << tasks[i]->absNodePath());
+        BOOST_CHECK_MESSAGE(zombie_ctrl.find_by_path_only(tasks[i]->absNodePath()).empty(), "Expected zombie removed");
+    }
+    zombies.clear();
+    zombie_ctrl.get(zombies);
+    BOOST_REQUIRE_MESSAGE(zombies.size() == no_of_tasks / 2, "Expected half the zombies to be removed");
+
+    // user actions on the remaining zombies
+    zombie_ctrl.fobCli(tasks[1]->absNodePath(), nullptr);
+    BOOST_CHECK_MESSAGE(zombie_ctrl.find_by_path_only(tasks[1]->absNodePath()).fob(), "Expected zombie to be fobed");
+    zombie_ctrl.removeCli(tasks[3]->absNodePath(), nullptr);
+    BOOST_CHECK_MESSAGE(zombie_ctrl.find_by_path_only(tasks[3]->absNodePath()).empty(), "Expected zombie removed");
+
+    // None of the zombies are stale yet
+    boost::posix_time::ptime time_now = Calendar::second_clock_time();
+    zombie_ctrl.remove_stale_zombies(time_now);
+    zombies.clear();
+    zombie_ctrl.get(zombies);
+    BOOST_REQUIRE_MESSAGE(zombies.size() == no_of_tasks / 2 - 1, "Expected no stale zombies");
+
+    // All zombies stale
+    zombie_ctrl.remove_stale_zombies(time_now + boost::posix_time::hours(24));
+    zombies.clear();
+    zombie_ctrl.get(zombies);
+    BOOST_REQUIRE_MESSAGE(zombies.empty(), "Expected all stale zombies to be removed");
+    for (auto* t : tasks) {
+        BOOST_CHECK_MESSAGE(zombie_ctrl.find_by_path_only(t->absNodePath()).empty(), "Expected index to be cleared");
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
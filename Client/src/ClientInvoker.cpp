@@ -100,6 +100,36 @@ void ClientInvoker::set_host_port(const std::string& host, const std::string& po
     clientEnv_.set_host_port(host, port);
 }
 
+// The client, and the io_service it runs on, kept between requests
+struct ClientInvoker::PersistentConnection
+{
+    PersistentConnection(const std::string& host, const std::string& port, int timeout)
+        : host_(host),
+          port_(port),
+          client_(io_service_, host, port, timeout) {}
+
+    std::string host_;
+    std::string port_;
+    boost::asio::io_service io_service_; // must be declared before client_
+    Client client_;
+};
+
+void ClientInvoker::set_persistent_connection(bool f) {
+    persistent_connection_ = f;
+    if (!f)
+        persistent_.reset(); // closes the connection
+}
+
+ClientInvoker::PersistentConnection& ClientInvoker::persistent_connection_for_request() const {
+    if (!persistent_ || persistent_->host_ != clientEnv_.host() || persistent_->port_ != clientEnv_.port()) {
+        persistent_.reset();
+        persistent_ =
+            std::make_shared<PersistentConnection>(clientEnv_.host(), clientEnv_.port(), clientEnv_.connect_timeout());
+    }
+    persistent_->io_service_.restart(); // run() was called for the previous request
+    return *persistent_;
+}
+
 void ClientInvoker::set_hostport(const std::string& host_port) {
     // assume format <host>:<port> || <host>@<port>
     size_t colonPos = host_port.find_first_of(':');
@@ -398,13 +428,26 @@ int ClientInvoker::do_invoke_cmd(Cmd_ptr cts_cmd) const {
                     }
                     else {
 #endif
-                        Client theClient(
-                            io_service, cts_cmd, clientEnv_.host(), clientEnv_.port(), clientEnv_.connect_timeout());
+                        // Either re-use the connection from the previous request, or connect for this request
+                        std::unique_ptr<Client> request_client;
+                        Client* theClient                  = nullptr;
+                        boost::asio::io_service* client_io = &io_service;
+                        if (persistent_connection_) {
+                            PersistentConnection& connection = persistent_connection_for_request();
+                            connection.client_.request(cts_cmd);
+                            theClient = &connection.client_;
+                            client_io = &connection.io_service_;
+                        }
+                        else {
+                            request_client = std::make_unique<Client>(
+                                io_service, cts_cmd, clientEnv_.host(), clientEnv_.port(), clientEnv_.connect_timeout());
+                            theClient = request_client.get();
+                        }
                         {
 #ifdef DEBUG_PERF
                             ecf::ScopedDurationTimer my_timer("   io_service.run()");
 #endif
-                            io_service.run();
+                            client_io->run();
                         }
                         if (clientEnv_.debug())
                             cout << TimeStamp::now() << "ClientInvoker: >>> After: io_service.run() <<<" << endl;
@@ -412,7 +455,7 @@ int ClientInvoker::do_invoke_cmd(Cmd_ptr cts_cmd) const {
                         /// Let see how the server responded if at all.
                         try {
                             /// will return false if further action required
-                            if (theClient.handle_server_response(server_reply_, clientEnv_.debug())) {
+                            if (theClient->handle_server_response(server_reply_, clientEnv_.debug())) {
                                 // The normal response.  RoundTriprecorder will record in rtt_
                                 return 0; // the normal exit path
                             }
@@ -489,6 +532,8 @@ int ClientInvoker::do_invoke_cmd(Cmd_ptr cts_cmd) const {
                     }
                 }
                 catch (std::exception& e) {
+                    persistent_.reset(); // start the next attempt with a new connection
+
                     // *Some kind of connection error*: fall through and try again. Avoid this message when pinging, i.e
                     // to see if server is alive.
                     if (clientEnv_.debug()) {
@@ -646,6 +691,23 @@ int ClientInvoker::sync_local(bool sync_suite_clock) const {
     return invoke(std::make_shared<CSyncCmd>(server_reply_.client_handle()));
 }
 
+int ClientInvoker::sync_local_wait(int wait_for_change) const {
+    defs_ptr defs = server_reply_.client_defs();
+    if (!defs.get() || testInterface_) {
+        return sync_local();
+    }
+
+    if (defs->in_notification()) {
+        std::cout << "ClientInvoker::sync_local_wait() called in the middle of notification. Ignoring..... \n";
+        return 0;
+    }
+    return invoke(std::make_shared<CSyncCmd>(CSyncCmd::SYNC,
+                                             server_reply_.client_handle(),
+                                             defs->state_change_no(),
+                                             defs->modify_change_no(),
+                                             wait_for_change));
+}
+
 int ClientInvoker::news(defs_ptr& client_defs) const {
     if (client_defs.get()) {
         if (testInterface_)
@@ -691,11 +753,12 @@ int ClientInvoker::loadDefs(const std::string& filePath,
                             bool force,      /* true means overwrite suite of same name */
                             bool check_only, /* client side, true means don't send to server, just check only */
                             bool print,      /* client side, print the defs */
-                            bool stats       /* client side, print the defs statitics */
+                            bool stats,      /* client side, print the defs statitics */
+                            bool patch       /* true means update suite of same name in place, keeping state */
 ) const {
     if (testInterface_)
-        return invoke(CtsApi::loadDefs(filePath, force, check_only, print));
-    Cmd_ptr cmd = LoadDefsCmd::create(filePath, force, check_only, print, stats, &clientEnv_);
+        return invoke(CtsApi::loadDefs(filePath, force, check_only, print, patch));
+    Cmd_ptr cmd = LoadDefsCmd::create(filePath, force, check_only, print, stats, &clientEnv_, patch);
     // If check_only cmd will be empty
     if (cmd)
         return invoke(cmd);
@@ -1060,9 +1123,10 @@ int ClientInvoker::restore(const std::string& absNodePath) const {
 int ClientInvoker::replace(const std::string& absNodePath,
                            const std::string& path_to_client_defs,
                            bool create_parents_as_required,
-                           bool force) const {
+                           bool force,
+                           bool patch) const {
     if (testInterface_)
-        return invoke(CtsApi::replace(absNodePath, path_to_client_defs, create_parents_as_required, force));
+        return invoke(CtsApi::replace(absNodePath, path_to_client_defs, create_parents_as_required, force, patch));
 
     /// *Note* server_reply_.client_handle_ is kept until the next call to register_client_handle
     /// The client invoker can be used multiple times, hence keep value of defs, and client handle in server reply
@@ -1072,7 +1136,8 @@ int ClientInvoker::replace(const std::string& absNodePath,
     Cmd_ptr cts_cmd;
     try {
         // For test allow the defs environment to changed, i.e. allow us to inject  ECF_CLIENT ???
-        cts_cmd = std::make_shared<ReplaceNodeCmd>(absNodePath, create_parents_as_required, path_to_client_defs, force);
+        cts_cmd = std::make_shared<ReplaceNodeCmd>(
+            absNodePath, create_parents_as_required, path_to_client_defs, force, patch);
     }
     catch (std::exception& e) {
         std::stringstream ss;
@@ -1089,7 +1154,8 @@ int ClientInvoker::replace(const std::string& absNodePath,
 int ClientInvoker::replace_1(const std::string& absNodePath,
                              defs_ptr client_defs,
                              bool create_parents_as_required,
-                             bool force) const {
+                             bool force,
+                             bool patch) const {
     /// *Note* server_reply_.client_handle_ is kept until the next call to register_client_handle
     /// The client invoker can be used multiple times, hence keep value of defs, and client handle in server reply
     server_reply_.clear_for_invoke(cli());
@@ -1097,7 +1163,7 @@ int ClientInvoker::replace_1(const std::string& absNodePath,
     /// Handle command constructors that can throw
     Cmd_ptr cts_cmd;
     try {
-        cts_cmd = std::make_shared<ReplaceNodeCmd>(absNodePath, create_parents_as_required, client_defs, force);
+        cts_cmd = std::make_shared<ReplaceNodeCmd>(absNodePath, create_parents_as_required, client_defs, force, patch);
     }
     catch (std::exception& e) {
         std::stringstream ss;
@@ -1226,18 +1292,21 @@ int ClientInvoker::freeDep(const std::string& absNodePath, bool trigger, bool al
 
 int ClientInvoker::file(const std::string& absNodePath,
                         const std::string& fileType,
-                        const std::string& max_lines) const {
+                        const std::string& max_lines,
+                        const std::string& range) const {
     if (testInterface_)
-        return invoke(CtsApi::file(absNodePath, fileType, max_lines));
+        return invoke(CtsApi::file(absNodePath, fileType, max_lines, range));
 
     /// Handle command constructors that can throw
     Cmd_ptr cts_cmd;
     try {
-        cts_cmd = std::make_shared<CFileCmd>(absNodePath, fileType, max_lines);
+        cts_cmd = std::make_shared<CFileCmd>(absNodePath, fileType, max_lines, range);
     }
     catch (std::exception& e) {
         std::stringstream ss;
-        ss << "ClientInvoker::file(" << absNodePath << "," << fileType << "," << max_lines << ") failed:\n" << e.what();
+        ss << "ClientInvoker::file(" << absNodePath << "," << fileType << "," << max_lines << "," << range
+           << ") failed:\n"
+           << e.what();
         server_reply_.set_error_msg(ss.str());
         if (on_error_throw_exception_) {
             throw std::runtime_error(server_reply_.error_msg());
@@ -1361,6 +1430,14 @@ int ClientInvoker::group(const std::string& groupRequest) const {
     return invoke(std::make_shared<GroupCTSCmd>(groupRequest, &clientEnv_));
 }
 
+int ClientInvoker::group(const std::vector<Cmd_ptr>& cmds) const {
+    auto grp_cmd = std::make_shared<GroupCTSCmd>();
+    for (const auto& cmd : cmds) {
+        grp_cmd->addChild(cmd);
+    }
+    return invoke(grp_cmd);
+}
+
 int ClientInvoker::logMsg(const std::string& msg) const {
     if (testInterface_)
         return invoke(CtsApi::logMsg(msg));
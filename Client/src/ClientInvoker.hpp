@@ -100,6 +100,15 @@ public:
     /// Default: In debug this period in set to 1 second and in release mode 10 seconds
     void set_retry_connection_period(unsigned int period) { retry_connection_period_ = period; }
 
+    /// Keep the connection to the server open between requests, instead of connecting for each request.
+    /// This reduces the latency of many small requests, i.e. from the GUI or python.
+    /// The connection is re-opened if the server closed it, or the host/port changes.
+    /// A request is only sent again if it could not be sent. When the reply is lost, the server
+    /// may have run the request, hence this is reported as an error.
+    /// TCP only: with SSL every request still makes its own connection.
+    void set_persistent_connection(bool f);
+    bool persistent_connection() const { return persistent_connection_; }
+
     /// Set the number of times to connect to server, in case of failure
     /// The period between connection attempts is handled by set_retry_connection_period
     /// i.e for the GUI & python interface this can be reduced to increase responsiveness.
@@ -214,13 +223,18 @@ public:
                  bool force      = false, /* true means overwrite suite of same name */
                  bool check_only = false, /* client side only, true means don't send to server, just check only */
                  bool print      = false, /* client side only, print the defs */
-                 bool stats      = false  /* client side only, print the defs statitics */
+                 bool stats      = false, /* client side only, print the defs statitics */
+                 bool patch      = false  /* true means update suite of same name in place, keeping state */
     ) const;
     int load(const defs_ptr& defs, bool force = false /*true means overwrite suite of same name*/) const {
         return load_in_memory_defs(defs, force);
     }
     int sync(defs_ptr& client_defs) const;
     int sync_local(bool sync_suite_clock = false) const;
+    /// Like sync_local(), but when there are no changes, the server replies as soon as the suites
+    /// change, or after wait_for_change seconds. Use instead of polling with news_local()/sync_local()
+    /// Older servers reply immediately.
+    int sync_local_wait(int wait_for_change) const;
     int news(defs_ptr& client_defs) const;
     int news_local() const;
 
@@ -307,11 +321,13 @@ public:
     int replace(const std::string& absNodePath,
                 const std::string& path_to_client_defs,
                 bool create_parents_as_required = true,
-                bool force                      = false) const;
+                bool force                      = false,
+                bool patch                      = false) const;
     int replace_1(const std::string& absNodePath,
                   defs_ptr client_defs,
                   bool create_parents_as_required = true,
-                  bool force                      = false) const;
+                  bool force                      = false,
+                  bool patch                      = false) const;
 
     int requeue(const std::vector<std::string>& paths, const std::string& option = "") const;
     int requeue(const std::string& absNodePath, const std::string& option = "") const;
@@ -346,7 +362,13 @@ public:
                 bool date    = false,
                 bool time    = false) const;
 
-    int file(const std::string& absNodePath, const std::string& fileType, const std::string& max_lines = "10000") const;
+    /// range is optional, i.e. bytes=<begin>-[<end>] or lines=<begin>-[<end>], see CFileCmd::desc()
+    /// When specified the server only returns that part of the file, and server_reply().file_offset(),
+    /// file_size() and file_modify_time() are set.
+    int file(const std::string& absNodePath,
+             const std::string& fileType,
+             const std::string& max_lines = "10000",
+             const std::string& range     = "") const;
 
     int plug(const std::string& sourcePath, const std::string& destPath) const;
 
@@ -372,6 +394,8 @@ public:
     int reloadcustompasswdfile() const;
 
     int group(const std::string& groupRequest) const;
+    /// Send the commands as a single request. Used to batch many small updates, i.e by ecflow_udp
+    int group(const std::vector<Cmd_ptr>& cmds) const;
 
     int logMsg(const std::string& msg) const;
     int new_log(const std::string& new_path = "") const;
@@ -415,6 +439,9 @@ private:
     std::string client_env_host_port() const;
     void check_child_parameters() const;
 
+    struct PersistentConnection;
+    PersistentConnection& persistent_connection_for_request() const;
+
 private:
     friend class RoundTripRecorder;
     friend class RequestLogger;
@@ -444,6 +471,9 @@ private:
     bool auto_sync_{false};
     bool test_{false};          // used in testing only
     bool testInterface_{false}; // used in testing only
+    bool persistent_connection_{false};
+
+    mutable std::shared_ptr<PersistentConnection> persistent_; // only created when persistent_connection_ is set
 };
 
 // Allow logging and debug output of request round trip times
@@ -0,0 +1,352 @@
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#include "JobSimulator.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/lexical_cast.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "ClientInvoker.hpp"
+#include "Defs.hpp"
+#include "Task.hpp"
+
+namespace ecf {
+
+// ==========================================================================
+// RequestLatencies
+// ==========================================================================
+
+static double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty())
+        return 0;
+    return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))];
+}
+
+void RequestLatencies::add(const std::string& name, double ms, bool ok) {
+    times_[name].push_back(ms);
+    if (!ok)
+        errors_[name]++;
+}
+
+void RequestLatencies::merge(const RequestLatencies& rhs) {
+    for (const auto& t : rhs.times_)
+        times_[t.first].insert(times_[t.first].end(), t.second.begin(), t.second.end());
+    for (const auto& e : rhs.errors_)
+        errors_[e.first] += e.second;
+}
+
+size_t RequestLatencies::requests() const {
+    size_t count = 0;
+    for (const auto& t : times_)
+        count += t.second.size();
+    return count;
+}
+
+size_t RequestLatencies::errors() const {
+    size_t count = 0;
+    for (const auto& e : errors_)
+        count += e.second;
+    return count;
+}
+
+void RequestLatencies::write_json(std::ostream& os, const std::string& indent) const {
+    os << "{";
+    for (auto i = times_.begin(); i != times_.end(); ++i) {
+        std::vector<double> t = i->second;
+        std::sort(t.begin(), t.end());
+        auto errors = errors_.find(i->first);
+        os << (i == times_.begin() ? "\n" : ",\n") << indent << "  \"" << i->first << "\": {\"count\": " << t.size()
+           << ", \"errors\": " << (errors == errors_.end() ? 0 : errors->second)
+           << ", \"p50_ms\": " << percentile(t, 0.5) << ", \"p90_ms\": " << percentile(t, 0.9)
+           << ", \"p99_ms\": " << percentile(t, 0.99) << ", \"max_ms\": " << (t.empty() ? 0 : t.back()) << "}";
+    }
+    os << "\n" << indent << "}";
+}
+
+// ==========================================================================
+// JobSimulator
+// ==========================================================================
+
+struct JobSimulator::TaskAttrs
+{
+    std::vector<std::string> events_;
+    std::vector<Meter> meters_;
+    std::vector<std::string> labels_;
+};
+
+struct JobSimulator::Job
+{
+    enum Kind { INIT, EVENT, METER, LABEL, COMPLETE, ABORT };
+    struct Step
+    {
+        Kind kind_;
+        std::string name_;
+        int value_;
+    };
+
+    std::string path_;
+    std::string password_;
+    std::string rid_;
+    int try_no_{1};
+    std::vector<Step> steps_;
+    size_t next_{0};
+};
+
+JobSimulator::JobSimulator(const std::string& host,
+                           const std::string& port,
+                           const Defs& defs,
+                           const std::string& queue_file,
+                           const Lifecycle& lifecycle,
+                           size_t workers)
+    : host_(host),
+      port_(port),
+      queue_file_(queue_file),
+      lifecycle_(lifecycle),
+      no_of_workers_(std::max(workers, size_t(1))),
+      rng_(1) {
+    std::vector<task_ptr> tasks;
+    defs.get_all_tasks(tasks);
+    for (const auto& task : tasks) {
+        auto attrs = std::make_shared<TaskAttrs>();
+        for (const auto& event : task->events())
+            attrs->events_.push_back(event.name_or_number());
+        attrs->meters_ = task->meters();
+        for (const auto& label : task->labels())
+            attrs->labels_.push_back(label.name());
+        tasks_[task->absNodePath()] = attrs;
+    }
+
+    std::ofstream queue(queue_file_.c_str(), std::ios::trunc);
+    if (!queue)
+        throw std::runtime_error("JobSimulator: could not create queue file " + queue_file_);
+}
+
+JobSimulator::~JobSimulator() {
+    stop();
+    ::unlink(queue_file_.c_str());
+}
+
+std::string JobSimulator::job_cmd() const {
+    // A single write, of less than PIPE_BUF, is atomic in append mode
+    return "echo %ECF_NAME% %ECF_PASS% %ECF_TRYNO% >> " + queue_file_;
+}
+
+void JobSimulator::start() {
+    if (!threads_.empty())
+        return;
+    stop_      = false;
+    next_slot_ = Clock::now();
+    worker_latencies_.resize(no_of_workers_);
+    threads_.emplace_back(&JobSimulator::read_queue, this);
+    for (size_t i = 0; i < no_of_workers_; i++)
+        threads_.emplace_back(&JobSimulator::worker, this, std::ref(worker_latencies_[i]));
+}
+
+void JobSimulator::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto& th : threads_)
+        th.join();
+    threads_.clear();
+
+    for (const auto& l : worker_latencies_)
+        latencies_.merge(l);
+    worker_latencies_.clear();
+}
+
+size_t JobSimulator::jobs_started() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return started_;
+}
+
+size_t JobSimulator::jobs_completed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return completed_;
+}
+
+size_t JobSimulator::jobs_aborted() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return aborted_;
+}
+
+size_t JobSimulator::jobs_failed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failed_;
+}
+
+size_t JobSimulator::jobs_in_flight() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return started_ - completed_ - aborted_ - failed_;
+}
+
+void JobSimulator::read_queue() {
+    int fd = ::open(queue_file_.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+
+    std::string pending;
+    char buffer[4096];
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stop_)
+                break;
+        }
+        ssize_t n = ::read(fd, buffer, sizeof(buffer));
+        if (n <= 0) {
+            // at the end of the queue, wait for the server to submit more jobs
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            continue;
+        }
+        pending.append(buffer, n);
+
+        size_t start = 0;
+        size_t eol   = 0;
+        while ((eol = pending.find('\n', start)) != std::string::npos) {
+            // <path> <password> <try number>
+            std::istringstream line(pending.substr(start, eol - start));
+            start = eol + 1;
+
+            auto job = std::make_shared<Job>();
+            if (!(line >> job->path_ >> job->password_ >> job->try_no_))
+                continue;
+
+            std::shared_ptr<TaskAttrs> attrs;
+            auto found = tasks_.find(job->path_);
+            if (found != tasks_.end())
+                attrs = found->second;
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            job->rid_ = "sim" + boost::lexical_cast<std::string>(started_++);
+            job->steps_.push_back({Job::INIT, "", 0});
+            if (attrs) {
+                for (const auto& event : attrs->events_)
+                    job->steps_.push_back({Job::EVENT, event, 1});
+                for (const auto& meter : attrs->meters_) {
+                    for (size_t i = 1; i <= lifecycle_.meter_steps; i++) {
+                        int value = meter.min() + static_cast<int>((meter.max() - meter.min()) * i /
+                                                                   lifecycle_.meter_steps);
+                        job->steps_.push_back({Job::METER, meter.name(), value});
+                    }
+                }
+                for (const auto& label : attrs->labels_)
+                    job->steps_.push_back({Job::LABEL, label, 0});
+            }
+            bool abort = lifecycle_.abort_rate > 0 &&
+                         std::uniform_real_distribution<double>(0.0, 1.0)(rng_) < lifecycle_.abort_rate;
+            job->steps_.push_back({abort ? Job::ABORT : Job::COMPLETE, "", 0});
+            scheduled_.emplace(Clock::now(), job);
+            cv_.notify_one();
+        }
+        pending.erase(0, start);
+    }
+    ::close(fd);
+}
+
+void JobSimulator::pace() {
+    if (lifecycle_.rate <= 0)
+        return;
+    Clock::time_point slot;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        slot       = std::max(Clock::now(), next_slot_);
+        next_slot_ = slot + std::chrono::duration_cast<Clock::duration>(
+                                std::chrono::duration<double>(1.0 / lifecycle_.rate));
+    }
+    std::this_thread::sleep_until(slot);
+}
+
+void JobSimulator::worker(RequestLatencies& latencies) {
+    ClientInvoker client(host_, port_);
+    client.set_child_timeout(60);        // do not retry for hours, if the server is gone
+    client.set_zombie_child_timeout(60);
+
+    while (true) {
+        JobPtr job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (!stop_) {
+                if (scheduled_.empty())
+                    cv_.wait(lock);
+                else if (scheduled_.top().first > Clock::now())
+                    cv_.wait_until(lock, scheduled_.top().first);
+                else
+                    break;
+            }
+            if (stop_)
+                return;
+            job = scheduled_.top().second;
+            scheduled_.pop();
+        }
+
+        pace();
+        client.set_child_path(job->path_);
+        client.set_child_password(job->password_);
+        client.set_child_pid(job->rid_);
+        client.set_child_try_no(job->try_no_);
+
+        const Job::Step& step = job->steps_[job->next_];
+        bool ok               = true;
+        switch (step.kind_) {
+            case Job::INIT:
+                ok = latencies.time("init", [&]() { client.child_init(); });
+                break;
+            case Job::EVENT:
+                ok = latencies.time("event", [&]() { client.child_event(step.name_); });
+                break;
+            case Job::METER:
+                ok = latencies.time("meter", [&]() { client.child_meter(step.name_, step.value_); });
+                break;
+            case Job::LABEL: {
+                std::string value = "try " + boost::lexical_cast<std::string>(job->try_no_);
+                ok                = latencies.time("label", [&]() { client.child_label(step.name_, value); });
+                break;
+            }
+            case Job::COMPLETE:
+                ok = latencies.time("complete", [&]() { client.child_complete(); });
+                break;
+            case Job::ABORT:
+                ok = latencies.time("abort", [&]() { client.child_abort("simulated"); });
+                break;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!ok) {
+            failed_++;
+            continue;
+        }
+        if (++job->next_ < job->steps_.size()) {
+            auto interval = std::chrono::milliseconds(lifecycle_.runtime_ms / (job->steps_.size() - 1));
+            scheduled_.emplace(Clock::now() + interval, job);
+            cv_.notify_one();
+        }
+        else if (step.kind_ == Job::ABORT)
+            aborted_++;
+        else
+            completed_++;
+    }
+}
+
+} // namespace ecf
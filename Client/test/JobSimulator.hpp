@@ -0,0 +1,157 @@
+#ifndef JOB_SIMULATOR_HPP_
+#define JOB_SIMULATOR_HPP_
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description : Impersonates the running jobs of a server, without running any
+//               job processes. Used to load test the server with child commands.
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/core/noncopyable.hpp>
+
+#include "NodeFwd.hpp"
+
+namespace ecf {
+
+/// The latencies (ms) of the requests, by request type. These are round trips, as seen by
+/// the client, hence include the connection and the serialisation on both sides.
+class RequestLatencies {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Time the request, any exception is counted as an error. Returns false on error
+    template <typename Request>
+    bool time(const std::string& name, Request request) {
+        Clock::time_point start = Clock::now();
+        bool ok                 = true;
+        try {
+            request();
+        }
+        catch (std::exception&) {
+            ok = false;
+        }
+        add(name, std::chrono::duration<double, std::milli>(Clock::now() - start).count(), ok);
+        return ok;
+    }
+
+    void add(const std::string& name, double ms, bool ok = true);
+    void merge(const RequestLatencies& rhs);
+
+    size_t requests() const;
+    size_t errors() const;
+
+    /// { "<name>": {"count": ..., "errors": ..., "p50_ms": ..., "p90_ms": ..., "p99_ms": ..., "max_ms": ...}, ...}
+    void write_json(std::ostream& os, const std::string& indent = "  ") const;
+
+private:
+    std::map<std::string, std::vector<double>> times_;
+    std::map<std::string, size_t> errors_;
+};
+
+/// The server submits a job by running the ECF_JOB_CMD returned by job_cmd(), which only
+/// appends the task path, password and try number to a queue file. The simulator reads
+/// the queue, and for each job replays the child commands of a typical job:
+///     init, event(s), meter(s) in steps, label(s), complete (or abort)
+/// with the ECF_PASS, a unique ECF_RID and the ECF_TRYNO of that submission. An aborted
+/// task is re-submitted by the server (ECF_TRIES), and hence re-appears with the next try number.
+///
+/// The jobs are state machines, hence thousands of jobs can be in flight with a few
+/// worker threads, each with its own ClientInvoker.
+class JobSimulator : private boost::noncopyable {
+public:
+    struct Lifecycle
+    {
+        size_t meter_steps{3}; // updates, per meter, from min to max
+        int runtime_ms{0};     // from init to complete, spread evenly between the child commands
+        double abort_rate{0};  // fraction of the jobs that abort rather than complete
+        double rate{0};        // child commands per second, over all workers, 0 means no limit
+    };
+
+    /// The events, meters and labels of each task are taken from the defs.
+    /// The queue file is created (truncated) on construction, and removed in the destructor.
+    JobSimulator(const std::string& host,
+                 const std::string& port,
+                 const Defs& defs,
+                 const std::string& queue_file,
+                 const Lifecycle& lifecycle,
+                 size_t workers = 4);
+    ~JobSimulator();
+
+    /// The ECF_JOB_CMD to set on the suites, together with ECF_NO_SCRIPT
+    std::string job_cmd() const;
+
+    void start();
+    /// Stop the workers, jobs still in flight are abandoned
+    void stop();
+
+    size_t jobs_started() const;
+    size_t jobs_completed() const;
+    size_t jobs_aborted() const;
+    size_t jobs_failed() const; // a child command failed, i.e. zombie, the job was abandoned
+    size_t jobs_in_flight() const;
+
+    /// Merged over all workers, only valid after stop()
+    const RequestLatencies& latencies() const { return latencies_; }
+
+private:
+    struct TaskAttrs;
+    struct Job;
+    using Clock        = std::chrono::steady_clock;
+    using JobPtr       = std::shared_ptr<Job>;
+    using ScheduledJob = std::pair<Clock::time_point, JobPtr>;
+    struct Later
+    {
+        bool operator()(const ScheduledJob& a, const ScheduledJob& b) const { return a.first > b.first; }
+    };
+
+    void read_queue();
+    void worker(RequestLatencies& latencies);
+    void pace();
+
+    std::string host_;
+    std::string port_;
+    std::string queue_file_;
+    Lifecycle lifecycle_;
+    size_t no_of_workers_;
+    std::map<std::string, std::shared_ptr<TaskAttrs>> tasks_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::priority_queue<ScheduledJob, std::vector<ScheduledJob>, Later> scheduled_;
+    Clock::time_point next_slot_;
+    std::mt19937 rng_;
+    size_t started_{0};
+    size_t completed_{0};
+    size_t aborted_{0};
+    size_t failed_{0};
+    bool stop_{false};
+
+    std::vector<std::thread> threads_;
+    std::vector<RequestLatencies> worker_latencies_;
+    RequestLatencies latencies_;
+};
+
+} // namespace ecf
+
+#endif
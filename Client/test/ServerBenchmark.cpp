@@ -0,0 +1,424 @@
+//============================================================================
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description : End to end server benchmark. Generates a synthetic defs, starts a
+//               local server, loads and begins the defs, then for <duration> seconds
+//               drives the server with simulated jobs, viewers and users.
+//               The timings, latency percentiles and server memory are written as JSON.
+//               The latencies are round trips, as seen by the clients. The time spent by
+//               the server is its CPU time (user + system) over each phase, in clock
+//               ticks (usually 10ms), with the requests it handled taken from its stats.
+//
+//   perf_server_benchmark [name=value ...]
+//       defs shape : see SyntheticDefs::Params, i.e. suites=100 depth=2 fan_out=4 tasks=10
+//       duration=10        seconds of load
+//       jobs=4             threads acting as the running jobs, see JobSimulator
+//       rate=0             child commands per second, over all jobs, 0 means no limit
+//       runtime=0          milliseconds from init to complete, per job
+//       abort_rate=0       fraction of jobs that abort, rather than complete
+//       meter_steps=3      updates per meter, per job
+//       viewers=2          threads doing news/sync, like ecflow_ui
+//       sync_interval=500  milliseconds between viewer news requests
+//       users=1            threads doing alter and suspend/resume
+//       user_interval=200  milliseconds between user commands
+//       port=<port>        defaults to a free port
+//       server=<path>      defaults to the ecflow_server of the build
+//       write_defs=<path>  also save the generated defs
+//       output=<path>      write the JSON to a file, rather than standard out
+//
+// Jobs are not run. The suites define ECF_NO_SCRIPT, and an ECF_JOB_CMD that only
+// queues the submission for the JobSimulator.
+//============================================================================
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "ClientInvoker.hpp"
+#include "EcfPortLock.hpp"
+#include "File.hpp"
+#include "Host.hpp"
+#include "Jobs.hpp"
+#include "JobSimulator.hpp"
+#include "JobsParam.hpp"
+#include "PrintStyle.hpp"
+#include "SCPort.hpp"
+#include "Stats.hpp"
+#include "Str.hpp"
+#include "SyntheticDefs.hpp"
+
+namespace fs = boost::filesystem;
+using namespace std;
+using namespace ecf;
+
+using Clock = std::chrono::steady_clock;
+
+static double ms_since(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// CPU time (user + system) used by a process in ms, from /proc/<pid>/stat
+static double cpu_ms(pid_t pid) {
+    std::ifstream stat("/proc/" + boost::lexical_cast<std::string>(pid) + "/stat");
+    std::string line;
+    if (!std::getline(stat, line))
+        return 0;
+
+    // The command name, field 2, may contain spaces, hence start after it
+    std::string::size_type pos = line.rfind(')');
+    if (pos == std::string::npos)
+        return 0;
+    std::istringstream ss(line.substr(pos + 1));
+    std::string field;
+    double utime = 0, stime = 0;
+    for (int i = 3; i <= 13 && ss >> field; i++) { // skip state .. majflt
+    }
+    if (!(ss >> utime >> stime))
+        return 0;
+    return (utime + stime) * 1000.0 / ::sysconf(_SC_CLK_TCK);
+}
+
+// The requests handled by the server, by type, from its stats
+static std::map<std::string, unsigned int> server_requests(ClientInvoker& client) {
+    client.stats_server();
+    const Stats& s = client.server_reply().stats();
+    return {{"init", s.task_init_},
+            {"event", s.task_event_},
+            {"meter", s.task_meter_},
+            {"label", s.task_label_},
+            {"complete", s.task_complete_},
+            {"abort", s.task_abort_},
+            {"news", s.news_},
+            {"sync", s.sync_},
+            {"sync(full)", s.sync_full_},
+            {"alter", s.alter_cmd_},
+            {"suspend", s.node_suspend_},
+            {"resume", s.node_resume_}};
+}
+
+// Resident and peak resident set size of a process in MB, from /proc/<pid>/status
+static double rss_mb(pid_t pid, const std::string& field = "VmRSS:") {
+    std::ifstream status("/proc/" + boost::lexical_cast<std::string>(pid) + "/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.find(field) == 0) {
+            std::istringstream ss(line.substr(field.size())); // i.e "   1234 kB"
+            double kb = 0;
+            ss >> kb;
+            return kb / 1024.0;
+        }
+    }
+    return 0;
+}
+
+struct Options
+{
+    SyntheticDefs::Params params;
+    int duration{10};
+    size_t jobs{4};
+    JobSimulator::Lifecycle lifecycle;
+    size_t viewers{2};
+    int sync_interval{500};
+    size_t users{1};
+    int user_interval{200};
+    std::string port;
+    std::string server;
+    std::string write_defs;
+    std::string output;
+
+    explicit Options(const std::vector<std::string>& args) {
+        for (const auto& arg : args) {
+            size_t eq         = arg.find('=');
+            std::string name  = arg.substr(0, eq);
+            std::string value = (eq == std::string::npos) ? std::string() : arg.substr(eq + 1);
+            if (name == "duration")
+                duration = boost::lexical_cast<int>(value);
+            else if (name == "jobs")
+                jobs = boost::lexical_cast<size_t>(value);
+            else if (name == "rate")
+                lifecycle.rate = boost::lexical_cast<double>(value);
+            else if (name == "runtime")
+                lifecycle.runtime_ms = boost::lexical_cast<int>(value);
+            else if (name == "abort_rate")
+                lifecycle.abort_rate = boost::lexical_cast<double>(value);
+            else if (name == "meter_steps")
+                lifecycle.meter_steps = boost::lexical_cast<size_t>(value);
+            else if (name == "viewers")
+                viewers = boost::lexical_cast<size_t>(value);
+            else if (name == "sync_interval")
+                sync_interval = boost::lexical_cast<int>(value);
+            else if (name == "users")
+                users = boost::lexical_cast<size_t>(value);
+            else if (name == "user_interval")
+                user_interval = boost::lexical_cast<int>(value);
+            else if (name == "port")
+                port = value;
+            else if (name == "server")
+                server = value;
+            else if (name == "write_defs")
+                write_defs = value;
+            else if (name == "output")
+                output = value;
+            else
+                params.set(arg);
+        }
+        if (port.empty())
+            port = SCPort::next_only();
+        if (server.empty())
+            server = File::find_ecf_server_path();
+    }
+};
+
+// Runs a server, in its own ECF_HOME, for the lifetime of the object
+class LocalServer {
+public:
+    LocalServer(const std::string& server_path, const std::string& port)
+        : port_(port),
+          home_(fs::temp_directory_path() / ("ecf_benchmark_" + port)) {
+        if (!fs::exists(server_path))
+            throw std::runtime_error("LocalServer: server not found at " + server_path);
+        fs::create_directories(home_);
+        EcfPortLock::create(port_);
+
+        pid_ = ::fork();
+        if (pid_ == 0) {
+            // keep the server output out of the JSON
+            int out = ::open((home_ / "server.out").string().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (out >= 0) {
+                ::dup2(out, STDOUT_FILENO);
+                ::dup2(out, STDERR_FILENO);
+            }
+            ::setenv("ECF_HOME", home_.string().c_str(), 1);
+            if (::chdir(home_.string().c_str()) == 0) {
+                std::string port_arg = "--port=" + port_;
+                ::execl(server_path.c_str(), server_path.c_str(), port_arg.c_str(), (char*)nullptr);
+            }
+            ::_exit(1);
+        }
+
+        ClientInvoker client(Str::LOCALHOST(), port_);
+        if (pid_ < 0 || !client.wait_for_server_reply(30))
+            throw std::runtime_error("LocalServer: failed to start server on port " + port_);
+    }
+
+    ~LocalServer() {
+        try {
+            ClientInvoker client(Str::LOCALHOST(), port_);
+            client.terminateServer();
+        }
+        catch (std::exception& e) {
+            std::cerr << "LocalServer: " << e.what() << "\n";
+            ::kill(pid_, SIGTERM);
+        }
+        ::waitpid(pid_, nullptr, 0);
+        EcfPortLock::remove(port_);
+        boost::system::error_code ec;
+        fs::remove_all(home_, ec);
+    }
+
+    pid_t pid() const { return pid_; }
+    std::string checkpt_file() const { return (home_ / Host().ecf_checkpt_file(port_)).string(); }
+
+private:
+    std::string port_;
+    fs::path home_;
+    pid_t pid_{-1};
+};
+
+// Polls for news, and syncs when there are changes, like the viewer
+static void viewer_thread(const Options& options, const Clock::time_point& end, RequestLatencies& latencies) {
+    ClientInvoker viewer(Str::LOCALHOST(), options.port);
+    latencies.time("sync(full)", [&viewer]() { viewer.sync_local(); });
+    while (Clock::now() < end) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(options.sync_interval));
+        latencies.time("news", [&viewer]() { viewer.news_local(); });
+        if (viewer.get_news())
+            latencies.time("sync", [&viewer]() { viewer.sync_local(); });
+    }
+}
+
+static void user_thread(const Options& options,
+                        const std::vector<std::string>& families,
+                        size_t id,
+                        const Clock::time_point& end,
+                        RequestLatencies& latencies) {
+    ClientInvoker user(Str::LOCALHOST(), options.port);
+    for (size_t i = id; Clock::now() < end && !families.empty(); i += options.users) {
+        const std::string& path = families[(i * 7919) % families.size()];
+        std::string value       = boost::lexical_cast<std::string>(i);
+        latencies.time("alter", [&user, &path, &value]() { user.alter(path, "change", "variable", "BENCH", value); });
+        latencies.time("suspend", [&user, &path]() { user.suspend(path); });
+        latencies.time("resume", [&user, &path]() { user.resume(path); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(options.user_interval));
+    }
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        Options options(std::vector<std::string>(argv + 1, argv + argc));
+
+        Clock::time_point start = Clock::now();
+        defs_ptr defs           = SyntheticDefs(options.params).create();
+        double generate_ms      = ms_since(start);
+        if (!options.write_defs.empty())
+            defs->save_as_filename(options.write_defs, PrintStyle::DEFS);
+
+        std::vector<std::string> families;
+        {
+            std::vector<Family*> vec;
+            defs->getAllFamilies(vec);
+            for (Family* f : vec) {
+                f->add_variable("BENCH", "0"); // changed by the users
+                families.push_back(f->absNodePath());
+            }
+        }
+
+        // Job generation only, in this process, on a copy
+        double job_generation_ms = 0;
+        size_t jobs_generated    = 0;
+        {
+            Defs copy(*defs);
+            copy.beginAll();
+            JobsParam jobsParam; // does not create or spawn jobs
+            Jobs jobs(&copy);
+            start = Clock::now();
+            jobs.generate(jobsParam);
+            job_generation_ms = ms_since(start);
+            jobs_generated    = jobsParam.submitted().size();
+        }
+
+        std::string queue_file = (fs::temp_directory_path() / ("ecf_benchmark_" + options.port + ".queue")).string();
+        JobSimulator jobs(Str::LOCALHOST(), options.port, *defs, queue_file, options.lifecycle, options.jobs);
+        for (const suite_ptr& suite : defs->suiteVec()) {
+            suite->add_variable(Str::ECF_NO_SCRIPT(), "1");
+            suite->add_variable(Str::ECF_JOB_CMD(), jobs.job_cmd());
+        }
+
+        LocalServer server(options.server, options.port);
+        double rss_start = rss_mb(server.pid());
+
+        ClientInvoker client(Str::LOCALHOST(), options.port);
+        client.restartServer(); // the server starts halted
+        jobs.start();
+        double cpu = cpu_ms(server.pid());
+        start      = Clock::now();
+        client.load(defs);
+        double load_ms        = ms_since(start);
+        double load_server_ms = cpu_ms(server.pid()) - cpu;
+        cpu                   = cpu_ms(server.pid());
+        start                 = Clock::now();
+        client.begin_all_suites();
+        double begin_ms        = ms_since(start);
+        double begin_server_ms = cpu_ms(server.pid()) - cpu;
+        double rss_loaded      = rss_mb(server.pid());
+        auto requests_before   = server_requests(client);
+        cpu                    = cpu_ms(server.pid());
+
+        // Drive the server
+        Clock::time_point end = Clock::now() + std::chrono::seconds(options.duration);
+        std::vector<RequestLatencies> latencies(options.viewers + options.users);
+        std::vector<std::thread> threads;
+        size_t t = 0;
+        for (size_t i = 0; i < options.viewers; i++, t++)
+            threads.emplace_back(viewer_thread, std::cref(options), std::cref(end), std::ref(latencies[t]));
+        for (size_t i = 0; i < options.users; i++, t++)
+            threads.emplace_back(user_thread,
+                                 std::cref(options),
+                                 std::cref(families),
+                                 i,
+                                 std::cref(end),
+                                 std::ref(latencies[t]));
+        start = Clock::now();
+        for (auto& th : threads)
+            th.join();
+        jobs.stop();
+        double load_seconds   = ms_since(start) / 1000.0;
+        double run_server_ms  = cpu_ms(server.pid()) - cpu;
+        auto requests_after   = server_requests(client);
+        size_t server_handled = 0;
+        for (auto& r : requests_after) {
+            r.second -= requests_before[r.first];
+            server_handled += r.second;
+        }
+
+        RequestLatencies all = jobs.latencies();
+        for (const auto& l : latencies)
+            all.merge(l);
+
+        cpu   = cpu_ms(server.pid());
+        start = Clock::now();
+        client.checkPtDefs();
+        double checkpt_ms        = ms_since(start);
+        double checkpt_server_ms = cpu_ms(server.pid()) - cpu;
+        boost::system::error_code ec;
+        auto checkpt_size = fs::file_size(server.checkpt_file(), ec);
+
+        std::ofstream file;
+        if (!options.output.empty()) {
+            file.open(options.output.c_str());
+            if (!file)
+                throw std::runtime_error("Could not create " + options.output);
+        }
+        std::ostream& os = options.output.empty() ? std::cout : file;
+        os << "{\n";
+        os << "  \"params\": \"" << options.params.to_string() << "\",\n";
+        os << "  \"tasks\": " << options.params.no_of_tasks() << ",\n";
+        os << "  \"generate_ms\": " << generate_ms << ",\n";
+        os << "  \"job_generation_ms\": " << job_generation_ms << ",\n";
+        os << "  \"jobs_generated\": " << jobs_generated << ",\n";
+        os << "  \"load_ms\": " << load_ms << ",\n";
+        os << "  \"begin_ms\": " << begin_ms << ",\n";
+        os << "  \"duration_s\": " << load_seconds << ",\n";
+        os << "  \"jobs\": {\"started\": " << jobs.jobs_started() << ", \"completed\": " << jobs.jobs_completed()
+           << ", \"aborted\": " << jobs.jobs_aborted() << ", \"failed\": " << jobs.jobs_failed()
+           << ", \"in_flight\": " << jobs.jobs_in_flight() << "},\n";
+        os << "  \"requests\": " << all.requests() << ",\n";
+        os << "  \"throughput\": " << all.requests() / load_seconds << ",\n";
+        os << "  \"latency\": ";
+        all.write_json(os);
+        os << ",\n";
+        os << "  \"checkpt_ms\": " << checkpt_ms << ",\n";
+        os << "  \"checkpt_bytes\": " << (ec ? 0 : checkpt_size) << ",\n";
+        os << "  \"server_cpu_ms\": {\"load\": " << load_server_ms << ", \"begin\": " << begin_server_ms
+           << ", \"run\": " << run_server_ms << ", \"checkpt\": " << checkpt_server_ms << "},\n";
+        os << "  \"server_requests\": {";
+        for (auto i = requests_after.begin(); i != requests_after.end(); ++i)
+            os << (i == requests_after.begin() ? "\"" : ", \"") << i->first << "\": " << i->second;
+        os << "},\n";
+        os << "  \"server_cpu_ms_per_request\": " << (server_handled ? run_server_ms / server_handled : 0) << ",\n";
+        os << "  \"server_rss_mb\": {\"start\": " << rss_start << ", \"loaded\": " << rss_loaded
+           << ", \"end\": " << rss_mb(server.pid()) << ", \"peak\": " << rss_mb(server.pid(), "VmHWM:") << "}\n";
+        os << "}\n";
+    }
+    catch (std::exception& e) {
+        std::cerr << "perf_server_benchmark: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -316,6 +316,9 @@ BOOST_AUTO_TEST_CASE(test_client_interface) {
     BOOST_REQUIRE_MESSAGE(theClient.loadDefs(path, true /*force*/, true /*check_only*/) == 0,
                           "should return 0\n"
                               << theClient.errorMsg());
+    BOOST_REQUIRE_MESSAGE(theClient.loadDefs(path, true /*force*/, false, false, false, true /*patch*/) == 0,
+                          "should return 0\n"
+                              << theClient.errorMsg());
 
     BOOST_REQUIRE_MESSAGE(theClient.replace("/suite1", path) == 0, " should return 0\n" << theClient.errorMsg());
     BOOST_REQUIRE_MESSAGE(theClient.replace("/suite1", path, true) == 0, " should return 0\n" << theClient.errorMsg());
@@ -325,6 +328,9 @@ BOOST_AUTO_TEST_CASE(test_client_interface) {
     BOOST_REQUIRE_MESSAGE(theClient.replace("/suite1", path, false, true) == 0,
                           " should return 0\n"
                               << theClient.errorMsg());
+    BOOST_REQUIRE_MESSAGE(theClient.replace("/suite1", path, true, true, true /*patch*/) == 0,
+                          " should return 0\n"
+                              << theClient.errorMsg());
 
     BOOST_REQUIRE_MESSAGE(theClient.order("/s", "top") == 0, " should return 0\n" << theClient.errorMsg());
     BOOST_REQUIRE_MESSAGE(theClient.order("/s", "bottom") == 0, " should return 0\n" << theClient.errorMsg());
@@ -398,6 +404,12 @@ BOOST_AUTO_TEST_CASE(test_client_interface) {
                               " should return 0\n"
                                   << theClient.errorMsg());
     }
+    BOOST_REQUIRE_MESSAGE(theClient.file("/s", "jobout", "100", "bytes=100-") == 0,
+                          " should return 0\n"
+                              << theClient.errorMsg());
+    BOOST_REQUIRE_MESSAGE(theClient.file("/s", "jobout", "100", "lines=10-20") == 0,
+                          " should return 0\n"
+                              << theClient.errorMsg());
 
     BOOST_REQUIRE_MESSAGE(theClient.plug("/source", "/dest") == 0, " should return 0\n" << theClient.errorMsg());
 
@@ -0,0 +1,95 @@
+//============================================================================
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+//============================================================================
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "ClientEnvironment.hpp"
+#include "ClientInvoker.hpp"
+#include "InvokeServer.hpp"
+#include "JobSimulator.hpp"
+#include "SCPort.hpp"
+#include "Suite.hpp"
+#include "SyntheticDefs.hpp"
+
+namespace fs = boost::filesystem;
+using namespace std;
+using namespace ecf;
+
+BOOST_AUTO_TEST_SUITE(ClientTestSuite)
+
+BOOST_AUTO_TEST_CASE(test_job_simulator) {
+    // The simulator reads the job submissions from a local file, hence needs a local server
+    if (!ClientEnvironment::hostSpecified().empty()) {
+        std::cout << "Client:: ...test_job_simulator, ignoring test when ECF_HOST specified..." << endl;
+        return;
+    }
+
+    InvokeServer invokeServer("Client:: ...test_job_simulator", SCPort::next());
+    BOOST_REQUIRE_MESSAGE(invokeServer.server_started(),
+                          "Server failed to start on " << invokeServer.host() << ":" << invokeServer.port());
+
+    SyntheticDefs::Params params;
+    params.suites          = 1;
+    params.depth           = 1;
+    params.fan_out         = 2;
+    params.tasks           = 4;
+    params.trigger_density = 1;
+    params.limits          = 0;
+    params.repeat_density  = 0;
+    params.time_density    = 0;
+    defs_ptr defs          = SyntheticDefs(params).create();
+
+    // Abort a third of the jobs, each abort is re-submitted with the next try number
+    JobSimulator::Lifecycle lifecycle;
+    lifecycle.abort_rate   = 0.3;
+    lifecycle.runtime_ms   = 20;
+    std::string queue_file = fs::absolute("test_job_simulator_" + invokeServer.port() + ".queue").string();
+    JobSimulator jobs(invokeServer.host(), invokeServer.port(), *defs, queue_file, lifecycle, 2);
+
+    suite_ptr suite = defs->suiteVec()[0];
+    suite->add_variable(Str::ECF_NO_SCRIPT(), "1");
+    suite->add_variable(Str::ECF_JOB_CMD(), jobs.job_cmd());
+    suite->add_variable(Str::ECF_TRIES(), "20");
+
+    ClientInvoker theClient(invokeServer.host(), invokeServer.port());
+    BOOST_REQUIRE_MESSAGE(theClient.restartServer() == 0, "restart failed " << theClient.errorMsg());
+    BOOST_REQUIRE_MESSAGE(theClient.load(defs) == 0, "load failed " << theClient.errorMsg());
+    jobs.start();
+    BOOST_REQUIRE_MESSAGE(theClient.begin_all_suites() == 0, "begin failed " << theClient.errorMsg());
+
+    bool complete = false;
+    for (int i = 0; i < 600 && !complete; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        BOOST_REQUIRE_MESSAGE(theClient.sync_local() == 0, "sync failed " << theClient.errorMsg());
+        complete = theClient.defs()->findAbsNode(suite->absNodePath())->state() == NState::COMPLETE;
+    }
+    jobs.stop();
+
+    BOOST_CHECK_MESSAGE(complete, "Expected the suite to complete");
+    BOOST_CHECK_MESSAGE(jobs.jobs_completed() == params.no_of_tasks(),
+                        "Expected " << params.no_of_tasks() << " jobs to complete but found " << jobs.jobs_completed());
+    BOOST_CHECK_MESSAGE(jobs.jobs_aborted() > 0 && jobs.jobs_started() == jobs.jobs_completed() + jobs.jobs_aborted(),
+                        "Expected the aborted jobs to be re-submitted, started(" << jobs.jobs_started() << ") aborted("
+                                                                                 << jobs.jobs_aborted() << ")");
+    BOOST_CHECK_MESSAGE(jobs.jobs_failed() == 0 && jobs.latencies().errors() == 0,
+                        "Expected no child command failures, i.e. wrong password or try number");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
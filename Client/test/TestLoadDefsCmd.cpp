@@ -165,4 +165,44 @@ BOOST_AUTO_TEST_CASE(test_load_defs) {
     System::destroy();
 }
 
+BOOST_AUTO_TEST_CASE(test_replace_patch_incremental_sync) {
+    /// Patching a suite in place, only changes the state, hence a connected client
+    /// should get an incremental sync, whereas replacing the suite needs a full sync
+    InvokeServer invokeServer("Client:: ...test_replace_patch_incremental_sync", SCPort::next());
+    BOOST_REQUIRE_MESSAGE(invokeServer.server_started(),
+                          "Server failed to start on " << invokeServer.host() << ":" << invokeServer.port());
+
+    defs_ptr theDefs = Defs::create();
+    theDefs->add_suite("s1")->add_family("f1")->add_task("t1");
+
+    ClientInvoker theClient(invokeServer.host(), invokeServer.port());
+    BOOST_REQUIRE_MESSAGE(theClient.load(theDefs) == 0, "Expected load to succeed\n" << theClient.errorMsg());
+    BOOST_REQUIRE_MESSAGE(theClient.sync_local() == 0, "sync_local failed\n" << theClient.errorMsg());
+
+    // Add a task and a label
+    defs_ptr patchDefs = Defs::create();
+    {
+        family_ptr f1 = patchDefs->add_suite("s1")->add_family("f1");
+        f1->add_task("t1")->addLabel(Label("info", "patched"));
+        f1->add_task("t2");
+    }
+    BOOST_REQUIRE_MESSAGE(theClient.replace_1("/s1", patchDefs, true, false, true /*patch*/) == 0,
+                          "Expected patch to succeed\n"
+                              << theClient.errorMsg());
+    BOOST_REQUIRE_MESSAGE(theClient.sync_local() == 0, "sync_local failed\n" << theClient.errorMsg());
+    BOOST_CHECK_MESSAGE(!theClient.server_reply().full_sync(), "Expected incremental sync after patch");
+    BOOST_CHECK_MESSAGE(theClient.defs()->findAbsNode("/s1/f1/t2"), "Expected added task to be synced");
+    node_ptr t1 = theClient.defs()->findAbsNode("/s1/f1/t1");
+    BOOST_CHECK_MESSAGE(t1 && t1->findLabel("info"), "Expected added label to be synced");
+
+    // Without patch, the suite is replaced
+    BOOST_REQUIRE_MESSAGE(theClient.replace_1("/s1", patchDefs, true, false) == 0,
+                          "Expected replace to succeed\n"
+                              << theClient.errorMsg());
+    BOOST_REQUIRE_MESSAGE(theClient.sync_local() == 0, "sync_local failed\n" << theClient.errorMsg());
+    BOOST_CHECK_MESSAGE(theClient.server_reply().full_sync(), "Expected full sync after replace");
+
+    System::destroy();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
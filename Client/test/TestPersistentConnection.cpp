@@ -0,0 +1,86 @@
+//============================================================================
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description : Test requests sent over a persistent connection, and compare with connecting per request
+//============================================================================
+
+#include <chrono>
+#include <iostream>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Defs.hpp"
+#include "InvokeServer.hpp"
+#include "SCPort.hpp"
+#include "Suite.hpp"
+#include "System.hpp"
+
+using namespace std;
+using namespace ecf;
+
+BOOST_AUTO_TEST_SUITE(ClientTestSuite)
+
+// Return the time in micro seconds, to make no_of_requests
+static long time_requests(ClientInvoker& theClient, int no_of_requests) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < no_of_requests; i++) {
+        BOOST_REQUIRE_MESSAGE(theClient.news_local() == 0, "news failed\n" << theClient.errorMsg());
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+BOOST_AUTO_TEST_CASE(test_persistent_connection) {
+    InvokeServer invokeServer("Client:: ...test_persistent_connection", SCPort::next());
+    BOOST_REQUIRE_MESSAGE(invokeServer.server_started(),
+                          "Server failed to start on " << invokeServer.host() << ":" << invokeServer.port());
+
+    ClientInvoker theClient(invokeServer.host(), invokeServer.port());
+    theClient.set_persistent_connection(true);
+
+    defs_ptr defs = Defs::create();
+    defs->add_suite("test_persistent_connection")->add_task("t1");
+    BOOST_REQUIRE_MESSAGE(theClient.load(defs) == 0, "load defs failed \n" << theClient.errorMsg());
+    BOOST_REQUIRE_MESSAGE(theClient.sync_local() == 0, "sync_local failed \n" << theClient.errorMsg());
+
+    // A change made over the persistent connection, must be seen by the next request
+    BOOST_REQUIRE_MESSAGE(theClient.suspend("/test_persistent_connection") == 0,
+                          "suspend failed\n" << theClient.errorMsg());
+    BOOST_REQUIRE_MESSAGE(theClient.sync_local() == 0, "sync_local failed \n" << theClient.errorMsg());
+    BOOST_CHECK_MESSAGE(theClient.defs()->findAbsNode("/test_persistent_connection")->isSuspended(),
+                        "Expected suspend to be synced");
+
+    // Waiting for changes closes the connection in the server, the next request must re-connect
+    BOOST_REQUIRE_MESSAGE(theClient.sync_local_wait(1) == 0, "sync_local_wait failed\n" << theClient.errorMsg());
+    BOOST_REQUIRE_MESSAGE(theClient.resume("/test_persistent_connection") == 0,
+                          "resume failed after server closed connection\n" << theClient.errorMsg());
+
+    // A request is sent once only, adding the same limit twice would fail
+    BOOST_REQUIRE_MESSAGE(theClient.sync_local_wait(1) == 0, "sync_local_wait failed\n" << theClient.errorMsg());
+    BOOST_REQUIRE_MESSAGE(theClient.alter("/test_persistent_connection", "add", "limit", "once", "10") == 0,
+                          "alter add failed after server closed connection\n" << theClient.errorMsg());
+    BOOST_REQUIRE_MESSAGE(theClient.sync_local() == 0, "sync_local failed \n" << theClient.errorMsg());
+    BOOST_CHECK_MESSAGE(theClient.defs()->findSuite("test_persistent_connection")->limits().size() == 1,
+                        "Expected a single limit");
+
+    // Compare the request latency, with and without a persistent connection
+    int no_of_requests = 500;
+    theClient.set_persistent_connection(false);
+    long per_request = time_requests(theClient, no_of_requests);
+    theClient.set_persistent_connection(true);
+    long persistent = time_requests(theClient, no_of_requests);
+    cout << "   " << no_of_requests << " news requests: connect per request(" << per_request / no_of_requests
+         << "us per request) persistent connection(" << persistent / no_of_requests << "us per request)\n";
+
+    System::destroy();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,127 @@
+//============================================================================
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description : Test clients waiting for changes, instead of polling. See ChangeSubscribers.hpp
+//============================================================================
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Defs.hpp"
+#include "DurationTimer.hpp"
+#include "InvokeServer.hpp"
+#include "SCPort.hpp"
+#include "Stats.hpp"
+#include "Suite.hpp"
+#include "System.hpp"
+
+using namespace std;
+using namespace ecf;
+
+BOOST_AUTO_TEST_SUITE(ClientTestSuite)
+
+// The number of news and sync requests handled by the server
+static int server_request_count(ClientInvoker& theClient) {
+    BOOST_REQUIRE_MESSAGE(theClient.stats_server() == 0, "stats_server failed\n" << theClient.errorMsg());
+    const Stats& stats = theClient.server_reply().stats();
+    return static_cast<int>(stats.news_ + stats.sync_);
+}
+
+// Run no_of_clients, for the given duration, either polling with news, or waiting for changes
+// Return the number of requests handled by the server
+static int client_load(const InvokeServer& invokeServer, int no_of_clients, int seconds, bool wait) {
+    ClientInvoker theClient(invokeServer.host(), invokeServer.port());
+    int start_count = server_request_count(theClient);
+
+    std::vector<std::thread> clients;
+    for (int i = 0; i < no_of_clients; i++) {
+        clients.emplace_back([&invokeServer, seconds, wait]() {
+            ClientInvoker client(invokeServer.host(), invokeServer.port());
+            client.set_throw_on_error(false);
+            if (client.sync_local() != 0)
+                return;
+            DurationTimer timer;
+            while (timer.duration() < seconds) {
+                if (wait) {
+                    (void)client.sync_local_wait(1);
+                }
+                else {
+                    if (client.news_local() == 0 && client.get_news())
+                        (void)client.sync_local();
+                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                }
+            }
+        });
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+
+    return server_request_count(theClient) - start_count;
+}
+
+BOOST_AUTO_TEST_CASE(test_sync_wait) {
+    InvokeServer invokeServer("Client:: ...test_sync_wait", SCPort::next());
+    BOOST_REQUIRE_MESSAGE(invokeServer.server_started(),
+                          "Server failed to start on " << invokeServer.host() << ":" << invokeServer.port());
+    ClientInvoker theClient(invokeServer.host(), invokeServer.port());
+
+    defs_ptr defs = Defs::create();
+    defs->add_suite("test_sync_wait")->add_task("t1");
+    BOOST_REQUIRE_MESSAGE(theClient.load(defs) == 0, "load defs failed \n" << theClient.errorMsg());
+    BOOST_REQUIRE_MESSAGE(theClient.sync_local() == 0, "sync_local failed \n" << theClient.errorMsg());
+
+    {
+        // No changes, the server should hold on to the request until the wait expires
+        int start_count = server_request_count(theClient);
+        DurationTimer timer;
+        BOOST_REQUIRE_MESSAGE(theClient.sync_local_wait(2) == 0, "sync_local_wait failed\n" << theClient.errorMsg());
+        BOOST_CHECK_MESSAGE(timer.duration() >= 1, "Expected server to wait, before replying");
+
+        // The held request is only counted once, the stats request itself is not counted
+        int count = server_request_count(theClient) - start_count;
+        BOOST_CHECK_MESSAGE(count == 1, "Expected the waiting sync to be counted once, but found " << count);
+    }
+    {
+        // A change made by another client, should end the wait
+        int suspend_result = 0;
+        std::thread other_client([&invokeServer, &suspend_result]() {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            ClientInvoker client(invokeServer.host(), invokeServer.port());
+            client.set_throw_on_error(false);
+            suspend_result = client.suspend("/test_sync_wait");
+        });
+        DurationTimer timer;
+        BOOST_REQUIRE_MESSAGE(theClient.sync_local_wait(60) == 0, "sync_local_wait failed\n" << theClient.errorMsg());
+        other_client.join();
+        BOOST_REQUIRE_MESSAGE(suspend_result == 0, "suspend failed");
+        BOOST_CHECK_MESSAGE(timer.duration() < 30, "Expected server to reply, when suite changed");
+        BOOST_CHECK_MESSAGE(theClient.defs()->findAbsNode("/test_sync_wait")->isSuspended(),
+                            "Expected suspend to be synced");
+    }
+    {
+        // Compare the number of requests handled by the server
+        int no_of_clients = 20;
+        int polling       = client_load(invokeServer, no_of_clients, 3, false);
+        int waiting       = client_load(invokeServer, no_of_clients, 3, true);
+        cout << "   " << no_of_clients << " clients for 3 seconds: polling requests(" << polling
+             << ") waiting requests(" << waiting << ")\n";
+        BOOST_CHECK_MESSAGE(waiting < polling, "Expected fewer requests, when clients wait for changes");
+    }
+
+    System::destroy();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
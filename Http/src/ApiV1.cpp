@@ -19,13 +19,16 @@
 #include <atomic>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include <sys/time.h>
 
 #include "ApiV1Impl.hpp"
 #include "Defs.hpp"
+#include "DefsSnapshot.hpp"
 #include "HttpServerException.hpp"
 #include "Options.hpp"
+#include "ResponseCache.hpp"
 #include "Str.hpp"
 #include "TypeToJson.hpp"
 #include "nlohmann/json.hpp"
@@ -37,7 +40,9 @@ static std::chrono::system_clock::time_point api_startup;
 std::atomic<unsigned int> num_requests(0);
 std::atomic<unsigned int> num_errors(0);
 std::atomic<unsigned int> num_cached_requests(0);
+std::atomic<unsigned int> num_not_modified(0);
 std::atomic<unsigned int> last_request_time(0);
+static ResponseCache response_cache;
 
 namespace {
 
@@ -207,17 +212,67 @@ json filter_json(const json& j, const httplib::Request& r) {
     return dive(j, path_elems);
 }
 
+// The ETag is derived from the change numbers of the defs, and the start up time of this
+// server, since the change numbers are only unique for the lifetime of the server
+std::string make_etag(const DefsVersion& version) {
+    const auto startup = std::chrono::duration_cast<std::chrono::seconds>(api_startup.time_since_epoch()).count();
+    return "\"" + std::to_string(startup) + "-" + std::to_string(version.modify_change_no) + "-" +
+           std::to_string(version.state_change_no) + "\"";
+}
+
+bool etag_matches(const httplib::Request& request, const std::string& etag) {
+    const std::string if_none_match = request.get_header_value("If-None-Match");
+    if (if_none_match.empty())
+        return false;
+
+    std::vector<std::string> tags;
+    ecf::Str::split(if_none_match, tags, ", ");
+    for (const auto& tag : tags) {
+        if (tag == "*" || tag == etag || tag == "W/" + etag)
+            return true;
+    }
+    return false;
+}
+
+// For requests that only read the mirrored defs. The ETag and the body are both derived from the
+// same snapshot of the defs, and the resource is resolved before any If-None-Match is answered, so
+// that a missing path is reported, rather than not modified. The response rendered for a version
+// of the defs is reused
+template <typename T>
+void cached_response(const httplib::Request& request, httplib::Response& response, T&& render) {
+    num_cached_requests++;
+    const auto defs = get_defs();
+    if (defs == nullptr) {
+        throw HttpServerException(HttpStatusCode::server_error_service_unavailable, "Definition not yet available");
+    }
+    const DefsVersion version = get_defs_version(*defs);
+    const std::string etag    = make_etag(version);
+
+    const std::string key = request.path + "?" + request.get_param_value("filter");
+    std::string body;
+    if (response_cache.find(key, version, body) == false) {
+        body = filter_json(render(*defs), request).dump();
+        response_cache.insert(key, version, body);
+    }
+
+    response.set_header("ETag", etag);
+    if (etag_matches(request, etag)) {
+        num_not_modified++;
+        response.status = HttpStatusCode::redirection_not_modified;
+        return;
+    }
+
+    response.status = HttpStatusCode::success_ok;
+    response.set_content(body, "application/json");
+}
+
 void create(httplib::Server& http_server) {
     if (opts.verbose)
         printf("Registering API location /v1\n");
 
     http_server.Get("/v1/suites", [](const httplib::Request& request, httplib::Response& response) {
         trycatch(request, response, [&]() {
-            num_cached_requests++;
-            json j          = filter_json(get_suites(), request);
-
-            response.status = HttpStatusCode::success_ok;
-            response.set_content(j.dump(), "application/json");
+            cached_response(request, response, [](const DefsSnapshot& defs) { return get_suites(defs); });
             set_cors(response);
         });
     });
@@ -241,10 +296,9 @@ void create(httplib::Server& http_server) {
 
     http_server.Get("/v1/suites/tree", [](const httplib::Request& request, httplib::Response& response) {
         trycatch(request, response, [&]() {
-            num_cached_requests++;
-            json j          = filter_json(get_sparser_node_tree("/"), request);
-            response.status = HttpStatusCode::success_ok;
-            response.set_content(j.dump(), "application/json");
+            cached_response(request, response, [](const DefsSnapshot& defs) {
+                return get_sparser_node_tree(defs, "/");
+            });
             set_cors(response);
         });
     });
@@ -261,11 +315,10 @@ void create(httplib::Server& http_server) {
     http_server.Get(R"(/v1/suites([A-Za-z0-9_\/\.]+)/tree$)",
                     [](const httplib::Request& request, httplib::Response& response) {
                         trycatch(request, response, [&]() {
-                            num_cached_requests++;
                             const std::string path = request.matches[1];
-                            json j                 = filter_json(get_sparser_node_tree(path), request);
-                            response.status        = HttpStatusCode::success_ok;
-                            response.set_content(j.dump(), "application/json");
+                            cached_response(request, response, [&](const DefsSnapshot& defs) {
+                                return get_sparser_node_tree(defs, path);
+                            });
                             set_cors(response);
                         });
                     });
@@ -310,12 +363,10 @@ void create(httplib::Server& http_server) {
     http_server.Get(R"(/v1/suites([A-Za-z0-9_\/\.]+)/definition$)",
                     [](const httplib::Request& request, httplib::Response& response) {
                         trycatch(request, response, [&]() {
-                            num_cached_requests++;
                             const std::string path = request.matches[1];
-                            json j                 = filter_json(get_node_definition(path), request);
-
-                            response.status        = HttpStatusCode::success_ok;
-                            response.set_content(j.dump(), "application/json");
+                            cached_response(request, response, [&](const DefsSnapshot& defs) {
+                                return get_node_definition(defs, path);
+                            });
                             set_cors(response);
                         });
                     });
@@ -367,12 +418,10 @@ void create(httplib::Server& http_server) {
     http_server.Get(R"(/v1/suites([A-Za-z0-9_\/\.]+)/attributes$)",
                     [](const httplib::Request& request, httplib::Response& response) {
                         trycatch(request, response, [&]() {
-                            num_cached_requests++;
                             const std::string path = request.matches[1];
-                            json j                 = filter_json(get_node_attributes(path), request);
-
-                            response.status        = HttpStatusCode::success_ok;
-                            response.set_content(j.dump(), "application/json");
+                            cached_response(request, response, [&](const DefsSnapshot& defs) {
+                                return get_node_attributes(defs, path);
+                            });
                             set_cors(response);
                         });
                     });
@@ -558,11 +607,7 @@ void create(httplib::Server& http_server) {
 
     http_server.Get("/v1/server/attributes", [](const httplib::Request& request, httplib::Response& response) {
         trycatch(request, response, [&]() {
-            num_cached_requests++;
-            json j          = filter_json(get_server_attributes(), request);
-
-            response.status = HttpStatusCode::success_ok;
-            response.set_content(j.dump(), "application/json");
+            cached_response(request, response, [](const DefsSnapshot& defs) { return get_server_attributes(defs); });
             set_cors(response);
         });
     });
@@ -617,6 +662,8 @@ void create(httplib::Server& http_server) {
             json j = {{"num_requests", num_requests.load()},
                       {"num_errors", num_errors.load()},
                       {"num_cached_requests", num_cached_requests.load()},
+                      {"num_not_modified", num_not_modified.load()},
+                      {"num_response_cache_hits", response_cache.hits()},
                       {"since", std::string(date)}};
 
             j      = filter_json(j, request);
@@ -17,6 +17,7 @@
 #include "ApiV1Impl.hpp"
 
 #include <mutex>
+#include <set>
 #include <string>
 #include <thread>
 
@@ -26,6 +27,7 @@
 #include "Child.hpp"
 #include "ClientInvoker.hpp"
 #include "Defs.hpp"
+#include "DefsSnapshot.hpp"
 #include "DefsStructureParser.hpp"
 #include "Family.hpp"
 #include "HttpServerException.hpp"
@@ -37,9 +39,11 @@
 #include "TypeToJson.hpp"
 #include "nlohmann/json.hpp"
 
-std::shared_ptr<Defs> defs_ = nullptr;
+// The defs mirrored from the ecFlow server. This is an immutable snapshot, published by the
+// update loop, whenever the server has changed. Requests hold on to a snapshot, and must not modify it
+std::shared_ptr<const DefsSnapshot> defs_ = nullptr;
 
-using json                  = nlohmann::json;
+using json                        = nlohmann::json;
 
 static std::mutex def_mutex, cv_mutex;
 static std::condition_variable defs_cv;
@@ -119,11 +123,20 @@ std::string json_type_to_string(const json& j) {
 
 } // namespace
 
-std::shared_ptr<Defs> get_defs() {
+std::shared_ptr<const DefsSnapshot> get_defs() {
     std::lock_guard<std::mutex> lock(def_mutex);
     return defs_;
 }
 
+DefsVersion get_defs_version(const DefsSnapshot& defs) {
+    return DefsVersion{defs.modify_change_no(), defs.state_change_no()};
+}
+
+void publish_defs(const std::shared_ptr<const DefsSnapshot>& defs) {
+    std::lock_guard<std::mutex> lock(def_mutex);
+    defs_ = defs;
+}
+
 json make_node_json(node_ptr node) {
     return json::object({{"type", tolower(node->debugType())}, {"name", node->name()}, {"children", json::array()}});
 }
@@ -247,8 +260,34 @@ std::unique_ptr<ClientInvoker> get_client(const json& j) {
     return ci;
 }
 
-node_ptr get_node(const std::string& path) {
-    node_ptr node = get_defs()->findAbsNode(path);
+// Return a defs, holding a copy of *only* the suite containing path, or nullptr if path is not found.
+// This can be modified locally, and then sent back to the server with replace_suite_copy()
+defs_ptr copy_suite_of(const std::string& path) {
+    auto snapshot = get_defs();
+    auto node     = snapshot->findAbsNode(path);
+    if (node.get() == nullptr) {
+        return nullptr;
+    }
+
+    auto defs = Defs::create();
+    defs->addSuite(std::make_shared<Suite>(*node->suite()));
+    return defs;
+}
+
+// Externs are added for references to nodes in other suites, so that the copy passes the client side checks
+void replace_suite_copy(const httplib::Request& request,
+                        const std::string& path,
+                        const defs_ptr& defs,
+                        bool create_parents_as_required,
+                        bool force) {
+    defs->auto_add_externs();
+
+    auto client = get_client(request);
+    client->replace_1(path, defs, create_parents_as_required, force);
+}
+
+node_ptr get_node(const DefsSnapshot& defs, const std::string& path) {
+    node_ptr node = defs.findAbsNode(path);
     if (node.get() == nullptr) {
         throw HttpServerException(HttpStatusCode::client_error_not_found, "Path " + path + " not found");
     }
@@ -256,6 +295,10 @@ node_ptr get_node(const std::string& path) {
     return node;
 }
 
+node_ptr get_node(const std::string& path) {
+    return get_node(*get_defs(), path);
+}
+
 json get_node_status(const httplib::Request& request) {
     const std::string path = request.matches[1];
 
@@ -291,11 +334,11 @@ void apply_recursively_to_parent(json& j, const Node* node, T&& func) {
     }
 }
 
-json get_sparser_node_tree(const std::string& path) {
+json get_sparser_node_tree(const DefsSnapshot& defs, const std::string& path) {
     json j;
 
     if (path == "/") {
-        const std::vector<suite_ptr> suites = get_defs()->suiteVec();
+        const std::vector<suite_ptr> suites = defs.suiteVec();
         for (const auto& suite : suites) {
             j[suite->name()] = json::object({});
 
@@ -303,7 +346,7 @@ json get_sparser_node_tree(const std::string& path) {
         }
     }
     else {
-        node_ptr node = get_node(path);
+        node_ptr node = get_node(defs, path);
 
         if (node == nullptr) {
             throw HttpServerException(HttpStatusCode::client_error_not_found, "Node " + path + " not found");
@@ -359,8 +402,8 @@ json get_node_tree(const std::string& path, bool add_id = false) {
     return j;
 }
 
-json get_suites() {
-    auto suites = get_defs()->suiteVec();
+json get_suites(const DefsSnapshot& defs) {
+    auto suites = defs.suiteVec();
 
     json j      = json::array();
     for (const auto& s : suites) {
@@ -369,13 +412,13 @@ json get_suites() {
     return j;
 }
 
-json get_server_attributes() {
+json get_server_attributes(const DefsSnapshot& defs) {
 
     json j;
 
-    j["variables"] = get_defs()->server().user_variables();
+    j["variables"] = defs.server().user_variables();
 
-    for (auto v : get_defs()->server().server_variables()) {
+    for (auto v : defs.server().server_variables()) {
         json _j     = v;
         _j["const"] = true;
         j["variables"].push_back(_j);
@@ -429,10 +472,10 @@ json get_generated_variables(node_ptr& node) {
     return j;
 }
 
-json get_node_attributes(const std::string& path) {
+json get_node_attributes(const DefsSnapshot& defs, const std::string& path) {
     json j;
 
-    node_ptr node      = get_node(path);
+    node_ptr node      = get_node(defs, path);
 
     j["meters"]        = node->meters();
     j["limits"]        = node->limits();
@@ -471,8 +514,8 @@ json get_node_attributes(const std::string& path) {
         j["inherited_variables"] = js;
     }
 
-    auto server_variables = get_defs()->server().server_variables();
-    auto user_variables   = get_defs()->server().user_variables();
+    auto server_variables = defs.server().server_variables();
+    auto user_variables   = defs.server().user_variables();
 
     server_variables.insert(server_variables.end(), user_variables.begin(), user_variables.end());
 
@@ -481,10 +524,10 @@ json get_node_attributes(const std::string& path) {
     return j;
 }
 
-json get_node_definition(const std::string& path) {
+json get_node_definition(const DefsSnapshot& defs, const std::string& path) {
     json j;
 
-    node_ptr node   = get_node(path);
+    node_ptr node   = get_node(defs, path);
 
     j["definition"] = node->print();
     j["path"]       = path;
@@ -570,11 +613,10 @@ json update_node_definition(const httplib::Request& request) {
     // user can give us just the definition of a new task, and
     // we will add that to the suite.
 
-    // this takes a long time, but we need a copy as we are changing
-    // the defs locally here
+    // The snapshot is shared, hence we change a copy of the suite locally
 
-    auto defs   = std::make_shared<Defs>(*get_defs());
-    auto parent = defs->findAbsNode(path);
+    auto defs   = copy_suite_of(path);
+    auto parent = (defs) ? defs->findAbsNode(path) : node_ptr();
 
     if (parent == nullptr) {
         throw HttpServerException(HttpStatusCode::client_error_not_found, "Path not found");
@@ -607,8 +649,7 @@ json update_node_definition(const httplib::Request& request) {
 
     parent->addChild(node);
 
-    auto client = get_client(request);
-    client->replace(path, defs->print(), true, force);
+    replace_suite_copy(request, path, defs, true, force);
 
     json j;
     j["path"]    = path;
@@ -658,23 +699,22 @@ template <typename T>
 void add_attribute_to_path(const T& attr, const httplib::Request& request) {
     const std::string path = request.matches[1];
 
-    auto defs              = std::make_shared<Defs>(*get_defs());
-    auto parent            = defs->findAbsNode(path);
+    auto defs              = copy_suite_of(path);
+    auto parent            = (defs) ? defs->findAbsNode(path) : node_ptr();
 
     if (parent.get() == nullptr) {
         throw HttpServerException(HttpStatusCode::client_error_not_found, "Path " + path + " not found");
     }
     add_attribute_to_node(parent, attr);
 
-    auto client = get_client(request);
-    client->replace(path, defs->print(), false, false);
+    replace_suite_copy(request, path, defs, false, false);
 }
 
 void remove_attribute_from_path(const std::string& type, const httplib::Request& request) {
     const std::string path = request.matches[1];
 
-    auto defs              = std::make_shared<Defs>(*get_defs());
-    auto parent            = defs->findAbsNode(path);
+    auto defs              = copy_suite_of(path);
+    auto parent            = (defs) ? defs->findAbsNode(path) : node_ptr();
 
     if (parent.get() == nullptr) {
         throw HttpServerException(HttpStatusCode::client_error_not_found, "Path " + path + " not found");
@@ -687,16 +727,15 @@ void remove_attribute_from_path(const std::string& type, const httplib::Request&
     else if (type == "autoarchive")
         parent->deleteAutoArchive();
 
-    auto client = get_client(request);
-    client->replace(path, defs->print(), false, false);
+    replace_suite_copy(request, path, defs, false, false);
 }
 
 template <typename T>
 void update_attribute_in_path(const T& attr, const std::string& type, const httplib::Request& request) {
     const std::string path = request.matches[1];
 
-    auto defs              = std::make_shared<Defs>(*get_defs());
-    auto parent            = defs->findAbsNode(path);
+    auto defs              = copy_suite_of(path);
+    auto parent            = (defs) ? defs->findAbsNode(path) : node_ptr();
 
     if (parent.get() == nullptr) {
         throw HttpServerException(HttpStatusCode::client_error_not_found, "Path " + path + " not found");
@@ -711,8 +750,7 @@ void update_attribute_in_path(const T& attr, const std::string& type, const http
 
     add_attribute_to_node(parent, attr);
 
-    auto client = get_client(request);
-    client->replace(path, defs->print(), false, false);
+    replace_suite_copy(request, path, defs, false, false);
 }
 
 template <typename T>
@@ -1170,17 +1208,44 @@ void update_defs_loop(int interval) {
             return static_cast<unsigned int>(curtime.tv_sec);
         };
 
+        // The defs kept in sync with the server, only ever used by this thread. When it has
+        // changed, a snapshot is published, hence readers never see the incremental changes applied.
+        // The snapshot only copies the suites changed by the sync, see DefsSnapshot
+        defs_ptr working;
+
         auto update = [&] {
-            {
-                std::lock_guard<std::mutex> lock(def_mutex);
-                if (defs_ != nullptr)
-                    client.sync(defs_);
-                defs_ = client.defs();
+            const bool first                    = (working == nullptr);
+            const unsigned int modify_change_no = (first) ? 0 : working->modify_change_no();
+            const unsigned int state_change_no  = (first) ? 0 : working->state_change_no();
+            if (!first)
+                client.sync(working);
+            working = client.defs();
+
+            if (first || modify_change_no != working->modify_change_no() ||
+                state_change_no != working->state_change_no()) {
+                // A full sync replaces the working defs, hence nothing can be shared
+                auto previous = get_defs();
+                bool share    = !first && previous && !client.server_reply().full_sync();
+
+                std::set<std::string> changed_suites;
+                if (share) {
+                    for (const auto& path : client.server_reply().changed_nodes()) {
+                        changed_suites.insert(DefsSnapshot::suite_name(path));
+                    }
+                }
+
+                auto snapshot = DefsSnapshot::create(*working, (share) ? previous : nullptr, changed_suites);
+                publish_defs(snapshot);
+                if (opts.verbose) {
+                    printf("Defs snapshot copied %zu of %zu suites\n",
+                           snapshot->suites_copied(),
+                           working->suiteVec().size());
+                }
             }
             if (opts.verbose) {
                 printf("Defs modify_change_no: %d state_change_no: %d\n",
-                       defs_->modify_change_no(),
-                       defs_->state_change_no());
+                       working->modify_change_no(),
+                       working->state_change_no());
             }
         };
 
@@ -1217,7 +1282,7 @@ void update_defs_loop(int interval) {
                     }
                     else {
                         // update triggered by timeout
-                        client.news(defs_);
+                        client.news(working);
                         if (client.get_news()) {
                             update();
                             update_defs = false;
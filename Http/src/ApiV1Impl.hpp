@@ -34,29 +34,38 @@
 #endif
 
 #include "ClientInvoker.hpp"
+#include "ResponseCache.hpp"
 #include "httplib.h"
 #include "nlohmann/json.hpp"
 
+class DefsSnapshot;
+
 void update_defs_loop(int interval);
 
+/// The current snapshot of the defs, nullptr until the first sync with the server
+std::shared_ptr<const DefsSnapshot> get_defs();
+
+/// The change numbers of a snapshot of the defs
+DefsVersion get_defs_version(const DefsSnapshot& defs);
+
 std::unique_ptr<ClientInvoker> get_client(const httplib::Request& request);
 std::unique_ptr<ClientInvoker> get_client(const nlohmann::json& j);
 
-nlohmann::json get_sparser_node_tree(const std::string& path);
+nlohmann::json get_sparser_node_tree(const DefsSnapshot& defs, const std::string& path);
 
 void add_suite(const httplib::Request& request, httplib::Response& response);
 
-nlohmann::json get_suites();
+nlohmann::json get_suites(const DefsSnapshot& defs);
 
-nlohmann::json get_server_attributes();
+nlohmann::json get_server_attributes(const DefsSnapshot& defs);
 nlohmann::json add_server_attribute(const httplib::Request& request);
 nlohmann::json update_server_attribute(const httplib::Request& request);
 nlohmann::json delete_server_attribute(const httplib::Request& request);
 
-nlohmann::json get_node_definition(const std::string& path);
+nlohmann::json get_node_definition(const DefsSnapshot& defs, const std::string& path);
 nlohmann::json update_node_definition(const httplib::Request& request);
 
-nlohmann::json get_node_attributes(const std::string& path);
+nlohmann::json get_node_attributes(const DefsSnapshot& defs, const std::string& path);
 nlohmann::json add_node_attribute(const httplib::Request& request);
 nlohmann::json update_node_attribute(const httplib::Request& request);
 nlohmann::json delete_node_attribute(const httplib::Request& request);
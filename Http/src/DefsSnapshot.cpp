@@ -0,0 +1,141 @@
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        : DefsSnapshot
+// Author      : partio
+// Revision    : $Revision$
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+//
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#include "DefsSnapshot.hpp"
+
+#include "Defs.hpp"
+#include "ExprAst.hpp"
+#include "ExprAstVisitor.hpp"
+#include "Suite.hpp"
+
+namespace {
+
+// The names of the other suites referenced by the trigger, complete and inlimit of the nodes of suite.
+// The nodes cache the nodes they reference, hence such a suite can not be shared once these have changed
+std::set<std::string> referenced_suites(const Suite& suite) {
+    std::set<Node*> referenced;
+    ecf::AstCollateNodesVisitor visitor(referenced);
+    std::set<std::string> suites;
+
+    auto collate = [&](const Node& node) {
+        if (AstTop* ast = node.triggerAst()) {
+            ast->accept(visitor);
+        }
+        if (AstTop* ast = node.completeAst()) {
+            ast->accept(visitor);
+        }
+        for (const auto& inlimit : node.inlimits()) {
+            const std::string& path = inlimit.pathToNode();
+            if (!path.empty() && path[0] == '/') {
+                suites.insert(DefsSnapshot::suite_name(path));
+            }
+        }
+    };
+
+    collate(suite);
+    std::vector<node_ptr> nodes;
+    suite.get_all_nodes(nodes);
+    for (const auto& node : nodes) {
+        collate(*node);
+    }
+
+    for (Node* node : referenced) {
+        suites.insert(node->suite()->name());
+    }
+    suites.erase(suite.name());
+    return suites;
+}
+
+bool references_any(const std::set<std::string>& suites, const std::set<std::string>& changed_suites) {
+    for (const auto& name : suites) {
+        if (changed_suites.find(name) != changed_suites.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+std::shared_ptr<const DefsSnapshot> DefsSnapshot::create(const Defs& working,
+                                                         const std::shared_ptr<const DefsSnapshot>& previous,
+                                                         const std::set<std::string>& changed_suites) {
+    std::shared_ptr<const DefsSnapshot> snapshot(new DefsSnapshot(working, previous.get(), changed_suites));
+    if (previous && snapshot->suites_copied_ < snapshot->owner_->suiteVec().size()) {
+        // The shared suites now point to the new Defs, which must outlive the previous snapshot
+        previous->successor_ = snapshot;
+    }
+    return snapshot;
+}
+
+DefsSnapshot::DefsSnapshot(const Defs& working,
+                           const DefsSnapshot* previous,
+                           const std::set<std::string>& changed_suites)
+    : modify_change_no_(working.modify_change_no()),
+      state_change_no_(working.state_change_no()),
+      server_(working.server()),
+      owner_(Defs::create()) {
+
+    owner_->set_server() = server_;
+    owner_->set_state_only(working.state());
+
+    for (const auto& suite : working.suiteVec()) {
+        if (previous && changed_suites.find(suite->name()) == changed_suites.end() &&
+            (changed_suites.empty() || !references_any(referenced_suites(*suite), changed_suites))) {
+            suite_ptr found = previous->owner_->findSuite(suite->name());
+            if (found) {
+                owner_->share_suite(found);
+                continue;
+            }
+        }
+
+        owner_->addSuite(std::make_shared<Suite>(*suite));
+        suites_copied_++;
+    }
+}
+
+DefsSnapshot::~DefsSnapshot() {
+    // Release the chain of successors iteratively, a long lived request could hold on to many
+    std::shared_ptr<const DefsSnapshot> next = std::move(successor_);
+    while (next && next.use_count() == 1) {
+        std::shared_ptr<const DefsSnapshot> after = std::move(next->successor_);
+        next                                      = std::move(after);
+    }
+}
+
+std::vector<suite_ptr> DefsSnapshot::suiteVec() const {
+    // The suites keep the snapshot, and hence its successors, alive
+    std::vector<suite_ptr> suites;
+    suites.reserve(owner_->suiteVec().size());
+    for (const auto& suite : owner_->suiteVec()) {
+        suites.emplace_back(shared_from_this(), suite.get());
+    }
+    return suites;
+}
+
+node_ptr DefsSnapshot::findAbsNode(const std::string& path) const {
+    node_ptr node = owner_->findAbsNode(path);
+    if (node) {
+        return node_ptr(shared_from_this(), node.get());
+    }
+    return node_ptr();
+}
+
+std::string DefsSnapshot::suite_name(const std::string& path) {
+    std::string::size_type start = (!path.empty() && path[0] == '/') ? 1 : 0;
+    std::string::size_type end   = path.find('/', start);
+    return path.substr(start, (end == std::string::npos) ? std::string::npos : end - start);
+}
@@ -0,0 +1,76 @@
+#ifndef DEFSSNAPSHOT_HPP
+#define DEFSSNAPSHOT_HPP
+
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        : DefsSnapshot
+// Author      : partio
+// Revision    : $Revision$
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+//
+// An immutable copy of the defs mirrored from the ecFlow server, shared by the
+// requests. Only the suites that changed since the previous snapshot, or that
+// reference the changed suites, are copied; the others are shared with it.
+//
+// All the suites are held by a single Defs, together with a copy of the server
+// state, hence trigger references across suites resolve within the snapshot.
+// A suite can only point to one Defs, hence a shared suite is moved to the Defs
+// of the latest snapshot holding it: requests still using an older snapshot then
+// see the newer server state through Node::defs(). Each snapshot keeps its
+// successor alive, so that Node::defs() remains valid for as long as a node is held.
+//
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "NodeFwd.hpp"
+#include "ServerState.hpp"
+
+class DefsSnapshot : public std::enable_shared_from_this<DefsSnapshot> {
+public:
+    /// Copy the suites of working, the defs kept in sync with the server. Suites not named
+    /// in changed_suites are shared with previous, if any.
+    static std::shared_ptr<const DefsSnapshot> create(const Defs& working,
+                                                      const std::shared_ptr<const DefsSnapshot>& previous,
+                                                      const std::set<std::string>& changed_suites);
+    DefsSnapshot(const DefsSnapshot&)            = delete;
+    DefsSnapshot& operator=(const DefsSnapshot&) = delete;
+    ~DefsSnapshot();
+
+    unsigned int modify_change_no() const { return modify_change_no_; }
+    unsigned int state_change_no() const { return state_change_no_; }
+    const ServerState& server() const { return server_; }
+
+    std::vector<suite_ptr> suiteVec() const;
+    node_ptr findAbsNode(const std::string& path) const;
+
+    /// The number of suites copied, rather than shared with the previous snapshot
+    size_t suites_copied() const { return suites_copied_; }
+
+    /// The name of the suite in an absolute node path, i.e. "s1" for "/s1/f1/t1"
+    static std::string suite_name(const std::string& path);
+
+private:
+    DefsSnapshot(const Defs& working, const DefsSnapshot* previous, const std::set<std::string>& changed_suites);
+
+    unsigned int modify_change_no_{0};
+    unsigned int state_change_no_{0};
+    ServerState server_;
+    std::shared_ptr<Defs> owner_; // holds all the suites
+    size_t suites_copied_{0};
+
+    // The next snapshot, set once it shares suites with this one. Never read by the requests
+    mutable std::shared_ptr<const DefsSnapshot> successor_;
+};
+
+#endif
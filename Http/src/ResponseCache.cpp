@@ -0,0 +1,50 @@
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        : ResponseCache
+// Author      : partio
+// Revision    : $Revision$
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+//
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#include "ResponseCache.hpp"
+
+bool ResponseCache::find(const std::string& key, const DefsVersion& version, std::string& body) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end() || it->second.version != version) {
+        misses_++;
+        return false;
+    }
+    hits_++;
+    body = it->second.body;
+    return true;
+}
+
+void ResponseCache::insert(const std::string& key, const DefsVersion& version, const std::string& body) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.size() >= max_entries_ && entries_.find(key) == entries_.end()) {
+        // Entries for an older version of the defs, can never be returned again
+        for (auto it = entries_.begin(); it != entries_.end();) {
+            if (it->second.version != version)
+                it = entries_.erase(it);
+            else
+                ++it;
+        }
+        if (entries_.size() >= max_entries_)
+            entries_.clear();
+    }
+    entries_[key] = Entry{version, body};
+}
+
+size_t ResponseCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
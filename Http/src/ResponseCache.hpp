@@ -0,0 +1,71 @@
+#ifndef RESPONSECACHE_HPP
+#define RESPONSECACHE_HPP
+
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        : ResponseCache
+// Author      : partio
+// Revision    : $Revision$
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+//
+// Rendered json responses, for requests that only read the mirrored defs.
+// Each response is stored with the version (change numbers) of the defs it was
+// rendered from. An entry is only returned for the same version, hence a new
+// snapshot invalidates the cache, without the need to clear it explicitly.
+//
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+struct DefsVersion
+{
+    unsigned int modify_change_no{0};
+    unsigned int state_change_no{0};
+
+    bool operator==(const DefsVersion& rhs) const {
+        return modify_change_no == rhs.modify_change_no && state_change_no == rhs.state_change_no;
+    }
+    bool operator!=(const DefsVersion& rhs) const { return !operator==(rhs); }
+};
+
+class ResponseCache {
+public:
+    explicit ResponseCache(size_t max_entries = 1024) : max_entries_(max_entries) {}
+    ResponseCache(const ResponseCache&)            = delete;
+    ResponseCache& operator=(const ResponseCache&) = delete;
+
+    /// Return true, and set body, if key was rendered from the given version of the defs
+    bool find(const std::string& key, const DefsVersion& version, std::string& body) const;
+
+    /// When full, the entries for older versions are removed first
+    void insert(const std::string& key, const DefsVersion& version, const std::string& body);
+
+    size_t size() const;
+    unsigned int hits() const { return hits_; }
+    unsigned int misses() const { return misses_; }
+
+private:
+    struct Entry
+    {
+        DefsVersion version;
+        std::string body;
+    };
+
+    size_t max_entries_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    mutable std::atomic<unsigned int> hits_{0};
+    mutable std::atomic<unsigned int> misses_{0};
+};
+
+#endif
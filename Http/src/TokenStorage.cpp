@@ -18,6 +18,7 @@
 
     #include "TokenStorage.hpp"
 
+    #include <algorithm>
     #include <atomic> // shared mutex only with c++14
     #include <fstream>
     #include <iomanip>
@@ -27,6 +28,7 @@
     #include <boost/filesystem.hpp>
     #include <openssl/evp.h>
     #include <openssl/hmac.h>
+    #include <openssl/rand.h>
     #include <openssl/sha.h>
     #include <shared_mutex>
 
@@ -120,9 +122,26 @@ std::chrono::system_clock::time_point time_point_from_isostring(const std::strin
     strptime(str.c_str(), "%Y-%m-%dT%H:%M:%SZ", &tm);
     return std::chrono::system_clock::from_time_t(std::mktime(&tm));
 }
+
+string create_secret() {
+    unsigned char secret[32];
+    if (RAND_bytes(secret, sizeof(secret)) != 1) {
+        throw HttpServerException(HttpStatusCode::server_error_internal_server_error,
+                                  "Failed to create secret for token cache");
+    }
+    return string(reinterpret_cast<const char*>(secret), sizeof(secret));
+}
 } // namespace
 
-TokenStorage::TokenStorage() {
+std::vector<Token> ReadTokens(const std::string& filename);
+
+TokenStorage::TokenStorage(const std::string& filename)
+    : tokens_(std::make_shared<const std::vector<Token>>()),
+      secret_(create_secret()) {
+    read_tokens(filename);
+}
+
+TokenStorage::TokenStorage() : tokens_(std::make_shared<const std::vector<Token>>()), secret_(create_secret()) {
     std::thread t(&TokenStorage::ReadStorage, this);
     t.detach();
 
@@ -134,16 +153,36 @@ TokenStorage::TokenStorage() {
 bool TokenStorage::verify(const std::string& token) const {
     const auto now = std::chrono::system_clock::now();
 
-    // Take a (weak) reader lock; the background thread updating
-    // tokens from file can block us but other readers cannot
+    // The hashing methods are deliberately slow (pbkdf2), hence avoid repeating
+    // it for tokens that were verified recently
+    const string key = hmac_sha256(secret_, token);
+    if (find_verified(key, now)) {
+        return true;
+    }
 
-    std::shared_lock<std::shared_mutex> lock(m);
-    for (const auto& t : tokens_) {
+    unsigned int generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(verified_mutex_);
+        generation = generation_;
+    }
+
+    // Take a (weak) reader lock, only to get the current tokens; the hashing is
+    // done without holding the lock, so that requests can be verified in parallel
+
+    std::shared_ptr<const std::vector<Token>> tokens;
+    {
+        std::shared_lock<std::shared_mutex> lock(m);
+        tokens = tokens_;
+    }
+
+    for (const auto& t : *tokens) {
+        hashes_++;
         const string hashed = ::hash(t.method, t.salt, token);
         if (hashed == t.hash && (t.expires.time_since_epoch().count() == 0 || t.expires > now) &&
             (t.revoked.time_since_epoch().count() == 0 || t.revoked > now)) {
             if (opts.verbose)
                 printf("Token for '%s' authenticated succesfully\n", t.description.c_str());
+            add_verified(key, t, generation);
             return true;
         }
         // printf("%s %s %s to %s should be %s\n", t.method.c_str(), t.salt.c_str(), token.c_str(), hashed.c_str(),
@@ -152,6 +191,36 @@ bool TokenStorage::verify(const std::string& token) const {
     return false;
 }
 
+bool TokenStorage::find_verified(const std::string& key, const std::chrono::system_clock::time_point& now) const {
+    std::lock_guard<std::mutex> lock(verified_mutex_);
+    auto it = verified_.find(key);
+    if (it == verified_.end()) {
+        return false;
+    }
+    if (it->second > now) {
+        return true;
+    }
+    verified_.erase(it);
+    return false;
+}
+
+void TokenStorage::add_verified(const std::string& key, const Token& t, unsigned int generation) const {
+    auto valid_until = std::chrono::system_clock::now() + verified_lifetime();
+    if (t.expires.time_since_epoch().count() != 0)
+        valid_until = std::min(valid_until, t.expires);
+    if (t.revoked.time_since_epoch().count() != 0)
+        valid_until = std::min(valid_until, t.revoked);
+
+    std::lock_guard<std::mutex> lock(verified_mutex_);
+    if (generation != generation_) {
+        return; // token file was read again, whilst verifying
+    }
+    if (verified_.size() >= max_verified()) {
+        verified_.clear();
+    }
+    verified_[key] = valid_until;
+}
+
 std::vector<Token> ReadTokens(const std::string& filename) {
     std::ifstream ifs(filename);
     json j = json::parse(ifs);
@@ -210,6 +279,25 @@ std::vector<Token> ReadTokens(const std::string& filename) {
     return new_tokens;
 }
 
+void TokenStorage::read_tokens(const std::string& filename) {
+    auto new_tokens = std::make_shared<const std::vector<Token>>(ReadTokens(filename));
+    {
+        std::lock_guard<std::shared_mutex> lock(m);
+        tokens_ = new_tokens;
+    }
+    {
+        // Tokens may have been revoked, or removed
+        std::lock_guard<std::mutex> lock(verified_mutex_);
+        verified_.clear();
+        generation_++;
+    }
+}
+
+unsigned int TokenStorage::generation() const {
+    std::lock_guard<std::mutex> lock(verified_mutex_);
+    return generation_;
+}
+
 void TokenStorage::ReadStorage() {
     namespace fs = boost::filesystem;
     namespace ch = std::chrono;
@@ -224,11 +312,7 @@ void TokenStorage::ReadStorage() {
         try {
             auto current_modified = ch::system_clock::from_time_t(fs::last_write_time(fs::path(opts.tokens_file)));
             if (current_modified > last_modified) {
-                auto new_tokens = ReadTokens(opts.tokens_file);
-                {
-                    std::lock_guard<std::shared_mutex> lock(m);
-                    tokens_ = new_tokens;
-                }
+                read_tokens(opts.tokens_file);
                 last_modified = current_modified;
             }
         }
@@ -18,8 +18,12 @@
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
 
 #ifdef ECF_OPENSSL
+    #include <atomic>
     #include <chrono>
+    #include <memory>
+    #include <mutex>
     #include <string>
+    #include <unordered_map>
     #include <vector>
 
 struct Token
@@ -51,6 +55,9 @@ public:
         static TokenStorage instance_;
         return instance_;
     }
+    /// Read the tokens from filename once, the file is not watched for changes
+    explicit TokenStorage(const std::string& filename);
+    ~TokenStorage() = default;
     TokenStorage(const TokenStorage&)            = delete;
     TokenStorage(TokenStorage&&)                 = delete;
     TokenStorage& operator=(const TokenStorage&) = delete;
@@ -58,12 +65,36 @@ public:
 
     bool verify(const std::string& token) const;
 
+    /// Replace the tokens with those of filename, this forgets the tokens verified so far
+    void read_tokens(const std::string& filename);
+
+    /// Incremented each time the tokens are read
+    unsigned int generation() const;
+
+    /// The number of times a token was hashed, by verify
+    unsigned int hashes() const { return hashes_; }
+
+    /// Successfully verified tokens are remembered for at most this long, or until
+    /// they expire, are revoked, or the token file is read again
+    static std::chrono::seconds verified_lifetime() { return std::chrono::seconds(300); }
+    static size_t max_verified() { return 1024; }
+
 private:
     TokenStorage();
-    ~TokenStorage() = default;
     void ReadStorage();
 
-    std::vector<Token> tokens_;
+    bool find_verified(const std::string& key, const std::chrono::system_clock::time_point& now) const;
+    void add_verified(const std::string& key, const Token& t, unsigned int generation) const;
+
+    // Replaced, not modified, when the token file is read, hence verify can hash without holding the lock
+    std::shared_ptr<const std::vector<Token>> tokens_;
+
+    // Keyed by a hmac of the presented token, using a secret only known to this process
+    std::string secret_;
+    mutable std::mutex verified_mutex_;
+    mutable std::unordered_map<std::string, std::chrono::system_clock::time_point> verified_;
+    unsigned int generation_{0}; // incremented when the token file is read
+    mutable std::atomic<unsigned int> hashes_{0};
 };
 
 #endif
@@ -397,6 +397,12 @@ BOOST_AUTO_TEST_CASE(test_token_authentication) {
         HttpStatusCode::success_created);
     wait_until([] { return check_for_element("/v1/server/attributes?filter=variables", "value", "xfoo", "xbar"); });
 
+    // A second request with the same token, the verification cache itself is tested by TestTokenStorage
+    handle_response(request("delete", "/v1/server/attributes", R"({"type":"variable","name":"xfoo"})", pbkdf2_API_KEY),
+                    HttpStatusCode::success_no_content);
+    wait_until(
+        [] { return false == check_for_element("/v1/server/attributes?filter=variables", "value", "xfoo", "xbar"); });
+
     const string expired_API_KEY("764073a74875ada28859454e58881229a5149ae400589fc617234d8d96c6d91a");
     handle_response(
         request(
@@ -867,6 +873,59 @@ BOOST_AUTO_TEST_CASE(test_suite_family_delete, *utf::depends_on("HttpTestSuite/t
     wait_until([] { return false == check_for_path("/v1/suites/test/definition"); });
 }
 
+BOOST_AUTO_TEST_CASE(test_etag, *utf::depends_on("HttpTestSuite/test_server")) {
+    std::cout << "======== " << boost::unit_test::framework::current_test_case().p_name << " =========" << std::endl;
+
+    const string resource = "/v1/suites/tree";
+    auto etag_of          = [&] { return handle_response(request("get", resource)).get_header_value("ETag"); };
+
+    string etag           = etag_of();
+    BOOST_REQUIRE_MESSAGE(etag.empty() == false, "Expected an ETag for " << resource);
+
+    // Unchanged defs
+    handle_response(request("get", resource, "", "", {{"If-None-Match", etag}}),
+                    HttpStatusCode::redirection_not_modified);
+
+    // Any version matches, but only a resource that exists
+    handle_response(request("get", resource, "", "", {{"If-None-Match", "*"}}),
+                    HttpStatusCode::redirection_not_modified);
+    handle_response(request("get", "/v1/suites/no_such_suite/tree", "", "", {{"If-None-Match", "*"}}),
+                    HttpStatusCode::client_error_not_found);
+
+    // Any change in the server, must change the ETag
+    handle_response(
+        request("post", "/v1/server/attributes", R"({"type":"variable","name":"etag","value":"1"})", API_KEY),
+        HttpStatusCode::success_created);
+    wait_until([&] {
+        auto r = request("get", resource, "", "", {{"If-None-Match", etag}});
+        return r && r->status == HttpStatusCode::success_ok;
+    });
+    handle_response(request("delete", "/v1/server/attributes", R"({"type":"variable","name":"etag"})", API_KEY),
+                    HttpStatusCode::success_no_content);
+    wait_until([&] { return etag_of() != etag; });
+
+    // Load, polling the same resource, with and without revalidation
+    auto load = [&](const httplib::Headers& headers, HttpStatusCode expected) {
+        const int count = 200;
+        auto start      = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; i++) {
+            auto r = request("get", resource, "", "", headers);
+            BOOST_REQUIRE_MESSAGE(r && r->status == expected, "Unexpected reply for " << resource);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return count / elapsed.count();
+    };
+
+    etag                 = etag_of();
+    const double full    = load({}, HttpStatusCode::success_ok);
+    const double revalid = load({{"If-None-Match", etag}}, HttpStatusCode::redirection_not_modified);
+    std::cout << "   " << resource << " requests/second: full(" << full << ") not modified(" << revalid << ")\n";
+
+    auto j = json::parse(handle_response(request("get", "/v1/statistics")).body);
+    BOOST_REQUIRE(j["num_not_modified"].get<int>() >= 200);
+    BOOST_REQUIRE(j["num_response_cache_hits"].get<int>() > 0);
+}
+
 BOOST_AUTO_TEST_CASE(test_statistics, *utf::depends_on("HttpTestSuite/test_server")) {
     std::cout << "======== " << boost::unit_test::framework::current_test_case().p_name << " =========" << std::endl;
 
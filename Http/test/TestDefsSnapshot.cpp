@@ -0,0 +1,91 @@
+#define BOOST_TEST_MODULE TestHttpUnit
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        :
+// Author      : partio
+// Revision    : $Revision$
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#include <boost/test/unit_test.hpp>
+
+#include "Defs.hpp"
+#include "DefsSnapshot.hpp"
+#include "ExprAst.hpp"
+#include "Suite.hpp"
+#include "Task.hpp"
+
+BOOST_AUTO_TEST_SUITE(DefsSnapshotTestSuite)
+
+namespace {
+
+defs_ptr create_working_defs(const std::string& trigger) {
+    defs_ptr defs = Defs::create();
+    task_ptr t1   = defs->add_suite("s1")->add_task("t");
+    defs->add_suite("s2")->add_task("t");
+    if (!trigger.empty()) {
+        t1->add_trigger(trigger);
+        t1->set_state(NState::QUEUED);
+    }
+    return defs;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_defs_snapshot_share_unchanged_suites) {
+    defs_ptr working = create_working_defs("");
+
+    auto first = DefsSnapshot::create(*working, nullptr, {});
+    BOOST_CHECK_EQUAL(first->suites_copied(), 2u);
+    node_ptr s1_t = first->findAbsNode("/s1/t");
+    BOOST_REQUIRE(s1_t);
+
+    working->findAbsNode("/s2/t")->set_state(NState::COMPLETE);
+    auto second = DefsSnapshot::create(*working, first, {"s2"});
+    BOOST_CHECK_EQUAL(second->suites_copied(), 1u);
+    BOOST_CHECK_MESSAGE(second->findAbsNode("/s1/t").get() == s1_t.get(), "Expected the unchanged suite to be shared");
+    BOOST_CHECK_EQUAL(first->findAbsNode("/s2/t")->state(), NState::UNKNOWN);
+    BOOST_CHECK_EQUAL(second->findAbsNode("/s2/t")->state(), NState::COMPLETE);
+
+    // The shared suite now belongs to the Defs of the second snapshot, which the first keeps alive
+    second.reset();
+    BOOST_REQUIRE(s1_t->defs());
+    node_ptr s2_t = s1_t->defs()->findAbsNode("/s2/t");
+    BOOST_REQUIRE(s2_t);
+    BOOST_CHECK_EQUAL(s2_t->state(), NState::COMPLETE);
+}
+
+BOOST_AUTO_TEST_CASE(test_defs_snapshot_cross_suite_trigger) {
+    defs_ptr working = create_working_defs("/s2/t == complete");
+
+    auto first    = DefsSnapshot::create(*working, nullptr, {});
+    node_ptr s1_t = first->findAbsNode("/s1/t");
+    BOOST_REQUIRE(s1_t && s1_t->triggerAst());
+    BOOST_CHECK_MESSAGE(!s1_t->triggerAst()->evaluate(), "Expected trigger to reference the incomplete /s2/t");
+
+    std::vector<std::string> why;
+    s1_t->bottom_up_why(why);
+    bool found = false;
+    for (const auto& reason : why) {
+        found |= (reason.find("/s2/t") != std::string::npos);
+    }
+    BOOST_CHECK_MESSAGE(found, "Expected why to reference /s2/t");
+
+    // s1 references the changed suite, hence is copied, rather than using the /s2/t cached by its trigger
+    working->findAbsNode("/s2/t")->set_state(NState::COMPLETE);
+    auto second = DefsSnapshot::create(*working, first, {"s2"});
+    BOOST_CHECK_EQUAL(second->suites_copied(), 2u);
+    node_ptr s1_t_second = second->findAbsNode("/s1/t");
+    BOOST_REQUIRE(s1_t_second && s1_t_second->triggerAst());
+    BOOST_CHECK_MESSAGE(s1_t_second->triggerAst()->evaluate(), "Expected trigger to reference the complete /s2/t");
+    BOOST_CHECK_MESSAGE(!s1_t->triggerAst()->evaluate(), "Expected the first snapshot to be unchanged");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
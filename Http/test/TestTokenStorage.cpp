@@ -0,0 +1,119 @@
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        :
+// Author      : partio
+// Revision    : $Revision$
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#ifdef ECF_OPENSSL
+
+    #include <chrono>
+    #include <cstdio>
+    #include <ctime>
+    #include <fstream>
+    #include <string>
+    #include <thread>
+
+    #include <boost/test/unit_test.hpp>
+
+    #include "TokenStorage.hpp"
+    #include "nlohmann/json.hpp"
+
+BOOST_AUTO_TEST_SUITE(TokenStorageTestSuite)
+
+namespace {
+
+// The hashes of these tokens are the same as in TokenFile.hpp
+const std::string SHA256_TOKEN("3a8c3f7ac204d9c6370b5916bd8b86166c208e10776285edcbc741d56b5b4c1e");
+const std::string SHA256_HASH(
+    "sha256$22660ab1789dc30e$7e24f61129294505b6ac310ebe891df9800f4854a67bac953bb86bf9fd726813");
+const std::string PBKDF2_TOKEN("351db772d94310a6d57aa7144448f4c108e7ee2e2a00a74edbdf8edb11bee71b");
+const std::string PBKDF2_HASH(
+    "pbkdf2:sha256:20000$Iqbh8Bz86hYHpkpn$ea95e8fb276c602fe4a4b56569fbcc321be5b31a3caa6bb3a9001e595349887f");
+
+std::string isostring(const std::chrono::system_clock::time_point& t) {
+    // The token file times are read with mktime(), i.e. as local time
+    const std::time_t tt = std::chrono::system_clock::to_time_t(t);
+    char buf[32];
+    std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", std::localtime(&tt));
+    return buf;
+}
+
+struct TokenFileFixture
+{
+    ~TokenFileFixture() { std::remove(path.c_str()); }
+
+    void write(const nlohmann::json& j) const {
+        std::ofstream o(path);
+        o << j << std::endl;
+    }
+
+    const std::string path{"TestTokenStorage.json"};
+};
+
+} // namespace
+
+BOOST_FIXTURE_TEST_CASE(test_token_storage_remembers_verified_tokens, TokenFileFixture) {
+    write({{{"hash", PBKDF2_HASH}, {"description", "pbkdf2"}}});
+    TokenStorage storage(path);
+
+    BOOST_CHECK(storage.verify(PBKDF2_TOKEN));
+    const unsigned int hashes = storage.hashes();
+    BOOST_CHECK_EQUAL(hashes, 1u);
+
+    BOOST_CHECK(storage.verify(PBKDF2_TOKEN));
+    BOOST_CHECK_MESSAGE(storage.hashes() == hashes, "Expected a verified token not to be hashed again");
+
+    BOOST_CHECK(!storage.verify(SHA256_TOKEN));
+    BOOST_CHECK(!storage.verify(SHA256_TOKEN));
+    BOOST_CHECK_MESSAGE(storage.hashes() == hashes + 2, "Expected an unknown token to be hashed each time");
+}
+
+BOOST_FIXTURE_TEST_CASE(test_token_storage_read_forgets_verified_tokens, TokenFileFixture) {
+    write({{{"hash", SHA256_HASH}, {"description", "sha256"}}});
+    TokenStorage storage(path);
+    const unsigned int generation = storage.generation();
+
+    BOOST_CHECK(storage.verify(SHA256_TOKEN));
+
+    // The token is removed from the file
+    write({{{"hash", PBKDF2_HASH}, {"description", "pbkdf2"}}});
+    storage.read_tokens(path);
+    BOOST_CHECK_EQUAL(storage.generation(), generation + 1);
+
+    const unsigned int hashes = storage.hashes();
+    BOOST_CHECK_MESSAGE(!storage.verify(SHA256_TOKEN), "Expected a removed token not to be served from the cache");
+    BOOST_CHECK_MESSAGE(storage.hashes() > hashes, "Expected the token to be hashed again");
+    BOOST_CHECK(storage.verify(PBKDF2_TOKEN));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_token_storage_expired_and_revoked_tokens, TokenFileFixture) {
+    const auto soon = isostring(std::chrono::system_clock::now() + std::chrono::seconds(2));
+    write({{{"hash", SHA256_HASH}, {"description", "expires"}, {"expires_at", soon}},
+           {{"hash", PBKDF2_HASH}, {"description", "revoked"}, {"revoked_at", soon}}});
+    TokenStorage storage(path);
+
+    BOOST_CHECK(storage.verify(SHA256_TOKEN));
+    BOOST_CHECK(storage.verify(PBKDF2_TOKEN));
+    const unsigned int hashes = storage.hashes();
+    BOOST_CHECK(storage.verify(SHA256_TOKEN));
+    BOOST_CHECK(storage.verify(PBKDF2_TOKEN));
+    BOOST_CHECK_EQUAL(storage.hashes(), hashes);
+
+    std::this_thread::sleep_for(std::chrono::seconds(3));
+    BOOST_CHECK_MESSAGE(!storage.verify(SHA256_TOKEN), "Expected an expired token not to be served from the cache");
+    BOOST_CHECK_MESSAGE(!storage.verify(PBKDF2_TOKEN), "Expected a revoked token not to be served from the cache");
+    BOOST_CHECK(storage.hashes() > hashes);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -42,4 +42,39 @@ const T copyObject(const T& v) {
     return v;
 }
 
+/// Release the python GIL, for the lifetime of this object. Use around calls that block, i.e. waiting
+/// for the server, or that do a lot of work in C++. *No* python objects may be used whilst released.
+class ReleaseGIL : private boost::noncopyable {
+public:
+    ReleaseGIL() : state_(PyEval_SaveThread()) {}
+    ~ReleaseGIL() { PyEval_RestoreThread(state_); }
+
+private:
+    PyThreadState* state_;
+};
+
+/// Adapts a member function, so that it is called without the GIL:
+///    .def("sync_local", &WithoutGIL<&ClientInvoker::sync_local>::call)
+/// The arguments are converted from python before, and the result converted after, the GIL is released
+template <auto F>
+struct WithoutGIL;
+
+template <typename R, typename C, typename... Args, R (C::*F)(Args...) const>
+struct WithoutGIL<F>
+{
+    static R call(C* self, Args... args) {
+        ReleaseGIL nogil;
+        return (self->*F)(args...);
+    }
+};
+
+template <typename R, typename C, typename... Args, R (C::*F)(Args...)>
+struct WithoutGIL<F>
+{
+    static R call(C* self, Args... args) {
+        ReleaseGIL nogil;
+        return (self->*F)(args...);
+    }
+};
+
 #endif
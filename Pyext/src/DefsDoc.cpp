@@ -1006,3 +1006,38 @@ const char* DefsDoc::get_server_state() {
            "   except RuntimeError, e:\n"
            "       print(str(e))\n";
 }
+
+const char* DefsDoc::node_iterator_doc() {
+    return "Yields `node`_\\ s one at a time, in depth first order. See iter_nodes()\n\n"
+           "The nodes are found as the iteration proceeds, hence the whole tree is never copied.\n"
+           "The definition should not be changed (i.e by sync_local()) while iterating.";
+}
+
+const char* DefsDoc::iter_nodes_doc() {
+    return "Returns an iterator over this node(s) and all child `node`_\\ s, in depth first order.\n\n"
+           "Unlike get_all_nodes(), nodes are found on demand. Hence this is preferred for large definitions.\n"
+           "The nodes can be filtered by:\n\n"
+           "- type:  one of 'suite','family','task','alias'. Default: any node\n"
+           "- state: a :py:class:`ecflow.State`. Default: any state\n"
+           "- path:  the absolute node path must start with this prefix. Default: any path\n"
+           "\nUsage:\n\n"
+           ".. code-block:: python\n\n"
+           "   for task in defs.iter_nodes(type='task', state=State.aborted, path='/s1/f1'):\n"
+           "       print(task.get_abs_node_path())\n";
+}
+
+const char* DefsDoc::get_node_paths_doc() {
+    return "Returns a list of the absolute node paths, for the nodes selected by iter_nodes()\n\n"
+           "No python object is created for the nodes, hence this is much cheaper when only the paths are needed.\n"
+           "Takes the same arguments, and returns the paths in the same order as get_node_states()\n"
+           "\nUsage:\n\n"
+           ".. code-block:: python\n\n"
+           "   paths  = defs.get_node_paths(type='task')\n"
+           "   states = defs.get_node_states(type='task')\n"
+           "   aborted = [ path for path, state in zip(paths, states) if state == State.aborted ]\n";
+}
+
+const char* DefsDoc::get_node_states_doc() {
+    return "Returns a list of :py:class:`ecflow.State`, for the nodes selected by iter_nodes()\n\n"
+           "Takes the same arguments, and returns the states in the same order as get_node_paths()";
+}
@@ -70,6 +70,10 @@ public:
     static const char* check();
     static const char* simulate();
     static const char* get_server_state();
+    static const char* node_iterator_doc();
+    static const char* iter_nodes_doc();
+    static const char* get_node_paths_doc();
+    static const char* get_node_states_doc();
 
 private:
     DefsDoc() = default;
@@ -45,6 +45,7 @@ std::string version(ClientInvoker* self) {
     return ecf::Version::raw();
 }
 std::string server_version(ClientInvoker* self) {
+    ReleaseGIL nogil;
     self->server_version();
     return self->get_string();
 }
@@ -53,10 +54,12 @@ const std::string& query(ClientInvoker* self,
                          const std::string& query_type,
                          const std::string& path_to_attribute,
                          const std::string& attribute) {
+    ReleaseGIL nogil;
     self->query(query_type, path_to_attribute, attribute);
     return self->get_string();
 }
 const std::string& query1(ClientInvoker* self, const std::string& query_type, const std::string& path_to_attribute) {
+    ReleaseGIL nogil;
     self->query(query_type, path_to_attribute, "");
     return self->get_string();
 }
@@ -64,16 +67,19 @@ const std::string& query1(ClientInvoker* self, const std::string& query_type, co
 // const std::string& get_log(ClientInvoker* self) { self->getLog(); return self->get_string();}
 
 const std::string& get_log(ClientInvoker* self, int lastLines) {
+    ReleaseGIL nogil;
     self->getLog(lastLines);
     return self->get_string();
 }
 
 const std::string& edit_script_edit(ClientInvoker* self, const std::string& absNodePath) {
+    ReleaseGIL nogil;
     self->edit_script_edit(absNodePath);
     return self->get_string();
 }
 
 const std::string& edit_script_preprocess(ClientInvoker* self, const std::string& absNodePath) {
+    ReleaseGIL nogil;
     self->edit_script_preprocess(absNodePath);
     return self->get_string();
 }
@@ -95,6 +101,7 @@ int edit_script_submit(ClientInvoker* self,
         string::size_type pos = namv[i].find(sep);
         used_variables.push_back(std::make_pair(namv[i].substr(0, pos - 1), namv[i].substr(pos + 1, namv[i].length())));
     }
+    ReleaseGIL nogil;
     return self->edit_script_submit(absNodePath, used_variables, file_contents, alias, run);
 }
 
@@ -120,7 +127,10 @@ boost::python::object get_file(ClientInvoker* self,
                                const std::string& file_type = "script",
                                const std::string& max_lines = "10000",
                                bool as_bytes                = false) {
-    self->file(absNodePath, file_type, max_lines);
+    {
+        ReleaseGIL nogil;
+        self->file(absNodePath, file_type, max_lines);
+    }
     const std::string& s = self->get_string();
 
     return convert_to_pyobject(s, as_bytes);
@@ -137,13 +147,18 @@ private:
 };
 void stats(ClientInvoker* self) {
     CliSetter setter(self);
+    ReleaseGIL nogil;
     self->stats();
 }
 void stats_reset(ClientInvoker* self) {
+    ReleaseGIL nogil;
     self->stats_reset();
 }
 bp::list suites(ClientInvoker* self) {
-    self->suites();
+    {
+        ReleaseGIL nogil;
+        self->suites();
+    }
     const std::vector<std::string>& the_suites = self->server_reply().get_string_vec();
     bp::list list;
     size_t the_size = the_suites.size();
@@ -153,139 +168,172 @@ bp::list suites(ClientInvoker* self) {
 }
 
 bool news_local(ClientInvoker* self) {
+    ReleaseGIL nogil;
     self->news_local();
     return self->get_news();
 }
 
 void free_trigger_dep(ClientInvoker* self, const std::string& path) {
+    ReleaseGIL nogil;
     self->freeDep(path, true /*trigger*/, false /*all*/, false /*date*/, false /*time*/);
 }
 void free_date_dep(ClientInvoker* self, const std::string& path) {
+    ReleaseGIL nogil;
     self->freeDep(path, false /*trigger*/, false /*all*/, true /*date*/, false /*time*/);
 }
 void free_time_dep(ClientInvoker* self, const std::string& path) {
+    ReleaseGIL nogil;
     self->freeDep(path, false /*trigger*/, false /*all*/, false /*date*/, true /*time*/);
 }
 void free_all_dep(ClientInvoker* self, const std::string& path) {
+    ReleaseGIL nogil;
     self->freeDep(path, false /*trigger*/, true /*all*/, false /*date*/, false /*time*/);
 }
 void free_trigger_dep1(ClientInvoker* self, const bp::list& list) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->freeDep(paths, true /*trigger*/, false /*all*/, false /*date*/, false /*time*/);
 }
 void free_date_dep1(ClientInvoker* self, const bp::list& list) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->freeDep(paths, false /*trigger*/, false /*all*/, true /*date*/, false /*time*/);
 }
 void free_time_dep1(ClientInvoker* self, const bp::list& list) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->freeDep(paths, false /*trigger*/, false /*all*/, false /*date*/, true /*time*/);
 }
 void free_all_dep1(ClientInvoker* self, const bp::list& list) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->freeDep(paths, false /*trigger*/, true /*all*/, false /*date*/, false /*time*/);
 }
 
 void force_state(ClientInvoker* self, const std::string& path, NState::State state) {
+    ReleaseGIL nogil;
     self->force(path, NState::toString(state), false);
 }
 void force_states(ClientInvoker* self, const bp::list& list, NState::State state) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->force(paths, NState::toString(state), false);
 }
 void force_state_recursive(ClientInvoker* self, const std::string& path, NState::State state) {
+    ReleaseGIL nogil;
     self->force(path, NState::toString(state), true);
 }
 void force_states_recursive(ClientInvoker* self, const bp::list& list, NState::State state) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->force(paths, NState::toString(state), true);
 }
 void force_event(ClientInvoker* self, const std::string& path, const std::string& set_or_clear) {
+    ReleaseGIL nogil;
     self->force(path, set_or_clear);
 }
 void force_events(ClientInvoker* self, const bp::list& list, const std::string& set_or_clear) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->force(paths, set_or_clear);
 }
 
 void run(ClientInvoker* self, const std::string& path, bool force) {
+    ReleaseGIL nogil;
     self->run(path, force);
 }
 void runs(ClientInvoker* self, const bp::list& list, bool force) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->run(paths, force);
 }
 void requeue(ClientInvoker* self, std::string path, const std::string& option) {
+    ReleaseGIL nogil;
     self->requeue(path, option);
 }
 void requeues(ClientInvoker* self, const bp::list& list, const std::string& option) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->requeue(paths, option);
 }
 void suspend(ClientInvoker* self, const std::string& path) {
+    ReleaseGIL nogil;
     self->suspend(path);
 }
 void suspends(ClientInvoker* self, const bp::list& list) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->suspend(paths);
 }
 void resume(ClientInvoker* self, const std::string& path) {
+    ReleaseGIL nogil;
     self->resume(path);
 }
 void resumes(ClientInvoker* self, const bp::list& list) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->resume(paths);
 }
 void archive(ClientInvoker* self, const std::string& path) {
+    ReleaseGIL nogil;
     self->archive(path);
 }
 void archives(ClientInvoker* self, const bp::list& list) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->archive(paths);
 }
 void restore(ClientInvoker* self, const std::string& path) {
+    ReleaseGIL nogil;
     self->restore(path);
 }
 void restores(ClientInvoker* self, const bp::list& list) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->restore(paths);
 }
 void the_status(ClientInvoker* self, const std::string& path) {
+    ReleaseGIL nogil;
     self->status(path);
 }
 void statuss(ClientInvoker* self, const bp::list& list) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->status(paths);
 }
 void do_kill(ClientInvoker* self, const std::string& path) {
+    ReleaseGIL nogil;
     self->kill(path);
 }
 void do_kills(ClientInvoker* self, const bp::list& list) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->kill(paths);
 }
 const std::string& check(ClientInvoker* self, const std::string& node_path) {
+    ReleaseGIL nogil;
     self->check(node_path);
     return self->get_string();
 }
 const std::string& checks(ClientInvoker* self, const bp::list& list) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->check(paths);
     return self->get_string();
 }
@@ -293,51 +341,66 @@ const std::string& checks(ClientInvoker* self, const bp::list& list) {
 void delete_node(ClientInvoker* self, const bp::list& list, bool force) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->delete_nodes(paths, force);
 }
 
 void ch_suites(ClientInvoker* self) {
     CliSetter cli(self);
+    ReleaseGIL nogil;
     self->ch_suites();
 }
 void ch_register(ClientInvoker* self, bool auto_add_new_suites, const bp::list& list) {
     std::vector<std::string> suites;
     BoostPythonUtil::list_to_str_vec(list, suites);
+    ReleaseGIL nogil;
     self->ch_register(auto_add_new_suites, suites);
 }
 
 void ch_add(ClientInvoker* self, int client_handle, const bp::list& list) {
     std::vector<std::string> suites;
     BoostPythonUtil::list_to_str_vec(list, suites);
+    ReleaseGIL nogil;
     self->ch_add(client_handle, suites);
 }
 void ch1_add(ClientInvoker* self, const bp::list& list) {
     std::vector<std::string> suites;
     BoostPythonUtil::list_to_str_vec(list, suites);
+    ReleaseGIL nogil;
     self->ch1_add(suites);
 }
 
 void ch_remove(ClientInvoker* self, int client_handle, const bp::list& list) {
     std::vector<std::string> suites;
     BoostPythonUtil::list_to_str_vec(list, suites);
+    ReleaseGIL nogil;
     self->ch_remove(client_handle, suites);
 }
 void ch1_remove(ClientInvoker* self, const bp::list& list) {
     std::vector<std::string> suites;
     BoostPythonUtil::list_to_str_vec(list, suites);
+    ReleaseGIL nogil;
     self->ch1_remove(suites);
 }
 
 /// Need to provide override since the boolean argument is optional.
 /// This saves on client python code, on having to specify the optional arg
 void replace_1(ClientInvoker* self, const std::string& absNodePath, defs_ptr client_defs) {
+    ReleaseGIL nogil;
     self->replace_1(absNodePath, client_defs);
 }
 void replace_2(ClientInvoker* self, const std::string& absNodePath, const std::string& path_to_client_defs) {
+    ReleaseGIL nogil;
     self->replace(absNodePath, path_to_client_defs);
 }
 
+int group(ClientInvoker* self, const std::string& groupRequest) {
+    ReleaseGIL nogil;
+    return self->group(groupRequest);
+}
+
 void order(ClientInvoker* self, const std::string& absNodePath, const std::string& the_order) {
+    ReleaseGIL nogil;
     self->order(absNodePath, the_order);
 }
 
@@ -349,6 +412,7 @@ void alters(ClientInvoker* self,
             const std::string& value = "") {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->check(paths);
     self->alter(paths, alterType, attrType, name, value);
 }
@@ -358,12 +422,14 @@ void alter(ClientInvoker* self,
            const std::string& attrType,
            const std::string& name  = "",
            const std::string& value = "") {
+    ReleaseGIL nogil;
     self->alter(path, alterType, attrType, name, value);
 }
 
 void alter_sorts(ClientInvoker* self, const bp::list& list, const std::string& attribute_name, bool recursive = true) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->check(paths);
     self->alter_sort(paths, attribute_name, recursive);
 }
@@ -371,6 +437,7 @@ void alter_sort(ClientInvoker* self,
                 const std::string& path,
                 const std::string& attribute_name,
                 bool recursive = true) {
+    ReleaseGIL nogil;
     self->alter_sort(std::vector<std::string>(1, path), attribute_name, recursive);
 }
 
@@ -428,11 +495,13 @@ bool client_exit(std::shared_ptr<ClientInvoker> self,
                  const bp::object& type,
                  const bp::object& value,
                  const bp::object& traceback) {
+    ReleaseGIL nogil;
     self->ch1_drop();
     return false;
 }
 
 const std::vector<Zombie>& zombieGet(ClientInvoker* self, int pid) {
+    ReleaseGIL nogil;
     self->zombieGet();
     return self->server_reply().zombies();
 }
@@ -440,31 +509,37 @@ const std::vector<Zombie>& zombieGet(ClientInvoker* self, int pid) {
 void zombieFobCli(ClientInvoker* self, const bp::list& list) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->zombieFobCliPaths(paths);
 }
 void zombieFailCli(ClientInvoker* self, const bp::list& list) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->zombieFailCliPaths(paths);
 }
 void zombieAdoptCli(ClientInvoker* self, const bp::list& list) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->zombieAdoptCliPaths(paths);
 }
 void zombieBlockCli(ClientInvoker* self, const bp::list& list) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->zombieBlockCliPaths(paths);
 }
 void zombieRemoveCli(ClientInvoker* self, const bp::list& list) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->zombieRemoveCliPaths(paths);
 }
 void zombieKillCli(ClientInvoker* self, const bp::list& list) {
     std::vector<std::string> paths;
     BoostPythonUtil::list_to_str_vec(list, paths);
+    ReleaseGIL nogil;
     self->zombieKillCliPaths(paths);
 }
 
@@ -515,29 +590,35 @@ void export_Client() {
              return_value_policy<copy_const_reference>(),
              ClientDoc::edit_script_preprocess())
         .def("edit_script_submit", &edit_script_submit, ClientDoc::edit_script_submit())
-        .def("new_log", &ClientInvoker::new_log, (bp::arg("path") = ""), ClientDoc::new_log())
-        .def("clear_log", &ClientInvoker::clearLog, ClientDoc::clear_log())
-        .def("flush_log", &ClientInvoker::flushLog, ClientDoc::flush_log())
-        .def("log_msg", &ClientInvoker::logMsg, ClientDoc::log_msg())
-        .def("restart_server", &ClientInvoker::restartServer, ClientDoc::restart_server())
-        .def("halt_server", &ClientInvoker::haltServer, ClientDoc::halt_server())
-        .def("shutdown_server", &ClientInvoker::shutdownServer, ClientDoc::shutdown_server())
-        .def("terminate_server", &ClientInvoker::terminateServer, ClientDoc::terminate_server())
+        .def("new_log", &WithoutGIL<&ClientInvoker::new_log>::call, (bp::arg("path") = ""), ClientDoc::new_log())
+        .def("clear_log", &WithoutGIL<&ClientInvoker::clearLog>::call, ClientDoc::clear_log())
+        .def("flush_log", &WithoutGIL<&ClientInvoker::flushLog>::call, ClientDoc::flush_log())
+        .def("log_msg", &WithoutGIL<&ClientInvoker::logMsg>::call, ClientDoc::log_msg())
+        .def("restart_server", &WithoutGIL<&ClientInvoker::restartServer>::call, ClientDoc::restart_server())
+        .def("halt_server", &WithoutGIL<&ClientInvoker::haltServer>::call, ClientDoc::halt_server())
+        .def("shutdown_server", &WithoutGIL<&ClientInvoker::shutdownServer>::call, ClientDoc::shutdown_server())
+        .def("terminate_server", &WithoutGIL<&ClientInvoker::terminateServer>::call, ClientDoc::terminate_server())
         .def("wait_for_server_reply",
-             &ClientInvoker::wait_for_server_reply,
+             &WithoutGIL<&ClientInvoker::wait_for_server_reply>::call,
              (bp::arg("time_out") = 60),
              ClientDoc::wait_for_server_reply())
         .def("load",
-             &ClientInvoker::loadDefs,
+             &WithoutGIL<&ClientInvoker::loadDefs>::call,
              (bp::arg("path_to_defs"),
               bp::arg("force")      = false,
               bp::arg("check_only") = false,
               bp::arg("print")      = false,
               bp::arg("stats")      = false),
              ClientDoc::load_defs())
-        .def("load", &ClientInvoker::load, (bp::arg("defs"), bp::arg("force") = false), ClientDoc::load())
-        .def("get_server_defs", &ClientInvoker::getDefs, ClientDoc::get_server_defs())
-        .def("sync_local", &ClientInvoker::sync_local, (bp::arg("sync_suite_clock") = false), ClientDoc::sync())
+        .def("load",
+             &WithoutGIL<&ClientInvoker::load>::call,
+             (bp::arg("defs"), bp::arg("force") = false),
+             ClientDoc::load())
+        .def("get_server_defs", &WithoutGIL<&ClientInvoker::getDefs>::call, ClientDoc::get_server_defs())
+        .def("sync_local",
+             &WithoutGIL<&ClientInvoker::sync_local>::call,
+             (bp::arg("sync_suite_clock") = false),
+             ClientDoc::sync())
         .def("news_local", &news_local, ClientDoc::news())
         .add_property("changed_node_paths",
                       bp::range(&ClientInvoker::changed_node_paths_begin, &ClientInvoker::changed_node_paths_end),
@@ -546,26 +627,30 @@ void export_Client() {
         .def("ch_register", &ch_register, ClientDoc::ch_register())
         .def("ch_suites", &ch_suites, ClientDoc::ch_suites())
         .def("ch_handle", &ClientInvoker::client_handle, ClientDoc::ch_register())
-        .def("ch_drop", &ClientInvoker::ch_drop, ClientDoc::ch_drop())
-        .def("ch_drop", &ClientInvoker::ch1_drop)
-        .def("ch_drop_user", &ClientInvoker::ch_drop_user, ClientDoc::ch_drop_user())
+        .def("ch_drop", &WithoutGIL<&ClientInvoker::ch_drop>::call, ClientDoc::ch_drop())
+        .def("ch_drop", &WithoutGIL<&ClientInvoker::ch1_drop>::call)
+        .def("ch_drop_user", &WithoutGIL<&ClientInvoker::ch_drop_user>::call, ClientDoc::ch_drop_user())
         .def("ch_add", &ch_add, ClientDoc::ch_add())
         .def("ch_add", &ch1_add)
         .def("ch_remove", &ch_remove, ClientDoc::ch_remove())
         .def("ch_remove", &ch1_remove)
-        .def("ch_auto_add", &ClientInvoker::ch_auto_add, ClientDoc::ch_auto_add())
-        .def("ch_auto_add", &ClientInvoker::ch1_auto_add)
+        .def("ch_auto_add", &WithoutGIL<&ClientInvoker::ch_auto_add>::call, ClientDoc::ch_auto_add())
+        .def("ch_auto_add", &WithoutGIL<&ClientInvoker::ch1_auto_add>::call)
         .def("checkpt",
-             &ClientInvoker::checkPtDefs,
+             &WithoutGIL<&ClientInvoker::checkPtDefs>::call,
              (bp::arg("mode")                     = ecf::CheckPt::UNDEFINED,
               bp::arg("check_pt_interval")        = 0,
               bp::arg("check_pt_save_alarm_time") = 0),
              ClientDoc::checkpt())
-        .def("restore_from_checkpt", &ClientInvoker::restoreDefsFromCheckPt, ClientDoc::restore_from_checkpt())
-        .def("reload_wl_file", &ClientInvoker::reloadwsfile, ClientDoc::reload_wl_file())
-        .def("reload_passwd_file", &ClientInvoker::reloadpasswdfile, "reload the passwd file. <host>.<port>.ecf.passwd")
+        .def("restore_from_checkpt",
+             &WithoutGIL<&ClientInvoker::restoreDefsFromCheckPt>::call,
+             ClientDoc::restore_from_checkpt())
+        .def("reload_wl_file", &WithoutGIL<&ClientInvoker::reloadwsfile>::call, ClientDoc::reload_wl_file())
+        .def("reload_passwd_file",
+             &WithoutGIL<&ClientInvoker::reloadpasswdfile>::call,
+             "reload the passwd file. <host>.<port>.ecf.passwd")
         .def("reload_custom_passwd_file",
-             &ClientInvoker::reloadcustompasswdfile,
+             &WithoutGIL<&ClientInvoker::reloadcustompasswdfile>::call,
              "reload the custom passwd file. <host>.<port>.ecf.custom_passwd. For users using ECF_USER or --user or "
              "set_user_name()")
         .def("requeue", &requeue, (bp::arg("abs_node_path"), bp::arg("option") = ""), ClientDoc::requeue())
@@ -578,14 +663,14 @@ void export_Client() {
         .def("free_time_dep", &free_time_dep1)
         .def("free_all_dep", &free_all_dep, ClientDoc::free_all_dep())
         .def("free_all_dep", &free_all_dep1)
-        .def("ping", &ClientInvoker::pingServer, ClientDoc::ping())
+        .def("ping", &WithoutGIL<&ClientInvoker::pingServer>::call, ClientDoc::ping())
         .def("stats", &stats, ClientDoc::stats())
         .def("stats_reset", &stats_reset, ClientDoc::stats_reset())
         .def("get_file",
              &get_file,
              (bp::arg("task"), bp::arg("type") = "script", bp::arg("max_lines") = "10000", bp::arg("as_bytes") = false),
              ClientDoc::get_file())
-        .def("plug", &ClientInvoker::plug, ClientDoc::plug())
+        .def("plug", &WithoutGIL<&ClientInvoker::plug>::call, ClientDoc::plug())
         .def("query", &query, return_value_policy<copy_const_reference>(), ClientDoc::query())
         .def("query", &query1, return_value_policy<copy_const_reference>(), ClientDoc::query())
         .def("alter",
@@ -614,18 +699,21 @@ void export_Client() {
         .def("force_state", &force_states)
         .def("force_state_recursive", &force_state_recursive, ClientDoc::force_state_recursive())
         .def("force_state_recursive", &force_states_recursive)
-        .def("replace", &ClientInvoker::replace, ClientDoc::replace())
-        .def("replace", &ClientInvoker::replace_1)
+        .def("replace", &WithoutGIL<&ClientInvoker::replace>::call, ClientDoc::replace())
+        .def("replace", &WithoutGIL<&ClientInvoker::replace_1>::call)
         .def("replace", &replace_1)
         .def("replace", &replace_2)
         .def("order", &order, ClientDoc::order())
-        .def("group", &ClientInvoker::group, ClientDoc::group())
+        .def("group", &group, ClientDoc::group())
         .def("begin_suite",
-             &ClientInvoker::begin,
+             &WithoutGIL<&ClientInvoker::begin>::call,
              (bp::arg("suite_name"), bp::arg("force") = false),
              ClientDoc::begin_suite())
-        .def("begin_all_suites", &ClientInvoker::begin_all_suites, (bp::arg("force") = false), ClientDoc::begin_all())
-        .def("job_generation", &ClientInvoker::job_gen, ClientDoc::job_gen())
+        .def("begin_all_suites",
+             &WithoutGIL<&ClientInvoker::begin_all_suites>::call,
+             (bp::arg("force") = false),
+             ClientDoc::begin_all())
+        .def("job_generation", &WithoutGIL<&ClientInvoker::job_gen>::call, ClientDoc::job_gen())
         .def("run", &run, ClientDoc::run())
         .def("run", &runs)
         .def("check", &check, return_value_policy<copy_const_reference>(), ClientDoc::check())
@@ -643,15 +731,18 @@ void export_Client() {
         .def("restore", &restore, ClientDoc::restore())
         .def("restore", &restores)
         .def("delete",
-             &ClientInvoker::delete_node,
+             &WithoutGIL<&ClientInvoker::delete_node>::call,
              (bp::arg("abs_node_path"), bp::arg("force") = false),
              ClientDoc::delete_node())
         .def("delete", &delete_node, (bp::arg("paths"), bp::arg("force") = false))
-        .def("delete_all", &ClientInvoker::delete_all, (bp::arg("force") = false), ClientDoc::delete_all())
+        .def("delete_all",
+             &WithoutGIL<&ClientInvoker::delete_all>::call,
+             (bp::arg("force") = false),
+             ClientDoc::delete_all())
         .def("debug_server_on",
-             &ClientInvoker::debug_server_on,
+             &WithoutGIL<&ClientInvoker::debug_server_on>::call,
              "Enable server debug, Will dump to standard out on server host.")
-        .def("debug_server_off", &ClientInvoker::debug_server_off, "Disable server debug")
+        .def("debug_server_off", &WithoutGIL<&ClientInvoker::debug_server_off>::call, "Disable server debug")
 
         .def("debug", &ClientInvoker::debug, "enable/disable client api debug")
 
@@ -660,12 +751,12 @@ void export_Client() {
         .def("disable_ssl", &ClientInvoker::disable_ssl, ecf::Openssl::ssl_info())
 #endif
         .def("zombie_get", &zombieGet, return_value_policy<copy_const_reference>())
-        .def("zombie_fob", &ClientInvoker::zombieFobCli)
-        .def("zombie_fail", &ClientInvoker::zombieFailCli)
-        .def("zombie_adopt", &ClientInvoker::zombieAdoptCli)
-        .def("zombie_block", &ClientInvoker::zombieBlockCli)
-        .def("zombie_remove", &ClientInvoker::zombieRemoveCli)
-        .def("zombie_kill", &ClientInvoker::zombieKillCli)
+        .def("zombie_fob", &WithoutGIL<&ClientInvoker::zombieFobCli>::call)
+        .def("zombie_fail", &WithoutGIL<&ClientInvoker::zombieFailCli>::call)
+        .def("zombie_adopt", &WithoutGIL<&ClientInvoker::zombieAdoptCli>::call)
+        .def("zombie_block", &WithoutGIL<&ClientInvoker::zombieBlockCli>::call)
+        .def("zombie_remove", &WithoutGIL<&ClientInvoker::zombieRemoveCli>::call)
+        .def("zombie_kill", &WithoutGIL<&ClientInvoker::zombieKillCli>::call)
         .def("zombie_fob", &zombieFobCli)
         .def("zombie_fail", &zombieFailCli)
         .def("zombie_adopt", &zombieAdoptCli)
@@ -687,28 +778,32 @@ void export_Client() {
              &ClientInvoker::set_zombie_child_timeout,
              "Set timeout for zombie child commands,that cannot connect to server, default is 24 hours. The input is "
              "required to be in seconds")
-        .def("child_init", &ClientInvoker::child_init, "Child command,notify server job has started")
+        .def("child_init", &WithoutGIL<&ClientInvoker::child_init>::call, "Child command,notify server job has started")
         .def("child_abort",
-             &ClientInvoker::child_abort,
+             &WithoutGIL<&ClientInvoker::child_abort>::call,
              (bp::arg("reason") = ""),
              "Child command,notify server job has aborted, can provide an optional reason")
         .def("child_event",
-             &ClientInvoker::child_event,
+             &WithoutGIL<&ClientInvoker::child_event>::call,
              (bp::arg("event_name"), bp::arg("value") = true),
              "Child command,notify server event occurred, requires the event name")
         .def("child_meter",
-             &ClientInvoker::child_meter,
+             &WithoutGIL<&ClientInvoker::child_meter>::call,
              "Child command,notify server meter changed, requires meter name and value")
         .def("child_label",
-             &ClientInvoker::child_label,
+             &WithoutGIL<&ClientInvoker::child_label>::call,
              "Child command,notify server label changed, requires label name, and new value")
-        .def("child_wait", &ClientInvoker::child_wait, "Child command,wait for expression to come true")
+        .def("child_wait",
+             &WithoutGIL<&ClientInvoker::child_wait>::call,
+             "Child command,wait for expression to come true")
         .def("child_queue",
-             &ClientInvoker::child_queue,
+             &WithoutGIL<&ClientInvoker::child_queue>::call,
              (bp::arg("queue_name"), bp::arg("action"), bp::arg("step") = "", bp::arg("path_to_node_with_queue") = ""),
              "Child command,active:return current step as string, then increment index, requires queue name, and "
              "optionally path to node with the queue")
-        .def("child_complete", &ClientInvoker::child_complete, "Child command,notify server job has complete");
+        .def("child_complete",
+             &WithoutGIL<&ClientInvoker::child_complete>::call,
+             "Child command,notify server job has complete");
 
     class_<WhyCmd, boost::noncopyable>("WhyCmd",
                                        "The why command reports, the reason why a node is not running.\n\n"
@@ -25,6 +25,7 @@
 #include "File.hpp"
 #include "GlossaryDoc.hpp"
 #include "JobCreationCtrl.hpp"
+#include "NodeUtil.hpp"
 #include "PrintStyle.hpp"
 #include "Simulator.hpp"
 #include "Suite.hpp"
@@ -41,7 +42,9 @@ void save_as_defs(const Defs& theDefs, const std::string& filename, PrintStyle::
     std::stringstream ss;
     ss << theDefs;
 
+    // Only the file is written without the GIL, the defs has already been printed
     std::string file_creation_error_msg;
+    ReleaseGIL nogil;
     if (!File::create(filename, ss.str(), file_creation_error_msg)) {
         std::string error = "save_as_defs failed: ";
         error += file_creation_error_msg;
@@ -118,6 +121,19 @@ std::vector<node_ptr> get_all_nodes(defs_ptr self) {
     return nodes;
 }
 
+static std::vector<node_ptr> suites_of(defs_ptr self) {
+    return std::vector<node_ptr>(self->suiteVec().begin(), self->suiteVec().end());
+}
+NodeIterator iter_nodes(defs_ptr self, const std::string& type, const bp::object& state, const std::string& path) {
+    return NodeUtil::iter_nodes(suites_of(self), type, state, path);
+}
+bp::list get_node_paths(defs_ptr self, const std::string& type, const bp::object& state, const std::string& path) {
+    return NodeUtil::node_paths(suites_of(self), type, state, path);
+}
+bp::list get_node_states(defs_ptr self, const std::string& type, const bp::object& state, const std::string& path) {
+    return NodeUtil::node_states(suites_of(self), type, state, path);
+}
+
 // Context management, Only used to provide indentation
 defs_ptr defs_enter(defs_ptr self) {
     return self;
@@ -333,6 +349,18 @@ void export_Defs() {
         .def("find_node", &Defs::find_node, "Given a type(suite,family,task) and a path to a node, return the node.")
         .def("get_all_nodes", &get_all_nodes, "Returns all the `node`_\\ s in the definition")
         .def("get_all_tasks", &get_all_tasks, "Returns all the `task`_ nodes")
+        .def("iter_nodes",
+             &iter_nodes,
+             (bp::arg("type") = "", bp::arg("state") = bp::object(), bp::arg("path") = ""),
+             DefsDoc::iter_nodes_doc())
+        .def("get_node_paths",
+             &get_node_paths,
+             (bp::arg("type") = "", bp::arg("state") = bp::object(), bp::arg("path") = ""),
+             DefsDoc::get_node_paths_doc())
+        .def("get_node_states",
+             &get_node_states,
+             (bp::arg("type") = "", bp::arg("state") = bp::object(), bp::arg("path") = ""),
+             DefsDoc::get_node_states_doc())
         .def("has_time_dependencies",
              &Defs::hasTimeDependencies,
              "returns True if the `suite definition`_ has any time `dependencies`_")
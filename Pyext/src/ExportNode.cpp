@@ -317,6 +317,28 @@ std::vector<node_ptr> get_all_nodes(node_ptr self) {
     return nodes;
 }
 
+NodeIterator iter_nodes(node_ptr self, const std::string& type, const bp::object& state, const std::string& path) {
+    return NodeUtil::iter_nodes(std::vector<node_ptr>(1, self), type, state, path);
+}
+bp::list get_node_paths(node_ptr self, const std::string& type, const bp::object& state, const std::string& path) {
+    return NodeUtil::node_paths(std::vector<node_ptr>(1, self), type, state, path);
+}
+bp::list get_node_states(node_ptr self, const std::string& type, const bp::object& state, const std::string& path) {
+    return NodeUtil::node_states(std::vector<node_ptr>(1, self), type, state, path);
+}
+
+bp::object node_iterator_iter(const bp::object& self) {
+    return self;
+}
+node_ptr node_iterator_next(NodeIterator& self) {
+    node_ptr node = self.next();
+    if (!node.get()) {
+        PyErr_SetString(PyExc_StopIteration, "No more nodes");
+        bp::throw_error_already_set();
+    }
+    return node;
+}
+
 node_ptr add_trigger(node_ptr self, const std::string& expr) {
     self->add_trigger(expr);
     return self;
@@ -534,6 +556,12 @@ void export_Node() {
     class_<std::vector<node_ptr>>("NodeVec", "Hold a list of Nodes (i.e `suite`_, `family`_ or `task`_\\ s)")
         .def(vector_indexing_suite<std::vector<node_ptr>, true>());
 
+    // Yields the nodes one at a time, see Node.iter_nodes() and Defs.iter_nodes()
+    class_<NodeIterator>("NodeIterator", DefsDoc::node_iterator_doc(), no_init)
+        .def("__iter__", &node_iterator_iter)
+        .def("__next__", &node_iterator_next) // python3
+        .def("next", &node_iterator_next);    // python2
+
     class_<Node, boost::noncopyable, node_ptr>("Node", DefsDoc::node_doc(), no_init)
         .def("name", &Node::name, return_value_policy<copy_const_reference>())
         .def("add", raw_function(add, 1), DefsDoc::add())  // a.add(b) & a.add([b])
@@ -721,6 +749,18 @@ void export_Node() {
         .def("get_defs", get_defs, return_internal_reference<>())
         .def("get_parent", &Node::parent, return_internal_reference<>())
         .def("get_all_nodes", &get_all_nodes, "Returns all the child nodes")
+        .def("iter_nodes",
+             &iter_nodes,
+             (bp::arg("type") = "", bp::arg("state") = bp::object(), bp::arg("path") = ""),
+             DefsDoc::iter_nodes_doc())
+        .def("get_node_paths",
+             &get_node_paths,
+             (bp::arg("type") = "", bp::arg("state") = bp::object(), bp::arg("path") = ""),
+             DefsDoc::get_node_paths_doc())
+        .def("get_node_states",
+             &get_node_states,
+             (bp::arg("type") = "", bp::arg("state") = bp::object(), bp::arg("path") = ""),
+             DefsDoc::get_node_states_doc())
         .def("get_flag",
              &Node::get_flag,
              return_value_policy<copy_const_reference>(),
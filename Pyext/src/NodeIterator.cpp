@@ -0,0 +1,97 @@
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#include "NodeIterator.hpp"
+
+#include <stdexcept>
+
+#include <boost/algorithm/string.hpp>
+
+#include "Alias.hpp"
+#include "NodeContainer.hpp"
+#include "Str.hpp"
+#include "Task.hpp"
+
+using namespace ecf;
+
+NodeFilter::NodeFilter(const std::string& type, const std::string& path_prefix)
+    : type_(boost::algorithm::to_upper_copy(type)),
+      path_prefix_(path_prefix) {
+}
+
+void NodeFilter::check() const {
+    if (type_.empty() || type_ == Str::SUITE() || type_ == Str::FAMILY() || type_ == Str::TASK() ||
+        type_ == Str::ALIAS())
+        return;
+    throw std::runtime_error("Expected node type to be one of suite, family, task, alias, but found: " +
+                             boost::algorithm::to_lower_copy(type_));
+}
+
+bool NodeFilter::match(const Node* node, const std::string& abs_node_path) const {
+    if (!type_.empty() && node->debugType() != type_)
+        return false;
+    if (has_state_ && node->state() != state_)
+        return false;
+    if (!path_prefix_.empty() && abs_node_path.compare(0, path_prefix_.size(), path_prefix_) != 0)
+        return false;
+    return true;
+}
+
+bool NodeFilter::descend(const Node* node, const std::string& abs_node_path) const {
+    if (!path_prefix_.empty()) {
+        // Either this node is below the prefix, or the prefix is still below this node
+        if (abs_node_path.compare(0, path_prefix_.size(), path_prefix_) != 0 &&
+            path_prefix_.compare(0, abs_node_path.size(), abs_node_path) != 0)
+            return false;
+    }
+    if (type_ == Str::SUITE())
+        return false; // suites are only found at the top
+    if (type_ == Str::FAMILY() || type_ == Str::TASK())
+        return node->isNodeContainer() != nullptr; // only aliases are found below tasks
+    return true;
+}
+
+NodeIterator::NodeIterator(const std::vector<node_ptr>& roots, const NodeFilter& filter)
+    : stack_(roots.rbegin(), roots.rend()),
+      filter_(filter) {
+}
+
+node_ptr NodeIterator::next() {
+    std::string abs_node_path;
+    while (!stack_.empty()) {
+        node_ptr node = stack_.back();
+        stack_.pop_back();
+
+        if (filter_.needs_path())
+            abs_node_path = node->absNodePath();
+        if (filter_.descend(node.get(), abs_node_path))
+            push_children(node);
+        if (filter_.match(node.get(), abs_node_path))
+            return node;
+    }
+    return node_ptr();
+}
+
+void NodeIterator::push_children(const node_ptr& node) {
+    // Pushed in reverse, so that the first child is returned first
+    if (NodeContainer* container = node->isNodeContainer()) {
+        const std::vector<node_ptr>& children = container->nodeVec();
+        stack_.insert(stack_.end(), children.rbegin(), children.rend());
+    }
+    else if (Task* task = node->isTask()) {
+        const std::vector<alias_ptr>& aliases = task->aliases();
+        stack_.insert(stack_.end(), aliases.rbegin(), aliases.rend());
+    }
+}
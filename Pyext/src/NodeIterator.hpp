@@ -0,0 +1,69 @@
+#ifndef NODE_ITERATOR_HPP_
+#define NODE_ITERATOR_HPP_
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        :
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+// Depth first walk over a node tree, that yields one node at a time.
+// Unlike get_all_nodes(), no vector of the whole tree is created up front.
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#include <string>
+#include <vector>
+
+#include "NState.hpp"
+#include "NodeFwd.hpp"
+
+/// Select nodes by type(suite,family,task,alias), state and path prefix. Empty type/path match any node.
+class NodeFilter {
+public:
+    NodeFilter() = default;
+    NodeFilter(const std::string& type, const std::string& path_prefix);
+
+    void set_state(NState::State s) {
+        state_     = s;
+        has_state_ = true;
+    }
+
+    /// Throws std::runtime_error if type is not one of: suite, family, task, alias
+    void check() const;
+
+    bool match(const Node*, const std::string& abs_node_path) const;
+
+    /// Return false if no node below this path can match
+    bool descend(const Node*, const std::string& abs_node_path) const;
+
+    bool needs_path() const { return !path_prefix_.empty(); }
+
+private:
+    std::string type_;
+    std::string path_prefix_;
+    NState::State state_{NState::UNKNOWN};
+    bool has_state_{false};
+};
+
+class NodeIterator {
+public:
+    NodeIterator(const std::vector<node_ptr>& roots, const NodeFilter& filter);
+
+    /// Returns the next matching node, in depth first order, or a NULL node_ptr when done
+    node_ptr next();
+
+private:
+    void push_children(const node_ptr&);
+
+private:
+    std::vector<node_ptr> stack_;
+    NodeFilter filter_;
+};
+
+#endif
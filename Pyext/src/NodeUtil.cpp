@@ -176,3 +176,42 @@ object NodeUtil::do_add(node_ptr self, const bp::object& arg) {
         throw std::runtime_error("ExportNode::add : Unknown type ");
     return object(self);
 }
+
+static NodeFilter make_filter(const std::string& type, const bp::object& state, const std::string& path) {
+    NodeFilter filter(type, path);
+    filter.check();
+    if (!state.is_none())
+        filter.set_state(extract<NState::State>(state));
+    return filter;
+}
+
+NodeIterator NodeUtil::iter_nodes(const std::vector<node_ptr>& roots,
+                                  const std::string& type,
+                                  const bp::object& state,
+                                  const std::string& path) {
+    return NodeIterator(roots, make_filter(type, state, path));
+}
+
+bp::list NodeUtil::node_paths(const std::vector<node_ptr>& roots,
+                              const std::string& type,
+                              const bp::object& state,
+                              const std::string& path) {
+    bp::list paths;
+    NodeIterator iter(roots, make_filter(type, state, path));
+    while (node_ptr node = iter.next()) {
+        paths.append(node->absNodePath());
+    }
+    return paths;
+}
+
+bp::list NodeUtil::node_states(const std::vector<node_ptr>& roots,
+                               const std::string& type,
+                               const bp::object& state,
+                               const std::string& path) {
+    bp::list states;
+    NodeIterator iter(roots, make_filter(type, state, path));
+    while (node_ptr node = iter.next()) {
+        states.append(node->state());
+    }
+    return states;
+}
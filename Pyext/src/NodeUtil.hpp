@@ -15,10 +15,13 @@
 // Description :
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
 
+#include <vector>
+
 #include <boost/core/noncopyable.hpp>
 #include <boost/python.hpp>
 
 #include "NodeFwd.hpp"
+#include "NodeIterator.hpp"
 
 class NodeUtil : private boost::noncopyable {
 public:
@@ -34,6 +37,22 @@ public:
     /// raw constructor,assumes first argument is a string.
     /// Assumes Task,Family,Suite has defined a constructor  init(const std::string& name, list attrs, dict kw)
     static boost::python::object node_raw_constructor(boost::python::tuple args, boost::python::dict kw);
+
+    /// Depth first iteration over roots and their children. state is None or a State
+    static NodeIterator iter_nodes(const std::vector<node_ptr>& roots,
+                                   const std::string& type,
+                                   const boost::python::object& state,
+                                   const std::string& path);
+
+    /// Columnar results, in the same order as iter_nodes(), without creating a python object per node
+    static boost::python::list node_paths(const std::vector<node_ptr>& roots,
+                                          const std::string& type,
+                                          const boost::python::object& state,
+                                          const std::string& path);
+    static boost::python::list node_states(const std::vector<node_ptr>& roots,
+                                           const std::string& type,
+                                           const boost::python::object& state,
+                                           const std::string& path);
 };
 
 #endif
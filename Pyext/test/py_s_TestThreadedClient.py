@@ -0,0 +1,93 @@
+#////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+# Name        :
+# Author      : Avi
+# Revision    : $Revision: #10 $
+#
+# Copyright 2009- ECMWF.
+# This software is licensed under the terms of the Apache Licence version 2.0
+# which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+# In applying this licence, ECMWF does not waive the privileges and immunities
+# granted to it by virtue of its status as an intergovernmental organisation
+# nor does it submit to any jurisdiction.
+#////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+#  Test that the client releases the GIL, whilst waiting on the server.
+#  Each thread must use its own Client, a Client is not thread safe.
+import os
+import time
+import threading
+
+# ecflow_test_util, see File ecflow_test_util.py
+import ecflow_test_util as Test
+from ecflow import Defs, Client
+
+def create_defs(no_of_suites):
+    defs = Defs()
+    for i in range(no_of_suites):
+        suite = defs.add_suite("s" + str(i))
+        for j in range(10):
+            family = suite.add_family("f" + str(j))
+            for k in range(10):
+                family.add_task("t" + str(k))
+    return defs
+
+def test_gil_released_while_waiting(ci):
+    # wait_for_server_reply() sleeps before pinging the server. If the GIL was held, this
+    # thread could not run until the call returned.
+    print("test_gil_released_while_waiting")
+    ticks = []
+    def wait():
+        client = Client("localhost", ci.get_port())
+        assert client.wait_for_server_reply(10), "Expected server to reply"
+    waiter = threading.Thread(target=wait)
+    waiter.start()
+    while waiter.is_alive():
+        ticks.append(time.time())
+        time.sleep(0.05)
+    waiter.join()
+    assert len(ticks) > 10, "Expected main thread to run, whilst client waits on server, ticks: " + str(len(ticks))
+
+def sync_and_query(port, no_of_requests, errors):
+    try:
+        client = Client("localhost", port)
+        for i in range(no_of_requests):
+            client.sync_local()
+            client.ping()
+            if len(list(client.get_defs().suites)) == 0:
+                errors.append("Expected suites in synced defs")
+    except RuntimeError as e:
+        errors.append(str(e))
+
+def run_clients(ci, no_of_threads, no_of_requests):
+    errors = []
+    threads = [threading.Thread(target=sync_and_query, args=(ci.get_port(), no_of_requests, errors))
+               for i in range(no_of_threads)]
+    start = time.time()
+    for thread in threads: thread.start()
+    for thread in threads: thread.join()
+    duration = time.time() - start
+    assert len(errors) == 0, "Client thread failed: " + str(errors)
+    return duration
+
+def test_threaded_clients(ci):
+    print("test_threaded_clients")
+    ci.load(create_defs(10))
+
+    no_of_threads = 4
+    no_of_requests = 25
+    serial = run_clients(ci, 1, no_of_threads * no_of_requests)
+    threaded = run_clients(ci, no_of_threads, no_of_requests)
+    total = 2 * no_of_threads * no_of_requests
+    print("   " + str(total) + " requests, serial: " + str(round(serial, 3)) + "s (" + str(int(total / serial))
+          + " requests/s), " + str(no_of_threads) + " threads: " + str(round(threaded, 3)) + "s ("
+          + str(int(total / threaded)) + " requests/s)")
+
+if __name__ == "__main__":
+    Test.print_test_start(os.path.basename(__file__))
+
+    with Test.Server() as ci:
+        ci.delete_all(True)
+        test_gil_released_while_waiting(ci)
+        test_threaded_clients(ci)
+        ci.delete_all(True)
+
+    print("All Tests pass ======================================================================")
@@ -12,7 +12,7 @@
 #////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
 
 # Simple check for get all tasks
-from ecflow import Defs, Client, debug_build
+from ecflow import Defs, Client, State, debug_build
 import ecflow_test_util as Test
 import os
 
@@ -92,7 +92,51 @@ def test_get_all_nodes_from_nodes():
     assert len(node_vec) == 6, "Expected 6 nodes but found " + str(len(node_vec))
 
     print("test_get_all_nodes_from_nodes PASSED")
-   
+
+def test_iter_nodes(defs):
+    # Lazy iteration, should yield the same nodes, in the same order as get_all_nodes()
+    all_nodes = [ node.get_abs_node_path() for node in defs.get_all_nodes() ]
+    iter_nodes = [ node.get_abs_node_path() for node in defs.iter_nodes() ]
+    assert all_nodes == iter_nodes, "Expected iter_nodes() to match get_all_nodes():\n" + str(iter_nodes)
+    assert defs.get_node_paths() == all_nodes, "Expected get_node_paths() to match get_all_nodes()"
+
+    tasks = [ node.name() for node in defs.iter_nodes(type="task") ]
+    assert tasks == ["t0", "t1", "t2", "t3"], "Expected four tasks, but found " + str(tasks)
+    suites = [ node.name() for node in defs.iter_nodes(type="suite") ]
+    assert suites == ["test_get_all"], "Expected one suite, but found " + str(suites)
+
+    paths = defs.get_node_paths(path="/test_get_all/f1/f")
+    assert paths == ["/test_get_all/f1/f2", "/test_get_all/f1/f2/t3"], "Path prefix not respected " + str(paths)
+    paths = defs.get_node_paths(type="task", path="/test_get_all/f1")
+    assert len(paths) == 3, "Expected three tasks under /test_get_all/f1, but found " + str(paths)
+
+    # Iterating from a node, includes the node
+    fam = defs.find_abs_node("/test_get_all/f1")
+    paths = [ node.get_abs_node_path() for node in fam.iter_nodes(type="family") ]
+    assert paths == ["/test_get_all/f1", "/test_get_all/f1/f2"], "Expected two families, but found " + str(paths)
+
+    it = defs.iter_nodes(type="family")
+    assert next(it).name() == "f1", "Expected first family to be f1"
+    assert next(it).name() == "f2", "Expected second family to be f2"
+    try:
+        next(it)
+        assert False, "Expected StopIteration"
+    except StopIteration:
+        pass
+
+    # Filter by state, nodes in a new definition are all unknown
+    assert defs.get_node_paths(state=State.unknown) == all_nodes, "Expected all nodes to be unknown"
+    assert defs.get_node_paths(state=State.aborted) == [], "Expected no aborted nodes"
+    states = defs.get_node_states(type="task")
+    assert states == [State.unknown] * 4, "Expected a state for each task, but found " + str(states)
+
+    try:
+        defs.iter_nodes(type="fred")
+        assert False, "Expected RuntimeError for unknown node type"
+    except RuntimeError:
+        pass
+
+    print("test_iter_nodes PASSED")
 
 if __name__ == "__main__":
     Test.print_test_start(os.path.basename(__file__))
@@ -100,4 +144,5 @@ if __name__ == "__main__":
     test_get_all_tasks(create_defs())
     test_get_all_nodes(create_defs())
     test_get_all_nodes_from_nodes()
+    test_iter_nodes(create_defs())
     print("All Tests pass")    
\ No newline at end of file
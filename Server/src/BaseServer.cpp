@@ -55,6 +55,7 @@ BaseServer::BaseServer(boost::asio::io_service& io_service, ServerEnvironment& s
 
     // Must be set before checkpt file is loaded.
     defs_->ecf_prune_node_log(serverEnv.ecf_prune_node_log());
+    defs_->set_edit_history_max_size(static_cast<size_t>(serverEnv.ecf_edit_history_size()) * 1024 * 1024);
 
     LogFlusher logFlusher;
 
@@ -0,0 +1,145 @@
+//============================================================================
+// Name        : ChangeSubscribers.cpp
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+//============================================================================
+
+#include "ChangeSubscribers.hpp"
+
+#include <algorithm>
+
+#include "AbstractServer.hpp"
+#include "Calendar.hpp"
+#include "ClientToServerCmd.hpp"
+#include "Defs.hpp"
+#include "Ecf.hpp"
+#include "PreAllocatedReply.hpp"
+#include "SSyncCmd.hpp"
+
+using namespace ecf;
+
+ChangeSubscribers::ChangeSubscribers(AbstractServer* as, boost::asio::io_service& io, size_t max_subscribers)
+    : as_(as),
+      timer_(io, boost::posix_time::seconds(0)),
+      max_subscribers_(max_subscribers) {
+}
+
+bool ChangeSubscribers::add(const Cmd_ptr& cmd, const STC_Cmd_ptr& reply_cmd, const reply_t& reply) {
+    auto* sync_cmd = dynamic_cast<CSyncCmd*>(cmd.get());
+    if (!sync_cmd || sync_cmd->api() != CSyncCmd::SYNC || sync_cmd->wait_for_change() <= 0) {
+        return false;
+    }
+
+    // Only hold requests, that were authenticated, and for which there was nothing to send
+    auto* ssync_cmd = dynamic_cast<SSyncCmd*>(reply_cmd.get());
+    if (!ssync_cmd ||
+        !ssync_cmd->client_in_sync(sync_cmd->client_state_change_no(), sync_cmd->client_modify_change_no())) {
+        return false;
+    }
+
+    if (subscribers_.size() >= max_subscribers_) {
+        return false;
+    }
+
+    int wait = std::min(sync_cmd->wait_for_change(), max_wait());
+    subscribers_.push_back(Subscriber{cmd, Calendar::second_clock_time() + boost::posix_time::seconds(wait), reply});
+
+    // Changes made by the server itself, i.e. job submission and time dependencies, are not
+    // the result of a request, hence also check periodically.
+    if (!timer_running_) {
+        start_timer();
+    }
+    return true;
+}
+
+void ChangeSubscribers::notify() {
+    if (subscribers_.empty()) {
+        return;
+    }
+
+    boost::posix_time::ptime time_now = Calendar::second_clock_time();
+
+    // Remove the subscribers first, since replying can re-enter, i.e. if the reply fails
+    std::vector<Subscriber> ready;
+    auto i = subscribers_.begin();
+    while (i != subscribers_.end()) {
+        if (time_now >= i->expires_ || changed(dynamic_cast<CSyncCmd*>(i->cmd_.get()))) {
+            ready.push_back(std::move(*i));
+            i = subscribers_.erase(i);
+        }
+        else {
+            ++i;
+        }
+    }
+
+    for (Subscriber& subscriber : ready) {
+        // The request was logged and counted when it arrived, hence only build the reply
+        STC_Cmd_ptr reply;
+        try {
+            reply = dynamic_cast<CSyncCmd*>(subscriber.cmd_.get())->sync_reply(as_);
+        }
+        catch (std::exception& e) {
+            reply = PreAllocatedReply::error_cmd(e.what());
+        }
+        subscriber.reply_(reply);
+        subscriber.cmd_->cleanup();
+    }
+}
+
+void ChangeSubscribers::terminate() {
+    timer_.cancel();
+    timer_running_ = false;
+    subscribers_.clear(); // closes the connections
+}
+
+bool ChangeSubscribers::changed(const CSyncCmd* cmd) const {
+    // This must relate to the news, See SNewsCmd. However we avoid SNewsCmd, since it logs.
+    defs_ptr defs = as_->defs();
+    if (!defs) {
+        return true;
+    }
+
+    unsigned int client_state_change_no  = cmd->client_state_change_no();
+    unsigned int client_modify_change_no = cmd->client_modify_change_no();
+    if (cmd->client_handle() == 0) {
+        return client_state_change_no != Ecf::state_change_no() || client_modify_change_no != Ecf::modify_change_no();
+    }
+
+    ClientSuiteMgr& client_suite_mgr = defs->client_suite_mgr();
+    if (!client_suite_mgr.valid_handle(cmd->client_handle()) || client_suite_mgr.handle_changed(cmd->client_handle())) {
+        return true;
+    }
+
+    unsigned int max_state_change_no  = 0;
+    unsigned int max_modify_change_no = 0;
+    client_suite_mgr.max_change_no(cmd->client_handle(), max_state_change_no, max_modify_change_no);
+    return client_state_change_no != max_state_change_no || client_modify_change_no != max_modify_change_no;
+}
+
+void ChangeSubscribers::start_timer() {
+    timer_running_ = true;
+    timer_.expires_from_now(boost::posix_time::seconds(1));
+    timer_.async_wait([this](const boost::system::error_code& error) { timer_expired(error); });
+}
+
+void ChangeSubscribers::timer_expired(const boost::system::error_code& error) {
+    timer_running_ = false;
+    if (error == boost::asio::error::operation_aborted) {
+        return;
+    }
+
+    notify();
+
+    if (!subscribers_.empty()) {
+        start_timer();
+    }
+}
@@ -0,0 +1,85 @@
+#ifndef CHANGE_SUBSCRIBERS_HPP_
+#define CHANGE_SUBSCRIBERS_HPP_
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// Name        : ChangeSubscribers.cpp
+// Author      : Avi
+// Revision    : $Revision: #1 $
+//
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description :
+//
+// Holds on to SYNC requests(CSyncCmd with wait_for_change() > 0) for which there
+// were no changes. Instead of the client polling with NEWS/SYNC, the server
+// replies with the incremental changes(SSyncCmd) as soon as the change numbers,
+// of the client handle move, or else when the wait expires.
+//
+// o The changes are collated when the reply is sent, hence a client only ever
+//   gets the latest state, changes made whilst waiting are coalesced.
+// o Each client has at most one outstanding request. A slow client does not get
+//   a new reply until it asks again, hence changes can not queue up in the server.
+// o The number of subscribers is bounded, when full, the request is answered
+//   immediately, i.e. the client falls back to polling.
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+
+#include <functional>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#include "Cmd.hpp"
+
+class AbstractServer;
+class CSyncCmd;
+
+class ChangeSubscribers {
+    ChangeSubscribers(const ChangeSubscribers&)                  = delete;
+    const ChangeSubscribers& operator=(const ChangeSubscribers&) = delete;
+
+public:
+    using reply_t = std::function<void(const STC_Cmd_ptr&)>;
+
+    ChangeSubscribers(AbstractServer* as, boost::asio::io_service& io, size_t max_subscribers = 1000);
+
+    /// Keep hold of the request, if it asked to wait, and there are no changes.
+    /// The reply function is called, once, with the response to the request.
+    /// Return false if the request should be replied to immediately.
+    bool add(const Cmd_ptr& cmd, const STC_Cmd_ptr& reply_cmd, const reply_t& reply);
+
+    /// Reply to subscribers whose client handle has changed, or whose wait has expired
+    /// Should be called after requests, that can change the server
+    void notify();
+
+    /// Called when the server is exiting, cancel the timer. Pending requests are dropped
+    void terminate();
+
+    size_t size() const { return subscribers_.size(); }
+
+    /// The maximum time a request is held, irrespective of what the client asked for
+    static int max_wait() { return 300; }
+
+private:
+    bool changed(const CSyncCmd*) const;
+    void start_timer();
+    void timer_expired(const boost::system::error_code& error);
+
+    struct Subscriber
+    {
+        Cmd_ptr cmd_;
+        boost::posix_time::ptime expires_;
+        reply_t reply_;
+    };
+
+    AbstractServer* as_;
+    boost::asio::deadline_timer timer_;
+    size_t max_subscribers_;
+    bool timer_running_{false};
+    std::vector<Subscriber> subscribers_;
+};
+
+#endif
@@ -119,6 +119,9 @@ bool CheckPtSaver::explicitSave(bool from_server) const {
             fs::rename(checkPtFile, oldCheckPtFile);
         }
 
+        // Edit history is only pruned on load, for long running servers also prune before saving
+        server_->defs_->prune_edit_history();
+
         // write to ecf_checkpt_file, if file system is full this could result in an empty file. ?
         server_->defs_->save_as_checkpt(serverEnv_->checkPtFilename());
 
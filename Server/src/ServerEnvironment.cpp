@@ -74,6 +74,7 @@ ServerEnvironment::ServerEnvironment(int argc, char* argv[])
       checkpt_save_time_alarm_(CheckPt::default_save_time_alarm()),
       submitJobsInterval_(defaultSubmitJobsInterval),
       ecf_prune_node_log_(0),
+      ecf_edit_history_size_(64),
       jobGeneration_(true),
       debug_(false),
       help_option_(false),
@@ -95,6 +96,7 @@ ServerEnvironment::ServerEnvironment(int argc, char* argv[], const std::string&
       checkpt_save_time_alarm_(CheckPt::default_save_time_alarm()),
       submitJobsInterval_(defaultSubmitJobsInterval),
       ecf_prune_node_log_(0),
+      ecf_edit_history_size_(64),
       jobGeneration_(true),
       debug_(false),
       help_option_(false),
@@ -266,6 +268,12 @@ bool ServerEnvironment::valid(std::string& errorMsg) const {
         errorMsg = ss.str();
         return false;
     }
+    if (ecf_edit_history_size_ < 0) {
+        ss << "ECF_EDIT_HISTORY_SIZE not set correctly. Please set in Server/server_environment.cfg\n";
+        ss << "or via environment variable of same name. It must be zero(no limit) or a size in megabytes\n";
+        errorMsg = ss.str();
+        return false;
+    }
     if (ecf_checkpt_file_.empty()) {
         ss << "No checkpoint file name specified. Please set in Server/server_environment.cfg or\n";
         ss << "set the environment variable ECF_CHECK\n";
@@ -622,7 +630,10 @@ void ServerEnvironment::read_config_file(std::string& log_file_name, const std::
             "The defaults thresholds when profiling job generation")(
             "ECF_PRUNE_NODE_LOG",
             po::value<int>(&ecf_prune_node_log_)->default_value(30),
-            "Node log, older than 180 days automatically pruned when checkpoint file loaded");
+            "Node log, older than 180 days automatically pruned when checkpoint file loaded")(
+            "ECF_EDIT_HISTORY_SIZE",
+            po::value<int>(&ecf_edit_history_size_)->default_value(64),
+            "Memory in megabytes, for the node log/edit history of all nodes");
 
         ifstream ifs(path_to_config_file.c_str());
         if (!ifs) {
@@ -728,6 +739,20 @@ void ServerEnvironment::read_environment_variables(std::string& log_file_name) {
         }
     }
 
+    char* ecf_edit_history_size = getenv("ECF_EDIT_HISTORY_SIZE");
+    if (ecf_edit_history_size) {
+        try {
+            ecf_edit_history_size_ = boost::lexical_cast<int>(ecf_edit_history_size);
+        }
+        catch (boost::bad_lexical_cast& e) {
+            std::stringstream ss;
+            ss << "ServerEnviroment::read_environment_variables: ECF_EDIT_HISTORY_SIZE must be convertible to an "
+                  "integer, But found: "
+               << ecf_edit_history_size;
+            throw ServerEnvironmentException(ss.str());
+        }
+    }
+
     if (getenv("ECF_DEBUG_SERVER")) {
         debug_ = true; // can also be enabled via --debug option
     }
@@ -793,6 +818,7 @@ std::string ServerEnvironment::dump() const {
     ss << "ECF_URL = '" << url_ << "'\n";
     ss << "ECF_MICRO = '" << ecf_micro_ << "'\n";
     ss << "ECF_PRUNE_NODE_LOG = '" << ecf_prune_node_log_ << "'\n";
+    ss << "ECF_EDIT_HISTORY_SIZE = '" << ecf_edit_history_size_ << "'\n";
     ss << "check pt save time alarm " << checkpt_save_time_alarm_ << "\n";
     ss << "Job generation " << jobGeneration_ << "\n";
     ss << "Server host name " << serverHost_ << "\n";
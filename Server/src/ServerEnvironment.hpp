@@ -137,6 +137,10 @@ public:
     /// A value of 0, means no pruning. i.e keep old edit history .
     int ecf_prune_node_log() const { return ecf_prune_node_log_; }
 
+    /// Returns ECF_EDIT_HISTORY_SIZE, the memory in megabytes, available to the node log/edit history
+    /// of all nodes. When exceeded the oldest history is removed. Default is 64MB. 0 means no limit.
+    int ecf_edit_history_size() const { return ecf_edit_history_size_; }
+
     /// returns server variables, as vector of pairs.
     /// Some of these variables hold environment variables
     /// Note:: additional variable are created for use by clients, i.e like
@@ -210,6 +214,7 @@ private:
     int checkpt_save_time_alarm_;
     int submitJobsInterval_;
     int ecf_prune_node_log_;
+    int ecf_edit_history_size_;
     bool jobGeneration_; // used in debug/test mode only
     bool debug_;
     bool help_option_;
@@ -101,6 +101,9 @@ ServerOptions::ServerOptions(int argc, char* argv[], ServerEnvironment* env) {
                        "  node log/edit history older than 30 days is automatically pruned, thus saving space\n"
                        "  in memory and disk. The environment variable of this name can be used to alter the days.\n"
                        "  If set to zero all edit history is preserved.\n"
+                       "ECF_EDIT_HISTORY_SIZE:\n"
+                       "  The memory in megabytes, available to the node log/edit history of all nodes.\n"
+                       "  When exceeded, the oldest history is removed. The default is 64. Zero means no limit.\n"
 #ifdef ECF_OPENSSL
                        "ECF_SSL:\n"
                        "  Enables encrypted communication between client and server.\n"
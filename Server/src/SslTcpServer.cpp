@@ -107,11 +107,23 @@ void SslTcpServer::handle_read(const boost::system::error_code& e, ssl_connectio
     // ***********************************************************************************
     if (!e) {
 
+        // Terminate requests always close the connection
+        bool keep_alive = inbound_request_.keep_alive() && !inbound_request_.terminateRequest();
+
         handle_request(); // populates outbound_response_
 
+        // The reply is sent when there are changes, or the wait expires
+        if (subscribe(conn)) {
+            return;
+        }
+
         // Always *Reply* back to the client, Otherwise client will get EOF
-        conn->async_write(outbound_response_,
-                          [this, conn](const boost::system::error_code& error) { this->handle_write(error, conn); });
+        conn->async_write(outbound_response_, [this, conn, keep_alive](const boost::system::error_code& error) {
+            this->handle_write(error, conn, keep_alive);
+        });
+
+        // Reply to waiting clients, whose suites were changed by this request
+        subscribers_.notify();
     }
     else {
         handle_read_error(e); // populates outbound_response_
@@ -120,7 +132,7 @@ void SslTcpServer::handle_read(const boost::system::error_code& e, ssl_connectio
     }
 }
 
-void SslTcpServer::handle_write(const boost::system::error_code& e, ssl_connection_ptr conn) {
+void SslTcpServer::handle_write(const boost::system::error_code& e, ssl_connection_ptr conn, bool keep_alive) {
     // Handle completion of a write operation.
     // Nothing to do. The socket will be closed automatically when the last
     // reference to the connection object goes away.
@@ -140,6 +152,12 @@ void SslTcpServer::handle_write(const boost::system::error_code& e, ssl_connecti
     // Do any necessary clean up after outbound_response_  has run. i.e like re-claiming memory
     outbound_response_.cleanup();
 
+    if (keep_alive) {
+        // The client will send its next request on the same connection
+        read_next_request(conn, [this, conn](const boost::system::error_code& error) { this->handle_read(error, conn); });
+        return;
+    }
+
     (void)shutdown_socket(conn, "SslTcpServer::handle_write:");
 
     // If asked to terminate we do it here rather than in handle_read.
@@ -27,7 +27,8 @@ TcpBaseServer::TcpBaseServer(BaseServer* server, boost::asio::io_service& io_ser
     : server_(server),
       io_service_(io_service),
       serverEnv_(serverEnv),
-      acceptor_(io_service) {
+      acceptor_(io_service),
+      subscribers_(server, io_service) {
     // Open the acceptor with the option to reuse the address (i.e. SO_REUSEADDR).
     boost::asio::ip::tcp::endpoint endpoint(serverEnv.tcp_protocol(), serverEnv.port());
     acceptor_.open(endpoint.protocol());
@@ -112,6 +113,8 @@ void TcpBaseServer::handle_terminate() {
 
     server_->handle_terminate();
 
+    subscribers_.terminate();
+
     acceptor_.close();
 
     // Stop the io_service object's event processing loop. Will cause run to return immediately
@@ -16,6 +16,7 @@
 
 #include <boost/asio.hpp>
 
+#include "ChangeSubscribers.hpp"
 #include "ClientToServerRequest.hpp"
 #include "Log.hpp"
 #include "ServerToClientResponse.hpp"
@@ -32,6 +33,51 @@ public:
     void handle_request();
     void handle_read_error(const boost::system::error_code& e);
 
+    /// If the request asked to wait for changes, and there are none, hold on to the connection.
+    /// The reply is then sent later, see ChangeSubscribers. Return true if the connection was held
+    template <typename T>
+    bool subscribe(T conn) {
+        return subscribers_.add(
+            inbound_request_.get_cmd(), outbound_response_.get_cmd(), [this, conn](const STC_Cmd_ptr& reply) {
+                // async_write serialises the reply immediately, hence push_response_ can be re-used
+                push_response_.set_cmd(reply);
+                conn->async_write(push_response_, [this, conn](const boost::system::error_code& error) {
+                    if (error) {
+                        ecf::LogToCout logToCout;
+                        ecf::log(ecf::Log::ERR, "TcpBaseServer::subscribe: reply failed: " + error.message());
+                        return;
+                    }
+                    (void)shutdown_socket(conn, "TcpBaseServer::subscribe:");
+                });
+                push_response_.cleanup();
+            });
+    }
+
+    /// The client asked to keep the connection open, wait for its next request on the same connection.
+    /// The handler is called with the request in inbound_request_. Idle connections are closed after
+    /// keep_alive_timeout() seconds. The handler is not called, when the client closes the connection
+    template <typename T, typename Handler>
+    void read_next_request(T conn, Handler handler) {
+        auto idle_timer =
+            std::make_shared<boost::asio::deadline_timer>(io_service_, boost::posix_time::seconds(keep_alive_timeout()));
+        idle_timer->async_wait([conn](const boost::system::error_code& error) {
+            if (error != boost::asio::error::operation_aborted) {
+                boost::system::error_code ec;
+                conn->socket_ll().close(ec); // aborts the pending read
+            }
+        });
+        conn->async_read(inbound_request_, [idle_timer, handler](const boost::system::error_code& error) {
+            idle_timer->cancel();
+            if (error && error != boost::asio::error::invalid_argument) {
+                return; // client has closed the connection, or it was idle for too long
+            }
+            handler(error);
+        });
+    }
+
+    /// The number of seconds, a kept alive connection, can be idle before the server closes it
+    static int keep_alive_timeout() { return 60; }
+
     /// Terminate the server gracefully. Need to cancel all timers, close all sockets
     /// Server will hang if there are any pending async handlers
     void handle_terminate_request();
@@ -72,6 +118,10 @@ protected:
     /// The data, typically loaded once, and then sent to many clients
     ClientToServerRequest inbound_request_;
     ServerToClientResponse outbound_response_;
+
+    /// Requests waiting for changes, and the response used to reply to them
+    ChangeSubscribers subscribers_;
+    ServerToClientResponse push_response_;
 };
 
 #endif
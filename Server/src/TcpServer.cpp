@@ -89,15 +89,28 @@ void TcpServer::handle_read(const boost::system::error_code& e, connection_ptr c
     // ***********************************************************************************
     if (!e) {
 
+        // Terminate requests always close the connection
+        bool keep_alive = inbound_request_.keep_alive() && !inbound_request_.terminateRequest();
+
         handle_request(); // populates outbound_response_
+
+        // The reply is sent when there are changes, or the wait expires
+        if (subscribe(conn)) {
+            return;
+        }
+
         // log(Log::DBG," handle_read()  n"  + timer_.format(3,Str::cpu_timer_format()));
 
         // start write
         // timer_.start();
 
         // Always *Reply* back to the client, Otherwise client will get EOF
-        conn->async_write(outbound_response_,
-                          [this, conn](const boost::system::error_code& error) { this->handle_write(error, conn); });
+        conn->async_write(outbound_response_, [this, conn, keep_alive](const boost::system::error_code& error) {
+            this->handle_write(error, conn, keep_alive);
+        });
+
+        // Reply to waiting clients, whose suites were changed by this request
+        subscribers_.notify();
     }
     else {
         handle_read_error(e); // populates outbound_response_
@@ -106,7 +119,7 @@ void TcpServer::handle_read(const boost::system::error_code& e, connection_ptr c
     }
 }
 
-void TcpServer::handle_write(const boost::system::error_code& e, connection_ptr conn) {
+void TcpServer::handle_write(const boost::system::error_code& e, connection_ptr conn, bool keep_alive) {
     // Handle completion of a write operation.
     // Nothing to do. The socket will be closed automatically when the last
     // reference to the connection object goes away.
@@ -126,6 +139,12 @@ void TcpServer::handle_write(const boost::system::error_code& e, connection_ptr
     // Do any necessary clean up after outbound_response_  has run. i.e like re-claiming memory
     outbound_response_.cleanup();
 
+    if (keep_alive) {
+        // The client will send its next request on the same connection
+        read_next_request(conn, [this, conn](const boost::system::error_code& error) { this->handle_read(error, conn); });
+        return;
+    }
+
     (void)shutdown_socket(conn, "TcpServer::handle_write:");
 
     // If asked to terminate we do it here rather than in handle_read.
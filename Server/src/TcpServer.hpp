@@ -31,7 +31,8 @@ private:
     void handle_accept(const boost::system::error_code& e, connection_ptr conn);
 
     /// Handle completion of a write operation.
-    void handle_write(const boost::system::error_code& e, connection_ptr conn);
+    /// When keep_alive is set, wait for the next request on the same connection, instead of closing it
+    void handle_write(const boost::system::error_code& e, connection_ptr conn, bool keep_alive = false);
 
     /// Handle completion of a read operation.
     void handle_read(const boost::system::error_code& e, connection_ptr conn);
@@ -11,6 +11,7 @@
 #include "ClientAPI.hpp"
 
 #include "ClientInvoker.hpp"
+#include "ClientToServerCmd.hpp"
 
 namespace ecf {
 
@@ -40,19 +41,48 @@ void ClientAPI::user_set_password(const std::string& password) {
     invoker_->set_password(password);
 }
 
+void ClientAPI::group_begin() {
+    grouping_ = true;
+}
+
+bool ClientAPI::group_flush() {
+    grouping_ = false;
+    if (group_.empty()) {
+        return false;
+    }
+
+    std::vector<std::shared_ptr<ClientToServerCmd>> cmds;
+    std::swap(cmds, group_);
+    try_invoke([&cmds](const auto& invoker) { invoker->group(cmds); });
+    return true;
+}
+
+void ClientAPI::user_alter(const std::string& path,
+                           const char* type,
+                           const std::string& name,
+                           const std::string& value) const {
+    if (grouping_) {
+        try_invoke([this, &path, type, &name, &value](const auto&) {
+            group_.push_back(std::make_shared<AlterCmd>(std::vector<std::string>{path}, "change", type, name, value));
+        });
+        return;
+    }
+    try_invoke([&path, type, &name, &value](const auto& invoker) { invoker->alter(path, "change", type, name, value); });
+}
+
 void ClientAPI::user_update_meter(const std::string& path, const std::string& name, const std::string& value) const {
-    try_invoke([&path, &name, &value](const auto& invoker) { invoker->alter(path, "change", "meter", name, value); });
+    user_alter(path, "meter", name, value);
 }
 
 void ClientAPI::user_update_label(const std::string& path, const std::string& name, const std::string& value) const {
-    try_invoke([&path, &name, &value](const auto& invoker) { invoker->alter(path, "change", "label", name, value); });
+    user_alter(path, "label", name, value);
 }
 
 void ClientAPI::user_clear_event(const std::string& path, const std::string& name) const {
-    try_invoke([&path, &name](const auto& invoker) { invoker->alter(path, "change", "event", name, "clear"); });
+    user_alter(path, "event", name, "clear");
 }
 void ClientAPI::user_set_event(const std::string& path, const std::string& name) const {
-    try_invoke([&path, &name](const auto& invoker) { invoker->alter(path, "change", "event", name, "set"); });
+    user_alter(path, "event", name, "set");
 }
 
 void ClientAPI::child_set_remote_id(const std::string& pid) {
@@ -14,9 +14,11 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 // Forward Declaration
 class ClientInvoker;
+class ClientToServerCmd;
 
 namespace ecf {
 
@@ -42,6 +44,12 @@ public:
     /// Define the User Password
     void user_set_password(const std::string& password);
 
+    /// Collect the user updates that follow, instead of sending each one, until group_flush()
+    void group_begin();
+    /// Send the collected user updates as a single (group) request, and stop collecting.
+    /// Returns true if a request was sent
+    bool group_flush();
+
     void user_update_meter(const std::string& path, const std::string& name, const std::string& value) const;
     void user_update_label(const std::string& path, const std::string& name, const std::string& value) const;
     void user_clear_event(const std::string& path, const std::string& name) const;
@@ -64,8 +72,13 @@ private:
     template <typename F>
     void try_invoke(F f) const;
 
+    void user_alter(const std::string& path, const char* type, const std::string& name, const std::string& value) const;
+
 private:
     std::unique_ptr<ClientInvoker> invoker_;
+
+    bool grouping_{false};
+    mutable std::vector<std::shared_ptr<ClientToServerCmd>> group_;
 };
 
 } // namespace ecf
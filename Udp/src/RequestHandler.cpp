@@ -10,7 +10,12 @@
 
 #include "RequestHandler.hpp"
 
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/lexical_cast.hpp>
@@ -27,7 +32,11 @@ namespace /* __anonymous__ */ {
 class BasicCommand {
 public:
     virtual void execute(ClientAPI& ctx) = 0;
-    virtual ~BasicCommand()              = default;
+    /// Commands with the same (non empty) key update the same attribute, only the last one needs to be executed
+    virtual std::string key() const = 0;
+    /// Can be sent in a group request, together with other commands
+    virtual bool grouped() const = 0;
+    virtual ~BasicCommand()      = default;
 };
 
 /// The default implementation of a `command`, enables CRTP-based mixins
@@ -35,6 +44,13 @@ template <typename COMMAND>
 class DefaultCommand : public BasicCommand {
 public:
     void execute(ClientAPI& client) final { static_cast<COMMAND*>(this)->actually_execute(client); }
+    std::string key() const final {
+        if constexpr (COMMAND::COALESCE) {
+            return std::string{COMMAND::COMMAND_TAG} + ":" + static_cast<const COMMAND*>(this)->attribute();
+        }
+        return std::string{};
+    }
+    bool grouped() const final { return COMMAND::GROUPED; }
 };
 
 /// The `command` to update an ecFlow meter (issued by an ecFlow user)
@@ -47,6 +63,10 @@ public:
     void actually_execute(ClientAPI& client) const { client.user_update_meter(path_, name_, std::to_string(value_)); };
 
     static constexpr const char* COMMAND_TAG = "alter_meter";
+    static constexpr bool COALESCE           = true;
+    static constexpr bool GROUPED            = true;
+
+    std::string attribute() const { return path_ + ":" + name_; }
 
 private:
     std::string path_;
@@ -64,6 +84,10 @@ public:
     void actually_execute(ClientAPI& client) const { client.user_update_label(path_, name_, value_); };
 
     static constexpr const char* COMMAND_TAG = "alter_label";
+    static constexpr bool COALESCE           = true;
+    static constexpr bool GROUPED            = true;
+
+    std::string attribute() const { return path_ + ":" + name_; }
 
 private:
     std::string path_;
@@ -88,6 +112,8 @@ public:
     };
 
     static constexpr const char* COMMAND_TAG = "alter_event";
+    static constexpr bool COALESCE           = false;
+    static constexpr bool GROUPED            = true;
 
 private:
     std::string path_;
@@ -105,6 +131,10 @@ public:
     void actually_execute(ClientAPI& client) const { client.user_update_meter(path_, name_, std::to_string(value_)); };
 
     static constexpr const char* COMMAND_TAG = "meter";
+    static constexpr bool COALESCE           = true;
+    static constexpr bool GROUPED            = true;
+
+    std::string attribute() const { return path_ + ":" + name_; }
 
 private:
     std::string path_;
@@ -122,6 +152,10 @@ public:
     void actually_execute(ClientAPI& client) const { client.user_update_label(path_, name_, value_); };
 
     static constexpr const char* COMMAND_TAG = "label";
+    static constexpr bool COALESCE           = true;
+    static constexpr bool GROUPED            = true;
+
+    std::string attribute() const { return path_ + ":" + name_; }
 
 private:
     std::string path_;
@@ -146,6 +180,8 @@ public:
     };
 
     static constexpr const char* COMMAND_TAG = "event";
+    static constexpr bool COALESCE           = false;
+    static constexpr bool GROUPED            = false;
 
 private:
     std::string path_;
@@ -157,6 +193,10 @@ private:
 class Command {
 public:
     Command(Command&& rhs) noexcept : impl_{std::move(rhs.impl_)} {}
+    Command& operator=(Command&& rhs) noexcept {
+        impl_ = std::move(rhs.impl_);
+        return *this;
+    }
 
     template <typename COMMAND, typename... ARGS>
     static Command make_command(ARGS&&... args) {
@@ -164,6 +204,8 @@ public:
     }
 
     void execute(ClientAPI& client) const { impl_->execute(client); }
+    std::string key() const { return impl_->key(); }
+    bool grouped() const { return impl_->grouped(); }
 
 private:
     explicit Command(std::unique_ptr<BasicCommand>&& impl) : impl_{std::move(impl)} {}
@@ -329,85 +371,255 @@ public:
     std::vector<std::unique_ptr<CommandBuilder>> builders_;
 };
 
-class JSONRequestHandler {
-public:
-    JSONRequestHandler() : client_{} {}
+/// Apply the authentication, given in the request "header"
+void configure_authentication(ClientAPI& client, const nlohmann::json& header) {
+    for (const auto& [key, value] : header.items()) {
 
-    void handle(const nlohmann::json& request) {
-        try {
-            std::string method_type = request.at("method");
+        if (key == "user_name") {
+            client.user_set_name(value);
+        }
+        else if (key == "user_password") {
+            client.user_set_password(value);
+        }
+        else if (key == "task_rid") {
+            client.child_set_remote_id(value);
+        }
+        else if (key == "task_password") {
+            client.child_set_password(value);
+        }
+        else if (key == "task_try_no") {
+            client.child_set_try_no(value);
+        }
+        else {
+            TRACE_ERR("RequestRelay", "unknown header: ", key, ", ignored.")
+        }
+    }
+}
 
-            // process "header"
-            if (request.contains("header")) {
-                nlohmann::json header = request.at("header");
-                configure_authentication(header);
-            }
+/// A `command` waiting to be forwarded, with the authentication of the request
+struct QueuedCommand
+{
+    nlohmann::json header;
+    std::string header_key; // requests with the same authentication can be grouped
+    Command command;
+};
 
-            // process "data"
-            if (method_type == "put") {
-                auto payload    = request.at("payload");
+} // namespace
 
-                Command command = command_factory_.make_command_from(payload);
-                command.execute(client_);
-            }
-            else {
-                TRACE_ERR("JSONRequestHandler", "unknown method: ", method_type)
-            }
+/// Queues the commands, and forwards them to the ecFlow server on a separate thread
+class RequestRelay {
+public:
+    explicit RequestRelay(const RequestHandler::Configuration& configuration)
+        : configuration_{configuration},
+          worker_{[this]() { run(); }} {}
+    RequestRelay(const RequestRelay&) = delete;
+    RequestRelay(RequestRelay&&)      = delete;
+
+    ~RequestRelay() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
         }
-        catch (nlohmann::json::exception& e) {
-            TRACE_ERR("JSONRequestHandler", "JSON format error: ", e.what())
-            return;
+        ready_.notify_one();
+        worker_.join();
+    }
+
+    void push(const nlohmann::json& header, Command command) {
+        std::string header_key = header.dump();
+        std::string key        = command.key();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        statistics_.received++;
+
+        if (!key.empty()) {
+            key = header_key + key;
+            if (auto found = index_.find(key); found != std::end(index_)) {
+                // Keep the position of the first update, with the value of the last
+                pending_[found->second].command = std::move(command);
+                statistics_.coalesced++;
+                return;
+            }
         }
-        catch (ClientAPIException& e) {
-            TRACE_ERR("JSONRequestHandler", "Client invocation error: ", e.what())
+
+        if (pending_.size() >= configuration_.queue_size) {
+            statistics_.dropped++;
+            TRACE_ERR("RequestRelay", "queue is full, dropped update")
             return;
         }
-        catch (...) {
-            TRACE_ERR("JSONRequestHandler", "Unknown error detected handling request")
-            return;
+
+        if (!key.empty()) {
+            index_[key] = pending_.size();
         }
+        pending_.push_back(QueuedCommand{header, std::move(header_key), std::move(command)});
+        ready_.notify_one();
+    }
 
-        TRACE_NFO("JSONRequestHandler", "request handled successfully");
+    RequestHandler::Statistics statistics() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return statistics_;
     }
 
-    void configure_authentication(const nlohmann::json& header) {
-        for (const auto& [key, value] : header.items()) {
+private:
+    void run() {
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                ready_.wait(lock, [this]() { return stop_ || !pending_.empty(); });
+                if (pending_.empty()) {
+                    return; // stopped, and nothing left to forward
+                }
+                // Wait for further updates, which can then be coalesced/grouped
+                ready_.wait_for(lock, configuration_.batch_window, [this]() { return stop_; });
+            }
+
+            std::vector<QueuedCommand> batch;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                std::swap(batch, pending_);
+                index_.clear();
+            }
+
+            auto [forwarded, requests] = forward(batch);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            statistics_.forwarded += forwarded;
+            statistics_.requests += requests;
+            TRACE_NFO("RequestRelay",
+                      "forwarded ",
+                      forwarded,
+                      " update(s) in ",
+                      requests,
+                      " request(s). Totals: received=",
+                      statistics_.received,
+                      " coalesced=",
+                      statistics_.coalesced,
+                      " dropped=",
+                      statistics_.dropped,
+                      " forwarded=",
+                      statistics_.forwarded,
+                      " requests=",
+                      statistics_.requests)
+        }
+    }
+
+    /// Forward the commands, those with the same authentication are sent in a single group request.
+    /// Returns the number of commands forwarded, and number of requests made
+    static std::pair<std::size_t, std::size_t> forward(std::vector<QueuedCommand>& batch) {
+        std::size_t forwarded = 0;
+        std::size_t requests  = 0;
+
+        std::vector<const std::string*> header_keys;
+        for (const auto& queued : batch) {
+            auto found = std::find_if(std::begin(header_keys), std::end(header_keys), [&queued](const auto* header_key) {
+                return *header_key == queued.header_key;
+            });
+            if (found == std::end(header_keys)) {
+                header_keys.push_back(&queued.header_key);
+            }
+        }
 
-            if (key == "user_name") {
-                client_.user_set_name(value);
+        for (const auto* header_key : header_keys) {
+            try {
+                forwarded += forward(batch, *header_key, requests);
             }
-            else if (key == "user_password") {
-                client_.user_set_password(value);
+            catch (std::exception& e) {
+                TRACE_ERR("RequestRelay", "Unable to forward updates: ", e.what())
             }
-            else if (key == "task_rid") {
-                client_.child_set_remote_id(value);
+        }
+        return {forwarded, requests};
+    }
+
+    static std::size_t forward(std::vector<QueuedCommand>& batch, const std::string& header_key, std::size_t& requests) {
+        std::size_t forwarded = 0;
+        ClientAPI client;
+        bool configured = false;
+
+        client.group_begin();
+        for (const auto& queued : batch) {
+            if (queued.header_key != header_key) {
+                continue;
             }
-            else if (key == "task_password") {
-                client_.child_set_password(value);
+            if (!configured) {
+                configure_authentication(client, queued.header);
+                configured = true;
             }
-            else if (key == "task_try_no") {
-                client_.child_set_try_no(value);
+
+            try {
+                if (queued.command.grouped()) {
+                    queued.command.execute(client);
+                }
+                else {
+                    // Preserve the order of updates, by first sending those already collected
+                    requests += flush(client);
+                    queued.command.execute(client);
+                    requests++;
+                    client.group_begin();
+                }
+                forwarded++;
             }
-            else {
-                TRACE_ERR("JSONRequestHandler", "unknown header: ", key, ", ignored.")
+            catch (ClientAPIException& e) {
+                TRACE_ERR("RequestRelay", "Client invocation error: ", e.what())
+                client.group_begin();
             }
         }
+        requests += flush(client);
+        return forwarded;
+    }
+
+    static std::size_t flush(ClientAPI& client) {
+        try {
+            return client.group_flush() ? 1 : 0;
+        }
+        catch (ClientAPIException& e) {
+            // The group is handled by the server, even if some of the updates fail
+            TRACE_ERR("RequestRelay", "Client invocation error: ", e.what())
+            return 1;
+        }
     }
 
 private:
-    ClientAPI client_;
-    CommandFactory command_factory_;
+    RequestHandler::Configuration configuration_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable ready_;
+    std::vector<QueuedCommand> pending_;
+    std::unordered_map<std::string, std::size_t> index_; // coalesce key -> position in pending_
+    RequestHandler::Statistics statistics_;
+    bool stop_{false};
+
+    std::thread worker_; // must be last, started once all the other members are initialised
 };
 
-} // namespace
+RequestHandler::RequestHandler() : RequestHandler(Configuration{}) {
+}
+
+RequestHandler::RequestHandler(const Configuration& configuration)
+    : relay_{std::make_shared<RequestRelay>(configuration)} {
+}
 
 void RequestHandler::handle(const RequestHandler::inbound_t& request) const {
     try {
         TRACE_NFO("RequestHandler", "Processing request: ", request);
 
-        nlohmann::json inbound = nlohmann::json::parse(request);
-        JSONRequestHandler handler;
-        handler.handle(inbound);
+        nlohmann::json inbound  = nlohmann::json::parse(request);
+
+        std::string method_type = inbound.at("method");
+        if (method_type != "put") {
+            TRACE_ERR("RequestHandler", "unknown method: ", method_type)
+            return;
+        }
+
+        // process "header", the authentication is applied when the command is forwarded
+        nlohmann::json header = nlohmann::json::object();
+        if (inbound.contains("header")) {
+            header = inbound.at("header");
+        }
+
+        // process "data"
+        static CommandFactory command_factory; // only used by the thread receiving requests
+        relay_->push(header, command_factory.make_command_from(inbound.at("payload")));
+
+        TRACE_NFO("RequestHandler", "request queued successfully");
     }
     catch (nlohmann::json::exception& e) {
         TRACE_ERR("RequestHandler", "Unable to parse JSON request");
@@ -417,4 +629,8 @@ void RequestHandler::handle(const RequestHandler::inbound_t& request) const {
     }
 }
 
+RequestHandler::Statistics RequestHandler::statistics() const {
+    return relay_->statistics();
+}
+
 } // namespace ecf
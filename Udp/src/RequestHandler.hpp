@@ -11,20 +11,54 @@
 #ifndef ECFLOW_UDP_REQUESTHANDLER_HPP
 #define ECFLOW_UDP_REQUESTHANDLER_HPP
 
+#include <chrono>
+#include <cstddef>
+#include <memory>
 #include <string>
 
 namespace ecf {
 
+class RequestRelay;
+
 /**
  * Enables the handling of all requests by a ecFlow UDP server
+ *
+ * Requests are parsed when received, and then queued. The queued requests are forwarded to the
+ * ecFlow server by a separate thread, so that receiving is never blocked by the ecFlow server.
+ *  - updates to the same (path, attribute) are coalesced, only the last meter/label value is forwarded
+ *  - the updates collected during the batch window are forwarded as a single (group) request
+ *  - when the queue is full, new updates are dropped
  */
 struct RequestHandler
 {
 public:
     using inbound_t = std::string;
 
+    struct Configuration
+    {
+        std::size_t queue_size{10'000};              // max number of (distinct) updates waiting to be forwarded
+        std::chrono::milliseconds batch_window{10}; // time to wait for further updates, before forwarding
+    };
+
+    struct Statistics
+    {
+        std::size_t received{0};  // updates received
+        std::size_t coalesced{0}; // updates replaced by a later update, to the same attribute
+        std::size_t dropped{0};   // updates dropped, since the queue was full
+        std::size_t forwarded{0}; // updates forwarded to the ecFlow server
+        std::size_t requests{0};  // requests made to the ecFlow server
+    };
+
 public:
+    RequestHandler();
+    explicit RequestHandler(const Configuration& configuration);
+
     void handle(const inbound_t& request) const;
+
+    Statistics statistics() const;
+
+private:
+    std::shared_ptr<RequestRelay> relay_; // shared, since the handler is copied into the server
 };
 
 } // namespace ecf
@@ -19,14 +19,19 @@ namespace /* __anonymous__ */ {
 // all variables to be collected
 const char* const variables[] = {UDPServerEnvironment::ECF_UDP_VERBOSE,
                                  UDPServerEnvironment::ECF_UDP_PORT,
+                                 UDPServerEnvironment::ECF_UDP_BATCH_WINDOW,
+                                 UDPServerEnvironment::ECF_UDP_QUEUE_SIZE,
                                  UDPServerEnvironment::ECF_HOST,
                                  UDPServerEnvironment::ECF_PORT};
 
 // the options related to each of the variables
-const std::unordered_map<std::string, std::string> options_map = {{UDPServerEnvironment::ECF_UDP_VERBOSE, "verbose"},
-                                                                  {UDPServerEnvironment::ECF_UDP_PORT, "port"},
-                                                                  {UDPServerEnvironment::ECF_HOST, "ecflow_host"},
-                                                                  {UDPServerEnvironment::ECF_PORT, "ecflow_port"}};
+const std::unordered_map<std::string, std::string> options_map = {
+    {UDPServerEnvironment::ECF_UDP_VERBOSE, "verbose"},
+    {UDPServerEnvironment::ECF_UDP_PORT, "port"},
+    {UDPServerEnvironment::ECF_UDP_BATCH_WINDOW, "batch_window"},
+    {UDPServerEnvironment::ECF_UDP_QUEUE_SIZE, "queue_size"},
+    {UDPServerEnvironment::ECF_HOST, "ecflow_host"},
+    {UDPServerEnvironment::ECF_PORT, "ecflow_port"}};
 
 } // namespace
 
@@ -48,10 +48,12 @@ public:
     std::string as_configuration_file() const;
 
 public:
-    static constexpr const char* ECF_UDP_VERBOSE = "ECF_UDP_VERBOSE";
-    static constexpr const char* ECF_UDP_PORT    = "ECF_UDP_PORT";
-    static constexpr const char* ECF_HOST        = "ECF_HOST";
-    static constexpr const char* ECF_PORT        = "ECF_PORT";
+    static constexpr const char* ECF_UDP_VERBOSE      = "ECF_UDP_VERBOSE";
+    static constexpr const char* ECF_UDP_PORT         = "ECF_UDP_PORT";
+    static constexpr const char* ECF_UDP_BATCH_WINDOW = "ECF_UDP_BATCH_WINDOW";
+    static constexpr const char* ECF_UDP_QUEUE_SIZE   = "ECF_UDP_QUEUE_SIZE";
+    static constexpr const char* ECF_HOST             = "ECF_HOST";
+    static constexpr const char* ECF_PORT             = "ECF_PORT";
 
 private:
     storage_t environment_;
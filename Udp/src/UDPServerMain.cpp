@@ -29,8 +29,8 @@ static std::string ecflow_udp_server_version() {
     return oss.str();
 }
 
-static void run_server(uint16_t port) {
-    ecf::RequestHandler handler;
+static void run_server(uint16_t port, const ecf::RequestHandler::Configuration& configuration) {
+    ecf::RequestHandler handler{configuration};
     ecf::UDPServer server{handler, port};
     server.run();
 }
@@ -42,8 +42,13 @@ static int launch_server(const ecf::UDPServerOptions& options) {
     auto port = options.get_option<size_t>(ecf::UDPServerOptions::OPTION_PORT);
     TRACE_NFO("UDPServerMain", "starting server on port ", port)
 
+    ecf::RequestHandler::Configuration configuration;
+    configuration.queue_size   = options.get_option<size_t>(ecf::UDPServerOptions::OPTION_QUEUE_SIZE);
+    configuration.batch_window = std::chrono::milliseconds(
+        options.get_option<size_t>(ecf::UDPServerOptions::OPTION_BATCH_WINDOW));
+
     try {
-        run_server(static_cast<uint16_t>(port));
+        run_server(static_cast<uint16_t>(port), configuration);
     }
     catch (const std::exception& e) {
         TRACE_FATAL("UDPServerMain", e.what())
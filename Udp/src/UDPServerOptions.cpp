@@ -89,7 +89,11 @@ po::options_description UDPServerOptions::create_options() {
         (as_string(OPTION_ECFLOW_HOST).c_str(), po::value<std::string>(),
                         "The ecFlow server port to forward requests")
         (as_string(OPTION_ECFLOW_PORT).c_str(), po::value<size_t>()->default_value(3141),
-                        "The ecFlow server port to forward requests");
+                        "The ecFlow server port to forward requests")
+        (as_string(OPTION_BATCH_WINDOW).c_str(), po::value<size_t>()->default_value(10),
+                        "The time (in milliseconds) to collect updates, before forwarding them as a single request")
+        (as_string(OPTION_QUEUE_SIZE).c_str(), po::value<size_t>()->default_value(10000),
+                        "The maximum number of updates waiting to be forwarded, further updates are dropped");
     // clang-format on
 
     return general;
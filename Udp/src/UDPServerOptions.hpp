@@ -60,12 +60,14 @@ public:
     static po::options_description create_options();
 
 public:
-    static inline const char* OPTION_HELP        = "help";
-    static inline const char* OPTION_VERSION     = "version";
-    static inline const char* OPTION_VERBOSE     = "verbose";
-    static inline const char* OPTION_PORT        = "port";
-    static inline const char* OPTION_ECFLOW_HOST = "ecflow_host";
-    static inline const char* OPTION_ECFLOW_PORT = "ecflow_port";
+    static inline const char* OPTION_HELP         = "help";
+    static inline const char* OPTION_VERSION      = "version";
+    static inline const char* OPTION_VERBOSE      = "verbose";
+    static inline const char* OPTION_PORT         = "port";
+    static inline const char* OPTION_ECFLOW_HOST  = "ecflow_host";
+    static inline const char* OPTION_ECFLOW_PORT  = "ecflow_port";
+    static inline const char* OPTION_BATCH_WINDOW = "batch_window";
+    static inline const char* OPTION_QUEUE_SIZE   = "queue_size";
 
 private:
     static void ensure_valid_options(const po::variables_map& variables);
@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <thread>
+#include <vector>
 
 #include <boost/asio.hpp>
 #include <boost/filesystem.hpp>
@@ -169,6 +170,17 @@ public:
         send(request);
     }
 
+    /// Send all the updates, without waiting in between
+    void update_meter_burst(const std::string& path, const std::string& name, const std::vector<int>& values) {
+        ecf::UDPClient client("localhost", std::to_string(port()));
+        for (auto value : values) {
+            client.send(format_request(path, "alter_meter", name, value));
+        }
+
+        // Wait for requests to flow...
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    }
+
     void clear_event(const std::string& path, const std::string& name) {
         auto request = format_request(path, "alter_event", name, "0");
         send(request);
@@ -144,6 +144,19 @@ BOOST_AUTO_TEST_CASE(can_update_meter_outside_valid_range) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(can_coalesce_meter_updates) {
+    // Updates arriving faster than they can be forwarded, are coalesced. Only the last value is kept
+    std::vector<int> values;
+    for (int value = 0; value <= 100; ++value) {
+        values.push_back(value);
+    }
+    values.push_back(42);
+
+    ecflow_udp.update_meter_burst("/s1/f2/f3/t4", "meter_at_t4", values);
+    auto meter = ecflow_server.get_meter("/s1/f2/f3/t4", "meter_at_t4");
+    BOOST_TEST(meter.value() == 42);
+}
+
 BOOST_AUTO_TEST_CASE(can_handle_invalid_json_request) {
     ecflow_udp.send(R"()");
     ecflow_udp.send(R"({})");
@@ -147,6 +147,7 @@ public:
     virtual void clear();
     virtual VReply* theReply() const = 0;
     virtual VFile_ptr findInCache(const std::string& /*fileName*/) { return nullptr; }
+    virtual VFile_ptr findInDiskCache(const std::string& /*fileName*/) { return nullptr; }
     virtual void addToCache(VFile_ptr) {}
     virtual void fetchQueueSucceeded()                                               = 0;
     virtual void fetchQueueFinished(const std::string& filePath, VNode* n = nullptr) = 0;
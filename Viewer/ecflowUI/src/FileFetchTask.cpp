@@ -20,6 +20,16 @@
 
 #define UI_FILEPROVIDER_TASK_DEBUG__
 
+// The current jobout of a submitted or active node may still be written to
+static bool isGrowingOutput(VNode* node, const std::string& filePath) {
+    return node && (node->isSubmitted() || node->isActive()) && node->findVariable("ECF_JOBOUT", true) == filePath;
+}
+
+static bool hasLogServer(VNode* node) {
+    std::string host, port;
+    return node && (node->userLogServer(host, port) || node->logServer(host, port));
+}
+
 //=================================
 //
 // FileFetchLocalTask
@@ -216,10 +226,23 @@ void FileFetchCacheTask::run() {
     // We try use the cache
     if (useCache_) {
         // Check if the given output is already in the cache
-        VFile_ptr f = owner_->findInCache(filePath_);
+        VFile_ptr f   = owner_->findInCache(filePath_);
+        bool fromDisk = false;
+
+        // Then try the disk cache shared by the instances. When there is a log server the
+        // copy is not taken as it is: the log server task checks it against the remote file
+        // and only fetches what was appended to it (or the whole file if it was replaced).
+        if (!f && !isGrowingOutput(node_, filePath_) && !hasLogServer(node_)) {
+            f = owner_->findInDiskCache(filePath_);
+            if (f) {
+                fromDisk = true;
+                owner_->addToCache(f);
+            }
+        }
+
         if (f) {
 #ifdef UI_FILEPROVIDER_TASK_DEBUG__
-            UiLog().dbg() << " File found in cache";
+            UiLog().dbg() << " File found in cache fromDisk=" << fromDisk;
 #endif
             f->setCached(true);
             f->setTransferDuration(0);
@@ -227,7 +250,7 @@ void FileFetchCacheTask::run() {
             reply->setInfoText("");
             reply->fileReadMode(VReply::LogServerReadMode);
             reply->setLog(f->log());
-            reply->addLogRemarkEntry("File were read from cache.");
+            reply->addLogRemarkEntry((fromDisk) ? "File were read from disk cache." : "File were read from cache.");
             if (appendResult_) {
                 reply->appendTmpFile(f);
             }
@@ -274,6 +297,7 @@ void FileFetchLogServerTask::stop() {
     UI_FN_DBG
 #endif
     AbstractFetchTask::clear();
+    base_.reset();
     if (status_ == RunningStatus) {
         deleteClient();
     }
@@ -336,8 +360,24 @@ void FileFetchLogServerTask::run() {
         VDir_ptr dir = owner_->dirToFile(filePath_);
         client_->setDir(dir);
 
+        // When the file is in the disk cache we only fetch the tail appended to the copy.
+        // The log server checks the modification time and checksum and sends the whole
+        // file if it was replaced in the meantime, e.g. by a rerun.
+        base_.reset();
+        if (useCache_ && deltaPos_ == 0) {
+            VFile_ptr f = owner_->findInDiskCache(filePath_);
+            if (f && f->fetchMode() == VFile::LogServerFetchMode && f->sizeInBytes() > 0) {
+                base_ = f;
+            }
+        }
+
         // fetch the file asynchronously
-        client_->getFile(filePath_, deltaPos_, modTime_, checkSum_);
+        if (base_) {
+            client_->getFile(filePath_, base_->sizeInBytes(), base_->sourceModTime(), base_->sourceCheckSum());
+        }
+        else {
+            client_->getFile(filePath_, deltaPos_, modTime_, checkSum_);
+        }
         return;
     }
 
@@ -356,6 +396,24 @@ void FileFetchLogServerTask::clientFinished() {
     if (tmp) {
         client_->clearResult();
 
+        // Complete the copy from the disk cache with the tail
+        bool tailOnly = false;
+        if (base_ && tmp->hasDeltaContents()) {
+            if (tmp->sizeInBytes() > 0) {
+                if (!base_->append(tmp)) {
+                    // fall back to fetching the whole file
+                    base_.reset();
+                    client_->getFile(filePath_, deltaPos_, modTime_, checkSum_);
+                    return;
+                }
+                base_->setCached(false);
+            }
+            base_->setFetchModeStr(tmp->fetchModeStr());
+            tmp      = base_;
+            tailOnly = true;
+        }
+        base_.reset();
+
         // Files retrieved from the log server are automatically added to the cache!
         // sourcePath must be already set on tmp
         if (useCache_ && !tmp->hasDeltaContents()) {
@@ -369,6 +427,10 @@ void FileFetchLogServerTask::clientFinished() {
         if (tmp->hasDeltaContents()) {
             reply->addLogTryEntry("fetch file increment from logserver=" + client_->longName() + ": OK");
         }
+        else if (tailOnly) {
+            reply->addLogTryEntry("fetch file tail from logserver=" + client_->longName() + ": OK");
+            reply->addLogRemarkEntry("The rest of the file were read from disk cache.");
+        }
         else {
             reply->addLogTryEntry("fetch file from logserver=" + client_->longName() + ": OK");
         }
@@ -397,6 +459,7 @@ void FileFetchLogServerTask::clientProgress(QString msg, int value) {
 
 void FileFetchLogServerTask::clientError(QString msg) {
     assert(client_);
+    base_.reset();
     owner_->progressStop();
     auto reply = owner_->theReply();
     reply->addLogTryEntry("fetch file from logserver=" + client_->longName() + ": FAILED");
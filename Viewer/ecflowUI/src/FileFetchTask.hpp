@@ -72,6 +72,7 @@ protected:
     void deleteClient();
 
     OutputFileClient* client_{nullptr};
+    VFile_ptr base_; // copy from the disk cache the fetched tail is appended to
 };
 
 #endif // FILEFETCHTASK_HPP
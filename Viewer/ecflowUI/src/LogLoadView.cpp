@@ -819,6 +819,28 @@ void LogRequestViewHandler::load(const std::string& logFile,
     loadPostProc();
 }
 
+// Only parse the lines appended to the log file since it was loaded. The plot states of
+// the suites, commands and users already shown are kept. Returns false if the log file
+// must be loaded again.
+bool LogRequestViewHandler::loadTail(const std::string& logFile, LogConsumer* logConsumer) {
+    if (!data_->loadLogFileTail(logFile, logConsumer))
+        return false;
+
+    while (suitePlotState_.count() < static_cast<int>(data_->suites().size()))
+        suitePlotState_ << false;
+
+    while (cmdPlotState_.count() < static_cast<int>(data_->total().subReq().size()))
+        cmdPlotState_ << false;
+
+    while (uidPlotState_.count() < static_cast<int>(data_->uidData().size()))
+        uidPlotState_ << false;
+
+    for (int i = 0; i < views_.count(); i++) {
+        views_[i]->load();
+    }
+    return true;
+}
+
 void LogRequestViewHandler::loadMultiLogFile(const std::string& logFile,
                                              const std::vector<std::string>& suites,
                                              int logFileIndex,
@@ -213,6 +213,7 @@ public:
     LogLoadData* data() const { return data_; }
     void clear();
     void load(const std::string& logFile, size_t maxReadSize, const std::vector<std::string>& suites, LogConsumer*);
+    bool loadTail(const std::string& logFile, LogConsumer*);
     void loadMultiLogFile(const std::string& logFile,
                           const std::vector<std::string>& suites,
                           int logFileIndex,
@@ -507,6 +507,10 @@ void LogLoadWidget::initLoad(QString serverName,
 void LogLoadWidget::loadLatest(bool usePrevState) {
     Q_ASSERT(logMode_ == LatestMode);
 
+    // A reload of a local log file only parses the lines appended to it
+    if (usePrevState && logLoaded_ && localLog_ && !logFile_.isEmpty() && loadTail())
+        return;
+
     // if it is a reload we remember the current period
     if (usePrevState) {
         auto data            = viewHandler_->data();
@@ -565,6 +569,35 @@ void LogLoadWidget::loadLatest(bool usePrevState) {
     }
 }
 
+// Parse the lines appended to the local log file since it was loaded. Returns false when
+// it has to be loaded again, e.g. the log file was truncated.
+bool LogLoadWidget::loadTail() {
+    if (!QFileInfo::exists(logFile_))
+        return false;
+
+    ViewerUtil::setOverrideCursor(QCursor(Qt::WaitCursor));
+
+    bool done = false;
+    try {
+        logModel_->beginLoadFromReader();
+        done = viewHandler_->loadTail(logFile_.toStdString(), logModel_->logData());
+        logModel_->endLoadFromReader();
+    }
+    catch (const std::runtime_error&) {
+        logModel_->endLoadFromReader();
+        done = false;
+    }
+
+    ViewerUtil::restoreOverrideCursor();
+
+    if (!done)
+        return false;
+
+    updateInfoLabel();
+    initFromData();
+    return true;
+}
+
 // Load a single/multiple logfiles in ArchiveMode
 void LogLoadWidget::loadArchive() {
     Q_ASSERT(logMode_ == ArchiveMode);
@@ -116,6 +116,7 @@ private:
     void clearData(bool usePrevState);
     void reloadLatest(bool canUsePrevState);
     void loadLatest(bool usePrevState);
+    bool loadTail();
     void loadArchive();
     void loadCore(QString logFile);
     void initFromData();
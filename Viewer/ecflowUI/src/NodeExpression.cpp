@@ -627,6 +627,8 @@ bool StateNodeCondition::execute(VItem* item) {
     else if (item->isNode()) {
         auto* n = static_cast<VNode*>(item);
         assert(n);
+        if (state_)
+            return (VNState::toState(n) == state_);
         return (n->stateName() == stateName_);
     }
     return false;
@@ -693,17 +695,30 @@ bool UIStateCondition::execute(VItem*) {
 //
 //=========================================================================
 
+const QRegularExpression& StringMatchBase::regexp(const std::string& searchFor, bool wildcard) {
+    if (!compiled_ || searchFor != pattern_) {
+        pattern_ = searchFor;
+        if (wildcard)
+            rx_.setPattern(ViewerUtil::wildcardToRegex(QString::fromStdString(searchFor)));
+        else
+            rx_.setPattern(QString::fromStdString(searchFor));
+
+        if (!caseSensitive_) {
+            rx_.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+        }
+        rx_.optimize();
+        compiled_ = true;
+    }
+    return rx_;
+}
+
 bool StringMatchExact::match(std::string searchFor, std::string searchIn) {
     return searchFor == searchIn;
 }
 
 bool StringMatchContains::match(std::string searchFor, std::string searchIn) {
 #if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
-    QRegularExpression rx(QString::fromStdString(searchFor));
-    if (!caseSensitive_) {
-        rx.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
-    }
-    auto m = rx.match(QString::fromStdString(searchIn));
+    auto m = regexp(searchFor, false).match(QString::fromStdString(searchIn));
     return m.hasMatch();
 #else
     Qt::CaseSensitivity cs = (caseSensitive_) ? Qt::CaseSensitive : Qt::CaseInsensitive;
@@ -715,13 +730,7 @@ bool StringMatchContains::match(std::string searchFor, std::string searchIn) {
 
 bool StringMatchWildcard::match(std::string searchFor, std::string searchIn) {
 #if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
-    QRegularExpression rx;
-    // rx.setPattern(QRegularExpression::wildcardToRegularExpression(QString::fromStdString(searchFor)));
-    rx.setPattern(ViewerUtil::wildcardToRegex(QString::fromStdString(searchFor)));
-    if (!caseSensitive_) {
-        rx.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
-    }
-    auto m = rx.match(QString::fromStdString(searchIn));
+    auto m = regexp(searchFor, true).match(QString::fromStdString(searchIn));
     return m.hasMatch();
 #else
 
@@ -734,11 +743,7 @@ bool StringMatchWildcard::match(std::string searchFor, std::string searchIn) {
 
 bool StringMatchRegexp::match(std::string searchFor, std::string searchIn) {
 #if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
-    QRegularExpression rx(QString::fromStdString(searchFor));
-    if (!caseSensitive_) {
-        rx.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
-    }
-    auto m = rx.match(QString::fromStdString(searchIn));
+    auto m = regexp(searchFor, false).match(QString::fromStdString(searchIn));
     return m.hasMatch();
 #else
     Qt::CaseSensitivity cs = (caseSensitive_) ? Qt::CaseSensitive : Qt::CaseInsensitive;
@@ -10,6 +10,8 @@
 // nor does it submit to any jurisdiction.
 //============================================================================
 
+#include <QRegularExpression>
+
 #include "DState.hpp"
 #include "StringMatchMode.hpp"
 #include "VAttribute.hpp"
@@ -181,7 +183,13 @@ public:
     virtual bool match(std::string searchFor, std::string searchIn) = 0;
 
 protected:
+    // The expression is only compiled again when the pattern changes
+    const QRegularExpression& regexp(const std::string& searchFor, bool wildcard);
+
     bool caseSensitive_;
+    QRegularExpression rx_;
+    std::string pattern_;
+    bool compiled_{false};
 };
 
 class StringMatchExact : public StringMatchBase {
@@ -291,7 +299,9 @@ private:
 
 class StateNodeCondition : public BaseNodeCondition {
 public:
-    explicit StateNodeCondition(QString stateName) : stateName_(stateName) {}
+    explicit StateNodeCondition(QString stateName)
+        : stateName_(stateName),
+          state_(VNState::find(stateName.toStdString())) {}
     ~StateNodeCondition() override = default;
 
     bool execute(VItem* node) override;
@@ -299,6 +309,7 @@ public:
 
 private:
     QString stateName_;
+    VNState* state_; // the nodes are compared by state object rather than by name
 };
 
 // -----------------------------------------------------------------
@@ -10,6 +10,9 @@
 
 #include "NodeQueryEngine.hpp"
 
+#include <algorithm>
+#include <thread>
+
 #include <QStandardItemModel>
 #include <QtAlgorithms>
 
@@ -40,8 +43,57 @@ NodeQueryEngine::NodeQueryEngine(QObject* parent) : QThread(parent), query_(new
 NodeQueryEngine::~NodeQueryEngine() {
     delete query_;
 
-    if (parser_)
-        delete parser_;
+    clearConditions();
+}
+
+void NodeQueryEngine::clearConditions() {
+    for (auto& c : conditions_) {
+        if (c.node_)
+            delete c.node_;
+
+        qDeleteAll(c.attr_);
+    }
+    conditions_.clear();
+}
+
+bool NodeQueryEngine::parse(Conditions& c, bool report) {
+    bool caseSensitive = query_->caseSensitive();
+
+    // The nodequery parser
+    if (report)
+        UiLog().dbg() << " node part: " << query_->nodeQueryPart().toStdString();
+
+    c.node_ = NodeExpressionParser::instance()->parseWholeExpression(query_->nodeQueryPart().toStdString(),
+                                                                     caseSensitive);
+    if (c.node_ == nullptr) {
+        UiLog().err() << " unable to parse node query: " << query_->nodeQueryPart().toStdString();
+        UserMessage::message(
+            UserMessage::ERROR, true, "Error, unable to parse node query: " + query_->nodeQueryPart().toStdString());
+        return false;
+    }
+
+    // The attribute parser
+    if (report)
+        UiLog().dbg() << " full attr part: " << query_->attrQueryPart().toStdString();
+
+    for (auto it : VAttributeType::types()) {
+        if (query_->hasAttribute(it)) {
+            QString attrPart = (query_->attrQueryPart(it));
+            if (report)
+                UiLog().dbg() << "  " << it->strName() << ": " << attrPart.toStdString();
+            BaseNodeCondition* ac =
+                NodeExpressionParser::instance()->parseWholeExpression(attrPart.toStdString(), caseSensitive);
+            if (!ac) {
+                UiLog().err() << "  unable to parse attribute query: " << attrPart.toStdString();
+                UserMessage::message(
+                    UserMessage::ERROR, true, "Error, unable to parse attribute query: " + attrPart.toStdString());
+                return false;
+            }
+            c.attr_[it] = ac;
+        }
+    }
+
+    return true;
 }
 
 bool NodeQueryEngine::runQuery(NodeQuery* query, QStringList allServers) {
@@ -62,27 +114,13 @@ bool NodeQueryEngine::runQuery(NodeQuery* query, QStringList allServers) {
     maxNum_ = query_->maxNum();
 
     servers_.clear();
+    items_.clear();
 
     // Init the parsers
-    if (parser_) {
-        delete parser_;
-        parser_ = nullptr;
-    }
-
-    qDeleteAll(attrParser_);
-    attrParser_.clear();
-
-    // The nodequery parser
-    UiLog().dbg() << " node part: " << query_->nodeQueryPart().toStdString();
-
-    parser_ = NodeExpressionParser::instance()->parseWholeExpression(query_->nodeQueryPart().toStdString(),
-                                                                     query->caseSensitive());
-    if (parser_ == nullptr) {
-        UiLog().err() << " unable to parse node query: " << query_->nodeQueryPart().toStdString();
-        UserMessage::message(
-            UserMessage::ERROR, true, "Error, unable to parse node query: " + query_->nodeQueryPart().toStdString());
+    clearConditions();
+    conditions_.resize(1);
+    if (!parse(conditions_[0], true))
         return false;
-    }
 
     QStringList serverNames = query_->servers();
     if (query_->servers().isEmpty())
@@ -108,25 +146,28 @@ bool NodeQueryEngine::runQuery(NodeQuery* query, QStringList allServers) {
         }
     }
 
-    // The attribute parser
-    UiLog().dbg() << " full attr part: " << query_->attrQueryPart().toStdString();
-
-    for (auto it : VAttributeType::types()) {
-        if (query_->hasAttribute(it)) {
-            QString attrPart = (query_->attrQueryPart(it));
-            UiLog().dbg() << "  " << it->strName() << ": " << attrPart.toStdString();
-            BaseNodeCondition* ac =
-                NodeExpressionParser::instance()->parseWholeExpression(attrPart.toStdString(), query->caseSensitive());
-            if (!ac) {
-                UiLog().err() << "  unable to parse attribute query: " << attrPart.toStdString();
-                UserMessage::message(
-                    UserMessage::ERROR, true, "Error, unable to parse attribute query: " + attrPart.toStdString());
-                return false;
-            }
-            attrParser_[it] = ac;
+    // The work is split up by servers and suites, in tree order. The server itself is not
+    // searched recursively.
+    if (rootNode_) {
+        items_.emplace_back(rootNode_, true);
+    }
+    else {
+        for (ServerHandler* server : servers_) {
+            VNode* root = server->vRoot();
+            items_.emplace_back(root, false);
+            for (int i = 0; i < root->numOfChildren(); i++)
+                items_.emplace_back(root->childAt(i), true);
         }
     }
 
+    // Each search thread needs its own conditions
+    size_t numOfThreads = std::max<size_t>(1, std::min<size_t>(items_.size(), std::thread::hardware_concurrency()));
+    conditions_.resize(numOfThreads);
+    for (size_t i = 1; i < numOfThreads; i++) {
+        if (!parse(conditions_[i], false))
+            return false;
+    }
+
     // Notify the servers that the search began
     for (ServerHandler* s : servers_) {
         s->searchBegan();
@@ -145,40 +186,63 @@ void NodeQueryEngine::stopQuery() {
     wait();
 }
 
+// The search threads take the items one by one and collect the results per item. This
+// thread broadcasts the results item by item in tree order, as soon as the next item is done.
 void NodeQueryEngine::run() {
-    if (rootNode_) {
-        run(servers_.at(0), rootNode_);
-    }
-    else {
-        for (auto it = servers_.begin(); it != servers_.end(); ++it) {
-            ServerHandler* server = *it;
+    nextItem_ = 0;
 
-            run(server, server->vRoot());
+    std::vector<std::thread> threads;
+    for (auto& c : conditions_)
+        threads.emplace_back(&NodeQueryEngine::search, this, std::ref(c));
 
-            if (stopIt_) {
-                broadcastChunk(true);
-                return;
-            }
+    for (auto& item : items_) {
+        {
+            std::unique_lock<std::mutex> lock(itemMutex_);
+            itemDone_.wait(lock, [this, &item] { return item.done_ || stopIt_; });
         }
+        if (stopIt_)
+            break;
+
+        broadcastItem(item);
     }
 
+    for (auto& t : threads)
+        t.join();
+
     broadcastChunk(true);
+
+    for (auto& item : items_)
+        item.res_.clear();
 }
 
-void NodeQueryEngine::run(ServerHandler*, VNode* root) {
-    runRecursively(root);
+// Runs in a search thread
+void NodeQueryEngine::search(Conditions& c) {
+    for (size_t i = nextItem_++; i < items_.size() && !stopIt_; i = nextItem_++) {
+        Item& item = items_[i];
+        runRecursively(item.node_, c, item.res_, item.recursive_);
+
+        std::lock_guard<std::mutex> lock(itemMutex_);
+        item.done_ = true;
+        itemDone_.notify_all();
+    }
+
+    // The broadcasting thread might wait for an item no thread takes after a stop
+    std::lock_guard<std::mutex> lock(itemMutex_);
+    itemDone_.notify_all();
 }
 
-void NodeQueryEngine::runRecursively(VNode* node) {
-    if (stopIt_)
+// Runs in a search thread. A single item cannot yield more than the maximum number of
+// results, the rest of the limit is applied when broadcasting.
+void NodeQueryEngine::runRecursively(VNode* node, Conditions& c, QList<NodeQueryResultTmp_ptr>& res, bool recursive) {
+    if (stopIt_ || res.count() >= maxNum_)
         return;
 
     // Execute the node part
-    if (parser_->execute(node)) {
+    if (c.node_->execute(node)) {
         // Then execute the attribute part
-        if (!attrParser_.isEmpty()) {
-            QMap<VAttributeType*, BaseNodeCondition*>::const_iterator it = attrParser_.constBegin();
-            while (it != attrParser_.constEnd()) {
+        if (!c.attr_.isEmpty()) {
+            QMap<VAttributeType*, BaseNodeCondition*>::const_iterator it = c.attr_.constBegin();
+            while (it != c.attr_.constEnd()) {
                 // Process a given attribute type
                 const std::vector<VAttribute*>& av = node->attrForSearch();
                 bool hasType                       = false;
@@ -186,7 +250,7 @@ void NodeQueryEngine::runRecursively(VNode* node) {
                     if (i->type() == it.key()) {
                         hasType = true;
                         if (it.value()->execute(i)) {
-                            broadcastFind(node, i->data(true));
+                            res << NodeQueryResultTmp_ptr(new NodeQueryResultTmp(node, i->data(true)));
                             scanCnt_++;
                         }
                     }
@@ -200,56 +264,37 @@ void NodeQueryEngine::runRecursively(VNode* node) {
             }
         }
         else {
-            broadcastFind(node);
+            res << NodeQueryResultTmp_ptr(new NodeQueryResultTmp(node));
             scanCnt_++;
         }
     }
 
+    if (!recursive)
+        return;
+
     for (int i = 0; i < node->numOfChildren(); i++) {
-        runRecursively(node->childAt(i));
-        if (stopIt_)
+        runRecursively(node->childAt(i), c, res, true);
+        if (stopIt_ || res.count() >= maxNum_)
             return;
     }
 }
 
-void NodeQueryEngine::broadcastFind(VNode* node, QStringList attr) {
-    Q_ASSERT(node);
-
-    if (!attr.isEmpty()) {
-        NodeQueryResultTmp_ptr d(new NodeQueryResultTmp(node, attr));
+// Broadcast the results of an item in chunks until the maximum number is reached
+void NodeQueryEngine::broadcastItem(Item& item) {
+    for (auto& d : item.res_) {
         res_ << d;
-    }
-    else {
-        NodeQueryResultTmp_ptr d(new NodeQueryResultTmp(node));
-        res_ << d;
-    }
-
-    broadcastChunk(false);
+        broadcastChunk(false);
 
-    cnt_++;
-
-    if (cnt_ >= maxNum_) {
-        broadcastChunk(true);
-        stopIt_     = true;
-        maxReached_ = true;
-    }
-}
+        cnt_++;
 
-void NodeQueryEngine::broadcastFind(VNode* node) {
-    Q_ASSERT(node);
-
-    NodeQueryResultTmp_ptr d(new NodeQueryResultTmp(node));
-    res_ << d;
-
-    broadcastChunk(false);
-
-    cnt_++;
-
-    if (cnt_ >= maxNum_) {
-        broadcastChunk(true);
-        stopIt_     = true;
-        maxReached_ = true;
+        if (cnt_ >= maxNum_) {
+            broadcastChunk(true);
+            stopIt_     = true;
+            maxReached_ = true;
+            break;
+        }
     }
+    item.res_.clear();
 }
 
 void NodeQueryEngine::broadcastChunk(bool force) {
@@ -11,7 +11,11 @@
 #ifndef VIEWER_SRC_NODEQUERYENGINE_HPP_
 #define VIEWER_SRC_NODEQUERYENGINE_HPP_
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <QMap>
@@ -55,23 +59,46 @@ protected:
     void run() override;
 
 private:
-    void run(ServerHandler*, VNode*);
-    void runRecursively(VNode* node);
-    void broadcastFind(VNode*);
-    void broadcastFind(VNode*, QStringList);
+    // The parsed query used by a search thread. The conditions cache their compiled
+    // expressions so each thread needs its own copy.
+    struct Conditions
+    {
+        BaseNodeCondition* node_{nullptr};
+        QMap<VAttributeType*, BaseNodeCondition*> attr_;
+    };
+
+    // A unit of the search: a node, and whether its children are searched as well. The
+    // results are collected by the search thread taking it and broadcast in tree order.
+    struct Item
+    {
+        Item(VNode* node, bool recursive) : node_(node), recursive_(recursive) {}
+        VNode* node_;
+        bool recursive_;
+        bool done_{false};
+        QList<NodeQueryResultTmp_ptr> res_;
+    };
+
+    bool parse(Conditions&, bool report);
+    void clearConditions();
+    void search(Conditions&);
+    void runRecursively(VNode* node, Conditions&, QList<NodeQueryResultTmp_ptr>& res, bool recursive);
+    void broadcastItem(Item&);
     void broadcastChunk(bool);
 
     NodeQuery* query_;
-    BaseNodeCondition* parser_{nullptr};
-    QMap<VAttributeType*, BaseNodeCondition*> attrParser_;
+    std::vector<Conditions> conditions_;
     std::vector<ServerHandler*> servers_;
+    std::vector<Item> items_;
+    std::atomic<size_t> nextItem_{0};
+    std::mutex itemMutex_;
+    std::condition_variable itemDone_;
     int cnt_{0};
-    int scanCnt_{0};
+    std::atomic<int> scanCnt_{0};
     int maxNum_{250000};
     int chunkSize_{100};
     QList<NodeQueryResultTmp_ptr> res_;
-    bool stopIt_{false};
-    bool maxReached_{false};
+    std::atomic<bool> stopIt_{false};
+    std::atomic<bool> maxReached_{false};
     VNode* rootNode_{nullptr};
 };
 
@@ -12,7 +12,9 @@
 
 #include <QDebug>
 
+#include "ServerHandler.hpp"
 #include "UiLog.hpp"
+#include "VNode.hpp"
 
 // #define _UI_OUTPUTCACHE_DEBUG
 
@@ -88,6 +90,12 @@ OutputCacheItem* OutputCache::add(VInfo_ptr info, const std::string& sourcePath,
         // The key we would store for the item in the map
         QString id = QString::fromStdString(info->path() + ":" + sourcePath);
 
+        // Files read from the disk cache are already there
+        OutputDiskCacheKey key;
+        if (!file->cached() && diskCacheKey(info, sourcePath, key)) {
+            OutputDiskCache::instance()->add(key, file);
+        }
+
         // The item exists
         QMap<QString, OutputCacheItem*>::iterator it = items_.find(id);
         if (it != items_.end()) {
@@ -136,6 +144,39 @@ OutputCacheItem* OutputCache::attachOne(VInfo_ptr info, const std::string& fileN
     return attachedItem;
 }
 
+// Look up the output in the disk cache, which is shared between the instances and
+// outlives them. The result is a private copy, so it can be appended to.
+VFile_ptr OutputCache::findOnDisk(VInfo_ptr info, const std::string& fileName) const {
+    OutputDiskCacheKey key;
+    if (!diskCacheKey(info, fileName, key))
+        return nullptr;
+
+    VFile_ptr f = OutputDiskCache::instance()->find(key);
+    if (f)
+        f->setCached(true);
+    return f;
+}
+
+// The output files are identified by the server and their path. Any output of the node can be
+// overwritten when it is rerun, which changes its status, so the time the node last changed status
+// is added to the key. The current jobout is also written to by the running job, so its try
+// number and remote id are added as well.
+bool OutputCache::diskCacheKey(VInfo_ptr info, const std::string& sourcePath, OutputDiskCacheKey& key) const {
+    if (sourcePath.empty() || !info || !info->isNode() || !info->server() || !info->node())
+        return false;
+
+    key.server_     = info->server()->host() + "@" + info->server()->port();
+    key.path_       = sourcePath;
+    key.statusTime_ = std::to_string(info->node()->statusChangeTime());
+    key.tryNo_.clear();
+    key.remoteId_.clear();
+    if (info->node()->findVariable("ECF_JOBOUT", true) == sourcePath) {
+        key.tryNo_    = info->node()->findVariable("ECF_TRYNO", true);
+        key.remoteId_ = info->node()->findVariable("ECF_RID", true);
+    }
+    return true;
+}
+
 // Detach all the items
 void OutputCache::detach() {
     QMap<QString, OutputCacheItem*>::iterator it = items_.begin();
@@ -19,6 +19,7 @@
 #include <QTimer>
 
 #include "OutputClient.hpp"
+#include "OutputDiskCache.hpp"
 #include "VFile.hpp"
 #include "VInfo.hpp"
 
@@ -53,6 +54,7 @@ public:
 
     OutputCacheItem* add(VInfo_ptr info, const std::string& sourcePath, VFile_ptr file);
     OutputCacheItem* attachOne(VInfo_ptr info, const std::string& fileName);
+    VFile_ptr findOnDisk(VInfo_ptr info, const std::string& fileName) const;
     void detach();
     void clear();
     void print();
@@ -63,6 +65,7 @@ protected Q_SLOTS:
 private:
     OutputCache(const OutputClient&);
     OutputCache& operator=(const OutputCache&);
+    bool diskCacheKey(VInfo_ptr info, const std::string& sourcePath, OutputDiskCacheKey& key) const;
     void adjustTimer();
     void startTimer();
     void stopTimer();
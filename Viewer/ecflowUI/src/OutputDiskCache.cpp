@@ -0,0 +1,168 @@
+//============================================================================
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//============================================================================
+
+#include "OutputDiskCache.hpp"
+
+#include <cstdlib>
+#include <exception>
+
+#include <QDateTime>
+#include <boost/filesystem/operations.hpp>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "DirectoryHandler.hpp"
+#include "OutputDiskStore.hpp"
+#include "UiLog.hpp"
+#include "User.hpp"
+#include "VConfig.hpp"
+#include "VProperty.hpp"
+
+// #define _UI_OUTPUTDISKCACHE_DEBUG
+
+namespace fs = boost::filesystem;
+
+OutputDiskCache* OutputDiskCache::instance_ = nullptr;
+
+OutputDiskCache::OutputDiskCache() = default;
+
+OutputDiskCache::~OutputDiskCache() = default;
+
+// The cache is shared by all the instances of the user on the host, so it cannot be in tmpDir(),
+// which belongs to a single instance and is removed when it exits
+std::string OutputDiskCache::cacheDir() {
+    std::string tmp = "/tmp";
+    if (const char* ch = getenv("TMPDIR")) {
+        if (*ch != '\0')
+            tmp = ch;
+    }
+
+    std::string user;
+    try {
+        user = ecf::User::login_name();
+    }
+    catch (const std::exception& e) {
+        UiLog().warn() << "OutputDiskCache - " << e.what();
+        return {};
+    }
+
+    std::string dir = DirectoryHandler::concatenate(tmp, "ecflow_ui_cache." + user);
+    boost::system::error_code ec;
+    if (!fs::exists(dir, ec))
+        fs::create_directory(dir, ec);
+
+    // The dir must not be a symlink and only the user may have access to it
+    struct stat st;
+    if (::lstat(dir.c_str(), &st) != 0 || !S_ISDIR(st.st_mode) || st.st_uid != ::getuid()) {
+        UiLog().warn() << "OutputDiskCache - could not create dir=" << dir;
+        return {};
+    }
+    if ((st.st_mode & 0777) != 0700)
+        ::chmod(dir.c_str(), 0700);
+
+    return dir;
+}
+
+OutputDiskCache* OutputDiskCache::instance() {
+    if (!instance_)
+        instance_ = new OutputDiskCache();
+    return instance_;
+}
+
+bool OutputDiskCache::isEnabled() {
+    size_t maxSize = 0;
+    if (VProperty* p = VConfig::instance()->find("server.files.maxSizeForOutputCache")) {
+        int v = p->value().toInt();
+        if (v > 0)
+            maxSize = static_cast<size_t>(v) * 1024 * 1024;
+    }
+    if (maxSize == 0)
+        return false;
+
+    if (store_ && store_->maxSize() == maxSize)
+        return true;
+
+    std::string dir = cacheDir();
+    if (dir.empty())
+        return false;
+
+    store_ = std::make_unique<OutputDiskStore>(dir, maxSize);
+    return true;
+}
+
+std::vector<std::string> OutputDiskCache::storeKey(const OutputDiskCacheKey& key) {
+    return {key.server_, key.path_, key.tryNo_, key.remoteId_, key.statusTime_};
+}
+
+VFile_ptr OutputDiskCache::find(const OutputDiskCacheKey& key) {
+    if (!isEnabled())
+        return nullptr;
+
+    std::string tmpPath = DirectoryHandler::tmpFileName();
+    if (tmpPath.empty())
+        return nullptr;
+
+    std::vector<std::string> meta;
+    if (!store_->find(storeKey(key), meta, tmpPath))
+        return nullptr;
+
+    VFile_ptr f = VFile::create(tmpPath, true);
+    if (meta.size() != 5)
+        return nullptr;
+
+    unsigned int modTime = 0;
+    int fetchMode        = 0;
+    qint64 fetchDate     = 0;
+    try {
+        modTime   = std::stoul(meta[0]);
+        fetchMode = std::stoi(meta[2]);
+        fetchDate = std::stoll(meta[4]);
+    }
+    catch (...) {
+        return nullptr;
+    }
+
+    f->setSourcePath(key.path_);
+    f->setSourceModTime(modTime);
+    f->setSourceCheckSum(meta[1]);
+    f->setFetchMode(static_cast<VFile::FetchMode>(fetchMode));
+    f->setFetchModeStr(meta[3]);
+    f->setFetchDate(QDateTime::fromMSecsSinceEpoch(fetchDate * 1000));
+
+#ifdef _UI_OUTPUTDISKCACHE_DEBUG
+    UiLog().dbg() << UI_FN_INFO << "found path=" << key.path_ << " size=" << f->sizeInBytes();
+#endif
+    return f;
+}
+
+void OutputDiskCache::add(const OutputDiskCacheKey& key, VFile_ptr file) {
+    if (!file || file->hasDeltaContents() || file->truncatedTo() > 0 || file->sizeInBytes() == 0 || !isEnabled())
+        return;
+
+    std::vector<std::string> meta = {std::to_string(file->sourceModTime()),
+                                     file->sourceCheckSum(),
+                                     std::to_string(static_cast<int>(file->fetchMode())),
+                                     file->fetchModeStr(),
+                                     std::to_string(file->fetchDate().toMSecsSinceEpoch() / 1000)};
+
+    bool ok = (file->storageMode() == VFile::DiskStorage)
+                  ? store_->addFile(storeKey(key), meta, file->path())
+                  : store_->add(storeKey(key), meta, file->data(), file->dataSize());
+
+#ifdef _UI_OUTPUTDISKCACHE_DEBUG
+    UiLog().dbg() << UI_FN_INFO << "added path=" << key.path_ << " ok=" << ok;
+#else
+    (void)ok;
+#endif
+}
+
+void OutputDiskCache::remove(const OutputDiskCacheKey& key) {
+    if (store_)
+        store_->remove(storeKey(key));
+}
@@ -0,0 +1,58 @@
+//============================================================================
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//============================================================================
+
+#ifndef OUTPUTDISKCACHE_HPP
+#define OUTPUTDISKCACHE_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "VFile.hpp"
+
+class OutputDiskStore;
+
+// Keeps the fetched output files on disk in a per-user directory in $TMPDIR, so they outlive
+// the in-memory OutputCache and are shared between the ecFlowUI instances on the same
+// host. The entries are kept by an OutputDiskStore, with the source modification time and
+// checksum as metadata.
+
+struct OutputDiskCacheKey
+{
+    std::string server_;     // host@port
+    std::string path_;
+    std::string tryNo_;      // only set for the current jobout
+    std::string remoteId_;   // only set for the current jobout, tells apart the runs with the same try number
+    std::string statusTime_; // the time the node last changed status
+};
+
+class OutputDiskCache {
+public:
+    static OutputDiskCache* instance();
+
+    // Returns a private copy of the cached file or nullptr
+    VFile_ptr find(const OutputDiskCacheKey& key);
+    void add(const OutputDiskCacheKey& key, VFile_ptr file);
+    void remove(const OutputDiskCacheKey& key);
+
+private:
+    OutputDiskCache();
+    ~OutputDiskCache();
+    OutputDiskCache(const OutputDiskCache&)            = delete;
+    OutputDiskCache& operator=(const OutputDiskCache&) = delete;
+
+    bool isEnabled();
+    static std::string cacheDir();
+    static std::vector<std::string> storeKey(const OutputDiskCacheKey& key);
+
+    static OutputDiskCache* instance_;
+    std::unique_ptr<OutputDiskStore> store_;
+};
+
+#endif // OUTPUTDISKCACHE_HPP
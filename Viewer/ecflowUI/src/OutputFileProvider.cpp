@@ -77,6 +77,7 @@ public:
 
     VReply* theReply() const override;
     VFile_ptr findInCache(const std::string& fileName) override;
+    VFile_ptr findInDiskCache(const std::string& fileName) override;
     void addToCache(VFile_ptr file) override;
     void fetchQueueSucceeded() override;
     void fetchQueueFinished(const std::string& filePath, VNode*) override;
@@ -103,6 +104,10 @@ VFile_ptr OutputFileFetchQueueManager::findInCache(const std::string& fileName)
     return (item) ? item->file() : nullptr;
 }
 
+VFile_ptr OutputFileFetchQueueManager::findInDiskCache(const std::string& fileName) {
+    return provider_->findInDiskCache(fileName);
+}
+
 void OutputFileFetchQueueManager::addToCache(VFile_ptr file) {
     provider_->addToCache(file);
 }
@@ -271,6 +276,11 @@ OutputCacheItem* OutputFileProvider::findInCache(const std::string& fileName) {
     return outCache_->attachOne(info_, fileName);
 }
 
+// Check if the given output is in the disk cache shared by the instances
+VFile_ptr OutputFileProvider::findInDiskCache(const std::string& fileName) {
+    return outCache_->findOnDisk(info_, fileName);
+}
+
 void OutputFileProvider::addToCache(VFile_ptr file) {
     outCache_->add(info_, file->sourcePath(), file);
 }
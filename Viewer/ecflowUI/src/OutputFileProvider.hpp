@@ -63,6 +63,7 @@ public:
 
 protected:
     OutputCacheItem* findInCache(const std::string& fileName);
+    VFile_ptr findInDiskCache(const std::string& fileName);
     void addToCache(VFile_ptr file);
     void fetchJoboutViaServer(ServerHandler* server, VNode* n, const std::string&);
     VDir_ptr dirToFile(const std::string& fileName) const;
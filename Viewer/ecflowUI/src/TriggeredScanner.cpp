@@ -55,3 +55,53 @@ int TriggeredScanner::progress() const {
     }
     return 0;
 }
+
+//============================================
+//
+// TriggeredMapThread
+//
+//============================================
+
+TriggeredMapThread::TriggeredMapThread(VServer* server) : QThread(nullptr), server_(server) {
+    connect(this, SIGNAL(finished()), this, SLOT(slotFinished()));
+}
+
+TriggeredMapThread::~TriggeredMapThread() {
+    stopMap();
+}
+
+void TriggeredMapThread::startMap(std::vector<TriggeredRef>&& refs, std::size_t nodeNum) {
+    stopMap();
+    refs_ = std::move(refs);
+    result_.assign(nodeNum, nullptr);
+    stopIt_ = false;
+    start(QThread::LowPriority);
+}
+
+void TriggeredMapThread::stopMap() {
+    stopIt_ = true;
+    wait();
+
+    refs_.clear();
+    for (auto d : takeResult())
+        delete d;
+}
+
+std::vector<VNodeTriggerData*> TriggeredMapThread::takeResult() {
+    assert(!isRunning());
+    std::vector<VNodeTriggerData*> res;
+    res.swap(result_);
+    return res;
+}
+
+// Runs in the background and only reads the references and writes the result
+void TriggeredMapThread::run() {
+    VServer::mapTriggered(refs_, result_, stopIt_);
+    std::vector<TriggeredRef>().swap(refs_);
+}
+
+// The result is handed over in the GUI thread, unless it was already taken by a panel needing it
+void TriggeredMapThread::slotFinished() {
+    if (!stopIt_ && !isRunning())
+        server_->finishTriggeredScan();
+}
@@ -10,9 +10,15 @@
 #ifndef TRIGGEREDSCANNER_HPP
 #define TRIGGEREDSCANNER_HPP
 
+#include <atomic>
+#include <string>
+#include <vector>
+
 #include <QObject>
+#include <QThread>
 
 class VNode;
+class VNodeTriggerData;
 class VServer;
 
 class TriggeredScanner : public QObject {
@@ -39,4 +45,39 @@ private:
     int batchSize_;
 };
 
+// A node or an event triggering another node. Collected in the GUI thread after a full scan, see
+// VServer::startTriggeredScan().
+struct TriggeredRef
+{
+    int trigger_;       // the index of the node triggering, or holding the event
+    int triggered_;     // the index of the triggered node
+    std::string event_; // empty when the node itself is the trigger
+};
+
+// Builds the trigger data of the nodes from the references in the background. It does not
+// access the nodes, the result is only handed over to them in the GUI thread.
+class TriggeredMapThread : public QThread {
+    Q_OBJECT
+
+public:
+    explicit TriggeredMapThread(VServer*);
+    ~TriggeredMapThread() override;
+
+    void startMap(std::vector<TriggeredRef>&& refs, std::size_t nodeNum);
+    void stopMap();
+    std::vector<VNodeTriggerData*> takeResult();
+
+protected Q_SLOTS:
+    void slotFinished();
+
+protected:
+    void run() override;
+
+private:
+    VServer* server_;
+    std::vector<TriggeredRef> refs_;
+    std::vector<VNodeTriggerData*> result_; // only accessed by the thread while it is running
+    std::atomic<bool> stopIt_{false};
+};
+
 #endif // TRIGGEREDSCANNER_HPP
@@ -10,6 +10,8 @@
 
 #include "VNode.hpp"
 
+#include <algorithm>
+
 #include <boost/algorithm/string.hpp>
 
 #include "AstCollateVNodesVisitor.hpp"
@@ -52,6 +54,10 @@ public:
     std::vector<int> data_;
     std::map<std::string, std::vector<int>> eventData_;
 
+    // The nodes this node was stored in as triggered. Used to remove the node when its
+    // trigger expressions change.
+    std::vector<int> triggers_;
+
     // std::vector<int> attr_;
 
     void get(VNode* node, TriggerCollector* tc) {
@@ -81,7 +87,15 @@ public:
         data_.push_back(triggeredNode->index());
     }
 
-    void add(VItem* triggered, VAttribute* trigger) {
+    // Used when the data is built from the references, see VServer::mapTriggered()
+    void add(int triggered, const std::string& event) {
+        if (event.empty())
+            data_.push_back(triggered);
+        else
+            eventData_[event].push_back(triggered);
+    }
+
+    bool add(VItem* triggered, VAttribute* trigger) {
         static VAttributeType* eventType = nullptr;
         if (!eventType)
             eventType = VAttributeType::find("event");
@@ -94,10 +108,49 @@ public:
         // We only store the events
         if (trigger->type() == eventType) {
             eventData_[trigger->strName()].push_back(triggeredNode->index());
+            return true;
         }
+        return false;
+    }
+
+    void remove(int triggered) {
+        data_.erase(std::remove(data_.begin(), data_.end(), triggered), data_.end());
+        for (auto& it : eventData_)
+            it.second.erase(std::remove(it.second.begin(), it.second.end(), triggered), it.second.end());
+    }
+
+    static VNodeTriggerData* get(VNodeTriggerData*& d) {
+        if (!d)
+            d = new VNodeTriggerData;
+        return d;
     }
 };
 
+// Collects the nodes and events triggering a node as references, which are turned into trigger
+// data outside the GUI thread
+class TriggeredRefCollector : public TriggerCollector {
+public:
+    TriggeredRefCollector(VNode* n, std::vector<TriggeredRef>& refs) : node_(n), refs_(refs) {}
+
+    bool add(VItem* trigger, VItem*, Mode) override {
+        static VAttributeType* eventType = VAttributeType::find("event");
+
+        if (VNode* n = trigger->isNode()) {
+            refs_.push_back({n->index(), node_->index(), std::string()});
+        }
+        // We only store the events
+        else if (VAttribute* a = trigger->isAttribute()) {
+            if (a->type() == eventType)
+                refs_.push_back({a->parent()->index(), node_->index(), a->strName()});
+        }
+        return false;
+    }
+
+private:
+    VNode* node_;
+    std::vector<TriggeredRef>& refs_;
+};
+
 #if 0
 class VNodeTriggerData
 {
@@ -964,30 +1017,40 @@ void VNode::clearTriggerData() {
     data_ = nullptr;
 }
 
+// Remove this node from the nodes it was stored in as triggered
+void VNode::removeTriggeredData() {
+    if (!data_)
+        return;
+
+    VServer* s = root();
+    for (int i : data_->triggers_) {
+        if (VNodeTriggerData* d = s->nodeAt(i)->data_)
+            d->remove(index_);
+    }
+    data_->triggers_.clear();
+}
+
 // These are called during the scan for triggered nodes
 void VNode::addTriggeredData(VItem* n) {
-    if (!data_)
-        data_ = new VNodeTriggerData;
+    VNodeTriggerData::get(data_)->add(n);
 
-    data_->add(n);
+    VNode* triggeredNode = n->isNode();
+    assert(triggeredNode);
+    VNodeTriggerData::get(triggeredNode->data_)->triggers_.push_back(index_);
 }
 
 void VNode::addTriggeredData(VItem* triggered, VAttribute* trigger) {
-    if (!data_)
-        data_ = new VNodeTriggerData;
-
     assert(trigger->parent() == this);
-    data_->add(triggered, trigger);
+    if (VNodeTriggerData::get(data_)->add(triggered, trigger)) {
+        VNode* triggeredNode = triggered->isNode();
+        VNodeTriggerData::get(triggeredNode->data_)->triggers_.push_back(index_);
+    }
 }
 
 // Collect the information about all the nodes this node or its attributes trigger
 void VNode::triggered(TriggerCollector* tlc, TriggeredScanner* scanner) {
-    if (scanner && !root()->triggeredScanned()) {
-        // unsigned int aNum=VAttribute::totalNum();
-        scanner->start(root());
-        root()->setTriggeredScanned(true);
-        // assert(aNum == VAttribute::totalNum());
-    }
+    if (scanner)
+        root()->updateTriggeredData(scanner);
 
     // Get the nodes directly triggered by this node
     if (data_)
@@ -1018,12 +1081,8 @@ void VNode::triggeredByChildren(VNode* n, VNode* p, TriggerCollector* tlc) {
 void VNode::triggeredByEvent(const std::string& name,
                              std::vector<std::string>& triggeredVec,
                              TriggeredScanner* scanner) {
-    if (scanner && !root()->triggeredScanned()) {
-        // unsigned int aNum=VAttribute::totalNum();
-        scanner->start(root());
-        root()->setTriggeredScanned(true);
-        // assert(aNum == VAttribute::totalNum());
-    }
+    if (scanner)
+        root()->updateTriggeredData(scanner);
 
     // Get the nodes directly triggered by this event
     if (data_)
@@ -1094,6 +1153,7 @@ VServer::VServer(ServerHandler* server)
 
 VServer::~VServer() {
     clear();
+    delete triggeredMapThread_;
 }
 
 int VServer::totalNumOfTopLevel(VNode* n) const {
@@ -1131,6 +1191,9 @@ int VServer::totalNumOfTopLevel(const std::string& name) const {
 
 // Clear the whole contents
 void VServer::clear() {
+    stopTriggeredScan();
+    triggeredChanges_.clear();
+
     if (totalNum_ == 0)
         return;
 
@@ -1319,7 +1382,9 @@ void VServer::endScan() {
         if (!defs)
             return;
 
-        bool hasNotifications = server_->conf()->notificationsEnabled();
+        // The notifications are checked against the state the tasks had before the tree was
+        // cleared. There is nothing to check against on the first load.
+        bool hasNotifications = server_->conf()->notificationsEnabled() && !prevNodeState_.empty();
 
         // Scan the suits.This will recursively scan all nodes in the tree.
         const std::vector<suite_ptr>& suites = defs->suiteVec();
@@ -1331,11 +1396,17 @@ void VServer::endScan() {
         }
     }
 
+    // The previous state is only needed while scanning
+    prevNodeState_.clear();
+
     if (totalNum_ > 0) {
         nodes_.reserve(totalNum_);
         collect(nodes_);
         for (size_t i = 0; i < nodes_.size(); i++)
             nodes_[i]->setIndex(i);
+
+        if (triggeredWanted_)
+            startTriggeredScan();
     }
 }
 
@@ -1434,13 +1505,15 @@ void VServer::beginUpdate(VNode* node, const std::vector<ecf::Aspect::Type>& asp
 
     for (auto it : aspect) {
         if (it == ecf::Aspect::ADD_REMOVE_ATTR) {
-            // we need to rescan the attributes belong to the node
+            // we need to rescan the attributes belong to the node. Triggers in other nodes
+            // might refer to the new attributes so the whole tree has to be mapped again.
             node->rescanAttr();
             clearNodeTriggerData();
             return;
         }
         else if (it == ecf::Aspect::EXPR_TRIGGER) {
-            clearNodeTriggerData();
+            // only this node needs to be mapped again
+            addTriggeredChange(node);
         }
     }
 
@@ -1662,10 +1735,118 @@ QString VServer::toolTip() {
 }
 
 void VServer::clearNodeTriggerData() {
+    stopTriggeredScan();
+
     triggeredScanned_ = false;
     std::size_t num   = nodes_.size();
     for (std::size_t i = 0; i < num; i++)
         nodes_[i]->clearTriggerData();
+
+    triggeredChanges_.clear();
+}
+
+// When the trigger data was already used it is mapped again after a full scan, so that it is
+// (mostly) ready when needed. The trigger ASTs are built and resolved lazily in the nodes and
+// the panels use them in the GUI thread, so the references are collected here, with the defs
+// locked. Only the trigger data is built from them in the background.
+void VServer::startTriggeredScan() {
+    stopTriggeredScan();
+    if (nodes_.empty())
+        return;
+
+    std::vector<TriggeredRef> refs;
+    {
+        ServerDefsAccess defsAccess(server_); // will reliquish its resources on destruction
+        for (auto n : nodes_) {
+            TriggeredRefCollector tc(n, refs);
+            n->triggers(&tc);
+        }
+    }
+
+    if (!triggeredMapThread_)
+        triggeredMapThread_ = new TriggeredMapThread(this);
+
+    triggeredMapping_ = true;
+    triggeredMapThread_->startMap(std::move(refs), nodes_.size());
+}
+
+void VServer::stopTriggeredScan() {
+    if (triggeredMapThread_)
+        triggeredMapThread_->stopMap();
+    triggeredMapping_ = false;
+}
+
+// Runs in TriggeredMapThread. Only the references and the result are accessed.
+void VServer::mapTriggered(const std::vector<TriggeredRef>& refs,
+                           std::vector<VNodeTriggerData*>& data,
+                           const std::atomic<bool>& stopIt) {
+    for (const auto& r : refs) {
+        if (stopIt)
+            return;
+
+        VNodeTriggerData::get(data[r.trigger_])->add(r.triggered_, r.event_);
+        VNodeTriggerData::get(data[r.triggered_])->triggers_.push_back(r.trigger_);
+    }
+}
+
+// Hand over the result of the background mapping to the nodes
+void VServer::finishTriggeredScan() {
+    if (!triggeredMapping_ || triggeredMapThread_->isRunning())
+        return;
+
+    std::vector<VNodeTriggerData*> data = triggeredMapThread_->takeResult();
+    triggeredMapping_                   = false;
+    if (data.size() != nodes_.size()) {
+        for (auto d : data)
+            delete d;
+        return;
+    }
+
+    for (std::size_t i = 0; i < nodes_.size(); i++) {
+        nodes_[i]->clearTriggerData();
+        nodes_[i]->data_ = data[i];
+    }
+    triggeredScanned_ = true;
+}
+
+// Record a node whose trigger expressions changed
+void VServer::addTriggeredChange(VNode* node) {
+    // Nothing is mapped yet. The next scan will see the change.
+    if (!triggeredScanned_ && !triggeredMapping_)
+        return;
+
+    if (std::find(triggeredChanges_.begin(), triggeredChanges_.end(), node->index()) == triggeredChanges_.end())
+        triggeredChanges_.push_back(node->index());
+}
+
+// Make the trigger data of the nodes up to date before it is used
+void VServer::updateTriggeredData(TriggeredScanner* scanner) {
+    triggeredWanted_ = true;
+
+    if (!triggeredScanned_) {
+        // Building the data from the references does not take long
+        if (triggeredMapping_) {
+            triggeredMapThread_->wait();
+            finishTriggeredScan();
+        }
+
+        // No background result is available, we have to do it here
+        if (!triggeredScanned_) {
+            clearNodeTriggerData();
+            scanner->start(this);
+            triggeredScanned_ = true;
+            return;
+        }
+    }
+
+    // Only the nodes whose trigger expressions changed since the scan are mapped again
+    for (int i : triggeredChanges_) {
+        VNode* n = nodes_[i];
+        n->removeTriggeredData();
+        TriggeredCollector tc(n);
+        n->triggers(&tc);
+    }
+    triggeredChanges_.clear();
 }
 
 void VServer::print() {
@@ -11,6 +11,7 @@
 #ifndef VNODE_HPP_
 #define VNODE_HPP_
 
+#include <atomic>
 #include <set>
 #include <vector>
 
@@ -25,6 +26,8 @@ class AttributeFilter;
 class IconFilter;
 class ServerHandler;
 class TriggerCollector;
+class TriggeredMapThread;
+struct TriggeredRef;
 class TriggeredScanner;
 class VAttributeType;
 class VServer;
@@ -199,6 +202,7 @@ public:
     void triggers(TriggerCollector*);
     void triggered(TriggerCollector* tlc, TriggeredScanner* scanner = nullptr);
     void clearTriggerData();
+    void removeTriggeredData();
     void addTriggeredData(VItem* n);
     void addTriggeredData(VItem* a, VAttribute* n);
     void triggeredByEvent(const std::string& name, std::vector<std::string>& triggeredVec, TriggeredScanner* scanner);
@@ -322,6 +326,13 @@ public:
     QString logOrCheckpointError() const;
 
     bool triggeredScanned() const { return triggeredScanned_; }
+    void updateTriggeredData(TriggeredScanner*);
+
+    // Called by TriggeredMapThread
+    static void mapTriggered(const std::vector<TriggeredRef>& refs,
+                             std::vector<VNodeTriggerData*>& data,
+                             const std::atomic<bool>& stopIt);
+    void finishTriggeredScan();
 
     void print() override;
 
@@ -331,6 +342,9 @@ protected:
     void endScan();
     void setTriggeredScanned(bool b) { triggeredScanned_ = b; }
     void clearNodeTriggerData();
+    void startTriggeredScan();
+    void stopTriggeredScan();
+    void addTriggeredChange(VNode*);
 
 private:
     void clear();
@@ -345,6 +359,10 @@ private:
     std::vector<int> totalNumInChild_;
     std::vector<VNode*> nodes_;
     bool triggeredScanned_;
+    TriggeredMapThread* triggeredMapThread_{nullptr};
+    bool triggeredWanted_{false};       // the trigger data was used since the server was loaded
+    bool triggeredMapping_{false};      // the trigger data is being mapped in the background
+    std::vector<int> triggeredChanges_; // nodes whose trigger expressions changed since the scan
 
     VServerCache cache_;
     std::vector<Variable> prevGenVars_;
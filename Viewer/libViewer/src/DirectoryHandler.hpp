@@ -25,6 +25,7 @@ public:
     static const std::string& etcDir() { return etcDir_; }
     static const std::string& configDir() { return configDir_; }
     static const std::string& rcDir() { return rcDir_; }
+    static const std::string& tmpDir() { return tmpDir_; }
     static const std::string& uiLogFileName() { return uiLogFile_; }
     static const std::string& uiEventLogFileName() { return uiEventLogFile_; }
     static const std::string& socketDir() { return socketDir_; }
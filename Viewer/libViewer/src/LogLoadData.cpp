@@ -10,7 +10,10 @@
 
 #include "LogLoadData.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <stdexcept>
+#include <thread>
 
 #include <QDateTime>
 #include <QFileInfo>
@@ -20,7 +23,8 @@
 #include "File.hpp"
 #include "File_r.hpp"
 #include "LogConsumer.hpp"
-#include "NodePath.hpp"
+#include "LogLoadParser.hpp"
+#include "MappedFile.hpp"
 #include "Str.hpp"
 #include "UIDebug.hpp"
 #include "UiLog.hpp"
@@ -49,36 +53,15 @@ void LogReqCounter::clear() {
     //        (*it).counter_=0;
 }
 
-void LogReqCounter::add(bool childCmd, const std::string& line) {
-    if (childCmd) {
+void LogReqCounter::add(bool childCmd, int subReqIndex) {
+    if (childCmd)
         childReq_++;
-        /*for(std::vector<LogRequestItem>::iterator it=childSubReq_.begin(); it != childSubReq_.end(); ++it)
-        {
-            if(line.find((*it).pattern_) != std::string::npos)
-            {
-                (*it).counter_++;
-                return;
-            }
-        }*/
-    }
-    else {
+    else
         userReq_++;
-        /*for(size_t i=0; i < userSubReq_.size(); i++)
-        {
-            if(line.find(userSubReq_[i].pattern_) != std::string::npos)
-            {
-                userSubReq_[i].counter_++;
-                return;
-            }
-        }*/
-    }
 
-    for (std::vector<LogRequestItem>::iterator it = subReq_.begin(); it != subReq_.end(); ++it) {
-        if (line.find((*it).pattern_) != std::string::npos) {
-            (*it).counter_++;
-            return;
-        }
-    }
+    // the index of the first sub request whose pattern matches the request
+    if (subReqIndex >= 0)
+        subReq_[subReqIndex].counter_++;
 }
 
 //=======================================================
@@ -446,6 +429,8 @@ void LogLoadDataItem::computeSubReqMax() {
 //
 //=======================================================
 
+size_t LogLoadData::parallelLoadThreshold_ = 16 * 1024 * 1024;
+
 void LogLoadData::clear() {
     numOfRows_ = 0;
     time_.clear();
@@ -988,189 +973,195 @@ void LogLoadData::loadLogFileCore(const std::string& logFile,
     ///   XXX:[HH:MM:SS D.M.YYYY] --begin  [+additional information]
     /// -------------:
 
-    /// The log file can be massive > 50Mb
-    ecf::File_r log_file(logFile);
+    /// The log file can be massive > 5Gb, hence it is mapped rather than read
+    ecf::MappedFile log_file(logFile);
     if (!log_file.ok()) {
         loadStatus_ = LoadFailed;
         UiLog().warn() << "LogLoadData::loadLogFileCore: Could not open log file " << logFile;
         throw std::runtime_error("Could not open log file: " + logFile);
     }
 
-    fullRead_ = true;
-    QFileInfo fInfo(QString::fromStdString(logFile));
-    size_t fSize         = fInfo.size();
-    size_t progressChunk = fSize / 200;
-    if (progressChunk == 0)
-        progressChunk = fSize;
-    size_t currentProgressChunk = 0;
-    size_t percent              = 0;
-
+    fullRead_          = true;
+    loadedFile_        = logFile;
+    loadedSize_        = 0;
+    loadedPartialLine_ = false;
+    size_t fSize       = log_file.size();
     if (fSize == 0)
         return;
 
+    size_t startPos = 0;
     if (maxReadSize_ > 0) {
         if (fSize > maxReadSize_) {
-            fullRead_     = false;
-            progressChunk = maxReadSize_ / 200;
-            log_file.setPos(fSize - maxReadSize_);
+            fullRead_ = false;
+            startPos  = fSize - maxReadSize_;
         }
     }
 
-    std::string line;
-    std::string delimiter(";");
+    loadRange(log_file.view(), startPos, false, logConsumer);
+}
 
-    while (log_file.good()) {
-        log_file.getline(line); // default delimiter is /n
+bool LogLoadData::loadLogFileTail(const std::string& logFile, LogConsumer* logConsumer) {
+    // The incomplete line parsed last can not be completed, hence the file must be parsed again
+    if (loadStatus_ == LoadFailed || logFile != loadedFile_ || loadedPartialLine_)
+        return false;
 
-        if (logConsumer) {
-            logConsumer->addLogLine(line);
-        }
+    ecf::MappedFile log_file(logFile);
+    if (!log_file.ok() || log_file.size() < loadedSize_)
+        return false;
 
-        // The log file format we are interested is :
+    size_t suiteNum = parseHelper_.suite_vec.size();
+    loadRange(log_file.view(), loadedSize_, true, logConsumer);
 
-        // MSG:[HH:MM:SS D.M.YYYY] chd:fullname [path +additional information]
-        // MSG:[HH:MM:SS D.M.YYYY] --begin      [args | path(optional) ]    :<user>@<host> [extra info]
+    for (size_t i = suiteNum; i < parseHelper_.suite_vec.size(); i++) {
+        suites_ << QString::fromStdString(parseHelper_.suite_vec[i].name_);
+    }
 
-        // Here are some USER COMMAND examples:
-        //  MSG:[13:53:56 4.10.2018] --run /test_client_run; --sync=0 1435 442 :user@host
-        //  MSG:[13:54:07 4.10.2018] --alter sort variable recursive /; --sync=0 1789 636 :user@host
-        //  MSG:[22:44:04 9.5.2020] --news=4 66603 46 :user@host [:NO_NEWS]
-        //  MSG:[22:44:38 9.5.2020] --news=1 115744 184 :user@host [server handle(115752,184) server(115752,184) :
-        //  *Small* scale changes :NEWS] MSG:[11:03:37 26.6.2020] --alter change variable GIT_TAG
-        //  hotfix/%METVIEW_VERSION% /metview; --sync=35 246693 515 :user@host
+    // the stats for the full period are no longer valid
+    fullStatComputed_ = false;
+    computeInitialStat();
+    return true;
+}
 
-        // We are only interested in Commands (i.e MSG:), and not state changes
-        if (line.empty() || line[0] != 'M')
-            continue;
+// Parse the lines from startPos. The text is split into chunks that are parsed in
+// parallel, the chunks are then added in file order, hence the result is the same as
+// parsing the lines one by one.
+void LogLoadData::loadRange(boost::string_view logText,
+                            size_t startPos,
+                            bool wholeLinesOnly,
+                            LogConsumer* logConsumer) {
+    // A tail load leaves an incomplete last line, i.e. still being written by the server, for
+    // the next tail load. A full load parses it, the file may just not end with a newline.
+    size_t endPos = logText.size();
+    if (wholeLinesOnly) {
+        endPos = logText.rfind('\n');
+        if (endPos == boost::string_view::npos)
+            return;
+        endPos++;
+    }
+    if (endPos <= startPos)
+        return;
+    loadedSize_        = endPos;
+    loadedPartialLine_ = (logText[endPos - 1] != '\n');
 
-        std::string::size_type msg_pos = line.find("MSG:");
-        if (msg_pos != 0)
-            continue;
+    boost::string_view text = logText.substr(startPos, endPos - startPos);
 
-        bool child_cmd = false;
-        bool user_cmd  = false;
-        if (line.find(ecf::Str::CHILD_CMD()) != std::string::npos) {
-            child_cmd = true;
-        }
-        else if (line.find(ecf::Str::USER_CMD()) != std::string::npos) {
-            user_cmd = true;
+    std::vector<std::string> subReqPatterns;
+    {
+        std::vector<LogRequestItem> subReq;
+        LogLoadDataItem::buildSubReq(subReq);
+        for (const auto& item : subReq)
+            subReqPatterns.push_back(item.pattern_);
+    }
+    LogLoadParser parser(subReqPatterns);
+
+    // The chunks are parsed in batches, to limit the memory used by the parsed requests
+    const size_t maxChunkSize = 32 * 1024 * 1024;
+    size_t numOfThreads       = 1;
+    if (parallelLoadThreshold_ > 0 && text.size() >= parallelLoadThreshold_)
+        numOfThreads = std::max(1u, std::thread::hardware_concurrency());
+    size_t numOfChunks = (numOfThreads == 1) ? 1 : std::max(numOfThreads, text.size() / maxChunkSize + 1);
+
+    std::vector<boost::string_view> ranges = LogLoadParser::split(text, numOfChunks);
+    std::vector<LogLoadChunk> chunks(std::min(numOfThreads, ranges.size()));
+
+    for (size_t batchStart = 0; batchStart < ranges.size(); batchStart += chunks.size()) {
+        size_t batchSize = std::min(chunks.size(), ranges.size() - batchStart);
+        if (batchSize == 1) {
+            chunks[0].clear();
+            parser.parse(ranges[batchStart], chunks[0]);
         }
-
-        if (!child_cmd && !user_cmd)
-            continue;
-
-        // lines containing multiple items separated by ";" share the same uid, so we
-        // extract it before the splitting
-        std::string uid;
-        if (user_cmd) {
-            extract_uid(line, uid);
+        else {
+            std::atomic<size_t> next(0);
+            auto worker = [&]() {
+                for (size_t i = next++; i < batchSize; i = next++) {
+                    chunks[i].clear();
+                    parser.parse(ranges[batchStart + i], chunks[i]);
+                }
+            };
+            std::vector<std::thread> threads;
+            for (size_t i = 1; i < batchSize; i++)
+                threads.emplace_back(worker);
+            worker();
+            for (auto& t : threads)
+                t.join();
         }
 
-        parseHelper_.new_time_stamp.clear();
-        {
-            /// MSG:[HH:MM:SS D.M.YYYY] chd:fullname [+additional information] ---> HH:MM:SS D.M.YYYY
-            /// EXTRACT the date
-            std::string::size_type first_open_bracket = line.find('[');
-            if (first_open_bracket == std::string::npos) {
-                // std::cout << line << "\n";
-                // assert(false);
-                continue;
-            }
-            line.erase(0, first_open_bracket + 1);
-
-            std::string::size_type first_closed_bracket = line.find(']');
-            if (first_closed_bracket == std::string::npos) {
-                // std::cout << line << "\n";
-                // assert(false);
-                continue;
+        for (size_t i = 0; i < batchSize; i++) {
+            boost::string_view range = ranges[batchStart + i];
+            if (logConsumer) {
+                size_t pos = 0;
+                while (pos < range.size()) {
+                    size_t nl = range.find('\n', pos);
+                    if (nl == boost::string_view::npos)
+                        nl = range.size();
+                    logConsumer->addLogLine(std::string(range.data() + pos, nl - pos));
+                    pos = nl + 1;
+                }
             }
-            std::string time_stamp = line.substr(0, first_closed_bracket);
 
-            ecf::Str::split(time_stamp, parseHelper_.new_time_stamp);
-            if (parseHelper_.new_time_stamp.size() != 2)
-                continue;
+            addChunk(chunks[i]);
 
-            line.erase(0, first_closed_bracket + 1);
+            size_t current = range.data() + range.size() - logText.data();
+            Q_EMIT loadProgress(current, logText.size());
         }
+    }
+}
 
-        size_t current = log_file.pos();
-        if (current / progressChunk > currentProgressChunk) {
-            currentProgressChunk = current / progressChunk;
-            percent              = current / fSize;
-            if (percent <= 100)
-                Q_EMIT loadProgress(current, fSize);
+// Add the requests of a chunk to the per second data
+void LogLoadData::addChunk(const LogLoadChunk& chunk) {
+    // The suite and uid indexes of the chunk, mapped to those of parseHelper_
+    std::vector<int> suiteIndex(chunk.suites_.size(), -1);
+    std::vector<int> uidIndex(chunk.uids_.size(), -1);
+    auto counterIndex = [](std::vector<LogReqCounter>& counters, const std::string& name) {
+        for (size_t n = 0; n < counters.size(); n++) {
+            if (counters[n].name_ == name)
+                return static_cast<int>(n);
         }
-
-        numOfRows_++;
-
-        std::vector<std::string> items;
-        ecf::Str::split(line, items, delimiter);
-        for (size_t i = 0; i < items.size(); ++i) {
-            // Should be just left with " chd:<child command> " or " --<user command>, since we have removed the time
-            // stamp
-            // #ifdef DEBUG
-            //       std::cout << line << "\n";
-            // #endif
-            line      = items[i];
-            child_cmd = false;
-            user_cmd  = false;
-            if (line.find(ecf::Str::CHILD_CMD()) != std::string::npos) {
-                child_cmd = true;
-            }
-            else if (line.find(ecf::Str::USER_CMD()) != std::string::npos) {
-                user_cmd = true;
-                if (i > 0 && line.find("--sync") != std::string::npos)
-                    continue;
-            }
-
-            if (!child_cmd && !user_cmd)
-                continue;
-
-            if (parseHelper_.old_time_stamp.empty() ||
-                parseHelper_.old_time_stamp[0] == parseHelper_.new_time_stamp[0]) {
-                parseHelper_.total.add(child_cmd, line);
-
-                // Extract path if any, to determine the suite most contributing to server load
-                size_t column_index = 0;
-                extract_suite_path(line, child_cmd, parseHelper_.suite_vec, column_index);
-                if (user_cmd && !uid.empty()) {
-                    extract_uid_data(line, uid, parseHelper_.uid_vec);
-                }
-                // if ( suite_path_found )
-                //     assert(suite_vec[column_index].request_per_second_ <= (child_requests_per_second +
-                //     user_request_per_second) );
-            }
-            else {
+        counters.emplace_back(name);
+        return static_cast<int>(counters.size() - 1);
+    };
+
+    size_t itemStart = 0;
+    for (const auto& line : chunk.lines_) {
+        const std::vector<std::string>& new_time_stamp = chunk.timeStamps_[line.timeStamp_];
+        for (size_t i = itemStart; i < line.itemEnd_; i++) {
+            const LogLoadChunk::Item& item = chunk.items_[i];
+            if (!parseHelper_.old_time_stamp.empty() && parseHelper_.old_time_stamp[0] != new_time_stamp[0]) {
                 // Add collected data to the storage objects
                 add(parseHelper_.old_time_stamp, parseHelper_.total, parseHelper_.suite_vec, parseHelper_.uid_vec);
 
                 // clear request per second
                 parseHelper_.total.clear();
 
-                for (auto& i : parseHelper_.suite_vec) {
-                    i.clear();
+                for (auto& counter : parseHelper_.suite_vec) {
+                    counter.clear();
                 }
-                for (auto& i : parseHelper_.uid_vec) {
-                    i.clear();
+                for (auto& counter : parseHelper_.uid_vec) {
+                    counter.clear();
                 }
+            }
 
-                // start of *new* time
-                parseHelper_.total.add(child_cmd, line); //?
+            parseHelper_.total.add(item.childCmd_, item.subReq_);
 
-                size_t column_index = 0;
-                extract_suite_path(line, child_cmd, parseHelper_.suite_vec, column_index);
-                // if ( suite_path_found )
-                //     assert(suite_vec[column_index].request_per_second_ <= (child_requests_per_second +
-                //     user_request_per_second) );
-                if (user_cmd && !uid.empty()) {
-                    extract_uid_data(line, uid, parseHelper_.uid_vec);
-                }
+            // the suite most contributing to server load
+            if (suiteIndex[item.suite_] < 0)
+                suiteIndex[item.suite_] = counterIndex(parseHelper_.suite_vec, chunk.suites_[item.suite_]);
+            parseHelper_.suite_vec[suiteIndex[item.suite_]].add(item.childCmd_, item.subReq_);
+
+            // collect uid based stats for user requests!
+            if (item.uid_ >= 0) {
+                if (uidIndex[item.uid_] < 0)
+                    uidIndex[item.uid_] = counterIndex(parseHelper_.uid_vec, chunk.uids_[item.uid_]);
+                parseHelper_.uid_vec[uidIndex[item.uid_]].add(false, item.subReq_);
             }
         }
-        parseHelper_.old_time_stamp = parseHelper_.new_time_stamp;
+        itemStart = line.itemEnd_;
+
+        if (parseHelper_.old_time_stamp != new_time_stamp)
+            parseHelper_.old_time_stamp = new_time_stamp;
     }
 
-    //    UiLog().dbg() << "REQCNT " << REQCNT;
+    numOfRows_ += static_cast<int>(chunk.lines_.size());
 }
 
 std::streamoff LogLoadData::getStartPos(const std::string& logFile, int numOfRows) {
@@ -1220,155 +1211,3 @@ std::streamoff LogLoadData::getStartPos(const std::string& logFile, int numOfRow
 
     return startPos;
 }
-
-void LogLoadData::extract_uid(const std::string& line, std::string& uid) {
-    std::string::size_type uidStart = line.find(" :");
-
-    if (uidStart != std::string::npos) {
-        uidStart += 2;
-        for (size_t i = uidStart; i < line.size(); i++) {
-            if (line[i] == ' ') {
-                if (i > uidStart + 1) {
-                    uid = line.substr(uidStart, i - uidStart);
-                }
-                break;
-            }
-            else if (line[i] == ';') {
-                if (i > uidStart + 1) {
-                    uid = line.substr(uidStart, i - uidStart);
-                }
-                break;
-            }
-            else if (line[i] == ':') {
-                if (i >= uidStart + 5 && line.substr(i - 3, 4) == "ERR:") {
-                    uid = line.substr(uidStart, i - uidStart - 3);
-                }
-                break;
-            }
-        }
-
-        if (uid.empty() && line.size() - uidStart >= 2) {
-            uid = line.substr(uidStart);
-        }
-    }
-}
-
-void LogLoadData::extract_uid_data(const std::string& line,
-                                   const std::string& uid,
-                                   std::vector<LogReqCounter>& uid_vec) {
-    // collect uid based stats for user requests!
-    if (!uid.empty()) {
-        for (size_t i = 0; i < uid_vec.size(); i++) {
-            if (uid_vec[i].name_ == uid) {
-                uid_vec[i].add(false, line);
-                return;
-            }
-        }
-
-        uid_vec.emplace_back(uid);
-        uid_vec.back().add(false, line);
-    }
-}
-
-bool LogLoadData::extract_suite_path(const std::string& line,
-                                     bool child_cmd,
-                                     std::vector<LogReqCounter>& suite_vec,
-                                     size_t& column_index // 0 based
-) {
-    // line should be either:
-    //  chd:<childcommand> path
-    //  --<user command> [args]   path<optional> :<user>
-    // special cases:
-    //  --begin=suite
-    //  --cancel=suite
-    //  --zombie_*=path
-
-    std::string suite_name("<no_suite>");
-    static std::vector<std::string> specialCmd = {"--begin=", "--cancel="};
-    bool hasSuiteName                          = false;
-    if (!child_cmd) {
-        if (line.find("--news") != std::string::npos || line.find("--load") != std::string::npos)
-            hasSuiteName = true;
-        else {
-            for (auto cmd : specialCmd) {
-                std::size_t pos = line.find(cmd);
-                if (pos != std::string::npos) {
-                    pos += cmd.length();
-                    // find the space after the path
-                    size_t space_pos = line.find(" ", pos);
-                    if (space_pos != std::string::npos && space_pos > pos) {
-                        suite_name = line.substr(pos, space_pos - pos);
-                        if (suite_name.size() > 1 && suite_name[suite_name.size() - 1] == ';') {
-                            suite_name.resize(suite_name.size() - 1);
-                        }
-                        hasSuiteName = true;
-                        break;
-                    }
-                }
-            }
-        }
-    }
-
-    if (!hasSuiteName) {
-        // Our assumption is that the path is the last seting starting with "/" preceded by a whitespace
-        size_t forward_slash = line.rfind(" /");
-        if (forward_slash != std::string::npos) {
-            forward_slash += 1;
-            std::string path;
-            if (child_cmd) {
-                // For labels ignore paths in the label part
-                // MSG:[14:55:04 17.10.2013] chd:label progress 'core/nodeattr/nodeAParser'
-                // /suite/build/cray/cray_gnu/build_release/test
-                if (line.find("chd:label") != std::string::npos) {
-                    size_t last_tick = line.rfind("'");
-                    if (last_tick != std::string::npos) {
-                        size_t the_forward_slash = line.find('/', last_tick);
-                        if (the_forward_slash != std::string::npos) {
-                            forward_slash = the_forward_slash;
-                        }
-                    }
-                }
-                path = line.substr(forward_slash);
-            }
-
-            // find the space after the path
-            size_t space_pos = line.find(" ", forward_slash + 1);
-            if (space_pos != std::string::npos && space_pos > forward_slash) {
-                path = line.substr(forward_slash, space_pos - forward_slash);
-                if (path.size() > 1 && path[path.size() - 1] == ';') {
-                    path.resize(path.size() - 1);
-                }
-            }
-
-            if (!path.empty()) {
-                if (path.find(":") != std::string::npos) {
-                    std::vector<std::string> pathParts;
-                    ecf::Str::split(path, pathParts, ":");
-                    if (pathParts.size() > 1) {
-                        path = pathParts[0];
-                    }
-                }
-
-                std::vector<std::string> theNodeNames;
-                theNodeNames.reserve(4);
-                NodePath::split(path, theNodeNames);
-                if (!theNodeNames.empty()) {
-                    suite_name = theNodeNames[0];
-                }
-            }
-        }
-    }
-
-    for (size_t n = 0; n < suite_vec.size(); n++) {
-        if (suite_vec[n].name_ == suite_name) {
-            suite_vec[n].add(child_cmd, line);
-            column_index = n;
-            return true;
-        }
-    }
-
-    suite_vec.emplace_back(suite_name);
-    column_index = suite_vec.size() - 1;
-    suite_vec[column_index].add(child_cmd, line);
-    return true;
-}
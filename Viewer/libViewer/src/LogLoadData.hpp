@@ -15,6 +15,8 @@
 #include <string>
 #include <vector>
 
+#include <boost/utility/string_view.hpp>
+
 #include <QAbstractItemModel>
 #include <QGraphicsItem>
 #include <QMap>
@@ -29,6 +31,7 @@ using namespace QtCharts;
 class LogLoadData;
 class LogLoadDataItem;
 class LogConsumer;
+struct LogLoadChunk;
 
 struct LogLoadStatItem
 {
@@ -82,7 +85,7 @@ struct LogReqCounter
     LogReqCounter(const std::string& name);
 
     void clear();
-    void add(bool childCmd, const std::string& line);
+    void add(bool childCmd, int subReqIndex);
 
     std::string name_; // used for suites
     size_t childReq_;
@@ -153,7 +156,6 @@ struct LogDataParseHelper
     // A collector for uid related data
     std::vector<LogReqCounter> uid_vec;
 
-    std::vector<std::string> new_time_stamp;
     std::vector<std::string> old_time_stamp;
 
     std::map<std::string, size_t> uidCnt;
@@ -176,6 +178,15 @@ public:
                           bool last,
                           LogConsumer*);
 
+    // Parse only the lines appended to the log file since it was loaded. Returns false if the
+    // file is not the one loaded last, has been truncated, or the load ended in an incomplete
+    // line, in which case it must be reloaded.
+    bool loadLogFileTail(const std::string& logFile, LogConsumer*);
+
+    // Log files larger than this are parsed in parallel, 0 disables it
+    static void setParallelLoadThreshold(size_t bytes) { parallelLoadThreshold_ = bytes; }
+    static size_t parallelLoadThreshold() { return parallelLoadThreshold_; }
+
     QDateTime loadedAt() const { return loadedAt_; }
     void clear();
     const LogLoadDataItem& dataItem() const { return total_; }
@@ -229,6 +240,8 @@ private:
                          const std::vector<std::string>& suites,
                          bool multi,
                          LogConsumer*);
+    void loadRange(boost::string_view logText, size_t startPos, bool wholeLinesOnly, LogConsumer*);
+    void addChunk(const LogLoadChunk&);
     std::streamoff getStartPos(const std::string& logFile, int numOfRows);
     void getSeries(QLineSeries& series, const LogRequestItem& item, int& maxVal);
     void getSeries(QLineSeries& series, const std::vector<int>& vals, int& maxVal);
@@ -241,14 +254,6 @@ private:
     void computeInitialStat();
     void computeStat(std::vector<LogLoadDataItem>& items, size_t startIndex, size_t endIndex, bool fullPeriod);
 
-    void extract_uid(const std::string& line, std::string& uid);
-    //    bool extract_uid_data(const std::string& line,std::vector<LogReqCounter>& uid_vec);
-    void extract_uid_data(const std::string& line, const std::string& uid, std::vector<LogReqCounter>& uid_vec);
-    bool extract_suite_path(const std::string& line,
-                            bool child_cmd,
-                            std::vector<LogReqCounter>& suite_vec,
-                            size_t& column_index);
-
     TimeRes timeRes_{SecondResolution};
     std::vector<qint64> time_; // times stored as msecs since the epoch
 
@@ -265,6 +270,11 @@ private:
     LoadStatus loadStatus_{LoadNotTried};
     std::streamoff startPos_{0};
     LogDataParseHelper parseHelper_;
+    std::string loadedFile_;        // the log file parsed last
+    size_t loadedSize_{0};          // the part of loadedFile_ already parsed
+    bool loadedPartialLine_{false}; // the parsed part ends in an incomplete line
+
+    static size_t parallelLoadThreshold_;
 };
 
 #endif // LOGLOADDATA_HPP
@@ -0,0 +1,293 @@
+//============================================================================
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+//============================================================================
+
+#include "LogLoadParser.hpp"
+
+#include "NodePath.hpp"
+#include "Str.hpp"
+
+static int indexOf(std::vector<std::string>& names, const std::string& name) {
+    for (size_t i = 0; i < names.size(); i++) {
+        if (names[i] == name)
+            return static_cast<int>(i);
+    }
+    names.push_back(name);
+    return static_cast<int>(names.size() - 1);
+}
+
+void LogLoadChunk::clear() {
+    timeStamps_.clear();
+    lines_.clear();
+    items_.clear();
+    suites_.clear();
+    uids_.clear();
+}
+
+std::vector<boost::string_view> LogLoadParser::split(boost::string_view text, size_t num) {
+    std::vector<boost::string_view> ranges;
+    if (num == 0)
+        num = 1;
+
+    size_t begin = 0;
+    for (size_t i = 1; i <= num && begin < text.size(); i++) {
+        size_t end = (i == num) ? text.size() : (text.size() / num) * i;
+        if (end < begin)
+            end = begin;
+
+        // The ranges must end on a line boundary
+        if (end < text.size()) {
+            size_t nl = text.find('\n', end);
+            end       = (nl == boost::string_view::npos) ? text.size() : nl + 1;
+        }
+        if (end > begin)
+            ranges.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+    return ranges;
+}
+
+void LogLoadParser::parse(boost::string_view text, LogLoadChunk& chunk) const {
+    std::string line;
+    std::string prevTimeStamp;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t nl  = text.find('\n', pos);
+        size_t end = (nl == boost::string_view::npos) ? text.size() : nl;
+        boost::string_view lineView(text.data() + pos, end - pos);
+        pos = end + 1;
+
+        // We are only interested in Commands (i.e MSG:), and not state changes
+        if (!lineView.starts_with("MSG:"))
+            continue;
+
+        line.assign(lineView.data(), lineView.size());
+        parseLine(line, chunk, prevTimeStamp);
+    }
+}
+
+void LogLoadParser::parseLine(std::string& line, LogLoadChunk& chunk, std::string& prevTimeStamp) const {
+    // The log file format we are interested is :
+
+    // MSG:[HH:MM:SS D.M.YYYY] chd:fullname [path +additional information]
+    // MSG:[HH:MM:SS D.M.YYYY] --begin      [args | path(optional) ]    :<user>@<host> [extra info]
+
+    // Here are some USER COMMAND examples:
+    //  MSG:[13:53:56 4.10.2018] --run /test_client_run; --sync=0 1435 442 :user@host
+    //  MSG:[13:54:07 4.10.2018] --alter sort variable recursive /; --sync=0 1789 636 :user@host
+    //  MSG:[22:44:04 9.5.2020] --news=4 66603 46 :user@host [:NO_NEWS]
+
+    bool child_cmd = false;
+    bool user_cmd  = false;
+    if (line.find(ecf::Str::CHILD_CMD()) != std::string::npos) {
+        child_cmd = true;
+    }
+    else if (line.find(ecf::Str::USER_CMD()) != std::string::npos) {
+        user_cmd = true;
+    }
+
+    if (!child_cmd && !user_cmd)
+        return;
+
+    // lines containing multiple items separated by ";" share the same uid, so we
+    // extract it before the splitting
+    std::string uid;
+    if (user_cmd) {
+        extract_uid(line, uid);
+    }
+
+    {
+        /// MSG:[HH:MM:SS D.M.YYYY] chd:fullname [+additional information] ---> HH:MM:SS D.M.YYYY
+        /// EXTRACT the date
+        std::string::size_type first_open_bracket = line.find('[');
+        if (first_open_bracket == std::string::npos)
+            return;
+        line.erase(0, first_open_bracket + 1);
+
+        std::string::size_type first_closed_bracket = line.find(']');
+        if (first_closed_bracket == std::string::npos)
+            return;
+
+        // Most consecutive lines are logged in the same second
+        if (chunk.timeStamps_.empty() || line.compare(0, first_closed_bracket, prevTimeStamp) != 0) {
+            std::string time_stamp = line.substr(0, first_closed_bracket);
+            std::vector<std::string> new_time_stamp;
+            ecf::Str::split(time_stamp, new_time_stamp);
+            if (new_time_stamp.size() != 2)
+                return;
+
+            chunk.timeStamps_.push_back(std::move(new_time_stamp));
+            prevTimeStamp = time_stamp;
+        }
+
+        line.erase(0, first_closed_bracket + 1);
+    }
+
+    std::vector<std::string> items;
+    ecf::Str::split(line, items, ";");
+    for (size_t i = 0; i < items.size(); ++i) {
+        // Should be just left with " chd:<child command> " or " --<user command>, since we have removed the time
+        // stamp
+        const std::string& item = items[i];
+        child_cmd               = false;
+        user_cmd                = false;
+        if (item.find(ecf::Str::CHILD_CMD()) != std::string::npos) {
+            child_cmd = true;
+        }
+        else if (item.find(ecf::Str::USER_CMD()) != std::string::npos) {
+            user_cmd = true;
+            if (i > 0 && item.find("--sync") != std::string::npos)
+                continue;
+        }
+
+        if (!child_cmd && !user_cmd)
+            continue;
+
+        LogLoadChunk::Item req;
+        req.childCmd_ = child_cmd;
+        req.subReq_   = subReqIndex(item);
+        req.suite_    = indexOf(chunk.suites_, extract_suite_name(item, child_cmd));
+        if (user_cmd && !uid.empty())
+            req.uid_ = indexOf(chunk.uids_, uid);
+        chunk.items_.push_back(req);
+    }
+
+    LogLoadChunk::Line reqLine;
+    reqLine.timeStamp_ = chunk.timeStamps_.size() - 1;
+    reqLine.itemEnd_   = chunk.items_.size();
+    chunk.lines_.push_back(reqLine);
+}
+
+int LogLoadParser::subReqIndex(const std::string& line) const {
+    for (size_t i = 0; i < subReqPatterns_.size(); i++) {
+        if (line.find(subReqPatterns_[i]) != std::string::npos)
+            return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void LogLoadParser::extract_uid(const std::string& line, std::string& uid) {
+    std::string::size_type uidStart = line.find(" :");
+
+    if (uidStart != std::string::npos) {
+        uidStart += 2;
+        for (size_t i = uidStart; i < line.size(); i++) {
+            if (line[i] == ' ') {
+                if (i > uidStart + 1) {
+                    uid = line.substr(uidStart, i - uidStart);
+                }
+                break;
+            }
+            else if (line[i] == ';') {
+                if (i > uidStart + 1) {
+                    uid = line.substr(uidStart, i - uidStart);
+                }
+                break;
+            }
+            else if (line[i] == ':') {
+                if (i >= uidStart + 5 && line.substr(i - 3, 4) == "ERR:") {
+                    uid = line.substr(uidStart, i - uidStart - 3);
+                }
+                break;
+            }
+        }
+
+        if (uid.empty() && line.size() - uidStart >= 2) {
+            uid = line.substr(uidStart);
+        }
+    }
+}
+
+std::string LogLoadParser::extract_suite_name(const std::string& line, bool child_cmd) {
+    // line should be either:
+    //  chd:<childcommand> path
+    //  --<user command> [args]   path<optional> :<user>
+    // special cases:
+    //  --begin=suite
+    //  --cancel=suite
+    //  --zombie_*=path
+
+    std::string suite_name("<no_suite>");
+    static const std::vector<std::string> specialCmd = {"--begin=", "--cancel="};
+    bool hasSuiteName                                = false;
+    if (!child_cmd) {
+        if (line.find("--news") != std::string::npos || line.find("--load") != std::string::npos)
+            hasSuiteName = true;
+        else {
+            for (const auto& cmd : specialCmd) {
+                std::size_t pos = line.find(cmd);
+                if (pos != std::string::npos) {
+                    pos += cmd.length();
+                    // find the space after the path
+                    size_t space_pos = line.find(" ", pos);
+                    if (space_pos != std::string::npos && space_pos > pos) {
+                        suite_name = line.substr(pos, space_pos - pos);
+                        if (suite_name.size() > 1 && suite_name[suite_name.size() - 1] == ';') {
+                            suite_name.resize(suite_name.size() - 1);
+                        }
+                        hasSuiteName = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    if (!hasSuiteName) {
+        // Our assumption is that the path is the last seting starting with "/" preceded by a whitespace
+        size_t forward_slash = line.rfind(" /");
+        if (forward_slash != std::string::npos) {
+            forward_slash += 1;
+            std::string path;
+            if (child_cmd) {
+                // For labels ignore paths in the label part
+                // MSG:[14:55:04 17.10.2013] chd:label progress 'core/nodeattr/nodeAParser'
+                // /suite/build/cray/cray_gnu/build_release/test
+                if (line.find("chd:label") != std::string::npos) {
+                    size_t last_tick = line.rfind("'");
+                    if (last_tick != std::string::npos) {
+                        size_t the_forward_slash = line.find('/', last_tick);
+                        if (the_forward_slash != std::string::npos) {
+                            forward_slash = the_forward_slash;
+                        }
+                    }
+                }
+                path = line.substr(forward_slash);
+            }
+
+            // find the space after the path
+            size_t space_pos = line.find(" ", forward_slash + 1);
+            if (space_pos != std::string::npos && space_pos > forward_slash) {
+                path = line.substr(forward_slash, space_pos - forward_slash);
+                if (path.size() > 1 && path[path.size() - 1] == ';') {
+                    path.resize(path.size() - 1);
+                }
+            }
+
+            if (!path.empty()) {
+                if (path.find(":") != std::string::npos) {
+                    std::vector<std::string> pathParts;
+                    ecf::Str::split(path, pathParts, ":");
+                    if (pathParts.size() > 1) {
+                        path = pathParts[0];
+                    }
+                }
+
+                std::vector<std::string> theNodeNames;
+                theNodeNames.reserve(4);
+                NodePath::split(path, theNodeNames);
+                if (!theNodeNames.empty()) {
+                    suite_name = theNodeNames[0];
+                }
+            }
+        }
+    }
+
+    return suite_name;
+}
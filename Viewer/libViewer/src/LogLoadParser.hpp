@@ -0,0 +1,67 @@
+//============================================================================
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+//============================================================================
+
+#ifndef LOGLOADPARSER_HPP
+#define LOGLOADPARSER_HPP
+
+#include <string>
+#include <vector>
+
+#include <boost/utility/string_view.hpp>
+
+// The requests found in a range of lines of the server log. The text processing is
+// done here, so that ranges can be parsed in parallel. Merging the chunks, in file
+// order, into the per second data only has to count the items.
+struct LogLoadChunk
+{
+    struct Item
+    {
+        int suite_{-1};  // index into suites_
+        int uid_{-1};    // index into uids_, -1 when the request has no uid
+        int subReq_{-1}; // index of the first matching sub request pattern, -1 if none match
+        bool childCmd_{false};
+    };
+
+    struct Line
+    {
+        size_t timeStamp_{0}; // index into timeStamps_
+        size_t itemEnd_{0};   // the items of this line end here in items_
+    };
+
+    void clear();
+
+    std::vector<std::vector<std::string>> timeStamps_; // consecutive lines with the same time stamp share it
+    std::vector<Line> lines_;                          // only the lines with user or child commands
+    std::vector<Item> items_;
+    std::vector<std::string> suites_; // in order of first appearance
+    std::vector<std::string> uids_;   // in order of first appearance
+};
+
+class LogLoadParser {
+public:
+    explicit LogLoadParser(const std::vector<std::string>& subReqPatterns) : subReqPatterns_(subReqPatterns) {}
+
+    // Parse the complete lines in text
+    void parse(boost::string_view text, LogLoadChunk& chunk) const;
+
+    // Split text into about num ranges of whole lines
+    static std::vector<boost::string_view> split(boost::string_view text, size_t num);
+
+    static void extract_uid(const std::string& line, std::string& uid);
+    static std::string extract_suite_name(const std::string& line, bool child_cmd);
+
+private:
+    void parseLine(std::string& line, LogLoadChunk& chunk, std::string& prevTimeStamp) const;
+    int subReqIndex(const std::string& line) const;
+
+    std::vector<std::string> subReqPatterns_;
+};
+
+#endif // LOGLOADPARSER_HPP
@@ -0,0 +1,268 @@
+//============================================================================
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//============================================================================
+
+#include "OutputDiskStore.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <unistd.h>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+
+namespace fs = boost::filesystem;
+
+static const char* entryMagic = "ecflowui_output 1";
+
+static bool validLines(const std::vector<std::string>& lines) {
+    for (const auto& s : lines) {
+        if (s.find('\n') != std::string::npos)
+            return false;
+    }
+    return true;
+}
+
+static void writeLines(std::ostream& out, const std::vector<std::string>& lines) {
+    out << lines.size() << "\n";
+    for (const auto& s : lines)
+        out << s << "\n";
+}
+
+static bool readLines(std::istream& in, std::vector<std::string>& lines) {
+    std::string line;
+    if (!std::getline(in, line))
+        return false;
+
+    size_t num = 0;
+    try {
+        num = std::stoul(line);
+    }
+    catch (...) {
+        return false;
+    }
+
+    lines.clear();
+    for (size_t i = 0; i < num; i++) {
+        if (!std::getline(in, line))
+            return false;
+        lines.push_back(line);
+    }
+    return true;
+}
+
+OutputDiskStore::OutputDiskStore(const std::string& dir, size_t maxSize) : dir_(dir), maxSize_(maxSize) {
+}
+
+// The file names are a hash of the key, so they do not depend on the characters in the key. A
+// collision only means that the entries replace each other, since the key is checked when read.
+std::string OutputDiskStore::entryPath(const std::vector<std::string>& key) const {
+    std::uint64_t h = 14695981039346656037ULL; // FNV-1a
+    for (const auto& s : key) {
+        for (unsigned char c : s) {
+            h ^= c;
+            h *= 1099511628211ULL;
+        }
+        h ^= '\n';
+        h *= 1099511628211ULL;
+    }
+
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(h));
+    return (fs::path(dir_) / (std::string(buf) + ".entry")).string();
+}
+
+bool OutputDiskStore::find(const std::vector<std::string>& key,
+                           std::vector<std::string>& meta,
+                           const std::string& outPath) {
+    std::string path = entryPath(key);
+
+    // The open file is not affected if another process replaces the entry meanwhile
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if (!in.is_open())
+        return false;
+
+    std::string line;
+    std::vector<std::string> entryKey;
+    if (!std::getline(in, line) || line != entryMagic || !readLines(in, entryKey) || entryKey != key ||
+        !readLines(in, meta) || !std::getline(in, line)) {
+        return false;
+    }
+
+    size_t size = 0;
+    try {
+        size = std::stoul(line);
+    }
+    catch (...) {
+        return false;
+    }
+
+    std::ofstream out(outPath.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+        return false;
+
+    char buf[64 * 1024];
+    size_t remaining = size;
+    while (remaining > 0) {
+        size_t len = std::min(remaining, sizeof(buf));
+        if (!in.read(buf, len) || !out.write(buf, len))
+            break;
+        remaining -= len;
+    }
+    out.close();
+    if (remaining > 0 || !out) {
+        std::remove(outPath.c_str());
+        return false;
+    }
+
+    // the modification time of the entry is used as the access time to find the least
+    // recently used entries
+    boost::system::error_code ec;
+    fs::last_write_time(path, std::time(nullptr), ec);
+    return true;
+}
+
+bool OutputDiskStore::add(const std::vector<std::string>& key,
+                          const std::vector<std::string>& meta,
+                          const char* data,
+                          size_t size) {
+    if (!write(key, meta, data, size, std::string()))
+        return false;
+    evict();
+    return true;
+}
+
+bool OutputDiskStore::addFile(const std::vector<std::string>& key,
+                              const std::vector<std::string>& meta,
+                              const std::string& contentsPath) {
+    boost::system::error_code ec;
+    uintmax_t size = fs::file_size(contentsPath, ec);
+    if (ec || !write(key, meta, nullptr, size, contentsPath))
+        return false;
+    evict();
+    return true;
+}
+
+// The entry is written to a temporary file, which is renamed into place. The rename is
+// atomic, hence readers get either the old or the new entry.
+bool OutputDiskStore::write(const std::vector<std::string>& key,
+                            const std::vector<std::string>& meta,
+                            const char* data,
+                            size_t size,
+                            const std::string& contentsPath) {
+    if (maxSize_ == 0 || size > maxSize_ || !validLines(key) || !validLines(meta))
+        return false;
+
+    std::string path = entryPath(key);
+    std::string tmp  = path + "." + std::to_string(getpid()) + ".tmp";
+    {
+        std::ofstream out(tmp.c_str(), std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+            return false;
+
+        out << entryMagic << "\n";
+        writeLines(out, key);
+        writeLines(out, meta);
+        out << size << "\n";
+
+        if (contentsPath.empty()) {
+            out.write(data, size);
+        }
+        else if (size > 0) {
+            std::ifstream in(contentsPath.c_str(), std::ios::binary);
+            if (!in.is_open() || !(out << in.rdbuf()) || static_cast<size_t>(in.tellg()) != size) {
+                out.close();
+                std::remove(tmp.c_str());
+                return false;
+            }
+        }
+
+        out.close();
+        if (!out) {
+            std::remove(tmp.c_str());
+            return false;
+        }
+    }
+
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+void OutputDiskStore::remove(const std::vector<std::string>& key) {
+    std::remove(entryPath(key).c_str());
+}
+
+size_t OutputDiskStore::size() const {
+    size_t total = 0;
+    boost::system::error_code dirEc, ec;
+    for (fs::directory_iterator it(dir_, dirEc), end; !dirEc && it != end; it.increment(dirEc)) {
+        if (it->path().extension() == ".entry") {
+            uintmax_t size = fs::file_size(it->path(), ec);
+            if (!ec)
+                total += size;
+        }
+    }
+    return total;
+}
+
+// Remove the least recently used entries until the total size is well below the
+// limit. The other processes may be doing the same, so all the errors are ignored.
+void OutputDiskStore::evict() {
+    struct Entry
+    {
+        fs::path path_;
+        uintmax_t size_;
+        std::time_t time_;
+    };
+
+    std::vector<Entry> entries;
+    uintmax_t total = 0;
+    std::time_t now = std::time(nullptr);
+
+    boost::system::error_code dirEc, ec;
+    for (fs::directory_iterator it(dir_, dirEc), end; !dirEc && it != end; it.increment(dirEc)) {
+        const fs::path& p = it->path();
+        std::time_t t     = fs::last_write_time(p, ec);
+        if (ec)
+            continue;
+
+        // left behind by a process that crashed while writing
+        if (p.extension() == ".tmp") {
+            if (now - t > 3600)
+                fs::remove(p, ec);
+            continue;
+        }
+
+        if (p.extension() == ".entry") {
+            uintmax_t size = fs::file_size(p, ec);
+            if (ec)
+                continue;
+            entries.push_back({p, size, t});
+            total += size;
+        }
+    }
+
+    if (total <= maxSize_)
+        return;
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.time_ < b.time_; });
+
+    uintmax_t target = maxSize_ - maxSize_ / 10;
+    for (const auto& e : entries) {
+        if (total <= target)
+            break;
+        fs::remove(e.path_, ec);
+        total -= e.size_;
+    }
+}
@@ -0,0 +1,62 @@
+//============================================================================
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//============================================================================
+
+#ifndef OUTPUTDISKSTORE_HPP
+#define OUTPUTDISKSTORE_HPP
+
+#include <string>
+#include <vector>
+
+// A directory of files shared by several processes, used by ecFlowUI to keep the fetched
+// output files. Each entry is a single file named after the hash of its key. It holds the
+// key, the metadata and the contents. Entries are written to a temporary file which is then
+// renamed into place, so a reader gets either the old or the new entry, never a mix. When
+// the total size exceeds the limit the least recently used entries are removed.
+//
+// The key and the metadata are lists of strings, which must not contain new lines.
+
+class OutputDiskStore {
+public:
+    OutputDiskStore(const std::string& dir, size_t maxSize);
+
+    const std::string& dir() const { return dir_; }
+    size_t maxSize() const { return maxSize_; }
+
+    // Copies the contents of the entry into outPath. Returns false if there is no entry for the key.
+    bool find(const std::vector<std::string>& key, std::vector<std::string>& meta, const std::string& outPath);
+
+    // Add or replace the entry for the key, the contents are either in memory or in a file
+    bool add(const std::vector<std::string>& key, const std::vector<std::string>& meta, const char* data, size_t size);
+    bool addFile(const std::vector<std::string>& key,
+                 const std::vector<std::string>& meta,
+                 const std::string& contentsPath);
+
+    void remove(const std::vector<std::string>& key);
+
+    // Remove the least recently used entries until the total size is below the limit
+    void evict();
+
+    // The total size of the entries
+    size_t size() const;
+
+    // The file holding the entry of the key
+    std::string entryPath(const std::vector<std::string>& key) const;
+
+private:
+    bool write(const std::vector<std::string>& key,
+               const std::vector<std::string>& meta,
+               const char* data,
+               size_t size,
+               const std::string& contentsPath);
+
+    std::string dir_;
+    size_t maxSize_;
+};
+
+#endif // OUTPUTDISKSTORE_HPP
@@ -0,0 +1,149 @@
+//============================================================================
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description : Times the loading of a server log, as done by the server load view.
+//               Does not need a display. Without an argument a log file is generated.
+//============================================================================
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/timer/timer.hpp>
+
+#include "File.hpp"
+#include "LogLoadData.hpp"
+#include "Str.hpp"
+
+using namespace std;
+using namespace ecf;
+using namespace boost::timer;
+
+// About 100MB of user and child commands, spread over several suites and users
+static void generate_log(const std::string& path) {
+    std::ofstream log(path.c_str());
+    const char* suites[] = {"operations", "research", "archive", "test"};
+    const char* users[]  = {"ops@host1", "rd@host2", "ecflow_ui@host3"};
+    int second           = 0;
+    for (int i = 0; i < 1000000; i++) {
+        if (i % 7 == 0)
+            second++;
+        char ts[32];
+        snprintf(ts, sizeof(ts), "%02d:%02d:%02d %d.1.2023", (second / 3600) % 24, (second / 60) % 60, second % 60,
+                 1 + second / 86400);
+        const char* suite = suites[i % 4];
+        const char* user  = users[i % 3];
+        switch (i % 6) {
+            case 0: log << "MSG:[" << ts << "] chd:init /" << suite << "/f" << i % 10 << "/t" << i % 50 << "\n"; break;
+            case 1:
+                log << "MSG:[" << ts << "] chd:complete /" << suite << "/f" << i % 10 << "/t" << i % 50 << "\n";
+                break;
+            case 2:
+                log << "MSG:[" << ts << "] --alter change variable X y /" << suite << "/f; --sync=0 1 2 :" << user
+                    << "\n";
+                break;
+            case 3: log << "MSG:[" << ts << "] --news=4 66603 46 :" << user << " [:NO_NEWS]\n"; break;
+            case 4: log << "LOG:[" << ts << "] complete: /" << suite << "/f" << i % 10 << "/t" << i % 50 << "\n"; break;
+            default: log << "MSG:[" << ts << "] chd:event started /" << suite << "/f" << i % 10 << "\n"; break;
+        }
+    }
+}
+
+static bool same(const LogLoadData& a, const LogLoadData& b) {
+    return a.numOfRows() == b.numOfRows() && a.time() == b.time() && a.total().childReq() == b.total().childReq() &&
+           a.total().userReq() == b.total().userReq() && a.suiteData().size() == b.suiteData().size() &&
+           a.uidData().size() == b.uidData().size();
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 2) {
+        cout << "Expect optional argument which is path to a server log file\n";
+        return 1;
+    }
+
+    std::string path = "perf_logload_timer.log";
+    if (argc == 2)
+        path = argv[1];
+    else
+        generate_log(path);
+
+    std::vector<std::string> suites;
+    cpu_timer timer;
+
+    LogLoadData serial;
+    {
+        LogLoadData::setParallelLoadThreshold(0);
+        timer.start();
+        serial.loadLogFile(path, 0, suites, nullptr);
+        cout << " Serial load, rows(" << serial.numOfRows() << ") seconds(" << serial.size()
+             << ")     = " << timer.format(3, Str::cpu_timer_format()) << endl;
+    }
+
+    LogLoadData parallel;
+    {
+        LogLoadData::setParallelLoadThreshold(1);
+        timer.start();
+        parallel.loadLogFile(path, 0, suites, nullptr);
+        cout << " Parallel load, rows(" << parallel.numOfRows() << ") seconds(" << parallel.size()
+             << ")   = " << timer.format(3, Str::cpu_timer_format()) << endl;
+    }
+
+    // Load the first half, then the lines appended to it
+    LogLoadData tail;
+    LogLoadData partial;
+    bool tailAfterPartial = false;
+    {
+        std::string contents;
+        if (!File::open(path, contents)) {
+            cout << "Could not open " << path << "\n";
+            return 1;
+        }
+        std::string tail_path = "perf_logload_timer_tail.log";
+        size_t half           = contents.find('\n', contents.size() / 2) + 1;
+        {
+            std::ofstream log(tail_path.c_str());
+            log << contents.substr(0, half);
+        }
+        tail.loadLogFile(tail_path, 0, suites, nullptr);
+        {
+            std::ofstream log(tail_path.c_str(), std::ios::app);
+            log << contents.substr(half);
+        }
+
+        timer.start();
+        bool ok = tail.loadLogFileTail(tail_path, nullptr);
+        cout << " Tail load of second half, ok(" << ok << ") = " << timer.format(3, Str::cpu_timer_format())
+             << endl;
+        std::remove(tail_path.c_str());
+
+        // A full load parses a last line without a newline, hence a tail load can not follow it
+        std::string partial_path = "perf_logload_timer_partial.log";
+        {
+            std::ofstream log(partial_path.c_str());
+            log << contents.substr(0, contents.find_last_not_of('\n') + 1);
+        }
+        partial.loadLogFile(partial_path, 0, suites, nullptr);
+        tailAfterPartial = partial.loadLogFileTail(partial_path, nullptr);
+        std::remove(partial_path.c_str());
+    }
+
+    if (argc == 1)
+        std::remove(path.c_str());
+
+    if (!same(serial, parallel) || !same(serial, tail)) {
+        cout << "Error: parallel and tail loads differ from the serial load\n";
+        return 1;
+    }
+    if (!same(serial, partial) || tailAfterPartial) {
+        cout << "Error: the last line without a newline was not parsed\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,134 @@
+#define BOOST_TEST_MODULE TestViewer
+//============================================================================
+// Copyright 2009- ECMWF.
+// This software is licensed under the terms of the Apache Licence version 2.0
+// which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+// In applying this licence, ECMWF does not waive the privileges and immunities
+// granted to it by virtue of its status as an intergovernmental organisation
+// nor does it submit to any jurisdiction.
+//
+// Description : Test the disk store used by ecFlowUI to keep the fetched output files
+//============================================================================
+
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "OutputDiskStore.hpp"
+
+namespace fs = boost::filesystem;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(ViewerTestSuite)
+
+// A store in its own directory, removed at the end of the test
+class TestStoreDir {
+public:
+    TestStoreDir() : dir_(fs::absolute("test_output_disk_store").string()) {
+        fs::remove_all(dir_);
+        fs::create_directory(dir_);
+    }
+    ~TestStoreDir() { fs::remove_all(dir_); }
+    const std::string& dir() const { return dir_; }
+
+private:
+    std::string dir_;
+};
+
+static std::string contents(const std::string& path) {
+    std::ifstream in(path.c_str(), std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+BOOST_AUTO_TEST_CASE(test_output_disk_store_find_add) {
+    cout << "Viewer:: ...test_output_disk_store_find_add\n";
+    TestStoreDir storeDir;
+    OutputDiskStore store(storeDir.dir(), 1024 * 1024);
+    std::string outPath = storeDir.dir() + "/found.out";
+
+    std::vector<std::string> key  = {"host@3141", "/s/f/t.1", "1", "rid"};
+    std::vector<std::string> meta = {"100", "checksum"};
+    std::vector<std::string> foundMeta;
+    BOOST_CHECK_MESSAGE(!store.find(key, foundMeta, outPath), "Expected empty store");
+
+    std::string data = "line 1\nline 2\n";
+    BOOST_REQUIRE_MESSAGE(store.add(key, meta, data.c_str(), data.size()), "add failed");
+    BOOST_REQUIRE_MESSAGE(store.find(key, foundMeta, outPath), "Expected entry to be found");
+    BOOST_CHECK_MESSAGE(foundMeta == meta, "Expected the metadata to be kept");
+    BOOST_CHECK_MESSAGE(contents(outPath) == data, "Expected the contents to be kept");
+
+    // A different try number is another entry
+    std::vector<std::string> key2 = {"host@3141", "/s/f/t.1", "2", "rid"};
+    BOOST_CHECK_MESSAGE(!store.find(key2, foundMeta, outPath), "Expected no entry for another try number");
+
+    // The contents can also come from a file, the entry is replaced as a whole
+    std::string srcPath = storeDir.dir() + "/src.out";
+    {
+        std::ofstream src(srcPath.c_str(), std::ios::binary);
+        src << "replaced\n";
+    }
+    std::vector<std::string> meta2 = {"200", "checksum2"};
+    BOOST_REQUIRE_MESSAGE(store.addFile(key, meta2, srcPath), "addFile failed");
+    BOOST_REQUIRE_MESSAGE(store.find(key, foundMeta, outPath), "Expected entry to be found");
+    BOOST_CHECK_MESSAGE(foundMeta == meta2, "Expected the metadata to be replaced");
+    BOOST_CHECK_MESSAGE(contents(outPath) == "replaced\n", "Expected the contents to be replaced");
+
+    // Only complete entries are left, no temporary files
+    size_t numOfFiles = 0;
+    for (fs::directory_iterator it(storeDir.dir()), end; it != end; ++it) {
+        if (it->path().extension() == ".entry" || it->path().extension() == ".tmp")
+            numOfFiles++;
+    }
+    BOOST_CHECK_MESSAGE(numOfFiles == 1, "Expected a single entry file but found " << numOfFiles);
+
+    // Keys and metadata are stored one per line
+    BOOST_CHECK_MESSAGE(!store.add({"host@3141", "bad\npath"}, meta, data.c_str(), data.size()),
+                        "Expected a key with a new line to be rejected");
+
+    store.remove(key);
+    BOOST_CHECK_MESSAGE(!store.find(key, foundMeta, outPath), "Expected entry to be removed");
+}
+
+BOOST_AUTO_TEST_CASE(test_output_disk_store_evict) {
+    cout << "Viewer:: ...test_output_disk_store_evict\n";
+    TestStoreDir storeDir;
+    OutputDiskStore store(storeDir.dir(), 10 * 1024);
+    std::string outPath = storeDir.dir() + "/found.out";
+
+    std::string data(3 * 1024, 'x');
+    std::vector<std::string> meta;
+    std::vector<std::vector<std::string>> keys = {{"a"}, {"b"}, {"c"}};
+
+    // The entries are used in the order of the keys, the first the longest ago
+    std::time_t t = std::time(nullptr) - 100;
+    for (const auto& key : keys) {
+        BOOST_REQUIRE_MESSAGE(store.add(key, meta, data.c_str(), data.size()), "add failed");
+        fs::last_write_time(store.entryPath(key), t++);
+    }
+    BOOST_CHECK_MESSAGE(store.size() > 9 * 1024 && store.size() <= 10 * 1024, "Unexpected size " << store.size());
+
+    // Reading the first entry makes it the most recently used
+    BOOST_REQUIRE_MESSAGE(store.find(keys[0], meta, outPath), "Expected entry to be found");
+
+    // Exceeds the limit, the least recently used entries are removed
+    BOOST_REQUIRE_MESSAGE(store.add({"d"}, meta, data.c_str(), data.size()), "add failed");
+    BOOST_CHECK_MESSAGE(store.size() <= 9 * 1024, "Expected the size to be below the limit " << store.size());
+    BOOST_CHECK_MESSAGE(store.find({"d"}, meta, outPath), "Expected the new entry to be kept");
+    BOOST_CHECK_MESSAGE(store.find(keys[0], meta, outPath), "Expected the recently read entry to be kept");
+    BOOST_CHECK_MESSAGE(!store.find(keys[1], meta, outPath), "Expected the least recently used entry to be removed");
+
+    // Entries larger than the limit are not stored
+    std::string big(11 * 1024, 'x');
+    BOOST_CHECK_MESSAGE(!store.add({"e"}, meta, big.c_str(), big.size()), "Expected entry larger than limit to fail");
+
+    // A store without a size is disabled
+    OutputDiskStore disabled(storeDir.dir(), 0);
+    BOOST_CHECK_MESSAGE(!disabled.add({"f"}, meta, data.c_str(), data.size()), "Expected disabled store");
+}
+
+BOOST_AUTO_TEST_SUITE_END()